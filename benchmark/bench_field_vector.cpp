@@ -0,0 +1,90 @@
+/*
+ * bench_field_vector.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ *       Email: holger@notjustphysics.com
+ *
+ * Growth of a std::vector<Field<double,3>> by push_back without reserving memory.
+ * Every reallocation of the vector relocates all fields. With the move constructor
+ * the data is handed over and the updater registration is re-keyed in place. The
+ * second run wraps the field in a type without a move constructor, so that every
+ * relocation copies the field and registers and removes an updater, which is what
+ * happened before grids could be moved.
+ *
+ * Usage: bench_field_vector [numFields] [N] [repetitions]
+ *
+ * Each field has N^3 inner points and two ghost cells.
+ */
+
+#include <grid/field.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace schnek;
+
+typedef Field<double, 3> FieldType;
+
+/// A field that can only be copied
+struct CopyOnlyField : public FieldType
+{
+  CopyOnlyField(const Array<int, 3> &size, const Range<double, 3> &domain, const Array<bool, 3> &stagger, int ghostCells)
+    : FieldType(size, domain, stagger, ghostCells)
+  {}
+  CopyOnlyField(const CopyOnlyField &) = default;
+  CopyOnlyField &operator=(const CopyOnlyField &) = default;
+};
+
+template<class ElementType>
+double grow(int numFields, int N, int repetitions)
+{
+  const Range<double, 3> domain(Array<double, 3>(0.0, 0.0, 0.0), Array<double, 3>(1.0, 1.0, 1.0));
+  const Array<bool, 3> stagger(false, false, false);
+  const Array<int, 3> size(N, N, N);
+
+  // allocate the fields up front so that only the vector growth is timed
+  std::vector<ElementType> source;
+  source.reserve(numFields);
+  for (int n=0; n<numFields; ++n)
+  {
+    source.emplace_back(size, domain, stagger, 2);
+  }
+
+  double best = std::numeric_limits<double>::max();
+  for (int r=0; r<repetitions; ++r)
+  {
+    std::vector<ElementType> copies(source);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ElementType> fields;
+    for (ElementType &field : copies)
+    {
+      fields.push_back(std::move(field));
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+  return 1e9*best/numFields;
+}
+
+int main(int argc, char **argv)
+{
+  int numFields = (argc > 1) ? std::atoi(argv[1]) : 10000;
+  int N = (argc > 2) ? std::atoi(argv[2]) : 8;
+  int repetitions = (argc > 3) ? std::atoi(argv[3]) : 10;
+
+  std::cout << "push_back of " << numFields << " fields with " << N << "^3 points\n";
+
+  double moved = grow<FieldType>(numFields, N, repetitions);
+  std::cout << "Field<double,3>, moved:  " << moved << " ns per field\n";
+
+  double copied = grow<CopyOnlyField>(numFields, N, repetitions);
+  std::cout << "Field<double,3>, copied: " << copied << " ns per field\n";
+
+  return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * bench_first_touch.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ *       Email: holger@notjustphysics.com
+ *
+ * STREAM-like triad a = b + s*c on three Grid<double,3> using the threads of the
+ * ThreadPool. The grids are split into slabs along the first dimension with
+ * partitionRange(). The triad is run once for grids that have been initialised
+ * serially and once for grids using FirstTouchArrayGridStorage.
+ *
+ * Usage: bench_first_touch [N] [repetitions]
+ *
+ * The grids have N^3 points. The number of threads is taken from SCHNEK_NUM_THREADS
+ * or OMP_NUM_THREADS. Pin the threads, e.g. with OMP_PROC_BIND or numactl, to see
+ * the effect on NUMA systems.
+ */
+
+#include <grid/grid.hpp>
+#include <util/threadpool.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+
+using namespace schnek;
+
+template<template<typename, size_t> class StoragePolicy>
+void parallelSlabs(const Grid<double, 3, GridNoArgCheck, StoragePolicy> &g, std::function<void(int, int)> func)
+{
+  ThreadPool &pool = ThreadPool::instance();
+  const size_t parts = pool.getNumThreads();
+  const int lo = g.getLo(0);
+  const int hi = g.getHi(0);
+  pool.run([&](size_t part) {
+    int partLo, partHi;
+    partitionRange(lo, hi, part, parts, partLo, partHi);
+    func(partLo, partHi);
+  });
+}
+
+template<template<typename, size_t> class StoragePolicy>
+double triad(int N, int repetitions, bool parallelInit)
+{
+  typedef Grid<double, 3, GridNoArgCheck, StoragePolicy> GridType;
+  typename GridType::IndexType lo(0, 0, 0), hi(N-1, N-1, N-1);
+
+  GridType a(lo, hi), b(lo, hi), c(lo, hi);
+
+  auto init = [&](int iLo, int iHi) {
+    for (int i=iLo; i<=iHi; ++i)
+      for (int j=0; j<N; ++j)
+        for (int k=0; k<N; ++k)
+        {
+          a(i,j,k) = 0.0;
+          b(i,j,k) = 1.0;
+          c(i,j,k) = 2.0;
+        }
+  };
+
+  if (parallelInit)
+    parallelSlabs(a, init);
+  else
+    init(0, N-1);
+
+  const double s = 3.0;
+  double best = std::numeric_limits<double>::max();
+  for (int r=0; r<repetitions; ++r)
+  {
+    auto start = std::chrono::steady_clock::now();
+    parallelSlabs(a, [&](int iLo, int iHi) {
+      for (int i=iLo; i<=iHi; ++i)
+        for (int j=0; j<N; ++j)
+          for (int k=0; k<N; ++k)
+            a(i,j,k) = b(i,j,k) + s*c(i,j,k);
+    });
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+
+  const double bytes = 3.0*sizeof(double)*double(N)*double(N)*double(N);
+  return 1e-9*bytes/best;
+}
+
+int main(int argc, char **argv)
+{
+  int N = (argc > 1) ? std::atoi(argv[1]) : 256;
+  int repetitions = (argc > 2) ? std::atoi(argv[2]) : 10;
+
+  std::cout << "Triad on 3 x " << N << "^3 doubles using "
+            << ThreadPool::instance().getNumThreads() << " threads\n";
+
+  double serial = triad<SingleArrayGridStorage>(N, repetitions, false);
+  std::cout << "SingleArrayGridStorage, serial initialisation:   " << serial << " GB/s\n";
+
+  double firstTouch = triad<FirstTouchArrayGridStorage>(N, repetitions, true);
+  std::cout << "FirstTouchArrayGridStorage, first touch in slabs: " << firstTouch << " GB/s\n";
+
+  return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * bench_morton_stencil.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ *       Email: holger@notjustphysics.com
+ *
+ * 7-point and 27-point stencils on Grid<double,3> with different storage layouts.
+ * Each layout is traversed with its own iteration policy: C-order storage with
+ * RangeCIterationPolicy, tiled storage with RangeTiledIterationPolicy and Morton
+ * storage with RangeMortonIterationPolicy.
+ *
+ * Usage: bench_morton_stencil [N] [repetitions]
+ *
+ * The grids have N^3 points. The stencils are applied to the inner (N-2)^3 points.
+ * Choose N as a power of two to avoid padding in the Morton layout.
+ */
+
+#include <grid/grid.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace schnek;
+
+template<template<typename, size_t> class StoragePolicy, size_t points>
+double stencil(int N, int repetitions, double &checksum)
+{
+  typedef Grid<double, 3, GridNoArgCheck, StoragePolicy> GridType;
+  typedef typename GridType::IndexType IndexType;
+  typedef typename StoragePolicy<double, 3>::IterationPolicy IterationPolicy;
+
+  IndexType lo(0, 0, 0), hi(N-1, N-1, N-1);
+  GridType in(lo, hi), out(lo, hi);
+
+  IterationPolicy::forEach(in.getRange(), [&](const IndexType &pos) {
+    in[pos] = double((pos[0]*7 + pos[1]*3 + pos[2]) % 17);
+    out[pos] = 0.0;
+  });
+
+  Range<int, 3> inner(IndexType(1, 1, 1), IndexType(N-2, N-2, N-2));
+  double best = std::numeric_limits<double>::max();
+  for (int r=0; r<repetitions; ++r)
+  {
+    auto start = std::chrono::steady_clock::now();
+    if (points == 7)
+    {
+      IterationPolicy::forEach(inner, [&](const IndexType &pos) {
+        const int i = pos[0], j = pos[1], k = pos[2];
+        out(i,j,k) = -6.0*in(i,j,k)
+                   + in(i-1,j,k) + in(i+1,j,k)
+                   + in(i,j-1,k) + in(i,j+1,k)
+                   + in(i,j,k-1) + in(i,j,k+1);
+      });
+    }
+    else
+    {
+      IterationPolicy::forEach(inner, [&](const IndexType &pos) {
+        const int i = pos[0], j = pos[1], k = pos[2];
+        double sum = 0.0;
+        for (int di=-1; di<=1; ++di)
+          for (int dj=-1; dj<=1; ++dj)
+            for (int dk=-1; dk<=1; ++dk)
+              sum += in(i+di,j+dj,k+dk);
+        out(i,j,k) = sum/27.0;
+      });
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+
+  checksum = 0.0;
+  IterationPolicy::forEach(inner, [&](const IndexType &pos) { checksum += out[pos]; });
+
+  const double n = double(N-2);
+  return 1e-6*n*n*n/best;
+}
+
+template<size_t points>
+void run(int N, int repetitions)
+{
+  double checkC, checkTiled, checkMorton;
+  double c = stencil<SingleArrayGridStorage, points>(N, repetitions, checkC);
+  double tiled = stencil<TiledGridStorage, points>(N, repetitions, checkTiled);
+  double morton = stencil<MortonGridStorage, points>(N, repetitions, checkMorton);
+
+  std::cout << points << "-point stencil\n"
+            << "  SingleArrayGridStorage, C order:   " << c << " Mpoints/s\n"
+            << "  TiledGridStorage, tiled order:     " << tiled << " Mpoints/s\n"
+            << "  MortonGridStorage, Morton order:   " << morton << " Mpoints/s\n";
+
+  const double tolerance = 1e-9*std::abs(checkC);
+  if ((std::abs(checkC - checkTiled) > tolerance) || (std::abs(checkC - checkMorton) > tolerance))
+  {
+    std::cout << "  checksums differ: " << checkC << " " << checkTiled << " " << checkMorton << "\n";
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int N = (argc > 1) ? std::atoi(argv[1]) : 128;
+  int repetitions = (argc > 2) ? std::atoi(argv[2]) : 10;
+
+  std::cout << "Stencils on " << N << "^3 doubles\n";
+  run<7>(N, repetitions);
+  run<27>(N, repetitions);
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * bench_work_stealing.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ *       Email: holger@notjustphysics.com
+ *
+ * Loop over a Grid<double,3> in which the work per cell is very uneven. Cells inside
+ * a sphere of radius N/4 near one corner of the grid are "particle-heavy" and cost many
+ * times more than the others. Cells in a thin layer at the upper boundary of the last
+ * dimension are "cut cells" with a moderate extra cost. The loop is run with
+ * RangeThreadedIterationPolicy using the static, dynamic and work-stealing schedules.
+ *
+ * Usage: bench_work_stealing [N] [heavy] [repetitions]
+ *
+ * The grid has N^3 points. A heavy cell does `heavy` times the work of a normal cell.
+ * The number of threads is taken from SCHNEK_NUM_THREADS or OMP_NUM_THREADS.
+ */
+
+#include <grid/grid.hpp>
+#include <grid/iteration/threaded-iteration.hpp>
+#include <util/threadpool.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+
+using namespace schnek;
+
+typedef Grid<double, 3> GridType;
+
+/// A fixed amount of floating point work that the compiler cannot remove
+inline double work(double x, int steps)
+{
+  for (int s=0; s<steps; ++s) x = std::sqrt(x*x + 1.0) - 0.5*x;
+  return x;
+}
+
+template<class IterationPolicy>
+double run(GridType &result, const GridType &cost, int repetitions)
+{
+  const GridType::RangeType range(result.getLo(), result.getHi());
+  double best = std::numeric_limits<double>::max();
+  for (int r=0; r<repetitions; ++r)
+  {
+    auto start = std::chrono::steady_clock::now();
+    IterationPolicy::forEach(range, [&](const GridType::IndexType &pos) {
+      result[pos] = work(result[pos], int(cost[pos]));
+    });
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+int main(int argc, char **argv)
+{
+  int N = (argc > 1) ? std::atoi(argv[1]) : 96;
+  int heavy = (argc > 2) ? std::atoi(argv[2]) : 50;
+  int repetitions = (argc > 3) ? std::atoi(argv[3]) : 5;
+
+  GridType::IndexType lo(0, 0, 0), hi(N-1, N-1, N-1);
+  GridType result(lo, hi), cost(lo, hi);
+
+  const double radius = 0.25*N;
+  for (int i=0; i<N; ++i)
+    for (int j=0; j<N; ++j)
+      for (int k=0; k<N; ++k)
+      {
+        const double r2 = double(i)*i + double(j)*j + double(k)*k;
+        int steps = 4;
+        if (r2 < radius*radius) steps *= heavy;
+        else if (k >= N-2) steps *= 4;
+        cost(i,j,k) = steps;
+        result(i,j,k) = 1.0;
+      }
+
+  std::cout << "Imbalanced loop on " << N << "^3 cells, heavy cells cost " << heavy
+            << "x, using " << ThreadPool::instance().getNumThreads() << " threads\n";
+
+  double serial = run<RangeThreadedIterationPolicy<3, DeterministicSchedule> >(result, cost, 1);
+  std::cout << "deterministic (serial): " << serial << " s\n";
+
+  double stat = run<RangeThreadedIterationPolicy<3, StaticSchedule> >(result, cost, repetitions);
+  std::cout << "static schedule:        " << stat << " s, speedup " << serial/stat << "\n";
+
+  double dynamic = run<RangeThreadedIterationPolicy<3, DynamicSchedule<> > >(result, cost, repetitions);
+  std::cout << "dynamic schedule:       " << dynamic << " s, speedup " << serial/dynamic << "\n";
+
+  double stealing = run<RangeWorkStealingIterationPolicy<3> >(result, cost, repetitions);
+  std::cout << "work stealing:          " << stealing << " s, speedup " << serial/stealing << "\n";
+
+  return 0;
+}
@@ -347,4 +347,20 @@ const hid_t H5DataType<float>::type = H5T_NATIVE_FLOAT;
 template<>
 const hid_t H5DataType<double>::type = H5T_NATIVE_DOUBLE;
 
+namespace {
+  /// bfloat16 has the layout of the upper half of an IEEE single precision number
+  hid_t createBFloat16Type()
+  {
+    hid_t type = H5Tcopy(H5T_NATIVE_FLOAT);
+    H5Tset_fields(type, 15, 7, 8, 0, 7);
+    H5Tset_precision(type, 16);
+    H5Tset_size(type, 2);
+    H5Tset_ebias(type, 127);
+    return type;
+  }
+}
+
+template<>
+const hid_t H5DataType<BFloat16>::type = createBFloat16Type();
+
 #endif
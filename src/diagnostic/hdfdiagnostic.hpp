@@ -30,11 +30,16 @@
 #ifdef SCHNEK_HAVE_HDF5
 
 #include "../grid/grid.hpp"
+#include "../grid/iteration/range-iteration.hpp"
 #include "diagnostic.hpp"
+#include "../grid/gridstorage/host-mirror.hpp"
+#include "../util/bfloat16.hpp"
 
 #include <hdf5.h>
 
 #include <memory>
+#include <type_traits>
+#include <vector>
 
 #if defined (H5_HAVE_PARALLEL) && defined (SCHNEK_USE_HDF_PARALLEL)
 #include <mpi.h>
@@ -49,6 +54,93 @@ struct H5DataType{
   static const hid_t type;
 };
 
+namespace internal {
+  /// True if the grid holds its data in a single array, false for storages such as SparseGridStorage
+  template<typename GridType, typename = void>
+  struct HasRawData : std::false_type {};
+
+  template<typename GridType>
+  struct HasRawData<GridType, std::void_t<decltype(std::declval<GridType&>().getRawData())> >
+    : std::true_type {};
+
+  /// True if the grid provides the strides of its raw data through `stride(dim)`
+  template<typename GridType, typename = void>
+  struct HasStride : std::false_type {};
+
+  template<typename GridType>
+  struct HasStride<GridType, std::void_t<decltype(std::declval<const GridType&>().stride(size_t(0)))> >
+    : std::true_type {};
+
+  /// True if the grid stores its components in separate planes, see SoAGridStorage
+  template<typename GridType, typename = void>
+  struct HasComponentData : std::false_type {};
+
+  template<typename GridType>
+  struct HasComponentData<GridType, std::void_t<decltype(std::declval<GridType&>().getComponentData(size_t(0)))> >
+    : std::true_type {};
+
+  /**
+   * True if the data returned by `getRawData()` is an array in C order
+   *
+   * Tiled, Morton and circular storages provide `getRawData()` but no `stride()`, because
+   * their layout is not a strided array. For grids that provide strides, the strides are
+   * checked at runtime, so Fortran-ordered grids are not taken as C arrays. Allocation
+   * policies may pad the array, so the extents of the array, which are returned in
+   * `extents`, can be larger than the dimensions of the grid.
+   */
+  template<typename GridType>
+  bool isCOrder(const GridType &grid, typename GridType::IndexType &extents)
+  {
+    if constexpr (HasRawData<GridType>::value && HasStride<GridType>::value)
+    {
+      extents = grid.getDims();
+      if (grid.stride(GridType::Rank-1) != 1) return false;
+      for (size_t d = 1; d < GridType::Rank; ++d)
+      {
+        if (grid.stride(d-1) % grid.stride(d) != 0) return false;
+        extents[d] = grid.stride(d-1) / grid.stride(d);
+        if (extents[d] < grid.getDims(d)) return false;
+      }
+      return true;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  /// The number of grid points
+  template<typename GridType>
+  size_t numGridPoints(const GridType &grid)
+  {
+    size_t size = 1;
+    for (size_t d = 0; d < GridType::Rank; ++d) size *= grid.getDims(d);
+    return size;
+  }
+
+  /// Copy the values of a grid into a dense array in C order
+  template<typename GridType, typename T>
+  void copyGridToDense(const GridType &grid, T *dest)
+  {
+    typedef typename GridType::IndexType IndexType;
+    RangeCIterationPolicy<GridType::Rank>::forEach(
+      RangeBounds<IndexType>{grid.getLo(), grid.getHi()},
+      [&](const IndexType &pos) { *dest++ = grid[pos]; }
+    );
+  }
+
+  /// Copy the values of a dense array in C order into a grid
+  template<typename GridType, typename T>
+  void copyDenseToGrid(const T *src, GridType &grid)
+  {
+    typedef typename GridType::IndexType IndexType;
+    RangeCIterationPolicy<GridType::Rank>::forEach(
+      RangeBounds<IndexType>{grid.getLo(), grid.getHi()},
+      [&](const IndexType &pos) { grid[pos] = *src++; }
+    );
+  }
+}
+
 
 /**
  * A container type for grids that are being passed to the HDFGridDiagnostic
@@ -195,9 +287,25 @@ class HdfIStream : public HdfStream {
     /// opens HDF file "fname", selects first dataset
     int open(const char*);
 
-    /// stream input operator for a schnek::Matrix
+    /**
+     * stream input operator for a schnek::Matrix
+     *
+     * Grids whose data is not an array in C order are read into a temporary dense
+     * array first, which is then copied into the grid element by element. Padded
+     * C-ordered arrays are read directly through a hyperslab of the allocated array.
+     * Grids with structure-of-arrays storage cannot be read.
+     */
     template<typename FieldType>
     void readGrid(GridContainer<FieldType> &g);
+  private:
+    /**
+     * read into the grid data pointed to by data
+     *
+     * The data is a C-ordered array with the extents allocDims, which may be larger
+     * than the dimensions of the grid.
+     */
+    template<typename FieldType, typename T>
+    void readGridData(GridContainer<FieldType> &g, T *data, const typename FieldType::IndexType &allocDims);
 };
 
 
@@ -223,9 +331,34 @@ class HdfOStream : public HdfStream {
     /// open file
     int open(const char*);
 
-    /// stream output operator for a matrix
+    /**
+     * stream output operator for a matrix
+     *
+     * Grids whose data is not an array in C order, such as tiled, Morton, circular
+     * or sparse grids, are copied element by element into a temporary dense array first.
+     * Padded C-ordered arrays are written directly through a hyperslab of the allocated array.
+     * Grids with structure-of-arrays storage must be written with writeGridComponent().
+     */
     template<typename FieldType>
     void writeGrid(GridContainer<FieldType> &g);
+
+    /**
+     * Write a single component of a grid with structure-of-arrays storage
+     *
+     * The grid must provide `getComponentData(component)`, see SoAGridStorage.
+     * The dataset has the component type of the grid.
+     */
+    template<typename FieldType>
+    void writeGridComponent(GridContainer<FieldType> &g, size_t component);
+  private:
+    /**
+     * write the grid data pointed to by data
+     *
+     * The data is a C-ordered array with the extents allocDims, which may be larger
+     * than the dimensions of the grid.
+     */
+    template<typename FieldType, typename T>
+    void writeGridData(GridContainer<FieldType> &g, const T *data, const typename FieldType::IndexType &allocDims);
 };
 /**
  * Abstract diagnostic class for writing Grids into HDF5 data files
@@ -52,11 +52,33 @@ void HdfAttributes::set(std::string name, const T &value, hsize_t dims) {
 
 template<typename FieldType>
 void HdfIStream::readGrid(GridContainer<FieldType> &g)
+{
+  static_assert(!internal::HasComponentData<FieldType>::value,
+                "grids with structure-of-arrays storage cannot be read with readGrid()");
+  if constexpr (internal::HasRawData<FieldType>::value)
+  {
+    typename FieldType::IndexType allocDims;
+    if (internal::isCOrder(g.grid, allocDims))
+    {
+      // the data is read in the stored type, which may differ from the value type of the grid
+      readGridData(g, g.grid.getRawData(), allocDims);
+      internal::markHostModified(g.grid);
+      return;
+    }
+  }
+
+  std::vector<typename FieldType::value_type> dense(internal::numGridPoints(g.grid));
+  readGridData(g, dense.data(), g.grid.getDims());
+  internal::copyDenseToGrid(dense.data(), g.grid);
+  internal::markHostModified(g.grid);
+}
+
+template<typename FieldType, typename T>
+void HdfIStream::readGridData(GridContainer<FieldType> &g, T *data, const typename FieldType::IndexType &allocDims)
 {
   std::string dset_name = getNextBlockName();
 
   typedef typename FieldType::IndexType IndexType;
-  typedef typename FieldType::value_type T;
 
   IndexType mdims = g.grid.getDims();
   IndexType mlo = g.grid.getLo();
@@ -70,8 +92,10 @@ void HdfIStream::readGrid(GridContainer<FieldType> &g)
 
   hsize_t locdims[FieldType::Rank];
   hsize_t memdims[FieldType::Rank];
+  hsize_t allocdims[FieldType::Rank];
   hsize_t locstart[FieldType::Rank];
   hsize_t memstart[FieldType::Rank];
+  hsize_t zero[FieldType::Rank];
 
   for (int i=0; i<FieldType::Rank; ++i)
   {
@@ -81,7 +105,9 @@ void HdfIStream::readGrid(GridContainer<FieldType> &g)
     locdims[i]  = lhi[i] - llo[i] + 1;
     locstart[i] = llo[i] - gmin;
     memdims[i] = mhi[i] - mlo[i] + 1;
+    allocdims[i] = allocDims[i];
     memstart[i] = llo[i] - mlo[i];
+    zero[i] = 0;
 
     if (dims[i]<(locstart[i]+locdims[i]))
     {
@@ -101,7 +127,6 @@ void HdfIStream::readGrid(GridContainer<FieldType> &g)
     }
   }
 
-  T *data = g.grid.getRawData();
   hid_t ret;
 
   /* open the dataset collectively */
@@ -124,7 +149,7 @@ void HdfIStream::readGrid(GridContainer<FieldType> &g)
   assert(ret != -1);
 
   /* create a memory dataspace independently */
-  hid_t mem_dataspace = H5Screate_simple(FieldType::Rank, memdims, NULL);
+  hid_t mem_dataspace = H5Screate_simple(FieldType::Rank, allocdims, NULL);
   assert (mem_dataspace != -1);
   ret = H5Sselect_hyperslab(mem_dataspace,  H5S_SELECT_SET,
                             memstart, NULL, locdims, NULL);
@@ -144,24 +169,59 @@ void HdfIStream::readGrid(GridContainer<FieldType> &g)
   H5Sclose(mem_dataspace);
   H5Sclose(file_dataspace);
 #else
+  /* the grid may be a hyperslab of a larger, padded array */
+  hid_t mem_dataspace = H5Screate_simple(FieldType::Rank, allocdims, NULL);
+  assert (mem_dataspace != -1);
+  ret = H5Sselect_hyperslab(mem_dataspace,  H5S_SELECT_SET,
+                            zero, NULL, memdims, NULL);
+  assert(ret != -1);
+
   /* read the data on single processor */
   ret = H5Dread(dataset,
                       H5DataType<T>::type,
-                      H5S_ALL,
+                      mem_dataspace,
                       H5S_ALL,
                       H5P_DEFAULT,
                       data);
   assert(ret != -1);
+
+  H5Sclose(mem_dataspace);
 #endif
 
   /* close dataset collectively */
   ret=H5Dclose(dataset);
   assert(ret != -1);
-
 }
 
 template<typename FieldType>
 void HdfOStream::writeGrid(GridContainer<FieldType> &g)
+{
+  static_assert(!internal::HasComponentData<FieldType>::value,
+                "grids with structure-of-arrays storage must be written with writeGridComponent()");
+  internal::syncHostMirror(g.grid);
+  if constexpr (internal::HasRawData<FieldType>::value)
+  {
+    typename FieldType::IndexType allocDims;
+    if (internal::isCOrder(g.grid, allocDims))
+    {
+      writeGridData(g, g.grid.getRawData(), allocDims);
+      return;
+    }
+  }
+
+  std::vector<typename FieldType::value_type> dense(internal::numGridPoints(g.grid));
+  internal::copyGridToDense(g.grid, dense.data());
+  writeGridData(g, dense.data(), g.grid.getDims());
+}
+
+template<typename FieldType>
+void HdfOStream::writeGridComponent(GridContainer<FieldType> &g, size_t component)
+{
+  writeGridData(g, g.grid.getComponentData(component), g.grid.getDims());
+}
+
+template<typename FieldType, typename T>
+void HdfOStream::writeGridData(GridContainer<FieldType> &g, const T *data, const typename FieldType::IndexType &allocDims)
 {
   if (!active) {
     return;
@@ -170,7 +230,6 @@ void HdfOStream::writeGrid(GridContainer<FieldType> &g)
   std::string dset_name = getNextBlockName();
 
   typedef typename FieldType::IndexType IndexType;
-  typedef typename FieldType::value_type T;
 
   IndexType mdims = g.grid.getDims();
   IndexType mlo = g.grid.getLo();
@@ -184,8 +243,10 @@ void HdfOStream::writeGrid(GridContainer<FieldType> &g)
 
   hsize_t locdims[FieldType::Rank];
   hsize_t memdims[FieldType::Rank];
+  hsize_t allocdims[FieldType::Rank];
   hsize_t locstart[FieldType::Rank];
   hsize_t memstart[FieldType::Rank];
+  hsize_t zero[FieldType::Rank];
 
   for (int i=0; i<FieldType::Rank; ++i)
   {
@@ -195,7 +256,9 @@ void HdfOStream::writeGrid(GridContainer<FieldType> &g)
     locdims[i]  = lhi[i] - llo[i] + 1;
     locstart[i] = llo[i] - gmin;
     memdims[i] = mhi[i] - mlo[i] + 1;
+    allocdims[i] = allocDims[i];
     memstart[i] = llo[i] - mlo[i];
+    zero[i] = 0;
 
     SCHNEK_TRACE_LOG(2,"HdfOStream::writeGrid("<<i<<") "<< gmin <<" "<< g.global_max[i]<<" " << llo[i]<<" " << lhi[i])
 
@@ -219,7 +282,6 @@ void HdfOStream::writeGrid(GridContainer<FieldType> &g)
     }
   }
 
-  const T *data = g.grid.getRawData();
   hid_t ret;
 
   /* setup dimensionality object */
@@ -260,7 +322,7 @@ void HdfOStream::writeGrid(GridContainer<FieldType> &g)
   assert(ret != -1);
 
   /* create a memory dataspace independently */
-  hid_t mem_dataspace = H5Screate_simple (FieldType::Rank, memdims, NULL);
+  hid_t mem_dataspace = H5Screate_simple (FieldType::Rank, allocdims, NULL);
   assert(mem_dataspace > -1);
 
   ret = H5Sselect_hyperslab(mem_dataspace,  H5S_SELECT_SET,
@@ -282,14 +344,23 @@ void HdfOStream::writeGrid(GridContainer<FieldType> &g)
   H5Sclose(mem_dataspace);
   H5Sclose(file_dataspace);
 #else
+  /* the grid may be a hyperslab of a larger, padded array */
+  hid_t mem_dataspace = H5Screate_simple (FieldType::Rank, allocdims, NULL);
+  assert(mem_dataspace > -1);
+  ret = H5Sselect_hyperslab(mem_dataspace,  H5S_SELECT_SET,
+                            zero, NULL, memdims, NULL);
+  assert(ret != -1);
+
   /* write data on single processor */
   ret = H5Dwrite(dataset,
                  H5DataType<T>::type,
-                 H5S_ALL,
+                 mem_dataspace,
                  H5S_ALL,
                  H5P_DEFAULT,
                  data);
   assert(ret != -1);
+
+  H5Sclose(mem_dataspace);
 #endif
 
   /* now write the attributes */
@@ -39,4 +39,5 @@
 #include "grid/mpisubdivision.hpp"
 
 #include "grid/range.hpp"
+#include "grid/timelevelfield.hpp"
 
@@ -124,6 +124,12 @@ class Boundary
     /** Returns the inner domain, excluding the ghost cells */
     DomainType getInnerDomain();
 
+    /** Moves the domain by n grid points in dimension dim
+     *
+     * Used for moving-window simulations, see CircularGridStorage.
+     */
+    void shift(size_t dim, int n);
+
 
     /** Returns the sub-grid containing only the ghost cells.
      * The ghost domain has a thickness given by the number of ghost cells, delta.
@@ -134,7 +140,7 @@ class Boundary
      * @return A sub-grid containing ghost cells
      */
     template<class GridType>
-    SubGrid<GridType, CheckingPolicy> getGhostBoundary(size_t dim, bound b, GridType &grid);
+    SubGrid<GridType> getGhostBoundary(size_t dim, bound b, GridType &grid);
 
     /** Returns sub-grid containing only the boundary domain.
      * The bounadry domain has a thickness determined by the number of ghost cells.
@@ -150,7 +156,7 @@ class Boundary
       template<size_t> class CheckingPolicy2,
       template<typename, size_t> class StoragePolicy
     >
-    SubGrid<Field<T,rank,CheckingPolicy2,StoragePolicy>, CheckingPolicy>
+    SubGrid<Field<T,rank,CheckingPolicy2,StoragePolicy>, CheckingPolicy2>
       getGhostBoundary(size_t dim, bound b, Field<T,rank,CheckingPolicy2,StoragePolicy> &field);
 };
 
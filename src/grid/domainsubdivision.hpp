@@ -116,6 +116,13 @@ class DomainSubdivision {
     /// Return the global domain size excluding ghost cells
     virtual const DomainType &getGlobalDomain() const = 0;
 
+    /** @brief Move the local and global domains by n grid points in dimension dim
+     *
+     *  Used for moving-window simulations. The grids must be shifted by the
+     *  same amount, see CircularGridStorage.
+     */
+    virtual void shift(size_t dim, int n) { bounds->shift(dim, n); }
+
     /// Return the local domain size
     const DomainType &getDomain() const { return bounds->getDomain(); }
     /// Return the minimum of the local domain
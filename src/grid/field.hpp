@@ -97,14 +97,17 @@ class Field : public Grid<T, rank, CheckingPolicy, StoragePolicy>
     /** copy constructor */
     Field(const FieldType&);
 
+    /** move constructor, leaves the moved-from field empty */
+    Field(FieldType&&) noexcept;
+
     /** Get the lo of the inner grid range */
-    IndexType getInnerLo() { return this->getLo() + ghostCells; }
+    IndexType getInnerLo() const { return this->getLo() + ghostCells; }
 
     /** Get the hi of the inner grid range */
-    IndexType getInnerHi() { return this->getHi() - ghostCells; }
+    IndexType getInnerHi() const { return this->getHi() - ghostCells; }
 
     /** Get the range the inner grid range */
-    RangeType getInnerRange() { return RangeType{this->getLo() + ghostCells, this->getHi() - ghostCells}; }
+    RangeType getInnerRange() const { return RangeType(getInnerLo(), getInnerHi()); }
 
     /** Calculates index and offset from a position on the field
      *
@@ -132,10 +135,31 @@ class Field : public Grid<T, rank, CheckingPolicy, StoragePolicy>
      */
     const DomainType& getDomain() { return domain; }
 
+    /**
+     * @brief Move the field by n grid points in dimension dim
+     *
+     * The physical domain moves with the grid. This requires a storage policy
+     * that provides `shift()`, see CircularGridStorage. Copies of the field
+     * follow the shift of the grid but keep their physical domain.
+     */
+    void shift(size_t dim, int n);
+
     /**
      * @brief Assignment operator
      */
     FieldType &operator=(const FieldType&) = default;
+
+    /**
+     * @brief Move assignment operator
+     */
+    FieldType &operator=(FieldType &&field) noexcept
+    {
+      BaseType::operator=(std::move(field));
+      domain = field.domain;
+      stagger = field.stagger;
+      ghostCells = field.ghostCells;
+      return *this;
+    }
     
     /** assign a value to the field*/
     FieldType& operator=(const T &val)
@@ -143,6 +143,35 @@ Field<T, rank, CheckingPolicy, StoragePolicy>::Field(const Field<T, rank, Checki
 {
 }
 
+template<
+  typename T,
+  size_t rank,
+  template<size_t> class CheckingPolicy,
+  template<typename, size_t> class StoragePolicy
+>
+Field<T, rank, CheckingPolicy, StoragePolicy>::Field(Field<T, rank, CheckingPolicy, StoragePolicy> &&field) noexcept
+  : Grid<T, rank, CheckingPolicy, StoragePolicy>(std::move(field)),
+    domain(field.domain),
+    stagger(field.stagger),
+    ghostCells(field.ghostCells)
+{
+}
+
+template<
+  typename T,
+  size_t rank,
+  template<size_t> class CheckingPolicy,
+  template<typename, size_t> class StoragePolicy
+>
+void Field<T, rank, CheckingPolicy, StoragePolicy>::shift(size_t dim, int n)
+{
+  const double dx = (domain.getHi()[dim] - domain.getLo()[dim])
+      /(this->getHi()[dim] - this->getLo()[dim] - 2*ghostCells + 1);
+  BaseType::shift(dim, n);
+  domain.getLo()[dim] += n*dx;
+  domain.getHi()[dim] += n*dx;
+}
+
 template<
   typename T,
   size_t rank,
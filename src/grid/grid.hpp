@@ -34,6 +34,8 @@
 #include "../typetools.hpp"
 #include "../macros.hpp"
 
+#include <utility>
+
 namespace schnek {
 
   template<class GridType, typename TList>
@@ -66,6 +68,10 @@ namespace schnek {
         typedef StoragePolicy StoragePolicyType;
         typedef typename CheckingPolicy::IndexType IndexType;
         typedef typename StoragePolicy::RangeType RangeType;
+        /// The type returned by the writing accessors, `T&` unless the storage returns a proxy
+        typedef decltype(
+          std::declval<StoragePolicy&>().get(std::declval<const typename StoragePolicy::IndexType&>())
+        ) reference;
         typedef GridBase<T,rank,CheckingPolicy,StoragePolicy> GridBaseType;
         enum {Rank = rank};
 
@@ -79,6 +85,11 @@ namespace schnek {
          */
         GridBase(const GridBase&) = default;
 
+        /** 
+         * @brief Move constructor, leaves the moved-from grid empty
+         */
+        GridBase(GridBase&&) = default;
+
         template<template<size_t> class ArrayCheckingPolicy>
         GridBase(const Array<int,rank,ArrayCheckingPolicy> &size);
 
@@ -90,61 +101,61 @@ namespace schnek {
 
         /** index operator, writing */
         template<template<size_t> class ArrayCheckingPolicy>
-        SCHNEK_INLINE T& operator[](const Array<int,rank,ArrayCheckingPolicy>& pos); // write
+        SCHNEK_INLINE reference operator[](const Array<int,rank,ArrayCheckingPolicy>& pos); // write
         /** index operator, reading */
         template<template<size_t> class ArrayCheckingPolicy>
         SCHNEK_INLINE T  operator[](const Array<int,rank,ArrayCheckingPolicy>& pos) const; // read
 
         /** index operator, writing */
         template<class Operator, int Length>
-        SCHNEK_INLINE T& operator[](const ArrayExpression<Operator, Length>& pos); // write
+        SCHNEK_INLINE reference operator[](const ArrayExpression<Operator, Length>& pos); // write
         /** index operator, reading */
         template<class Operator, int Length>
         SCHNEK_INLINE T  operator[](const ArrayExpression<Operator, Length>& pos) const; // read
 
         /** index operator, for 1D grids, writing */
-        SCHNEK_INLINE T& operator[](int i);
+        SCHNEK_INLINE reference operator[](int i);
         /** index operator, for 1D grids, reading */
         SCHNEK_INLINE T  operator[](int i) const;
 
         /** index operator, writing */
-        SCHNEK_INLINE T& operator()(int i);
+        SCHNEK_INLINE reference operator()(int i);
         /** index operator, reading */
         SCHNEK_INLINE T  operator()(int i) const;
         /** index operator, writing */
-        SCHNEK_INLINE T& operator()(int i, int j);
+        SCHNEK_INLINE reference operator()(int i, int j);
         /** index operator, reading */
         SCHNEK_INLINE T  operator()(int i, int j) const;
         /** index operator, writing */
-        SCHNEK_INLINE T& operator()(int i, int j, int k);
+        SCHNEK_INLINE reference operator()(int i, int j, int k);
         /** index operator, reading */
         SCHNEK_INLINE T  operator()(int i, int j, int k) const;
         /** index operator, writing */
-        SCHNEK_INLINE T& operator()(int i, int j, int k, int l);
+        SCHNEK_INLINE reference operator()(int i, int j, int k, int l);
         /** index operator, reading */
         SCHNEK_INLINE T  operator()(int i, int j, int k, int l) const;
         /** index operator, writing */
-        SCHNEK_INLINE T& operator()(int i, int j, int k, int l, int m);
+        SCHNEK_INLINE reference operator()(int i, int j, int k, int l, int m);
         /** index operator, reading */
         SCHNEK_INLINE T  operator()(int i, int j, int k, int l, int m) const;
         /** index operator, writing */
-        SCHNEK_INLINE T& operator()(int i, int j, int k, int l, int m, int o);
+        SCHNEK_INLINE reference operator()(int i, int j, int k, int l, int m, int o);
         /** index operator, reading */
         SCHNEK_INLINE T  operator()(int i, int j, int k, int l, int m, int o) const;
         /** index operator, writing */
-        SCHNEK_INLINE T& operator()(int i, int j, int k, int l, int m, int o, int p);
+        SCHNEK_INLINE reference operator()(int i, int j, int k, int l, int m, int o, int p);
         /** index operator, reading */
         SCHNEK_INLINE T  operator()(int i, int j, int k, int l, int m, int o, int p) const;
         /** index operator, writing */
-        SCHNEK_INLINE T& operator()(int i, int j, int k, int l, int m, int o, int p, int q);
+        SCHNEK_INLINE reference operator()(int i, int j, int k, int l, int m, int o, int p, int q);
         /** index operator, reading */
         SCHNEK_INLINE T  operator()(int i, int j, int k, int l, int m, int o, int p, int q) const;
         /** index operator, writing */
-        SCHNEK_INLINE T& operator()(int i, int j, int k, int l, int m, int o, int p, int q, int r);
+        SCHNEK_INLINE reference operator()(int i, int j, int k, int l, int m, int o, int p, int q, int r);
         /** index operator, reading */
         SCHNEK_INLINE T  operator()(int i, int j, int k, int l, int m, int o, int p, int q, int r) const;
         /** index operator, writing */
-        SCHNEK_INLINE T& operator()(int i, int j, int k, int l, int m, int o, int p, int q, int r, int s);
+        SCHNEK_INLINE reference operator()(int i, int j, int k, int l, int m, int o, int p, int q, int r, int s);
         /** index operator, reading */
         SCHNEK_INLINE T  operator()(int i, int j, int k, int l, int m, int o, int p, int q, int r, int s) const;
 
@@ -156,6 +167,10 @@ namespace schnek {
         SCHNEK_INLINE GridBase<T, rank, CheckingPolicy, StoragePolicy>&
           operator=(const GridBase<T, rank, CheckingPolicy, StoragePolicy> &val) = default;
 
+        /** move assignment, leaves the moved-from grid empty */
+        SCHNEK_INLINE GridBase<T, rank, CheckingPolicy, StoragePolicy>&
+          operator=(GridBase<T, rank, CheckingPolicy, StoragePolicy> &&val) = default;
+
         template<
           typename T2,
           class CheckingPolicy2
@@ -239,6 +254,22 @@ namespace schnek {
           class StoragePolicy2
         >
         void resize(const GridBase<T2, rank, CheckingPolicy2, StoragePolicy2>& grid);
+
+        /**
+         * @brief Resize to lower indices low[0],...,low[rank-1]
+         * and upper indices high[0],...,high[rank-1], keeping the values
+         * in the overlap of the old and the new range
+         *
+         * The values of grid points outside the old range are undefined.
+         * Only available if the storage policy provides `resizePreserve()`.
+         */
+        void resizePreserve(const IndexType &low, const IndexType &high);
+
+        /**
+         * @brief Resize to the range, keeping the values in the overlap of the
+         * old and the new range
+         */
+        void resizePreserve(const RangeType &range);
     };
   }
 
@@ -278,6 +309,13 @@ namespace schnek {
        */
       Grid(const Grid&) = default;
 
+      /**
+       * @brief move constructor
+       *
+       * Takes over the data of the other grid without copying. The other grid is left empty.
+       */
+      Grid(Grid&&) = default;
+
       /** 
        * @brief constructor, which builds Grid of size size[0] x ... x size[rank-1]
        * 
@@ -345,6 +383,13 @@ namespace schnek {
         return *this;
       }
 
+      /** move another grid into this grid */
+      GridType& operator=(GridType &&grid) noexcept
+      {
+        BaseType::operator=(std::move(grid));
+        return *this;
+      }
+
       /** assign another grid */
       template<
         typename T2,
@@ -93,7 +93,8 @@ template<
   class StoragePolicy
 >
 template<template<size_t> class ArrayCheckingPolicy>
-SCHNEK_INLINE T& GridBase<T, rank, CheckingPolicy, StoragePolicy>
+SCHNEK_INLINE typename GridBase<T, rank, CheckingPolicy, StoragePolicy>::reference
+  GridBase<T, rank, CheckingPolicy, StoragePolicy>
   ::operator[](const Array<int,rank,ArrayCheckingPolicy>& pos)
 {
   return this->get(this->check(pos,this->getLo(),this->getHi()));
@@ -119,7 +120,8 @@ template<
   class StoragePolicy
 >
 template<class Operator, int Length>
-SCHNEK_INLINE T& GridBase<T, rank, CheckingPolicy, StoragePolicy>
+SCHNEK_INLINE typename GridBase<T, rank, CheckingPolicy, StoragePolicy>::reference
+  GridBase<T, rank, CheckingPolicy, StoragePolicy>
   ::operator[](const ArrayExpression<Operator, Length>& pos)
 {
   return this->operator[](IndexType(pos));
@@ -144,7 +146,8 @@ template<
   class CheckingPolicy,
   class StoragePolicy
 >
-SCHNEK_INLINE T& GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator [](int i)
+SCHNEK_INLINE typename GridBase<T, rank, CheckingPolicy, StoragePolicy>::reference
+  GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator [](int i)
 {
   return this->get(this->check(IndexType(i),this->getLo(),this->getHi()));
 }
@@ -166,7 +169,8 @@ template<
   class CheckingPolicy,
   class StoragePolicy
 >
-SCHNEK_INLINE T& GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i)
+SCHNEK_INLINE typename GridBase<T, rank, CheckingPolicy, StoragePolicy>::reference
+  GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i)
 {
   return this->get(this->check(IndexType(i),this->getLo(),this->getHi()));
 }
@@ -189,7 +193,8 @@ template<
   class CheckingPolicy,
   class StoragePolicy
 >
-SCHNEK_INLINE T& GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j)
+SCHNEK_INLINE typename GridBase<T, rank, CheckingPolicy, StoragePolicy>::reference
+  GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j)
 {
   return this->get(this->check(IndexType(i,j),this->getLo(),this->getHi()));
 }
@@ -211,7 +216,8 @@ template<
   class CheckingPolicy,
   class StoragePolicy
 >
-SCHNEK_INLINE T& GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j, int k)
+SCHNEK_INLINE typename GridBase<T, rank, CheckingPolicy, StoragePolicy>::reference
+  GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j, int k)
 {
   return this->get(this->check(IndexType(i,j,k),this->getLo(),this->getHi()));
 }
@@ -233,7 +239,8 @@ template<
   class CheckingPolicy,
   class StoragePolicy
 >
-SCHNEK_INLINE T& GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j, int k, int l)
+SCHNEK_INLINE typename GridBase<T, rank, CheckingPolicy, StoragePolicy>::reference
+  GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j, int k, int l)
 {
   return this->get(this->check(IndexType(i,j,k,l),this->getLo(),this->getHi()));
 }
@@ -255,7 +262,8 @@ template<
   class CheckingPolicy,
   class StoragePolicy
 >
-SCHNEK_INLINE T& GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j, int k, int l, int m)
+SCHNEK_INLINE typename GridBase<T, rank, CheckingPolicy, StoragePolicy>::reference
+  GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j, int k, int l, int m)
 {
   return this->get(this->check(IndexType(i,j,k,l,m),this->getLo(),this->getHi()));
 }
@@ -277,7 +285,8 @@ template<
   class CheckingPolicy,
   class StoragePolicy
 >
-SCHNEK_INLINE T& GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j, int k, int l, int m, int o)
+SCHNEK_INLINE typename GridBase<T, rank, CheckingPolicy, StoragePolicy>::reference
+  GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j, int k, int l, int m, int o)
 {
   return this->get(this->check(IndexType(i,j,k,l,m,o),this->getLo(),this->getHi()));
 }
@@ -299,7 +308,8 @@ template<
   class CheckingPolicy,
   class StoragePolicy
 >
-SCHNEK_INLINE T& GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j, int k, int l, int m, int o, int p)
+SCHNEK_INLINE typename GridBase<T, rank, CheckingPolicy, StoragePolicy>::reference
+  GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j, int k, int l, int m, int o, int p)
 {
   return this->get(this->check(IndexType(i,j,k,l,m,o,p),this->getLo(),this->getHi()));
 }
@@ -321,7 +331,8 @@ template<
   class CheckingPolicy,
   class StoragePolicy
 >
-SCHNEK_INLINE T& GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j, int k, int l, int m, int o, int p, int q)
+SCHNEK_INLINE typename GridBase<T, rank, CheckingPolicy, StoragePolicy>::reference
+  GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j, int k, int l, int m, int o, int p, int q)
 {
   return this->get(this->check(IndexType(i,j,k,l,m,o,p,q),this->getLo(),this->getHi()));
 }
@@ -343,7 +354,8 @@ template<
   class CheckingPolicy,
   class StoragePolicy
 >
-SCHNEK_INLINE T& GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j, int k, int l, int m, int o, int p, int q, int r)
+SCHNEK_INLINE typename GridBase<T, rank, CheckingPolicy, StoragePolicy>::reference
+  GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j, int k, int l, int m, int o, int p, int q, int r)
 {
   return this->get(this->check(IndexType(i,j,k,l,m,o,p,q,r),this->getLo(),this->getHi()));
 }
@@ -365,7 +377,8 @@ template<
   class CheckingPolicy,
   class StoragePolicy
 >
-SCHNEK_INLINE T& GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j, int k, int l, int m, int o, int p, int q, int r, int s)
+SCHNEK_INLINE typename GridBase<T, rank, CheckingPolicy, StoragePolicy>::reference
+  GridBase<T, rank, CheckingPolicy, StoragePolicy>::operator ()(int i, int j, int k, int l, int m, int o, int p, int q, int r, int s)
 {
   return this->get(this->check(IndexType(i,j,k,l,m,o,p,q,r,s),this->getLo(),this->getHi()));
 }
@@ -575,6 +588,28 @@ GridBase<T, rank, CheckingPolicy, StoragePolicy>&
     StoragePolicy::resize(grid.getLo(), grid.getHi());
   }
 
+  template<
+    typename T,
+    size_t rank,
+    class CheckingPolicy,
+    class StoragePolicy
+  >
+  void GridBase<T, rank, CheckingPolicy, StoragePolicy>::resizePreserve(const IndexType &low, const IndexType &high)
+  {
+    StoragePolicy::resizePreserve(low, high);
+  }
+
+  template<
+    typename T,
+    size_t rank,
+    class CheckingPolicy,
+    class StoragePolicy
+  >
+  void GridBase<T, rank, CheckingPolicy, StoragePolicy>::resizePreserve(const RangeType &range)
+  {
+    StoragePolicy::resizePreserve(range.getLo(), range.getHi());
+  }
+
 }
 
 //=================================================================
@@ -28,7 +28,19 @@
 #define SCHNEK_GRID_GRIDSTORAGE_HPP_
 
 #include "gridstorage/single-array-allocation.hpp"
+#include "gridstorage/mmap-allocation.hpp"
+#include "gridstorage/file-mapped-allocation.hpp"
+#include "gridstorage/first-touch-allocation.hpp"
+#include "gridstorage/pool-allocation.hpp"
 #include "gridstorage/single-array-storage-base.hpp"
+#include "gridstorage/tiled-storage.hpp"
+#include "gridstorage/morton-storage.hpp"
+#include "gridstorage/soa-storage.hpp"
+#include "gridstorage/reduced-precision-storage.hpp"
+#include "gridstorage/copy-on-write-storage.hpp"
+#include "gridstorage/circular-storage.hpp"
+#include "gridstorage/sparse-storage.hpp"
+#include "gridstorage/static-storage.hpp"
 
 namespace schnek {
   template<typename T, size_t rank>
@@ -40,6 +52,42 @@ namespace schnek {
   template<typename T, size_t rank>
   using LazyArrayGridStorage = SingleArrayGridCOrderStorageBase<T, rank, SingleArrayLazyAllocation>;
 
+  template<typename T, size_t rank>
+  using AlignedArrayGridStorage = SingleArrayGridCOrderStorageBase<T, rank, SingleArrayAlignedAllocation>;
+
+  template<typename T, size_t rank>
+  using AlignedArrayGridStorageFortran = SingleArrayGridFortranOrderStorageBase<T, rank, SingleArrayAlignedFortranAllocation>;
+
+  template<typename T, size_t rank>
+  using HugePageArrayGridStorage = SingleArrayGridCOrderStorageBase<T, rank, SingleArrayHugePageAllocation>;
+
+  template<typename T, size_t rank>
+  using FileMappedArrayGridStorage = SingleArrayGridCOrderStorageBase<T, rank, SingleArrayFileMappedAllocation>;
+
+  template<typename T, size_t rank>
+  using FirstTouchArrayGridStorage = SingleArrayGridCOrderStorageBase<T, rank, SingleArrayFirstTouchAllocation>;
+
+  template<typename T, size_t rank>
+  using FirstTouchArrayGridStorageFortran = SingleArrayGridFortranOrderStorageBase<T, rank, SingleArrayFirstTouchFortranAllocation>;
+
+  template<typename T, size_t rank>
+  using PooledArrayGridStorage = SingleArrayGridCOrderStorageBase<T, rank, SingleArrayPooledAllocation>;
+
+  template<typename T, size_t rank>
+  using PooledArrayGridStorageFortran = SingleArrayGridFortranOrderStorageBase<T, rank, SingleArrayPooledAllocation>;
+
+  template<typename T, size_t rank>
+  using LazyPooledArrayGridStorage = SingleArrayGridCOrderStorageBase<T, rank, SingleArrayLazyPooledAllocation>;
+
+  template<typename T, size_t rank>
+  using AlignedPooledArrayGridStorage = SingleArrayGridCOrderStorageBase<T, rank, SingleArrayAlignedPooledAllocation>;
+
+  template<typename T, size_t rank>
+  using TiledGridStorage = TiledGridStorageBase<T, rank, GridTile<> >;
+
+  template<typename T, size_t rank>
+  using SparseGridStorage = SparseGridStorageBase<T, rank, GridTile<> >;
+
 } // namespace schnek
 
 
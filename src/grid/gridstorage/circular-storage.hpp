@@ -0,0 +1,329 @@
+/*
+ * circular-storage.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_GRIDSTORAGE_CIRCULARSTORAGE_HPP_
+#define SCHNEK_GRID_GRIDSTORAGE_CIRCULARSTORAGE_HPP_
+
+#include "single-array-allocation.hpp"
+#include "single-array-storage-base.hpp"
+
+#include <array>
+#include <utility>
+
+namespace schnek
+{
+    /**
+     * @brief Storage policy with periodic index mapping for moving-window simulations
+     *
+     * The grid index `i` in dimension `d` is stored at the position `i mod dims[d]` of
+     * the array, in C order. Because the position only depends on the index and not on
+     * the lowest coordinate of the grid, the window of valid indices can be moved by
+     * `shift()` without moving any data. Only the grid points that enter the window have
+     * to be cleared.
+     *
+     * A shift is passed on to all copies of the grid that share the data, just like a
+     * resize.
+     *
+     * The storage iterators run over the array in memory order, which is not the order of
+     * the grid indices once the grid has been shifted. There is no constant stride between
+     * grid points, so the storage does not provide a `stride()` method.
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     */
+    template <typename T, size_t rank>
+    class CircularGridStorage : public SingleArrayGridStorageBase<T, rank, SingleArrayInstantAllocation>
+    {
+    public:
+        /// Base class type
+        typedef SingleArrayGridStorageBase<T, rank, SingleArrayInstantAllocation> BaseType;
+
+        /// The grid index type
+        typedef typename BaseType::IndexType IndexType;
+
+        /// The grid range type
+        typedef typename BaseType::RangeType RangeType;
+
+        /// The iteration policy that visits the grid in C order of the indices
+        typedef RangeCIterationPolicy<rank> IterationPolicy;
+    private:
+        /// The largest multiple of the dimensions not greater than the lowest coordinate
+        IndexType base;
+
+        /// The distance in memory between neighbouring points in each dimension
+        std::array<ptrdiff_t, rank> strides;
+
+        /// A copy of the data pointer for faster access
+        T *data_fast;
+    public:
+        /// Default constructor
+        CircularGridStorage();
+
+        /// Copy constructor
+        CircularGridStorage(const CircularGridStorage&);
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param lo the lowest coordinate in the grid (inclusive)
+         * @param hi the highest coordinate in the grid (inclusive)
+         */
+        CircularGridStorage(const IndexType &lo, const IndexType &hi);
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param range the lowest and highest coordinates in the grid (inclusive)
+         */
+        CircularGridStorage(const RangeType &range);
+
+        /**
+         * @brief Assignment operator
+         */
+        CircularGridStorage<T, rank> &operator=(const CircularGridStorage<T, rank> &);
+
+        /// Move constructor, the moved-from storage is left empty
+        CircularGridStorage(CircularGridStorage &&) noexcept;
+
+        /**
+         * @brief Move assignment operator
+         */
+        CircularGridStorage<T, rank> &operator=(CircularGridStorage<T, rank> &&) noexcept;
+
+        /**
+         * @brief Get the lvalue at a given grid index
+         *
+         * @param index The grid index
+         * @return the lvalue at the grid index
+         */
+        SCHNEK_INLINE T &get(const IndexType &index);
+
+        /**
+         * @brief Get the rvalue at a given grid index
+         *
+         * @param index The grid index
+         * @return the rvalue at the grid index
+         */
+        SCHNEK_INLINE const T &get(const IndexType &index) const;
+
+        /**
+         * @brief resizes to grid with lower indices lo[0],...,lo[rank-1]
+         * and upper indices hi[0],...,hi[rank-1]
+         */
+        void resize(const IndexType &low, const IndexType &high);
+
+        /**
+         * @brief resizes to grid with the range.
+         * The endponts of the range are inclusive
+         */
+        void resize(const RangeType range);
+
+        /**
+         * @brief Move the window of valid grid indices
+         *
+         * The lowest and highest coordinates in dimension `dim` are increased by `n`. The
+         * values at the indices that remain inside the window are kept. The grid points that
+         * enter the window are set to `T()`. The cost is proportional to the number of
+         * these grid points and independent of the size of the grid.
+         *
+         * @param dim The dimension in which the window is moved
+         * @param n The number of grid points by which the window is moved, may be negative
+         */
+        void shift(size_t dim, int n);
+    private:
+        /// The position of a grid index in the array
+        SCHNEK_INLINE ptrdiff_t position(const IndexType &index) const;
+
+        /**
+         * @brief Update the base, the strides and the data pointer
+         *
+         * This method is called indirectly when a resize or shift is performed on any of the
+         * copies of the grid.
+         */
+        void updateDataFast();
+    };
+
+    //=================================================================
+    //==================== CircularGridStorage ========================
+    //=================================================================
+
+    template <typename T, size_t rank>
+    CircularGridStorage<T, rank>::CircularGridStorage()
+        : BaseType(), base(0), data_fast(NULL)
+    {
+        strides.fill(0);
+        this->onUpdate([this](){ updateDataFast(); });
+    }
+
+    template <typename T, size_t rank>
+    CircularGridStorage<T, rank>::CircularGridStorage(const CircularGridStorage &other)
+        : BaseType(other), base(other.base), strides(other.strides), data_fast(other.data_fast)
+    {
+        this->onUpdate([this](){ updateDataFast(); });
+    }
+
+    template <typename T, size_t rank>
+    CircularGridStorage<T, rank>::CircularGridStorage(
+        const IndexType &lo,
+        const IndexType &hi
+    ) : BaseType(), base(0), data_fast(NULL)
+    {
+        strides.fill(0);
+        this->onUpdate([this](){ updateDataFast(); });
+        resize(lo, hi);
+    }
+
+    template <typename T, size_t rank>
+    CircularGridStorage<T, rank>::CircularGridStorage(
+        const RangeType &range
+    ) : BaseType(), base(0), data_fast(NULL)
+    {
+        strides.fill(0);
+        this->onUpdate([this](){ updateDataFast(); });
+        resize(range.getLo(), range.getHi());
+    }
+
+    template <typename T, size_t rank>
+    CircularGridStorage<T, rank> &CircularGridStorage<T, rank>::operator=(const CircularGridStorage<T, rank> &other)
+    {
+        BaseType::operator=(other);
+        base = other.base;
+        strides = other.strides;
+        data_fast = other.data_fast;
+        return *this;
+    }
+
+    template <typename T, size_t rank>
+    CircularGridStorage<T, rank>::CircularGridStorage(CircularGridStorage &&other) noexcept
+        : BaseType(std::move(other)),
+          base(other.base),
+          strides(other.strides),
+          data_fast(other.data_fast)
+    {
+        this->onUpdate([this](){ updateDataFast(); });
+        other.data_fast = NULL;
+    }
+
+    template <typename T, size_t rank>
+    CircularGridStorage<T, rank> &CircularGridStorage<T, rank>::operator=(CircularGridStorage<T, rank> &&other) noexcept
+    {
+        if (this == &other) return *this;
+        BaseType::operator=(std::move(other));
+        base = other.base;
+        strides = other.strides;
+        data_fast = other.data_fast;
+        other.data_fast = NULL;
+        return *this;
+    }
+
+    template <typename T, size_t rank>
+    SCHNEK_INLINE ptrdiff_t CircularGridStorage<T, rank>::position(const IndexType &index) const
+    {
+        ptrdiff_t pos = 0;
+        for (size_t d = 0; d < rank; ++d)
+        {
+            // base[d] <= lo[d] < base[d] + dims[d], so a single subtraction wraps the index
+            int p = index[d] - base[d];
+            if (p >= this->dims[d]) p -= this->dims[d];
+            pos += p*strides[d];
+        }
+        return pos;
+    }
+
+    template <typename T, size_t rank>
+    SCHNEK_INLINE T &CircularGridStorage<T, rank>::get(const IndexType &index)
+    {
+        return this->data_fast[position(index)];
+    }
+
+    template <typename T, size_t rank>
+    SCHNEK_INLINE const T &CircularGridStorage<T, rank>::get(const IndexType &index) const
+    {
+        return this->data_fast[position(index)];
+    }
+
+    template <typename T, size_t rank>
+    inline void CircularGridStorage<T, rank>::resize(const IndexType &lo, const IndexType &hi)
+    {
+        this->resizeImpl(lo, hi);
+    }
+
+    template <typename T, size_t rank>
+    inline void CircularGridStorage<T, rank>::resize(const RangeType range)
+    {
+        this->resize(range.getLo(), range.getHi());
+    }
+
+    template <typename T, size_t rank>
+    void CircularGridStorage<T, rank>::shift(size_t dim, int n)
+    {
+        if (n == 0) return;
+
+        // a moved-from storage has no data, it is empty but can still be shifted
+        this->ensureData();
+
+        IndexType lo = this->getLo();
+        IndexType hi = this->getHi();
+        lo[dim] += n;
+        hi[dim] += n;
+        this->data->update(typename BaseType::SizeInfo{lo, hi});
+        if (this->getSize() == 0) return;
+
+        // clear the slab of grid points that have entered the window
+        IndexType clearLo = lo;
+        IndexType clearHi = hi;
+        if (n < this->dims[dim] && -n < this->dims[dim])
+        {
+            if (n > 0) clearLo[dim] = hi[dim] - n + 1;
+            else clearHi[dim] = lo[dim] - n - 1;
+        }
+
+        RangeType slab(clearLo, clearHi);
+        for (typename RangeType::iterator it = slab.begin(); it != slab.end(); ++it)
+        {
+            get(*it) = T();
+        }
+    }
+
+    template <typename T, size_t rank>
+    void CircularGridStorage<T, rank>::updateDataFast()
+    {
+        ptrdiff_t stride = 1;
+        for (int d = int(rank) - 1; d >= 0; --d)
+        {
+            const int lo = this->range.getLo(d);
+            const int extent = this->dims[d];
+            // round down to a multiple of the extent, also for negative coordinates
+            int wrapped = extent > 0 ? lo % extent : 0;
+            if (wrapped < 0) wrapped += extent;
+            base[d] = lo - wrapped;
+            strides[d] = stride;
+            stride *= extent;
+        }
+        data_fast = this->data->ptr;
+    }
+}
+
+#endif // SCHNEK_GRID_GRIDSTORAGE_CIRCULARSTORAGE_HPP_
@@ -0,0 +1,414 @@
+/*
+ * copy-on-write-storage.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_GRIDSTORAGE_COPYONWRITESTORAGE_HPP_
+#define SCHNEK_GRID_GRIDSTORAGE_COPYONWRITESTORAGE_HPP_
+
+#include "single-array-allocation.hpp"
+#include "single-array-storage-base.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace schnek
+{
+    /**
+     * @brief Allocate a single array that is shared between copies until one of them writes
+     *
+     * Unlike the other allocation policies, copies of a grid do not stay connected. A copy
+     * shares the array with the original only until one of the two is written to. The
+     * writing grid then receives its own copy of the array, see `prepareWrite()`. A resize
+     * only affects the grid that is resized.
+     *
+     * Each grid keeps a flag that is set when it is known to be the only owner of its array.
+     * Making a copy clears the flag in both grids. `prepareWrite()` only has to test the
+     * flag, so the check on the write path is a single, well predicted branch.
+     *
+     * Copies of the same grid must not be written to concurrently from different threads.
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     */
+    template <typename T, size_t rank>
+    class SingleArrayCopyOnWriteAllocation
+    {
+    public:
+        /// The grid index type
+        typedef Array<int, rank> IndexType;
+
+        /// The grid range type
+        typedef Range<int, rank> RangeType;
+    protected:
+        struct SizeInfo {
+            IndexType lo;
+            IndexType hi;
+        };
+
+        typedef std::function<void()> UpdaterType;
+
+        typedef internal::SingleArrayAllocationData<T, SizeInfo> DataType;
+
+        /// The pointer to the data
+        std::shared_ptr<DataType> data;
+
+        /// The length of the allocated array
+        size_t size;
+
+        /// The lowest and highest coordinates in the grid (inclusive)
+        RangeType range;
+
+        /// The dimensions of the grid `dims = high - low + 1`
+        IndexType dims;
+
+        /// The dimensions of the allocated array, identical to `dims`
+        IndexType allocDims;
+    private:
+        UpdaterType updater;
+
+        /// True if this object is known to be the only owner of the data
+        mutable bool exclusive;
+    public:
+        /// Default constructor
+        SingleArrayCopyOnWriteAllocation();
+
+        /**
+         * @brief Copy constructor
+         *
+         * The data is shared until either of the two objects is written to.
+         */
+        SingleArrayCopyOnWriteAllocation(const SingleArrayCopyOnWriteAllocation &);
+
+        /**
+         * @brief Assignment operator
+         *
+         * The data is shared until either of the two objects is written to.
+         */
+        SingleArrayCopyOnWriteAllocation &operator=(const SingleArrayCopyOnWriteAllocation &);
+
+        /// Move constructor, the moved-from allocation is left empty
+        SingleArrayCopyOnWriteAllocation(SingleArrayCopyOnWriteAllocation &&) noexcept;
+
+        /**
+         * @brief Move assignment operator
+         */
+        SingleArrayCopyOnWriteAllocation &operator=(SingleArrayCopyOnWriteAllocation &&) noexcept;
+
+        /// True if the data is currently shared with another grid
+        bool isShared() const { return data && (data.use_count() > 1); }
+    protected:
+        /**
+         * @brief resizes to grid with lower indices lo[0],...,lo[rank-1]
+         * and upper indices hi[0],...,hi[rank-1]
+         *
+         * Other grids sharing the data keep the old data and size.
+         */
+        void resizeImpl(const IndexType &lo, const IndexType &hi);
+
+        /**
+         * @brief resizes the grid and keeps the data in the overlap of the old and new grid
+         *
+         * `copy(oldPtr, newPtr)` must copy the overlap from the old to the new layout.
+         * Other grids sharing the data keep the old data and size.
+         */
+        template <class Copy>
+        void resizePreserveImpl(const IndexType &lo, const IndexType &hi, Copy copy);
+
+        /**
+         * @brief Set the updater that is called when the data pointer changes
+         */
+        void onUpdate(const UpdaterType &updater);
+
+        /**
+         * @brief Make sure that this object is the only owner of the data
+         *
+         * Must be called before writing to the data.
+         */
+        SCHNEK_INLINE void prepareWrite()
+        {
+            if (!exclusive) detach();
+        }
+
+        /**
+         * @brief Create the data if this allocation has been moved from
+         */
+        void ensureData();
+    private:
+        /// Copy the data if it is shared
+        void detach();
+
+        /// Set the size information to that of an empty grid
+        void resetSizeInfo();
+
+        /// Set the size information for a grid with the given bounds
+        void setSize(const IndexType &lo, const IndexType &hi);
+    };
+
+    /**
+     * @brief Storage policy for grids with value semantics, using copy-on-write
+     *
+     * Copying a grid with this storage is cheap, the copies share the array. The array is
+     * copied when a copy is accessed through a non-const `get()`, `begin()` or `end()`
+     * while it is shared. Read the grid through a const reference to avoid copying.
+     * `getRawData()` does not copy the array and must not be used for writing to a grid
+     * that may be shared.
+     *
+     * This is useful for taking snapshots of fields that are written out later, for
+     * example by a diagnostic. The snapshot only costs a copy of the array if the field
+     * is modified before the snapshot is destroyed.
+     *
+     * The array is stored in C order.
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     */
+    template <typename T, size_t rank>
+    class CopyOnWriteGridStorage
+        : public SingleArrayGridCOrderStorageBase<T, rank, SingleArrayCopyOnWriteAllocation>
+    {
+    public:
+        /// Base class type
+        typedef SingleArrayGridCOrderStorageBase<T, rank, SingleArrayCopyOnWriteAllocation> BaseType;
+
+        /// The grid index type
+        typedef typename BaseType::IndexType IndexType;
+
+        /// The grid range type
+        typedef typename BaseType::RangeType RangeType;
+
+        typedef typename BaseType::storage_iterator storage_iterator;
+
+        /// Default constructor
+        CopyOnWriteGridStorage() {}
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param lo the lowest coordinate in the grid (inclusive)
+         * @param hi the highest coordinate in the grid (inclusive)
+         */
+        CopyOnWriteGridStorage(const IndexType &lo, const IndexType &hi) : BaseType(lo, hi) {}
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param range the lowest and highest coordinates in the grid (inclusive)
+         */
+        CopyOnWriteGridStorage(const RangeType &range) : BaseType(range) {}
+
+        /**
+         * @brief Get the lvalue at a given grid index
+         *
+         * Copies the array if it is shared with another grid.
+         *
+         * @param index The grid index
+         * @return the lvalue at the grid index
+         */
+        SCHNEK_INLINE T &get(const IndexType &index)
+        {
+            this->prepareWrite();
+            return BaseType::get(index);
+        }
+
+        /**
+         * @brief Get the rvalue at a given grid index
+         *
+         * @param index The grid index
+         * @return the rvalue at the grid index
+         */
+        SCHNEK_INLINE const T &get(const IndexType &index) const { return BaseType::get(index); }
+
+        /// Iterator to the first element, copies the array if it is shared
+        SCHNEK_INLINE storage_iterator begin()
+        {
+            this->prepareWrite();
+            return BaseType::begin();
+        }
+
+        /// Iterator past the last element, copies the array if it is shared
+        SCHNEK_INLINE storage_iterator end()
+        {
+            this->prepareWrite();
+            return BaseType::end();
+        }
+    };
+
+    //=================================================================
+    //============== SingleArrayCopyOnWriteAllocation =================
+    //=================================================================
+
+    template <typename T, size_t rank>
+    SingleArrayCopyOnWriteAllocation<T, rank>::SingleArrayCopyOnWriteAllocation()
+        : data(new DataType()), size(0), exclusive(true)
+    {}
+
+    template <typename T, size_t rank>
+    SingleArrayCopyOnWriteAllocation<T, rank>::SingleArrayCopyOnWriteAllocation(
+        const SingleArrayCopyOnWriteAllocation &other
+    )
+        : data(other.data), size(other.size), range(other.range), dims(other.dims), allocDims(other.allocDims),
+          exclusive(false)
+    {
+        other.exclusive = false;
+    }
+
+    template <typename T, size_t rank>
+    SingleArrayCopyOnWriteAllocation<T, rank> &
+        SingleArrayCopyOnWriteAllocation<T, rank>::operator=(const SingleArrayCopyOnWriteAllocation &other)
+    {
+        if (this == &other) return *this;
+        this->data = other.data;
+        this->size = other.size;
+        this->range = other.range;
+        this->dims = other.dims;
+        this->allocDims = other.allocDims;
+        this->exclusive = false;
+        other.exclusive = false;
+        if (updater) updater();
+        return *this;
+    }
+
+    template <typename T, size_t rank>
+    SingleArrayCopyOnWriteAllocation<T, rank>::SingleArrayCopyOnWriteAllocation(
+        SingleArrayCopyOnWriteAllocation &&other
+    ) noexcept
+        : data(std::move(other.data)), size(other.size), range(other.range), dims(other.dims),
+          allocDims(other.allocDims), exclusive(other.exclusive)
+    {
+        other.resetSizeInfo();
+    }
+
+    template <typename T, size_t rank>
+    SingleArrayCopyOnWriteAllocation<T, rank> &
+        SingleArrayCopyOnWriteAllocation<T, rank>::operator=(SingleArrayCopyOnWriteAllocation &&other) noexcept
+    {
+        if (this == &other) return *this;
+        this->data = std::move(other.data);
+        this->size = other.size;
+        this->range = other.range;
+        this->dims = other.dims;
+        this->allocDims = other.allocDims;
+        this->exclusive = other.exclusive;
+        other.resetSizeInfo();
+        return *this;
+    }
+
+    template <typename T, size_t rank>
+    void SingleArrayCopyOnWriteAllocation<T, rank>::onUpdate(const UpdaterType &updater)
+    {
+        this->updater = updater;
+    }
+
+    template <typename T, size_t rank>
+    void SingleArrayCopyOnWriteAllocation<T, rank>::ensureData()
+    {
+        if (this->data) return;
+        this->data = std::make_shared<DataType>();
+        this->exclusive = true;
+    }
+
+    template <typename T, size_t rank>
+    void SingleArrayCopyOnWriteAllocation<T, rank>::resetSizeInfo()
+    {
+        size = 0;
+        range = RangeType{IndexType(0), IndexType(-1)};
+        dims = IndexType(0);
+        allocDims = IndexType(0);
+        exclusive = true;
+    }
+
+    template <typename T, size_t rank>
+    void SingleArrayCopyOnWriteAllocation<T, rank>::resizeImpl(const IndexType &lo, const IndexType &hi)
+    {
+        if (isShared())
+        {
+            // leave the old array to the other owners
+            this->data = std::make_shared<DataType>();
+        }
+        this->ensureData();
+        this->data->deallocate();
+        setSize(lo, hi);
+        this->data->allocate(size);
+        exclusive = true;
+        if (updater) updater();
+    }
+
+    template <typename T, size_t rank>
+    template <class Copy>
+    void SingleArrayCopyOnWriteAllocation<T, rank>::resizePreserveImpl(
+        const IndexType &lo,
+        const IndexType &hi,
+        Copy copy
+    )
+    {
+        if (isShared())
+        {
+            // copy from the shared array and leave it to the other owners
+            std::shared_ptr<DataType> shared = std::move(this->data);
+            this->data = std::make_shared<DataType>();
+            setSize(lo, hi);
+            this->data->allocate(size);
+            if (shared->ptr) copy(shared->ptr, this->data->ptr);
+        }
+        else
+        {
+            this->ensureData();
+            setSize(lo, hi);
+            this->data->reallocate(size, copy);
+        }
+        exclusive = true;
+        if (updater) updater();
+    }
+
+    template <typename T, size_t rank>
+    void SingleArrayCopyOnWriteAllocation<T, rank>::setSize(const IndexType &lo, const IndexType &hi)
+    {
+        size = 1;
+        range = RangeType{lo, hi};
+        for (size_t d = 0; d < rank; ++d)
+        {
+            dims[d] = hi[d] - lo[d] + 1;
+            size *= dims[d];
+        }
+        allocDims = dims;
+    }
+
+    template <typename T, size_t rank>
+    void SingleArrayCopyOnWriteAllocation<T, rank>::detach()
+    {
+        if (isShared())
+        {
+            std::shared_ptr<DataType> copy = std::make_shared<DataType>();
+            copy->allocate(size);
+            std::copy(this->data->ptr, this->data->ptr + size, copy->ptr);
+            this->data = std::move(copy);
+            if (updater) updater();
+        }
+        exclusive = true;
+    }
+}
+
+#endif // SCHNEK_GRID_GRIDSTORAGE_COPYONWRITESTORAGE_HPP_
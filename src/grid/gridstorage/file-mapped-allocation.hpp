@@ -0,0 +1,370 @@
+/*
+ * file-mapped-allocation.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_GRIDSTORAGE_FILEMAPPEDALLOCATION_HPP_
+#define SCHNEK_GRID_GRIDSTORAGE_FILEMAPPEDALLOCATION_HPP_
+
+#include "../../config.hpp"
+#include "single-array-allocation.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#ifdef SCHNEK_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace schnek
+{
+    /**
+     * @brief The way a file is mapped into memory
+     */
+    enum class FileMapMode {
+        /// Changes are written to the file and are visible to other processes mapping the file
+        shared,
+        /// Changes are private to the process and are never written to the file
+        copyOnWrite
+    };
+
+    namespace internal {
+        /**
+         * @brief Allocates arrays in a memory-mapped file
+         *
+         * The file is opened, or created if it does not exist, and extended with zeros if
+         * it is smaller than the array. Files are never truncated. If no file has been
+         * set, an anonymous temporary file is created in the directory given by the
+         * `TMPDIR` environment variable, or in `/tmp`. The temporary file is deleted
+         * immediately, so that it disappears when the mapping is removed.
+         *
+         * The elements are not constructed. The array holds whatever the file contains.
+         * This allows re-using the file as a checkpoint, but restricts the data to
+         * trivially copyable types.
+         *
+         * With FileMapMode::shared, the operating system writes modified pages back to the
+         * file when memory is scarce, so that arrays larger than the main memory can be
+         * used. `msync` forces the changes to be written to the file. This can be
+         * requested when the array is resized or destroyed, or explicitly with `sync()`.
+         *
+         * With FileMapMode::copyOnWrite, modified pages are written to swap space and never
+         * reach the file. Synchronisation has no effect.
+         *
+         * On systems without `mmap` every allocation fails with a std::system_error.
+         *
+         * @tparam T The type of data stored in the array
+         */
+        template <typename T>
+        class FileMappedArrayAllocator
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "file mapped arrays require trivially copyable types");
+        private:
+            /// The path of the file, empty for an anonymous temporary file
+            std::string path;
+
+            /// The mapping mode
+            FileMapMode mode;
+
+            /// Synchronise the file when the array is deallocated during a resize
+            bool syncOnResize;
+
+            /// Synchronise the file when the array is deallocated otherwise
+            bool syncOnDestroy;
+
+            /// True between beginResize() and the next allocation
+            bool resizing;
+
+            /// The start of the current mapping
+            void *mapped;
+
+            /// The number of bytes of the current mapping
+            size_t mappedBytes;
+        public:
+            FileMappedArrayAllocator()
+                : mode(FileMapMode::shared), syncOnResize(false), syncOnDestroy(true),
+                  resizing(false), mapped(NULL), mappedBytes(0)
+            {}
+
+            T *allocate(size_t size);
+            void deallocate(T *ptr, size_t size);
+
+            /// Set the file and the mapping mode used by the next allocation
+            void setFile(const std::string &path, FileMapMode mode)
+            {
+                this->path = path;
+                this->mode = mode;
+            }
+
+            /// The path of the file, empty for an anonymous temporary file
+            const std::string &getFile() const { return path; }
+
+            /// The mapping mode
+            FileMapMode getMode() const { return mode; }
+
+            void setSyncOnResize(bool sync) { syncOnResize = sync; }
+            bool getSyncOnResize() const { return syncOnResize; }
+
+            void setSyncOnDestroy(bool sync) { syncOnDestroy = sync; }
+            bool getSyncOnDestroy() const { return syncOnDestroy; }
+
+            /// Mark the next deallocation as part of a resize
+            void beginResize() { resizing = true; }
+
+            /// Write all changes of a shared mapping to the file and wait for completion
+            void sync();
+        private:
+            /// Open the file, or create the temporary file, and return the file descriptor
+            int openFile(size_t bytes);
+        };
+
+        /// The allocator keeps a single mapping, so resizes that preserve the data are not available
+        template <typename T>
+        struct AllocatorHoldsMultipleArrays<FileMappedArrayAllocator<T> >
+        {
+            static const bool value = false;
+        };
+    }
+
+    /**
+     * @brief Allocate a single array for multidimensional grids in a memory-mapped file.
+     *
+     * The array is backed by a file, see internal::FileMappedArrayAllocator. This allows
+     * grids that are larger than the main memory, with the operating system moving the
+     * data between memory and file as needed. The array is stored in C order without any
+     * header, so a file that is mapped with FileMapMode::shared can be used as a checkpoint.
+     * Mapping the same file again with the same grid size restores the data.
+     *
+     * The file and the synchronisation options are shared between all copies of a grid.
+     * They take effect at the next resize.
+     *
+     * @code
+     * Grid<double, 3, GridNoArgCheck, FileMappedArrayGridStorage> grid;
+     * grid.setMappedFile("/scratch/field.dat");
+     * grid.resize(lo, hi);
+     * @endcode
+     *
+     * Deallocation and allocation is performed on every resize. `resizePreserve()` is not
+     * available, because it would need a second copy of an array that may be larger than
+     * the main memory.
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     */
+    template <typename T, size_t rank>
+    class SingleArrayFileMappedAllocation
+        : public SingleArrayInstantAllocationBase<T, rank, internal::FileMappedArrayAllocator<T> >
+    {
+    public:
+        /// Base class type
+        typedef SingleArrayInstantAllocationBase<T, rank, internal::FileMappedArrayAllocator<T> > BaseType;
+
+        /// The grid index type
+        typedef typename BaseType::IndexType IndexType;
+
+        /**
+         * @brief Set the file backing the grid
+         *
+         * An empty path selects an anonymous temporary file, which is the default.
+         *
+         * @param path the path of the file
+         * @param mode the mapping mode
+         */
+        void setMappedFile(const std::string &path, FileMapMode mode = FileMapMode::shared)
+        {
+            this->ensureData();
+            this->data->getAllocator().setFile(path, mode);
+        }
+
+        /// The path of the file backing the grid, empty for an anonymous temporary file
+        std::string getMappedFile() const { return this->data ? this->data->getAllocator().getFile() : std::string(); }
+
+        /// The mapping mode of the file
+        FileMapMode getMapMode() const
+        {
+            return this->data ? this->data->getAllocator().getMode() : FileMapMode::shared;
+        }
+
+        /// Write the data to the file with `msync` before the grid is resized, off by default
+        void setSyncOnResize(bool sync)
+        {
+            this->ensureData();
+            this->data->getAllocator().setSyncOnResize(sync);
+        }
+
+        /// Write the data to the file with `msync` before the grid is destroyed, on by default
+        void setSyncOnDestroy(bool sync)
+        {
+            this->ensureData();
+            this->data->getAllocator().setSyncOnDestroy(sync);
+        }
+
+        /**
+         * @brief Write all changes to the file and wait for completion
+         *
+         * After this call the file holds a consistent copy of the grid data.
+         */
+        void sync() { if (this->data) this->data->getAllocator().sync(); }
+    protected:
+        /**
+         * @brief resizes to grid with lower indices lo[0],...,lo[rank-1]
+         * and upper indices hi[0],...,hi[rank-1]
+         */
+        void resizeImpl(const IndexType &lo, const IndexType &hi)
+        {
+            this->ensureData();
+            this->data->getAllocator().beginResize();
+            BaseType::resizeImpl(lo, hi);
+        }
+
+        /**
+         * @brief not available, file-mapped grids cannot be resized preserving the data
+         */
+        template <class Copy>
+        void resizePreserveImpl(const IndexType &, const IndexType &, Copy)
+        {
+            static_assert(
+                sizeof(Copy) == 0,
+                "file-mapped grids cannot be resized with resizePreserve(), use resize() instead"
+            );
+        }
+    };
+
+    //=================================================================
+    //=================== FileMappedArrayAllocator ====================
+    //=================================================================
+
+    namespace internal {
+
+#ifdef SCHNEK_HAVE_MMAP
+
+        template <typename T>
+        int FileMappedArrayAllocator<T>::openFile(size_t bytes)
+        {
+            int fd;
+            if (path.empty())
+            {
+                const char *tmpdir = std::getenv("TMPDIR");
+                std::string name = std::string((tmpdir != NULL) && (*tmpdir != '\0') ? tmpdir : "/tmp")
+                    + "/schnek-grid-XXXXXX";
+                std::vector<char> buffer(name.begin(), name.end());
+                buffer.push_back('\0');
+                fd = mkstemp(buffer.data());
+                if (fd >= 0)
+                {
+                    unlink(buffer.data());
+                }
+            }
+            else
+            {
+                fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+            }
+
+            if (fd < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "cannot open grid file " + path);
+            }
+
+            struct stat info;
+            if ((fstat(fd, &info) != 0) || ((size_t(info.st_size) < bytes) && (ftruncate(fd, bytes) != 0)))
+            {
+                const int error = errno;
+                close(fd);
+                throw std::system_error(error, std::generic_category(), "cannot resize grid file " + path);
+            }
+            return fd;
+        }
+
+        template <typename T>
+        T *FileMappedArrayAllocator<T>::allocate(size_t size)
+        {
+            resizing = false;
+            const size_t bytes = std::max(size * sizeof(T), size_t(1));
+            const int fd = openFile(bytes);
+
+            const int flags = (mode == FileMapMode::shared) ? MAP_SHARED : MAP_PRIVATE;
+            void *ptr = mmap(NULL, bytes, PROT_READ | PROT_WRITE, flags, fd, 0);
+            close(fd);
+            if (ptr == MAP_FAILED)
+            {
+                throw std::bad_alloc();
+            }
+
+            mapped = ptr;
+            mappedBytes = bytes;
+            return static_cast<T*>(ptr);
+        }
+
+        template <typename T>
+        void FileMappedArrayAllocator<T>::deallocate(T *ptr, size_t)
+        {
+            if (ptr == NULL) return;
+
+            if (resizing ? syncOnResize : syncOnDestroy)
+            {
+                sync();
+            }
+            munmap(mapped, mappedBytes);
+            mapped = NULL;
+            mappedBytes = 0;
+        }
+
+        template <typename T>
+        void FileMappedArrayAllocator<T>::sync()
+        {
+            if ((mapped != NULL) && (mode == FileMapMode::shared))
+            {
+                msync(mapped, mappedBytes, MS_SYNC);
+            }
+        }
+
+#else // SCHNEK_HAVE_MMAP
+
+        template <typename T>
+        T *FileMappedArrayAllocator<T>::allocate(size_t)
+        {
+            throw std::system_error(std::make_error_code(std::errc::function_not_supported),
+                                    "file mapped grids require mmap");
+        }
+
+        template <typename T>
+        void FileMappedArrayAllocator<T>::deallocate(T *, size_t)
+        {}
+
+        template <typename T>
+        void FileMappedArrayAllocator<T>::sync()
+        {}
+
+#endif // SCHNEK_HAVE_MMAP
+    }
+}
+
+#endif // SCHNEK_GRID_GRIDSTORAGE_FILEMAPPEDALLOCATION_HPP_
@@ -0,0 +1,223 @@
+/*
+ * first-touch-allocation.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_GRIDSTORAGE_FIRSTTOUCHALLOCATION_HPP_
+#define SCHNEK_GRID_GRIDSTORAGE_FIRSTTOUCHALLOCATION_HPP_
+
+#include "single-array-allocation.hpp"
+#include "mmap-allocation.hpp"
+#include "../../util/threadpool.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace schnek
+{
+    namespace internal {
+        /**
+         * @brief Allocates arrays and initialises them in parallel on the threads of the ThreadPool
+         *
+         * Operating systems place a page of memory on the NUMA node of the thread that
+         * first writes to it. This allocator obtains page aligned memory without touching
+         * it and then value-initialises the elements on the threads of the ThreadPool.
+         * The array is split into slabs of `slabLength` elements and the slabs are
+         * distributed over the threads using partitionRange().
+         *
+         * In contrast to the other allocators, the elements are value-initialised. For
+         * arithmetic types this means the array is filled with zeros. Default
+         * initialisation would leave the memory untouched.
+         *
+         * @tparam T The type of data stored in the array
+         */
+        template <typename T>
+        class FirstTouchArrayAllocator
+        {
+        private:
+            /// The number of elements in one slab
+            size_t slabLength;
+        public:
+            FirstTouchArrayAllocator() : slabLength(1) {}
+
+            /// Set the number of elements in one slab, the array is distributed in whole slabs
+            void setSlabLength(size_t length) { slabLength = std::max(length, size_t(1)); }
+
+            T *allocate(size_t size);
+            void deallocate(T *ptr, size_t size);
+        };
+    }
+
+    /**
+     * @brief Allocate a single array for multidimensional grids with parallel first-touch.
+     *
+     * The grid is split into slabs along dimension `slabDim` and each thread of the
+     * ThreadPool initialises its own slabs, see internal::FirstTouchArrayAllocator.
+     * On NUMA systems, this places the memory of each slab on the node of the thread
+     * that initialised it. Parallel loops over the grid should use partitionRange() to
+     * split `slabDim` over the same number of threads. Only the number of grid points
+     * enters the decomposition, so the grid range and the array index yield the same
+     * slabs.
+     *
+     * The slabs are contiguous in memory only if `slabDim` is the slowest running
+     * dimension of the storage layout.
+     *
+     * Deallocation and allocation is performed on every resize.
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     * @tparam slabDim The dimension along which the grid is split into slabs
+     */
+    template <typename T, size_t rank, size_t slabDim>
+    class SingleArrayFirstTouchAllocationBase
+        : public SingleArrayInstantAllocationBase<T, rank, internal::FirstTouchArrayAllocator<T> >
+    {
+        static_assert(slabDim < rank, "the slab dimension must be smaller than the rank");
+    private:
+        typedef SingleArrayInstantAllocationBase<T, rank, internal::FirstTouchArrayAllocator<T> > BaseType;
+    public:
+        typedef typename BaseType::IndexType IndexType;
+    protected:
+        /**
+         * @brief resizes to grid with lower indices lo[0],...,lo[rank-1]
+         * and upper indices hi[0],...,hi[rank-1]
+         */
+        void resizeImpl(const IndexType &lo, const IndexType &hi);
+
+        /**
+         * @brief resizes the grid and keeps the data in the overlap of the old and new grid
+         */
+        template <class Copy>
+        void resizePreserveImpl(const IndexType &lo, const IndexType &hi, Copy copy);
+    private:
+        /// Set the slab length of the allocator for a grid with the given bounds
+        void setSlabLength(const IndexType &lo, const IndexType &hi);
+    };
+
+    /**
+     * @brief First-touch allocation policy with slabs along the first dimension, for use with C ordering
+     */
+    template <typename T, size_t rank>
+    using SingleArrayFirstTouchAllocation = SingleArrayFirstTouchAllocationBase<T, rank, 0>;
+
+    /**
+     * @brief First-touch allocation policy with slabs along the last dimension, for use with Fortran ordering
+     */
+    template <typename T, size_t rank>
+    using SingleArrayFirstTouchFortranAllocation = SingleArrayFirstTouchAllocationBase<T, rank, rank - 1>;
+
+    //=================================================================
+    //=================== FirstTouchArrayAllocator ====================
+    //=================================================================
+
+    namespace internal {
+
+        template <typename T>
+        T *FirstTouchArrayAllocator<T>::allocate(size_t size)
+        {
+            const std::align_val_t alignment = std::align_val_t(std::max(basePageSize(), alignof(T)));
+            T *ptr = static_cast<T*>(::operator new(size * sizeof(T), alignment));
+
+            ThreadPool &pool = ThreadPool::instance();
+            const size_t parts = pool.getNumThreads();
+            const size_t numSlabs = (size + slabLength - 1) / slabLength;
+            std::vector<char> constructed(parts, 0);
+
+            auto slabElements = [&](size_t part, size_t &begin, size_t &end) {
+                long partLo, partHi;
+                partitionRange(0L, long(numSlabs) - 1, part, parts, partLo, partHi);
+                begin = std::min(size, size_t(partLo) * slabLength);
+                end = std::min(size, size_t(partHi + 1) * slabLength);
+            };
+
+            try
+            {
+                pool.run([&](size_t part) {
+                    size_t begin, end;
+                    slabElements(part, begin, end);
+                    std::uninitialized_value_construct_n(ptr + begin, end - begin);
+                    constructed[part] = 1;
+                });
+            }
+            catch (...)
+            {
+                for (size_t part = 0; part < parts; ++part)
+                {
+                    if (!constructed[part]) continue;
+                    size_t begin, end;
+                    slabElements(part, begin, end);
+                    std::destroy_n(ptr + begin, end - begin);
+                }
+                ::operator delete(ptr, alignment);
+                throw;
+            }
+            return ptr;
+        }
+
+        template <typename T>
+        void FirstTouchArrayAllocator<T>::deallocate(T *ptr, size_t size)
+        {
+            std::destroy_n(ptr, size);
+            ::operator delete(ptr, std::align_val_t(std::max(basePageSize(), alignof(T))));
+        }
+    }
+
+    //=================================================================
+    //============= SingleArrayFirstTouchAllocationBase ===============
+    //=================================================================
+
+    template <typename T, size_t rank, size_t slabDim>
+    void SingleArrayFirstTouchAllocationBase<T, rank, slabDim>::resizeImpl(const IndexType &lo, const IndexType &hi)
+    {
+        this->setSlabLength(lo, hi);
+        BaseType::resizeImpl(lo, hi);
+    }
+
+    template <typename T, size_t rank, size_t slabDim>
+    template <class Copy>
+    void SingleArrayFirstTouchAllocationBase<T, rank, slabDim>::resizePreserveImpl(
+        const IndexType &lo,
+        const IndexType &hi,
+        Copy copy
+    )
+    {
+        this->setSlabLength(lo, hi);
+        BaseType::resizePreserveImpl(lo, hi, copy);
+    }
+
+    template <typename T, size_t rank, size_t slabDim>
+    void SingleArrayFirstTouchAllocationBase<T, rank, slabDim>::setSlabLength(const IndexType &lo, const IndexType &hi)
+    {
+        size_t slabLength = 1;
+        for (size_t d = 0; d < rank; ++d)
+        {
+            if (d != slabDim) slabLength *= hi[d] - lo[d] + 1;
+        }
+        this->ensureData();
+        this->data->getAllocator().setSlabLength(slabLength);
+    }
+}
+
+#endif // SCHNEK_GRID_GRIDSTORAGE_FIRSTTOUCHALLOCATION_HPP_
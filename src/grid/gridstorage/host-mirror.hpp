@@ -0,0 +1,78 @@
+/*
+ * host-mirror.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_GRIDSTORAGE_HOSTMIRROR_HPP_
+#define SCHNEK_GRID_GRIDSTORAGE_HOSTMIRROR_HPP_
+
+#include <type_traits>
+#include <utility>
+
+namespace schnek
+{
+    namespace internal {
+        /// True if the grid keeps a host copy of device data, such as KokkosDualGridStorage
+        template<class GridType, typename = void>
+        struct HasHostMirror : std::false_type {};
+
+        template<class GridType>
+        struct HasHostMirror<
+            GridType,
+            std::void_t<
+                decltype(std::declval<GridType&>().syncHost()),
+                decltype(std::declval<GridType&>().modifyHost())
+            >
+        > : std::true_type {};
+
+        /**
+         * @brief Make the host copy of the grid data up to date before it is read on the host
+         *
+         * Does nothing for grids that do not have a host mirror.
+         */
+        template<class GridType>
+        inline void syncHostMirror(GridType &grid)
+        {
+            if constexpr (HasHostMirror<GridType>::value)
+            {
+                grid.syncHost();
+            }
+        }
+
+        /**
+         * @brief Mark the host copy of the grid data as modified after it has been written on the host
+         *
+         * Does nothing for grids that do not have a host mirror.
+         */
+        template<class GridType>
+        inline void markHostModified(GridType &grid)
+        {
+            if constexpr (HasHostMirror<GridType>::value)
+            {
+                grid.modifyHost();
+            }
+        }
+    }
+}
+
+#endif // SCHNEK_GRID_GRIDSTORAGE_HOSTMIRROR_HPP_
@@ -33,12 +33,15 @@
 #include "../../macros.hpp"
 #include "../array.hpp"
 #include "../range.hpp"
+#include "../iteration/range-iteration.hpp"
+#include "shared-view-list.hpp"
 
 #include <memory>
-#include <functional>
-#include <map>
+#include <type_traits>
+#include <utility>
 
 #include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
 
 namespace schnek {
 
@@ -74,9 +77,12 @@ namespace schnek {
 
         /// The grid range type
         typedef Range<int, rank> RangeType;
+
+        /// The Kokkos view holding the data
+        typedef Kokkos::View<typename internal::KokkosViewType<T, rank>::type, ViewProperties...> KokkosView;
     private:
-        typedef std::function<void(const RangeType&)> UpdaterType;
-        typedef std::map<void *, UpdaterType> UpdaterMapType;
+        typedef internal::SharedViewList<RangeType> ViewListType;
+        typedef typename ViewListType::ViewType ViewType;
 
         /// The lowest and highest coordinates in the grid (inclusive)
         RangeType range;
@@ -84,10 +90,13 @@ namespace schnek {
         /// The dimensions of the grid `dims = high - low + 1`
         IndexType dims;
 
-        Kokkos::View<typename internal::KokkosViewType<T, rank>::type, ViewProperties...> view;
+        KokkosView view;
+
+        /// The list of copies of this storage that share the view
+        std::shared_ptr<ViewListType> views;
 
-        /// A map of updaters that are called when the grid is resized
-        std::shared_ptr<UpdaterMapType> updaters;
+        /// The link of this storage in `views`
+        ViewType viewLink;
     public:
         /// Default constructor
         KokkosGridStorage();
@@ -97,6 +106,18 @@ namespace schnek {
          */
         KokkosGridStorage(const KokkosGridStorage &);
 
+        /**
+         * @brief Move constructor
+         *
+         * Takes over the view without copying. The moved-from storage is left empty.
+         */
+        KokkosGridStorage(KokkosGridStorage &&);
+
+        /**
+         * @brief Assignment operator
+         */
+        KokkosGridStorage &operator=(const KokkosGridStorage &);
+
         /**
          * @brief Construct with a given size
          * 
@@ -153,7 +174,23 @@ namespace schnek {
         SCHNEK_INLINE int getDims(int k) const { return this->dims[k]; }
 
         /// Get the length of the allocated array
-        SCHNEK_INLINE int getSize() const { return this->size; }
+        SCHNEK_INLINE size_t getSize() const { return this->view.size(); }
+
+        /**
+         * @brief Access to the underlying raw data
+         *
+         * The data is only contiguous in C or Fortran order when the view uses
+         * Kokkos::LayoutRight or Kokkos::LayoutLeft, see KokkosGridStorageC and
+         * KokkosGridStorageFortran.
+         */
+        SCHNEK_INLINE T *getRawData() const { return this->view.data(); }
+
+        /**
+         * @brief The Kokkos view holding the data
+         *
+         * The view is indexed from zero, the element at grid index `getLo()` is `view(0,...,0)`.
+         */
+        SCHNEK_INLINE const KokkosView &getView() const { return this->view; }
 
         /**
          * @brief resizes to grid with lower indices low[0],...,low[rank-1]
@@ -170,7 +207,7 @@ namespace schnek {
         template<std::size_t... I>
         auto createKokkosViewImpl(const IndexType& a, std::index_sequence<I...>)
         {
-            Kokkos::View<typename internal::KokkosViewType<T, rank>::type, ViewProperties...> view("schnek", a[I]...);
+            KokkosView view("schnek", a[I]...);
             return view;
         }
         
@@ -201,10 +238,8 @@ namespace schnek {
             return getFromViewImpl(pos, std::make_index_sequence<rank>{});
         }
 
-        void update(const RangeType& range) {
-            for (auto& updater: *updaters) {
-                updater.second(range);
-            }
+        static void notifyView(void *owner, const RangeType &range) {
+            static_cast<KokkosGridStorage*>(owner)->updateSizeInfo(range);
         }
 
         void updateSizeInfo(const RangeType &range) {
@@ -219,6 +254,265 @@ namespace schnek {
     template<typename T, size_t rank>
     using KokkosDefaultGridStorage = KokkosGridStorage<T, rank>;
 
+    /// Kokkos storage with the memory layout of SingleArrayGridStorage
+    template<typename T, size_t rank>
+    using KokkosGridStorageC = KokkosGridStorage<T, rank, Kokkos::LayoutRight>;
+
+    /// Kokkos storage with the memory layout of SingleArrayGridStorageFortran
+    template<typename T, size_t rank>
+    using KokkosGridStorageFortran = KokkosGridStorage<T, rank, Kokkos::LayoutLeft>;
+
+    /**
+     * @brief A grid storage that keeps the data on the device and a mirror on the host
+     *
+     * The data is held in a `Kokkos::DualView`. The grid accessors, `getRawData()`, `stride()`
+     * and the storage iterators all refer to the host view, so the grid can be used with
+     * HdfOStream and MPICartSubdivision like a grid using SingleArrayGridStorage. Device kernels
+     * use the view returned by `getDeviceView()`.
+     *
+     * The host and device copies are kept consistent with the modified flags of the dual view.
+     * After writing to one of the copies, mark it with `modifyHost()` or `modifyDevice()`.
+     * Before reading a copy, bring it up to date with `syncHost()` or `syncDevice()`. The HDF5
+     * streams and MPICartSubdivision do this for the host copy themselves. With the Serial
+     * or OpenMP backend both views refer to the same memory and synchronising only updates
+     * the flags.
+     *
+     * Copies of the storage share the dual view, including its flags. Resizing a copy
+     * resizes all of them.
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     * @tparam Layout The memory layout, Kokkos::LayoutRight for C order or Kokkos::LayoutLeft
+     *     for Fortran order
+     * @tparam Device The execution space or device of the device view
+     */
+    template <
+        typename T,
+        size_t rank,
+        class Layout = Kokkos::LayoutRight,
+        class Device = Kokkos::DefaultExecutionSpace
+    >
+    class KokkosDualGridStorage
+    {
+        static_assert(
+            std::is_same<Layout, Kokkos::LayoutRight>::value || std::is_same<Layout, Kokkos::LayoutLeft>::value,
+            "the layout must be Kokkos::LayoutRight or Kokkos::LayoutLeft"
+        );
+    public:
+        /// The grid index type
+        typedef Array<int, rank> IndexType;
+
+        /// The grid range type
+        typedef Range<int, rank> RangeType;
+
+        /// The Kokkos dual view holding the data
+        typedef Kokkos::DualView<typename internal::KokkosViewType<T, rank>::type, Layout, Device> DualViewType;
+
+        /// The view of the host copy
+        typedef typename DualViewType::t_host HostViewType;
+
+        /// The view of the device copy
+        typedef typename DualViewType::t_dev DeviceViewType;
+
+        /// The iteration policy that visits the host copy in storage order
+        typedef typename std::conditional<
+            std::is_same<Layout, Kokkos::LayoutRight>::value,
+            RangeCIterationPolicy<rank>,
+            RangeFortranIterationPolicy<rank>
+        >::type IterationPolicy;
+
+        typedef T* storage_iterator;
+        typedef const T* const_storage_iterator;
+    private:
+        /// The information passed to all copies on a resize
+        struct SizeInfo
+        {
+            RangeType range;
+            DualViewType dualView;
+        };
+
+        typedef internal::SharedViewList<SizeInfo> ViewListType;
+        typedef typename ViewListType::ViewType ViewType;
+
+        /// The lowest and highest coordinates in the grid (inclusive)
+        RangeType range;
+
+        /// The dimensions of the grid `dims = high - low + 1`
+        IndexType dims;
+
+        DualViewType dualView;
+
+        /// The list of copies of this storage that share the dual view
+        std::shared_ptr<ViewListType> views;
+
+        /// The link of this storage in `views`
+        ViewType viewLink;
+    public:
+        /// Default constructor
+        KokkosDualGridStorage();
+
+        /// Copy constructor, the copy shares the dual view
+        KokkosDualGridStorage(const KokkosDualGridStorage &);
+
+        /**
+         * @brief Move constructor
+         *
+         * Takes over the dual view without copying. The moved-from storage is left empty.
+         */
+        KokkosDualGridStorage(KokkosDualGridStorage &&) noexcept;
+
+        /**
+         * @brief Assignment operator
+         */
+        KokkosDualGridStorage &operator=(const KokkosDualGridStorage &);
+
+        /**
+         * @brief Move assignment operator
+         *
+         * Takes over the dual view without copying. The moved-from storage is left empty.
+         */
+        KokkosDualGridStorage &operator=(KokkosDualGridStorage &&) noexcept;
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param lo the lowest coordinate in the grid (inclusive)
+         * @param hi the highest coordinate in the grid (inclusive)
+         */
+        KokkosDualGridStorage(const IndexType &lo, const IndexType &hi);
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param range the lowest and highest coordinates in the grid (inclusive)
+         */
+        KokkosDualGridStorage(const RangeType &range);
+
+        /// Destructor
+        ~KokkosDualGridStorage();
+
+        /**
+         * @brief Get the rvalue at a given grid index in the host copy
+         *
+         * @param index The grid index
+         * @return the rvalue at the grid index
+         */
+        SCHNEK_INLINE const T& get(const IndexType &index) const;
+
+        /**
+         * @brief Get the lvalue at a given grid index in the host copy
+         *
+         * @param index The grid index
+         * @return the lvalue at the grid index
+         */
+        SCHNEK_INLINE T& get(const IndexType &index);
+
+        /// Get the lowest coordinate in the grid (inclusive)
+        SCHNEK_INLINE const IndexType &getLo() const { return this->range.getLo(); }
+
+        /// Get the highest coordinate in the grid (inclusive)
+        SCHNEK_INLINE const IndexType &getHi() const { return this->range.getHi(); }
+
+        /// Get the lowest coordinate in the grid (inclusive)
+        SCHNEK_INLINE const RangeType &getRange() const { return this->range; }
+
+        /// Get the dimensions of the grid `dims = high - low + 1`
+        SCHNEK_INLINE const IndexType &getDims() const { return this->dims; }
+
+        /// Get k-th component of the lowest coordinate in the grid (inclusive)
+        SCHNEK_INLINE int getLo(int k) const { return this->range.getLo(k); }
+
+        /// Get k-th component of the highest coordinate in the grid (inclusive)
+        SCHNEK_INLINE int getHi(int k) const { return this->range.getHi(k); }
+
+        /// Get k-th component of the dimensions of the grid `dims = high - low + 1`
+        SCHNEK_INLINE int getDims(int k) const { return this->dims[k]; }
+
+        /// Get the length of the allocated array
+        SCHNEK_INLINE size_t getSize() const { return this->dualView.view_host().size(); }
+
+        /// Access to the raw data of the host copy
+        SCHNEK_INLINE T *getRawData() const { return this->dualView.view_host().data(); }
+
+        /// The view of the host copy
+        SCHNEK_INLINE const HostViewType &getHostView() const { return this->dualView.view_host(); }
+
+        /// The view of the device copy, for use in device kernels
+        SCHNEK_INLINE const DeviceViewType &getDeviceView() const { return this->dualView.view_device(); }
+
+        /// Mark the host copy as modified
+        void modifyHost() { this->dualView.modify_host(); }
+
+        /// Mark the device copy as modified
+        void modifyDevice() { this->dualView.modify_device(); }
+
+        /// Copy the data to the host if the device copy has been modified
+        void syncHost() { this->dualView.sync_host(); }
+
+        /// Copy the data to the device if the host copy has been modified
+        void syncDevice() { this->dualView.sync_device(); }
+
+        /// True if the device copy has been modified since the last `syncHost()`
+        bool needSyncHost() const { return this->dualView.need_sync_host(); }
+
+        /// True if the host copy has been modified since the last `syncDevice()`
+        bool needSyncDevice() const { return this->dualView.need_sync_device(); }
+
+        /**
+         * @brief resizes to grid with lower indices low[0],...,low[rank-1]
+         * and upper indices high[0],...,high[rank-1]
+         *
+         * The data is not preserved and the modified flags are cleared.
+         */
+        void resize(const IndexType &low, const IndexType &high);
+
+        /**
+         * @brief returns the stride of the specified dimension
+         */
+        SCHNEK_INLINE ptrdiff_t stride(size_t dim) const { return this->dualView.view_host().stride(dim); }
+
+        SCHNEK_INLINE storage_iterator begin() { return getRawData(); }
+        SCHNEK_INLINE storage_iterator end() { return getRawData() + getSize(); }
+
+        SCHNEK_INLINE const_storage_iterator cbegin() const { return getRawData(); }
+        SCHNEK_INLINE const_storage_iterator cend() const { return getRawData() + getSize(); }
+    private:
+        template<std::size_t... I>
+        static DualViewType createDualViewImpl(const IndexType& a, std::index_sequence<I...>)
+        {
+            return DualViewType("schnek", a[I]...);
+        }
+
+        static DualViewType createDualView(const IndexType& dims)
+        {
+            return createDualViewImpl(dims, std::make_index_sequence<rank>{});
+        }
+
+        template<std::size_t... I>
+        SCHNEK_INLINE T& getFromViewImpl(const IndexType& pos, std::index_sequence<I...>) const
+        {
+            return this->dualView.view_host()(pos[I]...);
+        }
+
+        static void notifyView(void *owner, const SizeInfo &sizeInfo) {
+            static_cast<KokkosDualGridStorage*>(owner)->updateSizeInfo(sizeInfo);
+        }
+
+        void updateSizeInfo(const SizeInfo &sizeInfo) {
+            this->range = sizeInfo.range;
+            this->dims = sizeInfo.range.getHi() - sizeInfo.range.getLo() + 1;
+            this->dualView = sizeInfo.dualView;
+        }
+    };
+
+    /// Kokkos dual view storage with the memory layout of SingleArrayGridStorage
+    template<typename T, size_t rank>
+    using KokkosDualGridStorageC = KokkosDualGridStorage<T, rank, Kokkos::LayoutRight>;
+
+    /// Kokkos dual view storage with the memory layout of SingleArrayGridStorageFortran
+    template<typename T, size_t rank>
+    using KokkosDualGridStorageFortran = KokkosDualGridStorage<T, rank, Kokkos::LayoutLeft>;
+
     //=================================================================
     //==================== KokkosGridStorage ==========================
     //=================================================================
@@ -227,44 +521,74 @@ namespace schnek {
     KokkosGridStorage<T, rank, ViewProperties...>::KokkosGridStorage() 
         : range{IndexType{0}, IndexType{0}}, 
           dims{0},
-          updaters{new UpdaterMapType}
+          views{new ViewListType},
+          viewLink{this, &notifyView}
     {
-        (*updaters)[this] = [this](const RangeType& range) { this->updateSizeInfo(range); };
+        views->attach(&viewLink);
     }
 
     template <typename T, size_t rank, class ...ViewProperties>
     KokkosGridStorage<T, rank, ViewProperties...>::KokkosGridStorage(const KokkosGridStorage &other) 
         : range{other.range}, 
           dims{other.dims}, view{other.view},
-          updaters{other.updaters}
+          views{other.views},
+          viewLink{this, &notifyView}
+    {
+        views->attach(&viewLink);
+    }
+
+    template <typename T, size_t rank, class ...ViewProperties>
+    KokkosGridStorage<T, rank, ViewProperties...>::KokkosGridStorage(KokkosGridStorage &&other) 
+        : range{other.range}, 
+          dims{other.dims}, view{std::move(other.view)},
+          views{std::move(other.views)},
+          viewLink{this, &notifyView}
+    {
+        views->replace(&other.viewLink, &viewLink);
+        other.range = RangeType{IndexType{0}, IndexType{-1}};
+        other.dims = IndexType{0};
+    }
+
+    template <typename T, size_t rank, class ...ViewProperties>
+    KokkosGridStorage<T, rank, ViewProperties...> &
+        KokkosGridStorage<T, rank, ViewProperties...>::operator=(const KokkosGridStorage &other)
     {
-        (*updaters)[this] = [this](const RangeType& range) { this->updateSizeInfo(range); };
+        if (this == &other) return *this;
+        if (views) views->detach(&viewLink);
+        range = other.range;
+        dims = other.dims;
+        view = other.view;
+        views = other.views;
+        views->attach(&viewLink);
+        return *this;
     }
 
     template <typename T, size_t rank, class ...ViewProperties>
     KokkosGridStorage<T, rank, ViewProperties...>::KokkosGridStorage(const IndexType &lo, const IndexType &hi) 
         : range{lo, hi},
-          updaters{new UpdaterMapType}
+          views{new ViewListType},
+          viewLink{this, &notifyView}
     {
         dims = hi - lo + 1;
         view = createKokkosView(dims);
-        (*updaters)[this] = [this](const RangeType& range) { this->updateSizeInfo(range); };
+        views->attach(&viewLink);
     }
 
     template <typename T, size_t rank, class ...ViewProperties>
     KokkosGridStorage<T, rank, ViewProperties...>::KokkosGridStorage(const RangeType &range) 
         : range{range},
-          updaters{new UpdaterMapType}  
+          views{new ViewListType},
+          viewLink{this, &notifyView}
     {
         dims = range.getHi() - range.getLo() + 1;
         view = createKokkosView(dims);
-        (*updaters)[this] = [this](const RangeType& range) { this->updateSizeInfo(range); };
+        views->attach(&viewLink);
     }
 
     template <typename T, size_t rank, class ...ViewProperties>
     KokkosGridStorage<T, rank, ViewProperties...>::~KokkosGridStorage()
     {
-        updaters->erase(this);
+        if (views) views->detach(&viewLink);
     }
 
     template <typename T, size_t rank, class ...ViewProperties>
@@ -292,9 +616,14 @@ namespace schnek {
     template <typename T, size_t rank, class ...ViewProperties>
     void KokkosGridStorage<T, rank, ViewProperties...>::resize(const IndexType &lo, const IndexType &hi)
     {
+        if (!views)
+        {
+            views.reset(new ViewListType);
+            views->attach(&viewLink);
+        }
         IndexType dims = hi - lo + 1;
         this->view = createKokkosView(dims);
-        update(RangeType{lo, hi});
+        views->notify(RangeType{lo, hi});
     }
 
     template <typename T, size_t rank, class ...ViewProperties>
@@ -303,6 +632,132 @@ namespace schnek {
         return this->view.stride(dim);
     }
 
+    //=================================================================
+    //================== KokkosDualGridStorage ========================
+    //=================================================================
+
+    template <typename T, size_t rank, class Layout, class Device>
+    KokkosDualGridStorage<T, rank, Layout, Device>::KokkosDualGridStorage()
+        : range{IndexType{0}, IndexType{-1}},
+          dims{0},
+          views{new ViewListType},
+          viewLink{this, &notifyView}
+    {
+        views->attach(&viewLink);
+    }
+
+    template <typename T, size_t rank, class Layout, class Device>
+    KokkosDualGridStorage<T, rank, Layout, Device>::KokkosDualGridStorage(const KokkosDualGridStorage &other)
+        : range{other.range},
+          dims{other.dims},
+          dualView{other.dualView},
+          views{other.views},
+          viewLink{this, &notifyView}
+    {
+        views->attach(&viewLink);
+    }
+
+    template <typename T, size_t rank, class Layout, class Device>
+    KokkosDualGridStorage<T, rank, Layout, Device>::KokkosDualGridStorage(KokkosDualGridStorage &&other) noexcept
+        : range{other.range},
+          dims{other.dims},
+          dualView{std::move(other.dualView)},
+          views{std::move(other.views)},
+          viewLink{this, &notifyView}
+    {
+        if (views) views->replace(&other.viewLink, &viewLink);
+        other.range = RangeType{IndexType{0}, IndexType{-1}};
+        other.dims = IndexType{0};
+        other.dualView = DualViewType();
+    }
+
+    template <typename T, size_t rank, class Layout, class Device>
+    KokkosDualGridStorage<T, rank, Layout, Device> &
+        KokkosDualGridStorage<T, rank, Layout, Device>::operator=(const KokkosDualGridStorage &other)
+    {
+        if (this == &other) return *this;
+        if (views) views->detach(&viewLink);
+        range = other.range;
+        dims = other.dims;
+        dualView = other.dualView;
+        views = other.views;
+        views->attach(&viewLink);
+        return *this;
+    }
+
+    template <typename T, size_t rank, class Layout, class Device>
+    KokkosDualGridStorage<T, rank, Layout, Device> &
+        KokkosDualGridStorage<T, rank, Layout, Device>::operator=(KokkosDualGridStorage &&other) noexcept
+    {
+        if (this == &other) return *this;
+        if (views) views->detach(&viewLink);
+        range = other.range;
+        dims = other.dims;
+        dualView = std::move(other.dualView);
+        views = std::move(other.views);
+        if (views) views->replace(&other.viewLink, &viewLink);
+        other.range = RangeType{IndexType{0}, IndexType{-1}};
+        other.dims = IndexType{0};
+        other.dualView = DualViewType();
+        return *this;
+    }
+
+    template <typename T, size_t rank, class Layout, class Device>
+    KokkosDualGridStorage<T, rank, Layout, Device>::KokkosDualGridStorage(const IndexType &lo, const IndexType &hi)
+        : range{lo, hi},
+          views{new ViewListType},
+          viewLink{this, &notifyView}
+    {
+        dims = hi - lo + 1;
+        dualView = createDualView(dims);
+        views->attach(&viewLink);
+    }
+
+    template <typename T, size_t rank, class Layout, class Device>
+    KokkosDualGridStorage<T, rank, Layout, Device>::KokkosDualGridStorage(const RangeType &range)
+        : KokkosDualGridStorage(range.getLo(), range.getHi())
+    {}
+
+    template <typename T, size_t rank, class Layout, class Device>
+    KokkosDualGridStorage<T, rank, Layout, Device>::~KokkosDualGridStorage()
+    {
+        if (views) views->detach(&viewLink);
+    }
+
+    template <typename T, size_t rank, class Layout, class Device>
+    SCHNEK_INLINE const T &KokkosDualGridStorage<T, rank, Layout, Device>::get(const IndexType &index) const
+    {
+        IndexType pos;
+        for (size_t i=0; i<rank; ++i)
+        {
+            pos[i] = index[i] - range.getLo(i);
+        }
+        return getFromViewImpl(pos, std::make_index_sequence<rank>{});
+    }
+
+    template <typename T, size_t rank, class Layout, class Device>
+    SCHNEK_INLINE T &KokkosDualGridStorage<T, rank, Layout, Device>::get(const IndexType &index)
+    {
+        IndexType pos;
+        for (size_t i=0; i<rank; ++i)
+        {
+            pos[i] = index[i] - range.getLo(i);
+        }
+        return getFromViewImpl(pos, std::make_index_sequence<rank>{});
+    }
+
+    template <typename T, size_t rank, class Layout, class Device>
+    void KokkosDualGridStorage<T, rank, Layout, Device>::resize(const IndexType &lo, const IndexType &hi)
+    {
+        if (!views)
+        {
+            views.reset(new ViewListType);
+            views->attach(&viewLink);
+        }
+        IndexType dims = hi - lo + 1;
+        views->notify(SizeInfo{RangeType{lo, hi}, createDualView(dims)});
+    }
+
 }
 
 
@@ -0,0 +1,239 @@
+/*
+ * kokkos-subgrid-storage.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_GRIDSTORAGE_KOKKOSSUBGRIDSTORAGE_HPP_
+#define SCHNEK_GRID_GRIDSTORAGE_KOKKOSSUBGRIDSTORAGE_HPP_
+
+#include "../../config.hpp"
+
+#ifdef SCHNEK_HAVE_KOKKOS
+
+#include "../../macros.hpp"
+#include "../array.hpp"
+#include "../range.hpp"
+
+#include <type_traits>
+#include <utility>
+
+#include <Kokkos_Core.hpp>
+
+namespace schnek {
+
+    namespace internal {
+        /// True if the grid exposes its data as a Kokkos view through `getView()`
+        template<class GridType, typename = void>
+        struct HasKokkosView : std::false_type {};
+
+        template<class GridType>
+        struct HasKokkosView<
+            GridType,
+            std::void_t<decltype(std::declval<const GridType&>().getView())>
+        > : std::true_type {};
+
+        /// Create the subview covering the indices `lo` to `hi` (inclusive) of a view
+        template<class ViewType, class IndexType, std::size_t... I>
+        auto createKokkosSubview(const ViewType &view, const IndexType &lo, const IndexType &hi,
+                                 std::index_sequence<I...>)
+        {
+            return Kokkos::subview(view, std::pair<int, int>(lo[I], hi[I] + 1)...);
+        }
+    }
+
+    /**
+     * @brief Storage of a SubGrid whose base grid keeps its data in a Kokkos view
+     *
+     * Element access is forwarded to the base grid, as with SubGridStorage. In addition,
+     * `getView()` returns a `Kokkos::subview` of the base grid's view that covers the
+     * domain of the sub-grid, so that device kernels over ghost slabs or boundary regions
+     * can capture the view by value and run with RangeKokkosIterationPolicy over `getRange()`.
+     *
+     * @code
+     * auto view = ghost.getView();
+     * auto lo = ghost.getLo();
+     * RangeKokkosIterationPolicy<2>::forEach(ghost.getRange(), KOKKOS_LAMBDA(const Array<int, 2> &i) {
+     *     view(i[0] - lo[0], i[1] - lo[1]) = 0.0;
+     * });
+     * @endcode
+     *
+     * The subview shares the memory of the base grid. It is created from the current view
+     * of the base grid on every call of `getView()`, so the sub-grid follows resizes of the
+     * base grid and does not keep an old allocation alive. A kernel should capture the
+     * subview once instead of calling `getView()` for every element.
+     *
+     * SubGrid selects this storage for any base grid that provides `getView()`, such as
+     * grids using KokkosGridStorage or another SubGrid using this storage.
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     * @tparam BaseGrid The type of the base grid
+     */
+    template<
+        typename T,
+        size_t rank,
+        class BaseGrid
+    >
+    class KokkosSubGridStorage
+    {
+    public:
+        typedef Array<int, rank> IndexType;
+        typedef BaseGrid BaseGridType;
+        typedef Range<int, rank> DomainType;
+        typedef Range<int, rank> RangeType;
+
+        /// The view type of the base grid
+        typedef typename std::decay<decltype(std::declval<const BaseGrid&>().getView())>::type BaseViewType;
+
+        /// The type of the subview covering the domain of the sub-grid
+        typedef decltype(internal::createKokkosSubview(
+            std::declval<const BaseViewType&>(),
+            std::declval<const IndexType&>(),
+            std::declval<const IndexType&>(),
+            std::make_index_sequence<rank>{}
+        )) KokkosView;
+
+        typedef T& reference;
+    private:
+        BaseGridType *baseGrid;
+        DomainType domain;
+        IndexType dims;
+
+    public:
+        class storage_iterator {
+          protected:
+            typename DomainType::iterator it;
+            KokkosSubGridStorage *storage;
+            storage_iterator(typename DomainType::iterator it_, KokkosSubGridStorage *storage_)
+              : it(it_), storage(storage_) {}
+
+            friend class KokkosSubGridStorage;
+
+          public:
+            T &operator*() { return storage->get(*it); }
+            storage_iterator &operator++()
+            {
+              ++it;
+              return *this;
+            }
+            bool operator==(const storage_iterator &SI)
+            { return (it==SI.it) && (storage == SI.storage); }
+
+            bool operator!=(const storage_iterator &SI)
+            { return (it!=SI.it) || (storage != SI.storage); }
+        };
+
+        class const_storage_iterator {
+          protected:
+            typename DomainType::iterator it;
+            const KokkosSubGridStorage *storage;
+            const_storage_iterator(typename DomainType::iterator it_, const KokkosSubGridStorage *storage_)
+              : it(it_), storage(storage_) {}
+
+            friend class KokkosSubGridStorage;
+
+          public:
+            const T &operator*() { return storage->get(*it); }
+            const_storage_iterator &operator++()
+            {
+              ++it;
+              return *this;
+            }
+            bool operator==(const const_storage_iterator &SI)
+            { return (it==SI.it) && (storage == SI.storage); }
+            bool operator!=(const const_storage_iterator &SI)
+            { return (it!=SI.it) || (storage != SI.storage); }
+        };
+
+        KokkosSubGridStorage() : baseGrid(NULL), domain(0,0), dims(0) {}
+
+        KokkosSubGridStorage(const IndexType &low_, const IndexType &high_)
+          : baseGrid(NULL), domain(low_, high_)
+        {
+            for (size_t d = 0; d < rank; d++)
+                dims[d] = high_[d] - low_[d] + 1;
+        }
+
+        void resize(const IndexType &low_, const IndexType &high_)
+        {
+            domain = DomainType(low_, high_);
+            for (size_t d = 0; d < rank; d++)
+                dims[d] = high_[d] - low_[d] + 1;
+        }
+
+        SCHNEK_INLINE reference get(const IndexType &index)
+        {
+            return baseGrid->get(baseGrid->check(index, domain.getLo(), domain.getHi()));
+        }
+
+        SCHNEK_INLINE const T &get(const IndexType &index) const
+        {
+            const BaseGridType *grid = baseGrid;
+            return grid->get(grid->check(index, domain.getLo(), domain.getHi()));
+        }
+
+        /** */
+        const IndexType& getLo() const { return domain.getLo(); }
+        /** */
+        const IndexType& getHi() const { return domain.getHi(); }
+        /** */
+        const IndexType& getDims() const { return dims; }
+        /** */
+        const RangeType& getRange() const { return domain; }
+
+        /** */
+        int getLo(int k) const { return domain.getLo()[k]; }
+        /** */
+        int getHi(int k) const { return domain.getHi()[k]; }
+        /** */
+        int getDims(int k) const { return dims[k]; }
+
+        /**
+         * @brief The subview of the current view of the base grid
+         *
+         * The view is indexed from zero, the element at grid index `getLo()` is `view(0,...,0)`.
+         */
+        KokkosView getView() const
+        {
+            IndexType lo, hi;
+            for (size_t d = 0; d < rank; d++)
+            {
+                lo[d] = domain.getLo()[d] - baseGrid->getLo(d);
+                hi[d] = domain.getHi()[d] - baseGrid->getLo(d);
+            }
+            return internal::createKokkosSubview(baseGrid->getView(), lo, hi, std::make_index_sequence<rank>{});
+        }
+
+        storage_iterator begin() { return storage_iterator(domain.begin(), this); }
+        storage_iterator end() { return storage_iterator(domain.end(), this); }
+
+        const_storage_iterator cbegin() const { return const_storage_iterator(domain.cbegin(), this); }
+        const_storage_iterator cend() const { return const_storage_iterator(domain.cend(), this); }
+
+        void setBaseGrid(BaseGridType &baseGrid_) { baseGrid = &baseGrid_; }
+    };
+
+} // namespace schnek
+
+#endif // SCHNEK_HAVE_KOKKOS
+#endif // SCHNEK_GRID_GRIDSTORAGE_KOKKOSSUBGRIDSTORAGE_HPP_
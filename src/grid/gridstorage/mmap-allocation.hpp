@@ -0,0 +1,362 @@
+/*
+ * mmap-allocation.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_GRIDSTORAGE_MMAPALLOCATION_HPP_
+#define SCHNEK_GRID_GRIDSTORAGE_MMAPALLOCATION_HPP_
+
+#include "../../config.hpp"
+#include "single-array-allocation.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+
+#ifdef SCHNEK_HAVE_MMAP
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace schnek
+{
+    /**
+     * @brief The kind of memory pages backing an allocation
+     */
+    enum class PageType {
+        /// No memory has been allocated
+        none,
+        /// The memory is backed by pages of the base page size
+        base,
+        /// Transparent huge pages have been requested for the memory
+        transparentHuge,
+        /// The memory is backed by explicit huge pages from the huge page pool
+        explicitHuge
+    };
+
+    namespace internal {
+        /**
+         * @brief Returns the base page size of the system in bytes
+         */
+        inline size_t basePageSize()
+        {
+#ifdef SCHNEK_HAVE_MMAP
+            static const size_t pageSize = sysconf(_SC_PAGESIZE);
+            return pageSize;
+#else
+            return 4096;
+#endif
+        }
+
+        /**
+         * @brief Returns the default huge page size of the system in bytes
+         *
+         * The size is read from `/proc/meminfo`. If it cannot be determined, 2MiB is assumed.
+         */
+        inline size_t hugePageSize()
+        {
+            static const size_t pageSize = []() {
+                size_t size = 2*1024*1024;
+                std::ifstream meminfo("/proc/meminfo");
+                std::string line;
+                while (std::getline(meminfo, line))
+                {
+                    if (line.compare(0, 13, "Hugepagesize:") == 0)
+                    {
+                        std::istringstream value(line.substr(13));
+                        size_t kB;
+                        if (value >> kB)
+                        {
+                            size = 1024*kB;
+                        }
+                        break;
+                    }
+                }
+                return size;
+            }();
+            return pageSize;
+        }
+
+        /**
+         * @brief Allocates arrays with `mmap` and requests huge pages for them
+         *
+         * The allocator first tries to obtain explicit huge pages using `MAP_HUGETLB`. These
+         * are only available if the system administrator has reserved a huge page pool.
+         * If this fails, the allocator maps anonymous memory aligned to the huge page size
+         * and requests transparent huge pages with `madvise(MADV_HUGEPAGE)`. If that also
+         * fails, the memory is backed by base pages.
+         *
+         * Allocations smaller than one huge page would waste most of the page, and explicit
+         * huge pages are a scarce resource. These are allocated with the aligned
+         * `::operator new`, aligned to SCHNEK_DEFAULT_ALIGNMENT, and are backed by base pages.
+         *
+         * The elements are default-initialised, just like with `new T[size]`.
+         *
+         * The size of a mapping and the way it was allocated are derived from the number of
+         * elements passed to `deallocate()`, so the allocator can hold several arrays at a
+         * time. The page information describes the most recent allocation.
+         *
+         * On systems without `mmap` the allocator falls back to `::operator new`.
+         *
+         * @tparam T The type of data stored in the array
+         */
+        template <typename T>
+        class HugePageArrayAllocator
+        {
+        private:
+            /// The most recent allocation
+            void *current;
+
+            /// The size of the pages backing the most recent allocation
+            size_t pageSize;
+
+            /// The type of pages backing the most recent allocation
+            PageType pageType;
+
+            /// The alignment of allocations made with `::operator new`
+            static std::align_val_t heapAlignment()
+            {
+                return std::align_val_t(std::max(size_t(SCHNEK_DEFAULT_ALIGNMENT), alignof(T)));
+            }
+
+            /// True if an allocation of `bytes` is made with `::operator new` instead of `mmap`
+            static bool allocatedOnHeap(size_t bytes) { return bytes < hugePageSize(); }
+
+            /// The number of bytes mapped for an allocation of `bytes`, a multiple of the huge page size
+            static size_t mappedBytes(size_t bytes)
+            {
+                const size_t hugeSize = hugePageSize();
+                return hugeSize * ((std::max(bytes, size_t(1)) + hugeSize - 1) / hugeSize);
+            }
+        public:
+            HugePageArrayAllocator() : current(NULL), pageSize(0), pageType(PageType::none) {}
+
+            T *allocate(size_t size);
+            void deallocate(T *ptr, size_t size);
+
+            /// The size of the pages backing the current allocation in bytes
+            size_t getPageSize() const { return pageSize; }
+
+            /// The type of pages backing the current allocation
+            PageType getPageType() const { return pageType; }
+        private:
+            /// Map the memory, returns NULL on failure
+            void *map(size_t bytes);
+
+            /// Unmap the memory of an allocation of `bytes`
+            void unmap(void *ptr, size_t bytes);
+        };
+    }
+
+    /**
+     * @brief Allocate a single array for multidimensional grids backed by huge pages.
+     *
+     * Large grids suffer from TLB misses when they are backed by pages of the base page
+     * size. This allocation policy maps the memory with `mmap` and requests huge pages,
+     * see internal::HugePageArrayAllocator. If no huge pages are available, the policy
+     * falls back to base pages. Grids smaller than one huge page are allocated with the
+     * aligned `::operator new` and are always backed by base pages.
+     *
+     * Deallocation and allocation is performed on every resize.
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     */
+    template <typename T, size_t rank>
+    class SingleArrayHugePageAllocation
+        : public SingleArrayInstantAllocationBase<T, rank, internal::HugePageArrayAllocator<T> >
+    {
+    public:
+        /**
+         * @brief The size of the pages backing the grid in bytes
+         *
+         * For transparent huge pages this is the huge page size. The kernel may still
+         * decide to back parts of the memory with base pages.
+         */
+        size_t getPageSize() const { return this->data ? this->data->getAllocator().getPageSize() : 0; }
+
+        /// The type of pages backing the grid
+        PageType getPageType() const
+        {
+            return this->data ? this->data->getAllocator().getPageType() : PageType::none;
+        }
+    };
+
+    //=================================================================
+    //==================== HugePageArrayAllocator =====================
+    //=================================================================
+
+    namespace internal {
+
+        template <typename T>
+        T *HugePageArrayAllocator<T>::allocate(size_t size)
+        {
+            void *ptr = map(size * sizeof(T));
+            if (ptr == NULL)
+            {
+                throw std::bad_alloc();
+            }
+
+            try
+            {
+                std::uninitialized_default_construct_n(static_cast<T*>(ptr), size);
+            }
+            catch (...)
+            {
+                unmap(ptr, size * sizeof(T));
+                throw;
+            }
+            return static_cast<T*>(ptr);
+        }
+
+        template <typename T>
+        void HugePageArrayAllocator<T>::deallocate(T *ptr, size_t size)
+        {
+            if (ptr != NULL)
+            {
+                std::destroy_n(ptr, size);
+                unmap(ptr, size * sizeof(T));
+            }
+        }
+
+#ifdef SCHNEK_HAVE_MMAP
+
+        template <typename T>
+        void *HugePageArrayAllocator<T>::map(size_t bytes)
+        {
+            if (allocatedOnHeap(bytes))
+            {
+                void *ptr = ::operator new(std::max(bytes, size_t(1)), heapAlignment(), std::nothrow);
+                if (ptr != NULL)
+                {
+                    current = ptr;
+                    pageSize = basePageSize();
+                    pageType = PageType::base;
+                }
+                return ptr;
+            }
+
+            const size_t hugeSize = hugePageSize();
+            const size_t length = mappedBytes(bytes);
+
+#ifdef MAP_HUGETLB
+            void *ptr = mmap(NULL, length, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (ptr != MAP_FAILED)
+            {
+                current = ptr;
+                pageSize = hugeSize;
+                pageType = PageType::explicitHuge;
+                return ptr;
+            }
+#endif
+            // Over-allocate so that the mapping can be trimmed to a huge page boundary.
+            // Transparent huge pages only back aligned regions.
+            const size_t rawBytes = length + hugeSize;
+            void *raw = mmap(NULL, rawBytes, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED)
+            {
+                return NULL;
+            }
+
+            char *begin = static_cast<char*>(raw);
+            char *aligned = begin + (hugeSize - reinterpret_cast<uintptr_t>(begin) % hugeSize) % hugeSize;
+            char *end = begin + rawBytes;
+            if (aligned > begin)
+            {
+                munmap(begin, aligned - begin);
+            }
+            if (end > aligned + length)
+            {
+                munmap(aligned + length, end - (aligned + length));
+            }
+
+            current = aligned;
+            pageSize = basePageSize();
+            pageType = PageType::base;
+#ifdef MADV_HUGEPAGE
+            if (madvise(aligned, length, MADV_HUGEPAGE) == 0)
+            {
+                pageSize = hugeSize;
+                pageType = PageType::transparentHuge;
+            }
+#endif
+            return aligned;
+        }
+
+        template <typename T>
+        void HugePageArrayAllocator<T>::unmap(void *ptr, size_t bytes)
+        {
+            if (allocatedOnHeap(bytes))
+            {
+                ::operator delete(ptr, heapAlignment());
+            }
+            else
+            {
+                munmap(ptr, mappedBytes(bytes));
+            }
+            if (ptr == current)
+            {
+                current = NULL;
+                pageSize = 0;
+                pageType = PageType::none;
+            }
+        }
+
+#else // SCHNEK_HAVE_MMAP
+
+        template <typename T>
+        void *HugePageArrayAllocator<T>::map(size_t bytes)
+        {
+            void *ptr = ::operator new(bytes, std::nothrow);
+            if (ptr != NULL)
+            {
+                current = ptr;
+                pageSize = basePageSize();
+                pageType = PageType::base;
+            }
+            return ptr;
+        }
+
+        template <typename T>
+        void HugePageArrayAllocator<T>::unmap(void *ptr, size_t)
+        {
+            ::operator delete(ptr);
+            if (ptr == current)
+            {
+                current = NULL;
+                pageSize = 0;
+                pageType = PageType::none;
+            }
+        }
+
+#endif // SCHNEK_HAVE_MMAP
+    }
+}
+
+#endif // SCHNEK_GRID_GRIDSTORAGE_MMAPALLOCATION_HPP_
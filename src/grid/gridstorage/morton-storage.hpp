@@ -0,0 +1,318 @@
+/*
+ * morton-storage.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_GRIDSTORAGE_MORTONSTORAGE_HPP_
+#define SCHNEK_GRID_GRIDSTORAGE_MORTONSTORAGE_HPP_
+
+#include "single-array-allocation.hpp"
+#include "single-array-storage-base.hpp"
+#include "../mortonlayout.hpp"
+#include "../iteration/morton-iteration.hpp"
+
+#include <array>
+#include <vector>
+
+namespace schnek
+{
+    namespace internal {
+        /// Rounds the dimensions of the array up to the next power of two
+        struct PowerOfTwoRounding
+        {
+            static int round(size_t, int extent)
+            {
+                return extent > 0 ? (1 << mortonBits(extent)) : 0;
+            }
+        };
+    }
+
+    /**
+     * @brief Allocate a single array with power-of-two dimensions for Morton ordering
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     */
+    template <typename T, size_t rank>
+    using SingleArrayMortonAllocation = SingleArrayRoundedAllocation<T, rank, internal::PowerOfTwoRounding>;
+
+    /**
+     * @brief Storage policy that stores the grid in Morton (Z-order)
+     *
+     * The position of a grid point in memory is given by the Morton code of its offset
+     * from the lowest coordinate of the grid, see internal::MortonLayout. Grid points
+     * that are close in any dimension are therefore close in memory on all scales,
+     * which benefits stencils that access neighbours in all dimensions.
+     *
+     * The dimensions of the array are rounded up to the next power of two. The storage
+     * iterators run over all elements of the allocated array, including those outside
+     * the grid. There is no constant stride between grid points, so the storage does
+     * not provide a `stride()` method.
+     *
+     * The code of each offset in each dimension is tabulated when the grid is resized.
+     * An element access is therefore one table lookup per dimension. The tables are
+     * filled using the BMI2 `pdep` instruction when the code is compiled with BMI2
+     * support.
+     *
+     * The iteration policy matching the layout is available as `IterationPolicy`.
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     */
+    template <typename T, size_t rank>
+    class MortonGridStorage : public SingleArrayGridStorageBase<T, rank, SingleArrayMortonAllocation>
+    {
+    private:
+        /// The array positions of the offsets in each dimension
+        std::array<std::vector<size_t>, rank> offsets;
+
+        /// The tables in `offsets`, shifted so that they can be indexed with grid indices
+        std::array<const size_t*, rank> offsets_fast;
+
+        /// A copy of the data pointer for faster access
+        T *data_fast;
+    public:
+        /// Base class type
+        typedef SingleArrayGridStorageBase<T, rank, SingleArrayMortonAllocation> BaseType;
+
+        /// The grid index type
+        typedef typename BaseType::IndexType IndexType;
+
+        /// The grid index type
+        typedef typename BaseType::RangeType RangeType;
+
+        /// The iteration policy that visits the grid in Morton order
+        typedef RangeMortonIterationPolicy<rank> IterationPolicy;
+
+        /// Default constructor
+        MortonGridStorage();
+
+        /// Copy constructor
+        MortonGridStorage(const MortonGridStorage&);
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param lo the lowest coordinate in the grid (inclusive)
+         * @param hi the highest coordinate in the grid (inclusive)
+         */
+        MortonGridStorage(const IndexType &lo, const IndexType &hi);
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param range the lowest and highest coordinates in the grid (inclusive)
+         */
+        MortonGridStorage(const RangeType &range);
+
+        /**
+         * @brief Assignment operator
+         */
+        MortonGridStorage<T, rank> &operator=(const MortonGridStorage<T, rank> &);
+
+        /// Move constructor, the moved-from storage is left empty
+        MortonGridStorage(MortonGridStorage &&) noexcept;
+
+        /**
+         * @brief Move assignment operator
+         */
+        MortonGridStorage<T, rank> &operator=(MortonGridStorage<T, rank> &&) noexcept;
+
+        /**
+         * @brief Get the lvalue at a given grid index
+         *
+         * @param index The grid index
+         * @return the lvalue at the grid index
+         */
+        SCHNEK_INLINE T &get(const IndexType &index);
+
+        /**
+         * @brief Get the rvalue at a given grid index
+         *
+         * @param index The grid index
+         * @return the rvalue at the grid index
+         */
+        SCHNEK_INLINE const T &get(const IndexType &index) const;
+
+        /**
+         * @brief resizes to grid with lower indices lo[0],...,lo[rank-1]
+         * and upper indices hi[0],...,hi[rank-1]
+         */
+        void resize(const IndexType &low, const IndexType &high);
+
+        /**
+         * @brief resizes to grid with the range.
+         * The endponts of the range are inclusive
+         */
+        void resize(const RangeType range);
+    private:
+        /// The position of a grid index in the array
+        SCHNEK_INLINE size_t position(const IndexType &index) const;
+
+        /**
+         * @brief Update the offset tables and the data pointer
+         *
+         * This method is called indirectly when a resize is performed on any of the copies of the
+         * grid.
+         */
+        void updateDataFast();
+    };
+
+    //=================================================================
+    //===================== MortonGridStorage =========================
+    //=================================================================
+
+    template <typename T, size_t rank>
+    MortonGridStorage<T, rank>::MortonGridStorage()
+        : BaseType(), data_fast(NULL)
+    {
+        offsets_fast.fill(NULL);
+        this->onUpdate([this](){ updateDataFast(); });
+    }
+
+    template <typename T, size_t rank>
+    MortonGridStorage<T, rank>::MortonGridStorage(const MortonGridStorage &other)
+        : BaseType(other), data_fast(NULL)
+    {
+        offsets_fast.fill(NULL);
+        this->onUpdate([this](){ updateDataFast(); });
+        if (other.data_fast != NULL) updateDataFast();
+    }
+
+    template <typename T, size_t rank>
+    MortonGridStorage<T, rank>::MortonGridStorage(
+        const IndexType &lo,
+        const IndexType &hi
+    ) : BaseType(), data_fast(NULL)
+    {
+        offsets_fast.fill(NULL);
+        this->onUpdate([this](){ updateDataFast(); });
+        resize(lo, hi);
+    }
+
+    template <typename T, size_t rank>
+    MortonGridStorage<T, rank>::MortonGridStorage(
+        const RangeType &range
+    ) : BaseType(), data_fast(NULL)
+    {
+        offsets_fast.fill(NULL);
+        this->onUpdate([this](){ updateDataFast(); });
+        resize(range.getLo(), range.getHi());
+    }
+
+    template <typename T, size_t rank>
+    MortonGridStorage<T, rank> &MortonGridStorage<T, rank>::operator=(const MortonGridStorage<T, rank> &other)
+    {
+        BaseType::operator=(other);
+        if (other.data_fast != NULL)
+        {
+            updateDataFast();
+        }
+        else
+        {
+            data_fast = NULL;
+            offsets_fast.fill(NULL);
+        }
+        return *this;
+    }
+
+    template <typename T, size_t rank>
+    MortonGridStorage<T, rank>::MortonGridStorage(MortonGridStorage &&other) noexcept
+        : BaseType(std::move(other)),
+          offsets(std::move(other.offsets)),
+          offsets_fast(other.offsets_fast),
+          data_fast(other.data_fast)
+    {
+        // moving the vectors keeps their buffers, so the shifted pointers remain valid
+        this->onUpdate([this](){ updateDataFast(); });
+        other.offsets_fast.fill(NULL);
+        other.data_fast = NULL;
+    }
+
+    template <typename T, size_t rank>
+    MortonGridStorage<T, rank> &MortonGridStorage<T, rank>::operator=(MortonGridStorage<T, rank> &&other) noexcept
+    {
+        if (this == &other) return *this;
+        BaseType::operator=(std::move(other));
+        offsets = std::move(other.offsets);
+        offsets_fast = other.offsets_fast;
+        data_fast = other.data_fast;
+        other.offsets_fast.fill(NULL);
+        other.data_fast = NULL;
+        return *this;
+    }
+
+    template <typename T, size_t rank>
+    SCHNEK_INLINE size_t MortonGridStorage<T, rank>::position(const IndexType &index) const
+    {
+        size_t pos = 0;
+        for (size_t d = 0; d < rank; ++d)
+        {
+            pos += offsets_fast[d][index[d]];
+        }
+        return pos;
+    }
+
+    template <typename T, size_t rank>
+    SCHNEK_INLINE T &MortonGridStorage<T, rank>::get(const IndexType &index)
+    {
+        return this->data_fast[position(index)];
+    }
+
+    template <typename T, size_t rank>
+    SCHNEK_INLINE const T &MortonGridStorage<T, rank>::get(const IndexType &index) const
+    {
+        return this->data_fast[position(index)];
+    }
+
+    template <typename T, size_t rank>
+    inline void MortonGridStorage<T, rank>::resize(const IndexType &lo, const IndexType &hi)
+    {
+        this->resizeImpl(lo, hi);
+    }
+
+    template <typename T, size_t rank>
+    inline void MortonGridStorage<T, rank>::resize(const RangeType range)
+    {
+        this->resize(range.getLo(), range.getHi());
+    }
+
+    template <typename T, size_t rank>
+    void MortonGridStorage<T, rank>::updateDataFast()
+    {
+        const internal::MortonLayout<rank> layout(this->allocDims);
+        for (size_t d = 0; d < rank; ++d)
+        {
+            const int extent = this->dims[d] > 0 ? this->dims[d] : 0;
+            offsets[d].resize(extent);
+            for (int i = 0; i < extent; ++i)
+            {
+                offsets[d][i] = size_t(internal::mortonDeposit(uint64_t(i), layout.masks[d]));
+            }
+            offsets_fast[d] = offsets[d].data() - this->range.getLo(d);
+        }
+        data_fast = this->data->ptr;
+    }
+}
+
+#endif // SCHNEK_GRID_GRIDSTORAGE_MORTONSTORAGE_HPP_
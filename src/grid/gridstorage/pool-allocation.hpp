@@ -0,0 +1,106 @@
+/*
+ * pool-allocation.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_GRIDSTORAGE_POOLALLOCATION_HPP_
+#define SCHNEK_GRID_GRIDSTORAGE_POOLALLOCATION_HPP_
+
+#include "single-array-allocation.hpp"
+#include "../../util/memorypool.hpp"
+
+#include <memory>
+
+namespace schnek
+{
+    namespace internal {
+        /**
+         * @brief Allocates arrays from the MemoryPool
+         *
+         * Arrays that are freed are kept by the pool and re-used for later allocations
+         * of a similar size. The elements are default-initialised, just like with
+         * `new T[size]`.
+         *
+         * @tparam T The type of data stored in the array
+         */
+        template <typename T>
+        struct PoolArrayAllocator
+        {
+            static_assert(MemoryPool::blockAlignment >= alignof(T), "the pool alignment is too small for T");
+
+            T *allocate(size_t size)
+            {
+                MemoryPool &pool = MemoryPool::instance();
+                T *ptr = static_cast<T*>(pool.allocate(size * sizeof(T)));
+                try
+                {
+                    std::uninitialized_default_construct_n(ptr, size);
+                }
+                catch (...)
+                {
+                    pool.deallocate(ptr, size * sizeof(T));
+                    throw;
+                }
+                return ptr;
+            }
+
+            void deallocate(T *ptr, size_t size)
+            {
+                std::destroy_n(ptr, size);
+                MemoryPool::instance().deallocate(ptr, size * sizeof(T));
+            }
+        };
+    }
+
+    /**
+     * @brief Allocate a single array from the MemoryPool, re-allocating on every resize
+     */
+    template <typename T, size_t rank>
+    using SingleArrayPooledAllocation = SingleArrayInstantAllocationBase<T, rank, internal::PoolArrayAllocator<T> >;
+
+    /**
+     * @brief Allocate a single array lazily from the MemoryPool
+     */
+    template <typename T, size_t rank>
+    using SingleArrayLazyPooledAllocation = SingleArrayLazyAllocationBase<T, rank, internal::PoolArrayAllocator<T> >;
+
+    /**
+     * @brief Allocate an aligned and padded array from the MemoryPool, for use with C ordering
+     *
+     * The pool aligns all blocks to MemoryPool::blockAlignment bytes, which must not be
+     * smaller than SCHNEK_DEFAULT_ALIGNMENT.
+     */
+    template <typename T, size_t rank>
+    using SingleArrayAlignedPooledAllocation = SingleArrayPaddedAllocation<
+        T,
+        rank,
+        SCHNEK_DEFAULT_ALIGNMENT,
+        rank - 1,
+        internal::PoolArrayAllocator<T>
+    >;
+
+    static_assert(MemoryPool::blockAlignment >= SCHNEK_DEFAULT_ALIGNMENT,
+                  "the pool alignment must not be smaller than SCHNEK_DEFAULT_ALIGNMENT");
+}
+
+#endif // SCHNEK_GRID_GRIDSTORAGE_POOLALLOCATION_HPP_
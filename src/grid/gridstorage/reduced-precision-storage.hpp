@@ -0,0 +1,277 @@
+/*
+ * reduced-precision-storage.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_GRIDSTORAGE_REDUCEDPRECISIONSTORAGE_HPP_
+#define SCHNEK_GRID_GRIDSTORAGE_REDUCEDPRECISIONSTORAGE_HPP_
+
+#include "single-array-allocation.hpp"
+#include "single-array-storage-base.hpp"
+#include "../../util/bfloat16.hpp"
+
+#include <cstddef>
+
+namespace schnek
+{
+    /**
+     * @brief Convert `n` contiguous values from one floating point type to another
+     *
+     * This is used to load rows of a grid with reduced-precision storage into a buffer of the
+     * compute type and to store them back. The loop has no dependencies between iterations,
+     * so the compiler can vectorise it.
+     *
+     * @param src The values to convert
+     * @param dest The destination, must hold at least `n` values
+     * @param n The number of values
+     */
+    template <typename From, typename To>
+    SCHNEK_INLINE void convertPrecision(const From *src, To *dest, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            dest[i] = To(src[i]);
+        }
+    }
+
+    namespace internal {
+        /**
+         * @brief A reference to an element of a grid with reduced-precision storage
+         *
+         * Reading converts the stored value to the compute type and assignments round the
+         * value to the stored type. Compound assignments are carried out in the compute type.
+         *
+         * @tparam T The compute type
+         * @tparam StoredType The type of the values in memory
+         */
+        template <typename T, typename StoredType>
+        class ConvertingReference
+        {
+        private:
+            StoredType *element;
+        public:
+            explicit ConvertingReference(StoredType *element) : element(element) {}
+
+            ConvertingReference(const ConvertingReference &) = default;
+
+            /// Read the element
+            SCHNEK_INLINE operator T() const { return T(*element); }
+
+            /// Write the element
+            SCHNEK_INLINE ConvertingReference &operator=(const T &value)
+            {
+                *element = StoredType(value);
+                return *this;
+            }
+
+            /// Copy the value of another element, not the reference
+            SCHNEK_INLINE ConvertingReference &operator=(const ConvertingReference &other)
+            {
+                *element = *other.element;
+                return *this;
+            }
+
+            SCHNEK_INLINE ConvertingReference &operator+=(const T &rhs) { return *this = T(*this) + rhs; }
+            SCHNEK_INLINE ConvertingReference &operator-=(const T &rhs) { return *this = T(*this) - rhs; }
+            SCHNEK_INLINE ConvertingReference &operator*=(const T &rhs) { return *this = T(*this) * rhs; }
+            SCHNEK_INLINE ConvertingReference &operator/=(const T &rhs) { return *this = T(*this) / rhs; }
+        };
+
+        /**
+         * @brief Iterates over all elements of a grid with reduced-precision storage in storage order
+         *
+         * @tparam T The compute type
+         * @tparam StoredType The type of the values in memory
+         * @tparam Reference The type returned by dereferencing the iterator, either
+         *     ConvertingReference or the compute type
+         */
+        template <typename T, typename StoredType, typename Reference>
+        class ConvertingIterator
+        {
+        private:
+            StoredType *element;
+        public:
+            explicit ConvertingIterator(StoredType *element) : element(element) {}
+
+            Reference operator*() const { return ConvertingReference<T, StoredType>(element); }
+
+            ConvertingIterator &operator++()
+            {
+                ++element;
+                return *this;
+            }
+
+            ptrdiff_t operator-(const ConvertingIterator &other) const { return element - other.element; }
+
+            bool operator==(const ConvertingIterator &other) const { return element == other.element; }
+
+            bool operator!=(const ConvertingIterator &other) const { return element != other.element; }
+        };
+    }
+
+    /**
+     * @brief Storage policy that keeps the values in memory with a lower precision than the compute type
+     *
+     * The grid behaves like a grid of `T`, usually `double`, but the values are stored in C order
+     * in an array of `StoredType`, such as `float` or BFloat16. This halves or quarters the
+     * memory footprint and bandwidth of fields that do not need the full precision, such as
+     * diagnostic and auxiliary fields.
+     *
+     * Because the stored values are not of type `T`, `get()` returns a lightweight proxy, see
+     * internal::ConvertingReference. The proxy converts the value to `T` when it is read and
+     * rounds it to `StoredType` when it is written. Compound assignments are carried out in `T`.
+     *
+     * `getRawData()` returns a pointer to the stored values. Kernels that process whole rows
+     * can convert a row into a buffer of `T` with `load()`, work on the buffer, and write it back
+     * with `store()`. Grids with this storage are written to HDF5 files in the stored type.
+     *
+     * Use ReducedPrecision<StoredType>::Storage as the storage policy of the Grid class.
+     *
+     * @tparam T The compute type
+     * @tparam rank The rank of the grid
+     * @tparam StoredType The type of the values in memory
+     * @tparam AllocationPolicy The allocation policy of the array of stored values
+     */
+    template <
+        typename T,
+        size_t rank,
+        typename StoredType,
+        template <typename, size_t> class AllocationPolicy = SingleArrayInstantAllocation
+    >
+    class ReducedPrecisionGridStorage : public SingleArrayGridCOrderStorageBase<StoredType, rank, AllocationPolicy>
+    {
+    public:
+        /// Base class type
+        typedef SingleArrayGridCOrderStorageBase<StoredType, rank, AllocationPolicy> BaseType;
+
+        /// The grid index type
+        typedef typename BaseType::IndexType IndexType;
+
+        /// The grid range type
+        typedef typename BaseType::RangeType RangeType;
+
+        /// The proxy returned by `get()`
+        typedef internal::ConvertingReference<T, StoredType> reference;
+
+        typedef internal::ConvertingIterator<T, StoredType, reference> storage_iterator;
+        typedef internal::ConvertingIterator<T, StoredType, T> const_storage_iterator;
+
+        /// Default constructor
+        ReducedPrecisionGridStorage() : BaseType() {}
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param lo the lowest coordinate in the grid (inclusive)
+         * @param hi the highest coordinate in the grid (inclusive)
+         */
+        ReducedPrecisionGridStorage(const IndexType &lo, const IndexType &hi) : BaseType(lo, hi) {}
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param range the lowest and highest coordinates in the grid (inclusive)
+         */
+        ReducedPrecisionGridStorage(const RangeType &range) : BaseType(range) {}
+
+        /**
+         * @brief Get a reference to the element at a given grid index
+         *
+         * @param index The grid index
+         * @return a proxy for the element at the grid index
+         */
+        SCHNEK_INLINE reference get(const IndexType &index)
+        {
+            return reference(&BaseType::get(index));
+        }
+
+        /**
+         * @brief Get the value at a given grid index
+         *
+         * @param index The grid index
+         * @return the value at the grid index, converted to the compute type
+         */
+        SCHNEK_INLINE T get(const IndexType &index) const
+        {
+            return T(BaseType::get(index));
+        }
+
+        /**
+         * @brief Convert `n` consecutive elements in storage order to the compute type
+         *
+         * @param start The grid index of the first element
+         * @param dest The destination, must hold at least `n` values
+         * @param n The number of elements, must not reach past the end of the grid
+         */
+        SCHNEK_INLINE void load(const IndexType &start, T *dest, size_t n) const
+        {
+            convertPrecision(&BaseType::get(start), dest, n);
+        }
+
+        /**
+         * @brief Round `n` values to the stored type and write them to consecutive elements in storage order
+         *
+         * @param start The grid index of the first element
+         * @param src The values to write
+         * @param n The number of elements, must not reach past the end of the grid
+         */
+        SCHNEK_INLINE void store(const IndexType &start, const T *src, size_t n)
+        {
+            convertPrecision(src, &BaseType::get(start), n);
+        }
+
+        SCHNEK_INLINE storage_iterator begin() { return storage_iterator(this->getRawData()); }
+        SCHNEK_INLINE storage_iterator end() { return storage_iterator(this->getRawData() + this->getSize()); }
+
+        SCHNEK_INLINE const_storage_iterator cbegin() const { return const_storage_iterator(this->getRawData()); }
+        SCHNEK_INLINE const_storage_iterator cend() const
+        {
+            return const_storage_iterator(this->getRawData() + this->getSize());
+        }
+    };
+
+    /**
+     * @brief The stored type of grids using ReducedPrecisionGridStorage
+     *
+     * The nested alias `Storage` can be passed as a storage policy to the Grid class.
+     *
+     * @code
+     * Grid<double, 3, GridNoArgCheck, ReducedPrecision<float>::Storage> diagnostic;
+     * @endcode
+     *
+     * @tparam StoredType The type of the values in memory
+     * @tparam AllocationPolicy The allocation policy of the array of stored values
+     */
+    template <
+        typename StoredType,
+        template <typename, size_t> class AllocationPolicy = SingleArrayInstantAllocation
+    >
+    struct ReducedPrecision
+    {
+        /// The reduced-precision storage policy with this stored type
+        template <typename T, size_t rank>
+        using Storage = ReducedPrecisionGridStorage<T, rank, StoredType, AllocationPolicy>;
+    };
+}
+
+#endif // SCHNEK_GRID_GRIDSTORAGE_REDUCEDPRECISIONSTORAGE_HPP_
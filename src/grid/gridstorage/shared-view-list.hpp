@@ -0,0 +1,138 @@
+/*
+ * shared-view-list.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_GRIDSTORAGE_SHAREDVIEWLIST_HPP_
+#define SCHNEK_GRID_GRIDSTORAGE_SHAREDVIEWLIST_HPP_
+
+#include <cstddef>
+
+namespace schnek
+{
+    namespace internal {
+        /**
+         * @brief A link in the list of grid objects sharing the same data
+         *
+         * The link is a member of the grid object, so linking and unlinking never
+         * allocates. A link must not be copied. Each grid object owns its own link,
+         * which points back to the object through `owner`.
+         *
+         * @tparam SizeInfo The size information passed on a resize
+         */
+        template <typename SizeInfo>
+        struct SharedView
+        {
+            /// The function called with `owner` when the shared data is resized
+            typedef void (*NotifyType)(void *owner, const SizeInfo &sizeInfo);
+
+            SharedView *prev;
+            SharedView *next;
+            void *owner;
+            NotifyType notify;
+
+            SharedView(void *owner, NotifyType notify)
+                : prev(NULL), next(NULL), owner(owner), notify(notify)
+            {}
+
+            SharedView(const SharedView &) = delete;
+            SharedView &operator=(const SharedView &) = delete;
+        };
+
+        /**
+         * @brief An intrusive doubly-linked list of the grid objects sharing the same data
+         *
+         * Attaching, detaching and replacing a view are constant-time operations that do
+         * not allocate. A resize walks the list and calls each view directly through a
+         * function pointer. The list also counts the resizes, so that objects caching
+         * derived information can check whether it is still valid.
+         *
+         * @tparam SizeInfo The size information passed on a resize
+         */
+        template <typename SizeInfo>
+        class SharedViewList
+        {
+        public:
+            typedef SharedView<SizeInfo> ViewType;
+        private:
+            ViewType *head;
+            size_t generation;
+        public:
+            SharedViewList() : head(NULL), generation(0) {}
+
+            SharedViewList(const SharedViewList &) = delete;
+            SharedViewList &operator=(const SharedViewList &) = delete;
+
+            /// Add a view to the list
+            void attach(ViewType *view)
+            {
+                view->prev = NULL;
+                view->next = head;
+                if (head) head->prev = view;
+                head = view;
+            }
+
+            /// Remove a view from the list, views that are not in the list are ignored
+            void detach(ViewType *view)
+            {
+                if (view->prev) view->prev->next = view->next;
+                else if (head == view) head = view->next;
+                else return;
+
+                if (view->next) view->next->prev = view->prev;
+                view->prev = NULL;
+                view->next = NULL;
+            }
+
+            /// Put `to` in the place of `from`, used when a grid object is moved
+            void replace(ViewType *from, ViewType *to)
+            {
+                to->prev = from->prev;
+                to->next = from->next;
+                if (to->prev) to->prev->next = to;
+                else head = to;
+                if (to->next) to->next->prev = to;
+                from->prev = NULL;
+                from->next = NULL;
+            }
+
+            /// Notify all views of a resize
+            void notify(const SizeInfo &sizeInfo)
+            {
+                ++generation;
+                for (ViewType *view = head; view != NULL; view = view->next)
+                {
+                    view->notify(view->owner, sizeInfo);
+                }
+            }
+
+            /// The number of resizes so far
+            size_t getGeneration() const { return generation; }
+
+            /// True if no view is attached
+            bool empty() const { return head == NULL; }
+        };
+    }
+}
+
+#endif // SCHNEK_GRID_GRIDSTORAGE_SHAREDVIEWLIST_HPP_
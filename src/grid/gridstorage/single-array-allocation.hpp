@@ -28,12 +28,24 @@
 #define SCHNEK_GRID_GRIDSTORAGE_SINGLEARRAYALLOCATION_HPP_
 
 #include "../array.hpp"
+#include "shared-view-list.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <cmath>
 #include <functional>
-#include <map>
+#include <new>
+#include <numeric>
 
+/**
+ * The default alignment in bytes used by the aligned allocation policies.
+ *
+ * The default of 64 bytes matches the cache line size of most current CPUs and
+ * the width of AVX-512 registers.
+ */
+#ifndef SCHNEK_DEFAULT_ALIGNMENT
+#define SCHNEK_DEFAULT_ALIGNMENT 64
+#endif
 
 /**
  * @page Grid Allocation Policies
@@ -47,53 +59,178 @@ namespace schnek
 {
 
     namespace internal {
+        /**
+         * @brief Allocates arrays using `new[]` and `delete[]`
+         */
+        template <typename T>
+        struct NewArrayAllocator
+        {
+            T *allocate(size_t size) { return new T[size]; }
+            void deallocate(T *ptr, size_t) { delete[] ptr; }
+        };
+
+        /**
+         * @brief Allocates arrays with the first element aligned to a given number of bytes
+         * 
+         * The elements are default-initialised, just like with `new T[size]`.
+         * 
+         * @tparam T The type of data stored in the array
+         * @tparam alignment The alignment in bytes, must be a power of two
+         */
+        template <typename T, size_t alignment>
+        struct AlignedArrayAllocator
+        {
+            static_assert((alignment & (alignment - 1)) == 0, "alignment must be a power of two");
+            static_assert(alignment >= alignof(T), "alignment must not be smaller than the alignment of T");
+
+            T *allocate(size_t size) 
+            {
+                T *ptr = static_cast<T*>(::operator new(size * sizeof(T), std::align_val_t(alignment)));
+                try
+                {
+                    std::uninitialized_default_construct_n(ptr, size);
+                }
+                catch (...)
+                {
+                    ::operator delete(ptr, std::align_val_t(alignment));
+                    throw;
+                }
+                return ptr;
+            }
+
+            void deallocate(T *ptr, size_t size) 
+            {
+                std::destroy_n(ptr, size);
+                ::operator delete(ptr, std::align_val_t(alignment));
+            }
+        };
+
+        /**
+         * @brief True if the allocator can hold more than one array at a time
+         *
+         * Allocators that keep information about the current array, such as a memory
+         * mapping, must specialise this to false. Resizes that preserve the data are not
+         * available for these allocators, because they need the old and the new array at
+         * the same time.
+         */
+        template <typename Allocator>
+        struct AllocatorHoldsMultipleArrays
+        {
+            static const bool value = true;
+        };
+
         /**
          * @brief The data for a single array allocation
          * 
          * This class is used to store the data for a single array allocation. It
-         * stores the pointer to the data and a list of updaters. The updaters should 
-         * be called when the data is resized.
+         * stores the pointer to the data and the list of grid objects sharing the 
+         * data, see SharedViewList. The views should be notified when the data is
+         * resized.
+         * 
+         * @tparam T The type of data stored in the array
+         * @tparam SizeInfo The size information passed to the views
+         * @tparam Allocator The allocator used to allocate and free the array
          */
-        template <typename T, typename SizeInfo>
+        template <typename T, typename SizeInfo, typename Allocator = NewArrayAllocator<T> >
         class SingleArrayAllocationData
         {
         public:
-            typedef std::function<void(const SizeInfo&)> UpdaterType;
+            typedef SharedView<SizeInfo> ViewType;
         private:
-            std::map<void*, UpdaterType> updaters;
+            SharedViewList<SizeInfo> views;
+            Allocator allocator;
         public:
             T *ptr;
-            SingleArrayAllocationData(): ptr(NULL) {}
+
+            /// The number of elements allocated
+            size_t length;
+
+            SingleArrayAllocationData(): ptr(NULL), length(0) {}
             ~SingleArrayAllocationData() {
-                delete[] ptr;
+                deallocate();
             }
 
-            void addUpdater(void* key, const UpdaterType &updater) {
-                updaters[key] = updater;
+            /// Allocate an array of `size` elements
+            void allocate(size_t size) {
+                ptr = allocator.allocate(size);
+                length = size;
             }
 
-            void removeUpdater(void* key) {
-                updaters.erase(key);
+            /**
+             * @brief Replace the array with a new array of `size` elements
+             *
+             * `copy(oldPtr, newPtr)` is called with the old and the new array before the
+             * old array is freed. The allocator must be able to hold two arrays at a time,
+             * see AllocatorHoldsMultipleArrays.
+             */
+            template <class Copy>
+            void reallocate(size_t size, Copy copy)
+            {
+                static_assert(
+                    AllocatorHoldsMultipleArrays<Allocator>::value,
+                    "the allocator cannot hold the old and the new array at the same time"
+                );
+
+                if (!ptr)
+                {
+                    allocate(size);
+                    return;
+                }
+
+                T *oldPtr = ptr;
+                const size_t oldLength = length;
+                ptr = allocator.allocate(size);
+                length = size;
+                copy(oldPtr, ptr);
+                allocator.deallocate(oldPtr, oldLength);
             }
 
-            void update(const SizeInfo& sizeInfo) {
-                for (auto& updater: updaters) {
-                    updater.second(sizeInfo);
+            /// Access to the allocator
+            Allocator &getAllocator() { return allocator; }
+
+            /// Access to the allocator
+            const Allocator &getAllocator() const { return allocator; }
+
+            /// Free the array, if any
+            void deallocate() {
+                if (ptr) 
+                {
+                    allocator.deallocate(ptr, length);
                 }
+                ptr = NULL;
+                length = 0;
             }
+
+            /// Add a view sharing the data
+            void attach(ViewType *view) { views.attach(view); }
+
+            /// Remove a view sharing the data
+            void detach(ViewType *view) { views.detach(view); }
+
+            /// Put the view `to` in the place of `from`, used when a grid object is moved
+            void replace(ViewType *from, ViewType *to) { views.replace(from, to); }
+
+            /// Notify all views of a resize
+            void update(const SizeInfo& sizeInfo) { views.notify(sizeInfo); }
+
+            /// The number of resizes so far
+            size_t getGeneration() const { return views.getGeneration(); }
         };
     }
 
     /**
      * @brief Allocate a single array for multidimensional grids in C ordering.
      *
-     * Deallocation and allocation is performed on every resize.
+     * Deallocation and allocation is performed on every resize. The memory is obtained 
+     * from an allocator that provides the methods `T *allocate(size_t size)` and 
+     * `void deallocate(T *ptr, size_t size)`.
      *
      * @tparam T The type of data stored in the grid
      * @tparam rank The rank of the grid
+     * @tparam Allocator The allocator used for the array
      */
-    template <typename T, size_t rank>
-    class SingleArrayInstantAllocation
+    template <typename T, size_t rank, typename Allocator>
+    class SingleArrayInstantAllocationBase
     {
     public:
         /// The grid index type
@@ -109,8 +246,12 @@ namespace schnek
 
         typedef std::function<void()> UpdaterType;
 
+        typedef internal::SingleArrayAllocationData<T, SizeInfo, Allocator> DataType;
+
+        typedef typename DataType::ViewType ViewType;
+
         /// The pointer to the data
-        std::shared_ptr<internal::SingleArrayAllocationData<T, SizeInfo> > data;
+        std::shared_ptr<DataType> data;
 
         /// The length of the allocated array
         size_t size;
@@ -120,26 +261,42 @@ namespace schnek
 
         /// The dimensions of the grid `dims = high - low + 1`
         IndexType dims;
+
+        /// The dimensions of the allocated array, identical to `dims`
+        IndexType allocDims;
     public:
         /**
          * @brief Default constructor
          */
-        SingleArrayInstantAllocation();
+        SingleArrayInstantAllocationBase();
 
         /**
          * @brief Copy constructor
          */
-        SingleArrayInstantAllocation(const SingleArrayInstantAllocation<T, rank> &);
+        SingleArrayInstantAllocationBase(const SingleArrayInstantAllocationBase &);
 
         /**
          * @brief Assignment operator
          */
-        SingleArrayInstantAllocation<T, rank> &operator=(const SingleArrayInstantAllocation<T, rank> &);
+        SingleArrayInstantAllocationBase &operator=(const SingleArrayInstantAllocationBase &);
+
+        /**
+         * @brief Move constructor
+         *
+         * Takes over the data and the registration with it. The moved-from
+         * allocation is left empty.
+         */
+        SingleArrayInstantAllocationBase(SingleArrayInstantAllocationBase &&) noexcept;
+
+        /**
+         * @brief Move assignment operator
+         */
+        SingleArrayInstantAllocationBase &operator=(SingleArrayInstantAllocationBase &&) noexcept;
 
         /**
          * @brief destructor
          */
-        ~SingleArrayInstantAllocation();
+        ~SingleArrayInstantAllocationBase();
     protected:
         /**
          * @brief resizes to grid with lower indices lo[0],...,lo[rank-1]
@@ -147,6 +304,16 @@ namespace schnek
          */
         void resizeImpl(const IndexType &lo, const IndexType &hi);
 
+        /**
+         * @brief resizes the grid and keeps the data in the overlap of the old and new grid
+         *
+         * The new array is allocated before the old array is freed. `copy(oldPtr, newPtr)`
+         * must copy the overlap from the old to the new layout. The size information
+         * already describes the new grid when `copy` is called.
+         */
+        template <class Copy>
+        void resizePreserveImpl(const IndexType &lo, const IndexType &hi, Copy copy);
+
         /**
          * @brief Add an updater to the data
          * 
@@ -154,21 +321,49 @@ namespace schnek
          */
         void onUpdate(const UpdaterType &updater);
 
+        /**
+         * @brief Create the data if this allocation has been moved from
+         */
+        void ensureData();
+
     private:
         UpdaterType updater;
 
+        /// The link of this object in the list of objects sharing the data
+        ViewType view;
+
+        /// Forwards a resize of the shared data to `updateSizeInfo`
+        static void notifyView(void *owner, const SizeInfo &sizeInfo);
+
         /**
          * @brief Update the size information
          */
         void updateSizeInfo(const SizeInfo& sizeInfo);
 
+        /// Set the size information to that of an empty grid
+        void resetSizeInfo();
+
         /// Free the allocated memory
         void deleteData();
 
         /// Allocate a new array
         void newData(const IndexType &lo, const IndexType &hi);
+
+        /// Set the size information for a grid with the given bounds
+        void setSize(const IndexType &lo, const IndexType &hi);
     };
 
+    /**
+     * @brief Allocate a single array for multidimensional grids using `new[]` and `delete[]`.
+     *
+     * Deallocation and allocation is performed on every resize.
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     */
+    template <typename T, size_t rank>
+    using SingleArrayInstantAllocation = SingleArrayInstantAllocationBase<T, rank, internal::NewArrayAllocator<T> >;
+
     /**
      * @brief Allocate a single array for multidimensional grids in C ordering.
      *
@@ -180,16 +375,17 @@ namespace schnek
      *
      * @tparam T The type of data stored in the grid
      * @tparam rank The rank of the grid
+     * @tparam Allocator The allocator used for the array
      */
-    template <typename T, size_t rank>
-    class SingleArrayLazyAllocation
+    template <typename T, size_t rank, typename Allocator>
+    class SingleArrayLazyAllocationBase
     {
     public:
         /// The grid index type
-        typedef Array<size_t, rank> IndexType;
+        typedef Array<int, rank> IndexType;
 
         /// The grid range type
-        typedef Range<size_t, rank> RangeType;
+        typedef Range<int, rank> RangeType;
     protected:
         struct SizeInfo {
             IndexType lo;
@@ -203,8 +399,12 @@ namespace schnek
 
         typedef std::function<void()> UpdaterType;
 
+        typedef internal::SingleArrayAllocationData<T, SizeInfo, Allocator> DataType;
+
+        typedef typename DataType::ViewType ViewType;
+
         /// The pointer to the data
-        std::shared_ptr<internal::SingleArrayAllocationData<T, SizeInfo> > data;
+        std::shared_ptr<DataType> data;
 
         /// The length of the array
         size_t size;
@@ -215,6 +415,9 @@ namespace schnek
         /// The dimensions of the grid `dims = high - low + 1`
         IndexType dims;
 
+        /// The dimensions of the allocated array, identical to `dims`
+        IndexType allocDims;
+
     private:
         /// The size allocated memory
         size_t bufSize;
@@ -230,20 +433,33 @@ namespace schnek
 
     public:
         /// Default constructor
-        SingleArrayLazyAllocation();
+        SingleArrayLazyAllocationBase();
 
         /// Copy constructor
-        SingleArrayLazyAllocation(const SingleArrayLazyAllocation &);
+        SingleArrayLazyAllocationBase(const SingleArrayLazyAllocationBase &);
 
         /**
          * @brief Assignment operator
          */
-        SingleArrayLazyAllocation<T, rank> &operator=(const SingleArrayLazyAllocation<T, rank> &);
+        SingleArrayLazyAllocationBase &operator=(const SingleArrayLazyAllocationBase &);
+
+        /**
+         * @brief Move constructor
+         *
+         * Takes over the data and the registration with it. The moved-from
+         * allocation is left empty.
+         */
+        SingleArrayLazyAllocationBase(SingleArrayLazyAllocationBase &&) noexcept;
+
+        /**
+         * @brief Move assignment operator
+         */
+        SingleArrayLazyAllocationBase &operator=(SingleArrayLazyAllocationBase &&) noexcept;
 
         /**
          * @brief destructor
          */
-        ~SingleArrayLazyAllocation();
+        ~SingleArrayLazyAllocationBase();
     protected:
         /**
          * @brief resizes to grid with lower indices lo[0],...,lo[rank-1]
@@ -251,6 +467,17 @@ namespace schnek
          */
         void resizeImpl(const IndexType &lo, const IndexType &hi);
 
+        /**
+         * @brief resizes the grid and keeps the data in the overlap of the old and new grid
+         *
+         * `copy(oldPtr, newPtr)` must copy the overlap from the old to the new layout.
+         * If the buffer is large enough for the new grid, no memory is allocated and
+         * `copy` is called with the same pointer twice to move the data in place. The
+         * size information already describes the new grid when `copy` is called.
+         */
+        template <class Copy>
+        void resizePreserveImpl(const IndexType &lo, const IndexType &hi, Copy copy);
+
         /**
          * @brief Add an updater to the data
          * 
@@ -258,9 +485,20 @@ namespace schnek
          */
         void onUpdate(const UpdaterType &updater);
 
+        /**
+         * @brief Create the data if this allocation has been moved from
+         */
+        void ensureData();
+
     private:
         UpdaterType updater;
 
+        /// The link of this object in the list of objects sharing the data
+        ViewType view;
+
+        /// Forwards a resize of the shared data to `updateSizeInfo`
+        static void notifyView(void *owner, const SizeInfo &sizeInfo);
+
         /**
          * @brief Update the size information
          * 
@@ -268,6 +506,9 @@ namespace schnek
          */
         void updateSizeInfo(const SizeInfo& sizeInfo);
 
+        /// Set the size information to that of an empty grid
+        void resetSizeInfo();
+
         /// Free the allocated memory
         void deleteData();
 
@@ -275,164 +516,616 @@ namespace schnek
         void newData(size_t size);
     };
 
-    //=================================================================
-    //=============== SingleArrayInstantAllocation ====================
-    //=================================================================
-
+    /**
+     * @brief Allocate a single array lazily using `new[]` and `delete[]`.
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     */
     template <typename T, size_t rank>
-    SingleArrayInstantAllocation<T, rank>::SingleArrayInstantAllocation()
-        : data(new internal::SingleArrayAllocationData<T, SizeInfo>()), size(0) 
-    {
-        this->data->addUpdater(this, [this](const SizeInfo& sizeInfo) { this->updateSizeInfo(sizeInfo); }); 
-    }
+    using SingleArrayLazyAllocation = SingleArrayLazyAllocationBase<T, rank, internal::NewArrayAllocator<T> >;
 
-    template <typename T, size_t rank>
-    SingleArrayInstantAllocation<T, rank>::SingleArrayInstantAllocation(const SingleArrayInstantAllocation<T, rank> &other)
-        : data(other.data), size(other.size), range(other.range), dims(other.dims)
+    /**
+     * @brief Allocate a single, aligned and padded array for multidimensional grids.
+     *
+     * The first element of the array is aligned to `alignment` bytes. The dimension
+     * `paddedDim` of the array is padded so that the length of each line along this
+     * dimension is a multiple of `alignment` bytes. When `paddedDim` is the fastest
+     * running dimension of the storage layout, every line of the grid starts on an
+     * aligned address. This allows aligned vector loads and avoids lines that split
+     * cache lines.
+     *
+     * The padding elements are part of the allocated array. They are included in the
+     * storage iterators but are never accessed through the grid index.
+     *
+     * Deallocation and allocation is performed on every resize.
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     * @tparam alignment The alignment in bytes, must be a power of two
+     * @tparam paddedDim The dimension that is padded, this should be the fastest running
+     *     dimension of the storage layout
+     * @tparam Allocator The allocator used for the array, it must align the array to
+     *     at least `alignment` bytes
+     */
+    template <
+        typename T, 
+        size_t rank, 
+        size_t alignment, 
+        size_t paddedDim, 
+        typename Allocator = internal::AlignedArrayAllocator<T, alignment> 
+    >
+    class SingleArrayPaddedAllocation
     {
-        this->data->addUpdater(this, [this](const SizeInfo& sizeInfo) { this->updateSizeInfo(sizeInfo); }); 
-    };
+        static_assert(paddedDim < rank, "the padded dimension must be smaller than the rank");
+    public:
+        /// The grid index type
+        typedef Array<int, rank> IndexType;
 
-    template <typename T, size_t rank>
-    SingleArrayInstantAllocation<T, rank> &SingleArrayInstantAllocation<T, rank>::operator=(const SingleArrayInstantAllocation<T, rank> &other) 
-    {
-        this->data = other.data;
-        this->size = other.size;
-        this->range = other.range;
-        this->dims = other.dims;
-        this->data->addUpdater(this, [this](const SizeInfo& sizeInfo) { this->updateSizeInfo(sizeInfo); });
-        return *this;
-    };
+        /// The grid range type
+        typedef Range<int, rank> RangeType;
+    protected:
+        struct SizeInfo {
+            IndexType lo;
+            IndexType hi;
+        };
 
-    template <typename T, size_t rank>
-    SingleArrayInstantAllocation<T, rank>::~SingleArrayInstantAllocation()
-    {
-        this->data->removeUpdater(this);
-    }
+        typedef std::function<void()> UpdaterType;
 
-    template <typename T, size_t rank>
-    void SingleArrayInstantAllocation<T, rank>::onUpdate(const UpdaterType &updater)
-    {
-        this->updater = updater;
-    }
+        typedef internal::SingleArrayAllocationData<T, SizeInfo, Allocator> DataType;
 
-    template <typename T, size_t rank>
-    void SingleArrayInstantAllocation<T, rank>::updateSizeInfo(const SizeInfo &sizeInfo) {
-        size = 1;
-        range = RangeType{sizeInfo.lo, sizeInfo.hi};
+        typedef typename DataType::ViewType ViewType;
 
-        for (size_t d = 0; d < rank; ++d)
-        {
-            dims[d] = sizeInfo.hi[d] - sizeInfo.lo[d] + 1;
-            size *= dims[d];
-        }
+        /// The pointer to the data
+        std::shared_ptr<DataType> data;
 
-        if (updater) {
-            updater();
-        }
-    }
+        /// The length of the allocated array, including the padding
+        size_t size;
 
-    template <typename T, size_t rank>
-    void SingleArrayInstantAllocation<T, rank>::resizeImpl(const IndexType &lo, const IndexType &hi)
-    {
-        this->deleteData();
-        this->newData(lo, hi);
-        data->update(SizeInfo{lo, hi});
-    }
+        /// The lowest and highest coordinates in the grid (inclusive)
+        RangeType range;
 
-    template <typename T, size_t rank>
-    void SingleArrayInstantAllocation<T, rank>::deleteData()
-    {
-        if (data->ptr)
-        {
-            delete[] data->ptr;
-        }
-        data->ptr = NULL;
-        size = 0;
-    }
+        /// The dimensions of the grid `dims = high - low + 1`
+        IndexType dims;
 
-    template <typename T, size_t rank>
-    void SingleArrayInstantAllocation<T, rank>::newData(
-        const IndexType &lo,
-        const IndexType &hi
-    )
-    {
-        size = 1;
-        range = RangeType{lo, hi};
+        /// The dimensions of the allocated array, including the padding
+        IndexType allocDims;
+    public:
+        /**
+         * @brief Default constructor
+         */
+        SingleArrayPaddedAllocation();
 
-        for (size_t d = 0; d < rank; ++d)
-        {
-            dims[d] = hi[d] - lo[d] + 1;
-            size *= dims[d];
-        }
-        data->ptr = new T[size];
-    }
+        /**
+         * @brief Copy constructor
+         */
+        SingleArrayPaddedAllocation(const SingleArrayPaddedAllocation &);
 
-    //=================================================================
-    //================== SingleArrayLazyAllocation ====================
-    //=================================================================
+        /**
+         * @brief Assignment operator
+         */
+        SingleArrayPaddedAllocation &operator=(const SingleArrayPaddedAllocation &);
 
-    template <typename T, size_t rank>
-    SingleArrayLazyAllocation<T, rank>::SingleArrayLazyAllocation()
-        : data(new internal::SingleArrayAllocationData<T, SizeInfo>()), 
-          size(0), 
-          bufSize(0), 
-          avgSize(0.0), 
-          avgVar(0.0), 
-          r(0.05)
-    {
-        this->data->addUpdater(this, [this](const SizeInfo& sizeInfo) { this->updateSizeInfo(sizeInfo); });       
-    }
+        /**
+         * @brief Move constructor
+         *
+         * Takes over the data and the registration with it. The moved-from
+         * allocation is left empty.
+         */
+        SingleArrayPaddedAllocation(SingleArrayPaddedAllocation &&) noexcept;
 
-    template <typename T, size_t rank>
-    SingleArrayLazyAllocation<T, rank>::SingleArrayLazyAllocation(const SingleArrayLazyAllocation<T, rank> &other)
-        : data(other.data), 
-          size(other.size), 
-          range(other.range), 
-          dims(other.dims), 
-          bufSize(other.bufSize), 
-          avgSize(other.avgSize), 
-          avgVar(other.avgVar), 
-          r(other.r)
-    {
-        this->data->addUpdater(this, [this](const SizeInfo& sizeInfo) { this->updateSizeInfo(sizeInfo); });      
-    };
+        /**
+         * @brief Move assignment operator
+         */
+        SingleArrayPaddedAllocation &operator=(SingleArrayPaddedAllocation &&) noexcept;
 
-    template <typename T, size_t rank>
-    SingleArrayLazyAllocation<T, rank> &SingleArrayLazyAllocation<T, rank>::operator=(const SingleArrayLazyAllocation<T, rank> &other) 
-    {
-        this->data = other.data;
-        this->size = other.size;
-        this->range = other.range;
-        this->dims = other.dims;
-        this->data->addUpdater(this, [this](const SizeInfo& sizeInfo) { this->updateSizeInfo(sizeInfo); });
-        return *this;
-    };
+        /**
+         * @brief destructor
+         */
+        ~SingleArrayPaddedAllocation();
+    protected:
+        /**
+         * @brief resizes to grid with lower indices lo[0],...,lo[rank-1]
+         * and upper indices hi[0],...,hi[rank-1]
+         */
+        void resizeImpl(const IndexType &lo, const IndexType &hi);
 
+        /**
+         * @brief resizes the grid and keeps the data in the overlap of the old and new grid
+         *
+         * The new array is allocated before the old array is freed. `copy(oldPtr, newPtr)`
+         * must copy the overlap from the old to the new layout. The size information
+         * already describes the new grid when `copy` is called.
+         */
+        template <class Copy>
+        void resizePreserveImpl(const IndexType &lo, const IndexType &hi, Copy copy);
 
-    template <typename T, size_t rank>
-    SingleArrayLazyAllocation<T, rank>::~SingleArrayLazyAllocation()
-    {
-        this->data->removeUpdater(this);
-    }
+        /**
+         * @brief Add an updater to the data
+         * 
+         * The updater is called when the data is resized.
+         */
+        void onUpdate(const UpdaterType &updater);
 
-    template <typename T, size_t rank>
-    void SingleArrayLazyAllocation<T, rank>::onUpdate(const UpdaterType &updater)
-    {
-        this->updater = updater;
-    }
+        /**
+         * @brief Create the data if this allocation has been moved from
+         */
+        void ensureData();
 
-    template <typename T, size_t rank>
-    void SingleArrayLazyAllocation<T, rank>::updateSizeInfo(const SizeInfo &sizeInfo) {
-        size = 1;
-        range = RangeType{sizeInfo.lo, sizeInfo.hi};
+    private:
+        UpdaterType updater;
 
-        for (size_t d = 0; d < rank; ++d)
-        {
-            dims[d] = sizeInfo.hi[d] - sizeInfo.lo[d] + 1;
-            size *= dims[d];
-        }
-        bufSize = sizeInfo.bufSize;
+        /// The link of this object in the list of objects sharing the data
+        ViewType view;
+
+        /// Forwards a resize of the shared data to `updateSizeInfo`
+        static void notifyView(void *owner, const SizeInfo &sizeInfo);
+
+        /**
+         * @brief Update the size information
+         */
+        void updateSizeInfo(const SizeInfo& sizeInfo);
+
+        /// Set the size information to that of an empty grid
+        void resetSizeInfo();
+
+        /**
+         * @brief Calculate range, dims, allocDims and size from the grid limits
+         */
+        void setSize(const IndexType &lo, const IndexType &hi);
+    };
+
+    /**
+     * @brief Aligned allocation policy padding the last dimension, for use with C ordering
+     */
+    template <typename T, size_t rank>
+    using SingleArrayAlignedAllocation = SingleArrayPaddedAllocation<T, rank, SCHNEK_DEFAULT_ALIGNMENT, rank - 1>;
+
+    /**
+     * @brief Aligned allocation policy padding the first dimension, for use with Fortran ordering
+     */
+    template <typename T, size_t rank>
+    using SingleArrayAlignedFortranAllocation = SingleArrayPaddedAllocation<T, rank, SCHNEK_DEFAULT_ALIGNMENT, 0>;
+
+    /**
+     * @brief Allocate a single array with every dimension rounded up.
+     *
+     * The dimensions of the array are obtained from the dimensions of the grid by
+     * `Rounding::round(dim, dims[dim])`, which must return a value not smaller than
+     * `dims[dim]`. This is used by layouts that need whole blocks of memory, such as
+     * tiles or power-of-two extents.
+     *
+     * Deallocation and allocation is performed on every resize.
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     * @tparam Rounding Provides the static method `int round(size_t dim, int extent)`
+     * @tparam Allocator The allocator used for the array
+     */
+    template <
+        typename T,
+        size_t rank,
+        class Rounding,
+        typename Allocator = internal::NewArrayAllocator<T>
+    >
+    class SingleArrayRoundedAllocation
+    {
+    public:
+        /// The grid index type
+        typedef Array<int, rank> IndexType;
+
+        /// The grid range type
+        typedef Range<int, rank> RangeType;
+    protected:
+        struct SizeInfo {
+            IndexType lo;
+            IndexType hi;
+        };
+
+        typedef std::function<void()> UpdaterType;
+
+        typedef internal::SingleArrayAllocationData<T, SizeInfo, Allocator> DataType;
+
+        typedef typename DataType::ViewType ViewType;
+
+        /// The pointer to the data
+        std::shared_ptr<DataType> data;
+
+        /// The length of the allocated array, including the rounding
+        size_t size;
+
+        /// The lowest and highest coordinates in the grid (inclusive)
+        RangeType range;
+
+        /// The dimensions of the grid `dims = high - low + 1`
+        IndexType dims;
+
+        /// The dimensions of the allocated array, rounded up
+        IndexType allocDims;
+    public:
+        /**
+         * @brief Default constructor
+         */
+        SingleArrayRoundedAllocation();
+
+        /**
+         * @brief Copy constructor
+         */
+        SingleArrayRoundedAllocation(const SingleArrayRoundedAllocation &);
+
+        /**
+         * @brief Assignment operator
+         */
+        SingleArrayRoundedAllocation &operator=(const SingleArrayRoundedAllocation &);
+
+        /**
+         * @brief Move constructor
+         *
+         * Takes over the data and the registration with it. The moved-from
+         * allocation is left empty.
+         */
+        SingleArrayRoundedAllocation(SingleArrayRoundedAllocation &&) noexcept;
+
+        /**
+         * @brief Move assignment operator
+         */
+        SingleArrayRoundedAllocation &operator=(SingleArrayRoundedAllocation &&) noexcept;
+
+        /**
+         * @brief destructor
+         */
+        ~SingleArrayRoundedAllocation();
+    protected:
+        /**
+         * @brief resizes to grid with lower indices lo[0],...,lo[rank-1]
+         * and upper indices hi[0],...,hi[rank-1]
+         */
+        void resizeImpl(const IndexType &lo, const IndexType &hi);
+
+        /**
+         * @brief Add an updater to the data
+         *
+         * The updater is called when the data is resized.
+         */
+        void onUpdate(const UpdaterType &updater);
+
+        /**
+         * @brief Create the data if this allocation has been moved from
+         */
+        void ensureData();
+
+    private:
+        UpdaterType updater;
+
+        /// The link of this object in the list of objects sharing the data
+        ViewType view;
+
+        /// Forwards a resize of the shared data to `updateSizeInfo`
+        static void notifyView(void *owner, const SizeInfo &sizeInfo);
+
+        /**
+         * @brief Update the size information
+         */
+        void updateSizeInfo(const SizeInfo& sizeInfo);
+
+        /// Set the size information to that of an empty grid
+        void resetSizeInfo();
+
+        /**
+         * @brief Calculate range, dims, allocDims and size from the grid limits
+         */
+        void setSize(const IndexType &lo, const IndexType &hi);
+    };
+
+    //=================================================================
+    //============= SingleArrayInstantAllocationBase ==================
+    //=================================================================
+
+    template <typename T, size_t rank, typename Allocator>
+    SingleArrayInstantAllocationBase<T, rank, Allocator>::SingleArrayInstantAllocationBase()
+        : data(new DataType()), size(0), view(this, &notifyView)
+    {
+        this->data->attach(&view); 
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    SingleArrayInstantAllocationBase<T, rank, Allocator>::SingleArrayInstantAllocationBase(
+        const SingleArrayInstantAllocationBase &other
+    )
+        : data(other.data), size(other.size), range(other.range), dims(other.dims), allocDims(other.allocDims),
+          view(this, &notifyView)
+    {
+        if (this->data) this->data->attach(&view); 
+    };
+
+    template <typename T, size_t rank, typename Allocator>
+    SingleArrayInstantAllocationBase<T, rank, Allocator> &
+        SingleArrayInstantAllocationBase<T, rank, Allocator>::operator=(const SingleArrayInstantAllocationBase &other) 
+    {
+        if (this == &other) return *this;
+        if (this->data) this->data->detach(&view);
+        this->data = other.data;
+        this->size = other.size;
+        this->range = other.range;
+        this->dims = other.dims;
+        this->allocDims = other.allocDims;
+        if (this->data) this->data->attach(&view);
+        return *this;
+    };
+
+    template <typename T, size_t rank, typename Allocator>
+    SingleArrayInstantAllocationBase<T, rank, Allocator>::SingleArrayInstantAllocationBase(SingleArrayInstantAllocationBase &&other) noexcept
+        : data(std::move(other.data)), size(other.size), range(other.range), dims(other.dims), allocDims(other.allocDims),
+          view(this, &notifyView)
+    {
+        if (this->data) this->data->replace(&other.view, &view);
+        other.resetSizeInfo();
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    SingleArrayInstantAllocationBase<T, rank, Allocator> &
+        SingleArrayInstantAllocationBase<T, rank, Allocator>::operator=(SingleArrayInstantAllocationBase &&other) noexcept
+    {
+        if (this == &other) return *this;
+        if (this->data) this->data->detach(&view);
+        this->data = std::move(other.data);
+        this->size = other.size;
+        this->range = other.range;
+        this->dims = other.dims;
+        this->allocDims = other.allocDims;
+        if (this->data) this->data->replace(&other.view, &view);
+        other.resetSizeInfo();
+        return *this;
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    SingleArrayInstantAllocationBase<T, rank, Allocator>::~SingleArrayInstantAllocationBase()
+    {
+        if (this->data) this->data->detach(&view);
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayInstantAllocationBase<T, rank, Allocator>::onUpdate(const UpdaterType &updater)
+    {
+        this->updater = updater;
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayInstantAllocationBase<T, rank, Allocator>::notifyView(void *owner, const SizeInfo &sizeInfo)
+    {
+        static_cast<SingleArrayInstantAllocationBase*>(owner)->updateSizeInfo(sizeInfo);
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayInstantAllocationBase<T, rank, Allocator>::ensureData()
+    {
+        if (this->data) return;
+        this->data = std::make_shared<DataType>();
+        this->data->attach(&view);
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayInstantAllocationBase<T, rank, Allocator>::resetSizeInfo()
+    {
+        size = 0;
+        range = RangeType{IndexType(0), IndexType(-1)};
+        dims = IndexType(0);
+        allocDims = IndexType(0);
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayInstantAllocationBase<T, rank, Allocator>::updateSizeInfo(const SizeInfo &sizeInfo) {
+        size = 1;
+        range = RangeType{sizeInfo.lo, sizeInfo.hi};
+
+        for (size_t d = 0; d < rank; ++d)
+        {
+            dims[d] = sizeInfo.hi[d] - sizeInfo.lo[d] + 1;
+            size *= dims[d];
+        }
+        allocDims = dims;
+
+        if (updater) {
+            updater();
+        }
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayInstantAllocationBase<T, rank, Allocator>::resizeImpl(const IndexType &lo, const IndexType &hi)
+    {
+        this->ensureData();
+        this->deleteData();
+        this->newData(lo, hi);
+        data->update(SizeInfo{lo, hi});
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    template <class Copy>
+    void SingleArrayInstantAllocationBase<T, rank, Allocator>::resizePreserveImpl(
+        const IndexType &lo,
+        const IndexType &hi,
+        Copy copy
+    )
+    {
+        this->ensureData();
+        this->setSize(lo, hi);
+        data->reallocate(size, copy);
+        data->update(SizeInfo{lo, hi});
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayInstantAllocationBase<T, rank, Allocator>::deleteData()
+    {
+        data->deallocate();
+        size = 0;
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayInstantAllocationBase<T, rank, Allocator>::newData(
+        const IndexType &lo,
+        const IndexType &hi
+    )
+    {
+        this->setSize(lo, hi);
+        data->allocate(size);
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayInstantAllocationBase<T, rank, Allocator>::setSize(
+        const IndexType &lo,
+        const IndexType &hi
+    )
+    {
+        size = 1;
+        range = RangeType{lo, hi};
+
+        for (size_t d = 0; d < rank; ++d)
+        {
+            dims[d] = hi[d] - lo[d] + 1;
+            size *= dims[d];
+        }
+        allocDims = dims;
+    }
+
+    //=================================================================
+    //================ SingleArrayLazyAllocationBase ==================
+    //=================================================================
+
+    template <typename T, size_t rank, typename Allocator>
+    SingleArrayLazyAllocationBase<T, rank, Allocator>::SingleArrayLazyAllocationBase()
+        : data(new DataType()), 
+          size(0), 
+          bufSize(0), 
+          avgSize(0.0), 
+          avgVar(0.0), 
+          r(0.05),
+          view(this, &notifyView)
+    {
+        this->data->attach(&view);       
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    SingleArrayLazyAllocationBase<T, rank, Allocator>::SingleArrayLazyAllocationBase(const SingleArrayLazyAllocationBase &other)
+        : data(other.data), 
+          size(other.size), 
+          range(other.range), 
+          dims(other.dims), 
+          allocDims(other.allocDims), 
+          bufSize(other.bufSize), 
+          avgSize(other.avgSize), 
+          avgVar(other.avgVar), 
+          r(other.r),
+          view(this, &notifyView)
+    {
+        if (this->data) this->data->attach(&view);      
+    };
+
+    template <typename T, size_t rank, typename Allocator>
+    SingleArrayLazyAllocationBase<T, rank, Allocator> &SingleArrayLazyAllocationBase<T, rank, Allocator>::operator=(const SingleArrayLazyAllocationBase &other) 
+    {
+        if (this == &other) return *this;
+        if (this->data) this->data->detach(&view);
+        this->data = other.data;
+        this->size = other.size;
+        this->range = other.range;
+        this->dims = other.dims;
+        this->allocDims = other.allocDims;
+        this->bufSize = other.bufSize;
+        this->avgSize = other.avgSize;
+        this->avgVar = other.avgVar;
+        this->r = other.r;
+        if (this->data) this->data->attach(&view);
+        return *this;
+    };
+
+
+    template <typename T, size_t rank, typename Allocator>
+    SingleArrayLazyAllocationBase<T, rank, Allocator>::SingleArrayLazyAllocationBase(SingleArrayLazyAllocationBase &&other) noexcept
+        : data(std::move(other.data)),
+          size(other.size),
+          range(other.range),
+          dims(other.dims),
+          allocDims(other.allocDims),
+          bufSize(other.bufSize),
+          avgSize(other.avgSize),
+          avgVar(other.avgVar),
+          r(other.r),
+          view(this, &notifyView)
+    {
+        if (this->data) this->data->replace(&other.view, &view);
+        other.resetSizeInfo();
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    SingleArrayLazyAllocationBase<T, rank, Allocator> &
+        SingleArrayLazyAllocationBase<T, rank, Allocator>::operator=(SingleArrayLazyAllocationBase &&other) noexcept
+    {
+        if (this == &other) return *this;
+        if (this->data) this->data->detach(&view);
+        this->data = std::move(other.data);
+        this->size = other.size;
+        this->range = other.range;
+        this->dims = other.dims;
+        this->allocDims = other.allocDims;
+        this->bufSize = other.bufSize;
+        this->avgSize = other.avgSize;
+        this->avgVar = other.avgVar;
+        this->r = other.r;
+        if (this->data) this->data->replace(&other.view, &view);
+        other.resetSizeInfo();
+        return *this;
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    SingleArrayLazyAllocationBase<T, rank, Allocator>::~SingleArrayLazyAllocationBase()
+    {
+        if (this->data) this->data->detach(&view);
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayLazyAllocationBase<T, rank, Allocator>::onUpdate(const UpdaterType &updater)
+    {
+        this->updater = updater;
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayLazyAllocationBase<T, rank, Allocator>::notifyView(void *owner, const SizeInfo &sizeInfo)
+    {
+        static_cast<SingleArrayLazyAllocationBase*>(owner)->updateSizeInfo(sizeInfo);
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayLazyAllocationBase<T, rank, Allocator>::ensureData()
+    {
+        if (this->data) return;
+        this->data = std::make_shared<DataType>();
+        this->data->attach(&view);
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayLazyAllocationBase<T, rank, Allocator>::resetSizeInfo()
+    {
+        size = 0;
+        range = RangeType{IndexType(0), IndexType(-1)};
+        dims = IndexType(0);
+        allocDims = IndexType(0);
+        bufSize = 0;
+        avgSize = 0.0;
+        avgVar = 0.0;
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayLazyAllocationBase<T, rank, Allocator>::updateSizeInfo(const SizeInfo &sizeInfo) {
+        size = 1;
+        range = RangeType{sizeInfo.lo, sizeInfo.hi};
+
+        for (size_t d = 0; d < rank; ++d)
+        {
+            dims[d] = sizeInfo.hi[d] - sizeInfo.lo[d] + 1;
+            size *= dims[d];
+        }
+        allocDims = dims;
+        bufSize = sizeInfo.bufSize;
         avgSize = sizeInfo.avgSize;
         avgVar = sizeInfo.avgVar;
 
@@ -441,9 +1134,10 @@ namespace schnek
         }
     }
 
-    template <typename T, size_t rank>
-    void SingleArrayLazyAllocation<T, rank>::resizeImpl(const IndexType &lo, const IndexType &hi)
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayLazyAllocationBase<T, rank, Allocator>::resizeImpl(const IndexType &lo, const IndexType &hi)
     {
+        this->ensureData();
         size_t newSize = 1;
         range = RangeType{lo, hi};
 
@@ -452,6 +1146,7 @@ namespace schnek
             dims[d] = hi[d] - lo[d] + 1;
             newSize *= dims[d];
         }
+        allocDims = dims;
 
         avgSize = r * newSize + (1 - r) * avgSize;
         ptrdiff_t diff = newSize - avgSize;
@@ -466,21 +1161,58 @@ namespace schnek
         this->data->update(SizeInfo{lo, hi, size, bufSize, avgSize, avgVar});
     }
 
-    template <typename T, size_t rank>
-    void SingleArrayLazyAllocation<T, rank>::deleteData()
+    template <typename T, size_t rank, typename Allocator>
+    template <class Copy>
+    void SingleArrayLazyAllocationBase<T, rank, Allocator>::resizePreserveImpl(
+        const IndexType &lo,
+        const IndexType &hi,
+        Copy copy
+    )
     {
-        SCHNEK_TRACE_LOG(5, "Deleting pointer (" << (void *)data << "): size=" << size << " avgSize=" << avgSize << " avgVar=" << avgVar << " bufSize=" << bufSize);
-        if (data->ptr)
+        this->ensureData();
+        size_t newSize = 1;
+        range = RangeType{lo, hi};
+
+        for (size_t d = 0; d < rank; d++)
         {
-            delete[] data->ptr;
+            dims[d] = hi[d] - lo[d] + 1;
+            newSize *= dims[d];
+        }
+        allocDims = dims;
+
+        avgSize = r * newSize + (1 - r) * avgSize;
+        ptrdiff_t diff = newSize - avgSize;
+        avgVar = r * diff * diff + (1 - r) * avgVar;
+
+        if ((newSize > bufSize) || (((newSize + 32.0 * sqrt(avgVar)) < bufSize) && (bufSize > 100)))
+        {
+            bufSize = newSize + (size_t)(4 * sqrt(avgVar));
+            if (bufSize <= 0)
+            {
+                bufSize = 10;
+            }
+            data->reallocate(bufSize, copy);
         }
-        data->ptr = NULL;
+        else if (data->ptr)
+        {
+            // the buffer is large enough, move the data in place
+            copy(data->ptr, data->ptr);
+        }
+        size = newSize;
+        this->data->update(SizeInfo{lo, hi, size, bufSize, avgSize, avgVar});
+    }
+
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayLazyAllocationBase<T, rank, Allocator>::deleteData()
+    {
+        SCHNEK_TRACE_LOG(5, "Deleting pointer (" << (void *)data << "): size=" << size << " avgSize=" << avgSize << " avgVar=" << avgVar << " bufSize=" << bufSize);
+        data->deallocate();
         size = 0;
         bufSize = 0;
     }
 
-    template <typename T, size_t rank>
-    void SingleArrayLazyAllocation<T, rank>::newData(
+    template <typename T, size_t rank, typename Allocator>
+    void SingleArrayLazyAllocationBase<T, rank, Allocator>::newData(
         size_t newSize)
     {
         bufSize = newSize + (size_t)(4 * sqrt(avgVar));
@@ -488,7 +1220,293 @@ namespace schnek
         {
             bufSize = 10;
         }
-        data->ptr = new T[bufSize];
+        data->allocate(bufSize);
+    }
+
+    //=================================================================
+    //================= SingleArrayPaddedAllocation ===================
+    //=================================================================
+
+    template <typename T, size_t rank, size_t alignment, size_t paddedDim, typename Allocator>
+    SingleArrayPaddedAllocation<T, rank, alignment, paddedDim, Allocator>::SingleArrayPaddedAllocation()
+        : data(new DataType()), size(0), view(this, &notifyView)
+    {
+        this->data->attach(&view); 
+    }
+
+    template <typename T, size_t rank, size_t alignment, size_t paddedDim, typename Allocator>
+    SingleArrayPaddedAllocation<T, rank, alignment, paddedDim, Allocator>::SingleArrayPaddedAllocation(
+        const SingleArrayPaddedAllocation &other
+    )
+        : data(other.data), size(other.size), range(other.range), dims(other.dims), allocDims(other.allocDims),
+          view(this, &notifyView)
+    {
+        if (this->data) this->data->attach(&view); 
+    }
+
+    template <typename T, size_t rank, size_t alignment, size_t paddedDim, typename Allocator>
+    SingleArrayPaddedAllocation<T, rank, alignment, paddedDim, Allocator> &
+        SingleArrayPaddedAllocation<T, rank, alignment, paddedDim, Allocator>::operator=(const SingleArrayPaddedAllocation &other) 
+    {
+        if (this == &other) return *this;
+        if (this->data) this->data->detach(&view);
+        this->data = other.data;
+        this->size = other.size;
+        this->range = other.range;
+        this->dims = other.dims;
+        this->allocDims = other.allocDims;
+        if (this->data) this->data->attach(&view);
+        return *this;
+    }
+
+    template <typename T, size_t rank, size_t alignment, size_t paddedDim, typename Allocator>
+    SingleArrayPaddedAllocation<T, rank, alignment, paddedDim, Allocator>::SingleArrayPaddedAllocation(SingleArrayPaddedAllocation &&other) noexcept
+        : data(std::move(other.data)), size(other.size), range(other.range), dims(other.dims), allocDims(other.allocDims),
+          view(this, &notifyView)
+    {
+        if (this->data) this->data->replace(&other.view, &view);
+        other.resetSizeInfo();
+    }
+
+    template <typename T, size_t rank, size_t alignment, size_t paddedDim, typename Allocator>
+    SingleArrayPaddedAllocation<T, rank, alignment, paddedDim, Allocator> &
+        SingleArrayPaddedAllocation<T, rank, alignment, paddedDim, Allocator>::operator=(SingleArrayPaddedAllocation &&other) noexcept
+    {
+        if (this == &other) return *this;
+        if (this->data) this->data->detach(&view);
+        this->data = std::move(other.data);
+        this->size = other.size;
+        this->range = other.range;
+        this->dims = other.dims;
+        this->allocDims = other.allocDims;
+        if (this->data) this->data->replace(&other.view, &view);
+        other.resetSizeInfo();
+        return *this;
+    }
+
+    template <typename T, size_t rank, size_t alignment, size_t paddedDim, typename Allocator>
+    SingleArrayPaddedAllocation<T, rank, alignment, paddedDim, Allocator>::~SingleArrayPaddedAllocation()
+    {
+        if (this->data) this->data->detach(&view);
+    }
+
+    template <typename T, size_t rank, size_t alignment, size_t paddedDim, typename Allocator>
+    void SingleArrayPaddedAllocation<T, rank, alignment, paddedDim, Allocator>::onUpdate(const UpdaterType &updater)
+    {
+        this->updater = updater;
+    }
+
+    template <typename T, size_t rank, size_t alignment, size_t paddedDim, typename Allocator>
+    void SingleArrayPaddedAllocation<T, rank, alignment, paddedDim, Allocator>::notifyView(void *owner, const SizeInfo &sizeInfo)
+    {
+        static_cast<SingleArrayPaddedAllocation*>(owner)->updateSizeInfo(sizeInfo);
+    }
+
+    template <typename T, size_t rank, size_t alignment, size_t paddedDim, typename Allocator>
+    void SingleArrayPaddedAllocation<T, rank, alignment, paddedDim, Allocator>::ensureData()
+    {
+        if (this->data) return;
+        this->data = std::make_shared<DataType>();
+        this->data->attach(&view);
+    }
+
+    template <typename T, size_t rank, size_t alignment, size_t paddedDim, typename Allocator>
+    void SingleArrayPaddedAllocation<T, rank, alignment, paddedDim, Allocator>::resetSizeInfo()
+    {
+        size = 0;
+        range = RangeType{IndexType(0), IndexType(-1)};
+        dims = IndexType(0);
+        allocDims = IndexType(0);
+    }
+
+    template <typename T, size_t rank, size_t alignment, size_t paddedDim, typename Allocator>
+    void SingleArrayPaddedAllocation<T, rank, alignment, paddedDim, Allocator>::updateSizeInfo(const SizeInfo &sizeInfo) {
+        setSize(sizeInfo.lo, sizeInfo.hi);
+
+        if (updater) {
+            updater();
+        }
+    }
+
+    template <typename T, size_t rank, size_t alignment, size_t paddedDim, typename Allocator>
+    void SingleArrayPaddedAllocation<T, rank, alignment, paddedDim, Allocator>::resizeImpl(const IndexType &lo, const IndexType &hi)
+    {
+        this->ensureData();
+        data->deallocate();
+        setSize(lo, hi);
+        data->allocate(size);
+        data->update(SizeInfo{lo, hi});
+    }
+
+    template <typename T, size_t rank, size_t alignment, size_t paddedDim, typename Allocator>
+    template <class Copy>
+    void SingleArrayPaddedAllocation<T, rank, alignment, paddedDim, Allocator>::resizePreserveImpl(
+        const IndexType &lo,
+        const IndexType &hi,
+        Copy copy
+    )
+    {
+        this->ensureData();
+        setSize(lo, hi);
+        data->reallocate(size, copy);
+        data->update(SizeInfo{lo, hi});
+    }
+
+    template <typename T, size_t rank, size_t alignment, size_t paddedDim, typename Allocator>
+    void SingleArrayPaddedAllocation<T, rank, alignment, paddedDim, Allocator>::setSize(
+        const IndexType &lo,
+        const IndexType &hi
+    )
+    {
+        // the smallest number of elements whose size is a multiple of the alignment
+        constexpr size_t padStep = alignment / std::gcd(alignment, sizeof(T));
+
+        size = 1;
+        range = RangeType{lo, hi};
+
+        for (size_t d = 0; d < rank; ++d)
+        {
+            dims[d] = hi[d] - lo[d] + 1;
+            allocDims[d] = dims[d];
+        }
+        allocDims[paddedDim] = padStep * ((dims[paddedDim] + padStep - 1) / padStep);
+
+        for (size_t d = 0; d < rank; ++d)
+        {
+            size *= allocDims[d];
+        }
+    }
+
+    //=================================================================
+    //================ SingleArrayRoundedAllocation ===================
+    //=================================================================
+
+    template <typename T, size_t rank, class Rounding, typename Allocator>
+    SingleArrayRoundedAllocation<T, rank, Rounding, Allocator>::SingleArrayRoundedAllocation()
+        : data(new DataType()), size(0), view(this, &notifyView)
+    {
+        this->data->attach(&view);
+    }
+
+    template <typename T, size_t rank, class Rounding, typename Allocator>
+    SingleArrayRoundedAllocation<T, rank, Rounding, Allocator>::SingleArrayRoundedAllocation(
+        const SingleArrayRoundedAllocation &other
+    )
+        : data(other.data), size(other.size), range(other.range), dims(other.dims), allocDims(other.allocDims),
+          view(this, &notifyView)
+    {
+        if (this->data) this->data->attach(&view);
+    }
+
+    template <typename T, size_t rank, class Rounding, typename Allocator>
+    SingleArrayRoundedAllocation<T, rank, Rounding, Allocator> &
+        SingleArrayRoundedAllocation<T, rank, Rounding, Allocator>::operator=(const SingleArrayRoundedAllocation &other)
+    {
+        if (this == &other) return *this;
+        if (this->data) this->data->detach(&view);
+        this->data = other.data;
+        this->size = other.size;
+        this->range = other.range;
+        this->dims = other.dims;
+        this->allocDims = other.allocDims;
+        if (this->data) this->data->attach(&view);
+        return *this;
+    }
+
+    template <typename T, size_t rank, class Rounding, typename Allocator>
+    SingleArrayRoundedAllocation<T, rank, Rounding, Allocator>::SingleArrayRoundedAllocation(SingleArrayRoundedAllocation &&other) noexcept
+        : data(std::move(other.data)), size(other.size), range(other.range), dims(other.dims), allocDims(other.allocDims),
+          view(this, &notifyView)
+    {
+        if (this->data) this->data->replace(&other.view, &view);
+        other.resetSizeInfo();
+    }
+
+    template <typename T, size_t rank, class Rounding, typename Allocator>
+    SingleArrayRoundedAllocation<T, rank, Rounding, Allocator> &
+        SingleArrayRoundedAllocation<T, rank, Rounding, Allocator>::operator=(SingleArrayRoundedAllocation &&other) noexcept
+    {
+        if (this == &other) return *this;
+        if (this->data) this->data->detach(&view);
+        this->data = std::move(other.data);
+        this->size = other.size;
+        this->range = other.range;
+        this->dims = other.dims;
+        this->allocDims = other.allocDims;
+        if (this->data) this->data->replace(&other.view, &view);
+        other.resetSizeInfo();
+        return *this;
+    }
+
+    template <typename T, size_t rank, class Rounding, typename Allocator>
+    SingleArrayRoundedAllocation<T, rank, Rounding, Allocator>::~SingleArrayRoundedAllocation()
+    {
+        if (this->data) this->data->detach(&view);
+    }
+
+    template <typename T, size_t rank, class Rounding, typename Allocator>
+    void SingleArrayRoundedAllocation<T, rank, Rounding, Allocator>::onUpdate(const UpdaterType &updater)
+    {
+        this->updater = updater;
+    }
+
+    template <typename T, size_t rank, class Rounding, typename Allocator>
+    void SingleArrayRoundedAllocation<T, rank, Rounding, Allocator>::notifyView(void *owner, const SizeInfo &sizeInfo)
+    {
+        static_cast<SingleArrayRoundedAllocation*>(owner)->updateSizeInfo(sizeInfo);
+    }
+
+    template <typename T, size_t rank, class Rounding, typename Allocator>
+    void SingleArrayRoundedAllocation<T, rank, Rounding, Allocator>::ensureData()
+    {
+        if (this->data) return;
+        this->data = std::make_shared<DataType>();
+        this->data->attach(&view);
+    }
+
+    template <typename T, size_t rank, class Rounding, typename Allocator>
+    void SingleArrayRoundedAllocation<T, rank, Rounding, Allocator>::resetSizeInfo()
+    {
+        size = 0;
+        range = RangeType{IndexType(0), IndexType(-1)};
+        dims = IndexType(0);
+        allocDims = IndexType(0);
+    }
+
+    template <typename T, size_t rank, class Rounding, typename Allocator>
+    void SingleArrayRoundedAllocation<T, rank, Rounding, Allocator>::updateSizeInfo(const SizeInfo &sizeInfo) {
+        setSize(sizeInfo.lo, sizeInfo.hi);
+
+        if (updater) {
+            updater();
+        }
+    }
+
+    template <typename T, size_t rank, class Rounding, typename Allocator>
+    void SingleArrayRoundedAllocation<T, rank, Rounding, Allocator>::resizeImpl(const IndexType &lo, const IndexType &hi)
+    {
+        this->ensureData();
+        data->deallocate();
+        setSize(lo, hi);
+        data->allocate(size);
+        data->update(SizeInfo{lo, hi});
+    }
+
+    template <typename T, size_t rank, class Rounding, typename Allocator>
+    void SingleArrayRoundedAllocation<T, rank, Rounding, Allocator>::setSize(
+        const IndexType &lo,
+        const IndexType &hi
+    )
+    {
+        size = 1;
+        range = RangeType{lo, hi};
+
+        for (size_t d = 0; d < rank; ++d)
+        {
+            dims[d] = hi[d] - lo[d] + 1;
+            allocDims[d] = Rounding::round(d, dims[d]);
+            size *= allocDims[d];
+        }
     }
 }
 
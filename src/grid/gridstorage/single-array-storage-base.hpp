@@ -28,12 +28,126 @@
 #define SCHNEK_GRID_GRIDSTORAGE_SINGLESTORAGEBASE_HPP_
 
 #include "../array.hpp"
+#include "../iteration/range-iteration.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
 
 namespace schnek
 {
+    namespace internal {
+        /**
+         * @brief Copy a hyperslab between two arrays holding grids of different extent
+         *
+         * The hyperslab is copied in rows along `innerDim`, which must have unit stride in
+         * both arrays. Both arrays must order the other dimensions in the same way.
+         * `src` and `dst` may point to the same array. Rows that move towards the start
+         * of the array are then copied first, in memory order, and rows that move towards
+         * the end are copied afterwards, in reverse order. This way no row is overwritten
+         * before it has been copied.
+         *
+         * @param src The source array
+         * @param srcStride The strides of the source array
+         * @param srcLo The grid index of the first element of the source array
+         * @param dst The destination array
+         * @param dstStride The strides of the destination array
+         * @param dstLo The grid index of the first element of the destination array
+         * @param slab The grid indices to copy
+         * @param innerDim The dimension with unit stride
+         */
+        template <typename T, size_t rank>
+        void copyHyperslab(
+            const T *src,
+            const Array<ptrdiff_t, rank> &srcStride,
+            const Array<int, rank> &srcLo,
+            T *dst,
+            const Array<ptrdiff_t, rank> &dstStride,
+            const Array<int, rank> &dstLo,
+            const Range<int, rank> &slab,
+            size_t innerDim
+        )
+        {
+            const ptrdiff_t rowLength = slab.getHi(innerDim) - slab.getLo(innerDim) + 1;
+            if (rowLength <= 0) return;
+
+            // the outer dimensions, from the slowest to the fastest running
+            std::array<size_t, rank> order;
+            size_t numOuter = 0;
+            size_t numRows = 1;
+            for (size_t d = 0; d < rank; ++d)
+            {
+                if (d == innerDim) continue;
+                const int extent = slab.getHi(d) - slab.getLo(d) + 1;
+                if (extent <= 0) return;
+                numRows *= extent;
+                order[numOuter++] = d;
+            }
+            std::sort(order.begin(), order.begin() + numOuter,
+                      [&srcStride](size_t a, size_t b) { return srcStride[a] > srcStride[b]; });
+
+            auto offsets = [&](size_t row, ptrdiff_t &srcOffset, ptrdiff_t &dstOffset)
+            {
+                Array<int, rank> index = slab.getLo();
+                for (size_t k = numOuter; k-- > 0;)
+                {
+                    const size_t d = order[k];
+                    const size_t extent = slab.getHi(d) - slab.getLo(d) + 1;
+                    index[d] += row % extent;
+                    row /= extent;
+                }
+                srcOffset = 0;
+                dstOffset = 0;
+                for (size_t d = 0; d < rank; ++d)
+                {
+                    srcOffset += (index[d] - srcLo[d]) * srcStride[d];
+                    dstOffset += (index[d] - dstLo[d]) * dstStride[d];
+                }
+            };
+
+            const bool inPlace = (src == dst);
+            ptrdiff_t srcOffset, dstOffset;
+            for (size_t row = 0; row < numRows; ++row)
+            {
+                offsets(row, srcOffset, dstOffset);
+                if (!inPlace || (dstOffset < srcOffset))
+                {
+                    std::copy(src + srcOffset, src + srcOffset + rowLength, dst + dstOffset);
+                }
+            }
+
+            if (!inPlace) return;
+            for (size_t row = numRows; row-- > 0;)
+            {
+                offsets(row, srcOffset, dstOffset);
+                if (dstOffset > srcOffset)
+                {
+                    std::copy_backward(src + srcOffset, src + srcOffset + rowLength, dst + dstOffset + rowLength);
+                }
+            }
+        }
+
+        /// The intersection of two ranges, empty if the ranges do not overlap
+        template <size_t rank>
+        Range<int, rank> intersectRanges(const Range<int, rank> &a, const Range<int, rank> &b)
+        {
+            Array<int, rank> lo, hi;
+            for (size_t d = 0; d < rank; ++d)
+            {
+                lo[d] = std::max(a.getLo(d), b.getLo(d));
+                hi[d] = std::min(a.getHi(d), b.getHi(d));
+            }
+            return Range<int, rank>(lo, hi);
+        }
+    }
+
     /**
      * @brief The storage base extends from an allocation policy and adds some accessor methods
      * 
+     * The allocation policy provides the dimensions of the grid, `dims`, and the dimensions 
+     * of the allocated array, `allocDims`. The latter are used for indexing and may be larger 
+     * than `dims` if the allocation policy pads the array.
+     * 
      * @tparam T The type of data stored in the grid
      * @tparam rank The rank of the grid
      * @tparam AllocationPolicy The allocation policy
@@ -61,8 +175,31 @@ namespace schnek
             const SingleArrayGridStorageBase<T, rank, AllocationPolicy>&
         ) = default;
 
-        /// Access to the underlying raw data
-        T *getRawData() const { return this->data->ptr; }
+        /**
+         * @brief Move constructor
+         *
+         * The moved-from storage is left empty. Copies of the moved-from storage now share
+         * the data with the new storage.
+         */
+        SingleArrayGridStorageBase(SingleArrayGridStorageBase&&) = default;
+
+        /**
+         * @brief Move assignment operator
+         */
+        SingleArrayGridStorageBase<T, rank, AllocationPolicy> &operator=(
+            SingleArrayGridStorageBase<T, rank, AllocationPolicy>&&
+        ) = default;
+
+        /// Access to the underlying raw data, NULL if the storage has been moved from
+        T *getRawData() const { return this->data ? this->data->ptr : NULL; }
+
+        /**
+         * @brief The number of resizes of the data shared with the copies of this storage
+         *
+         * Code that caches information derived from the grid can store this number and
+         * compare it later to find out whether any of the copies has been resized since.
+         */
+        size_t getGeneration() const { return this->data ? this->data->getGeneration() : 0; }
 
         /// Get the lowest coordinate in the grid (inclusive)
         SCHNEK_INLINE const IndexType &getLo() const { return this->range.getLo(); }
@@ -86,16 +223,16 @@ namespace schnek
         SCHNEK_INLINE int getDims(int k) const { return this->dims[k]; }
 
         /// Get the length of the allocated array
-        SCHNEK_INLINE int getSize() const { return this->size; }
+        SCHNEK_INLINE size_t getSize() const { return this->size; }
 
         typedef T* storage_iterator;
         typedef const T* const_storage_iterator;
 
-        SCHNEK_INLINE storage_iterator begin() { return this->data->ptr; }
-        SCHNEK_INLINE storage_iterator end() { return this->data->ptr + this->size; }
+        SCHNEK_INLINE storage_iterator begin() { return getRawData(); }
+        SCHNEK_INLINE storage_iterator end() { return getRawData() + this->size; }
 
-        SCHNEK_INLINE const_storage_iterator cbegin() const { return this->data->ptr; }
-        SCHNEK_INLINE const_storage_iterator cend() const { return this->data->ptr + this->size; }
+        SCHNEK_INLINE const_storage_iterator cbegin() const { return getRawData(); }
+        SCHNEK_INLINE const_storage_iterator cend() const { return getRawData() + this->size; }
     };
 
     /**
@@ -122,6 +259,9 @@ namespace schnek
         /// The grid index type
         typedef typename BaseType::RangeType RangeType;
 
+        /// The iteration policy that visits the grid in storage order
+        typedef RangeCIterationPolicy<rank> IterationPolicy;
+
         /// Default constructor
         SingleArrayGridCOrderStorageBase();
 
@@ -150,6 +290,16 @@ namespace schnek
             const SingleArrayGridCOrderStorageBase<T, rank, AllocationPolicy> &
         ) = default;
 
+        /// Move constructor, the moved-from storage is left empty
+        SingleArrayGridCOrderStorageBase(SingleArrayGridCOrderStorageBase &&) noexcept;
+
+        /**
+         * @brief Move assignment operator
+         */
+        SingleArrayGridCOrderStorageBase<T, rank, AllocationPolicy> &operator=(
+            SingleArrayGridCOrderStorageBase<T, rank, AllocationPolicy> &&
+        ) noexcept;
+
         /**
          * @brief Get the lvalue at a given grid index
          * 
@@ -178,11 +328,28 @@ namespace schnek
          */
         void resize(const RangeType range);
 
+        /**
+         * @brief resizes the grid and keeps the values in the overlap of the old and new grid
+         *
+         * The array is reallocated once and the overlap is copied in contiguous rows.
+         * The values of grid points outside the old grid are undefined, as after `resize()`.
+         * All copies of the grid see the resized grid with the preserved values.
+         */
+        void resizePreserve(const IndexType &low, const IndexType &high);
+
+        /**
+         * @brief resizes the grid and keeps the values in the overlap of the old and new grid
+         */
+        void resizePreserve(const RangeType range);
+
         /**
          * @brief returns the stride of the specified dimension 
          */
         ptrdiff_t stride(size_t dim) const;
     private:
+        /// The strides of all dimensions
+        Array<ptrdiff_t, rank> strides() const;
+
         /**
          * @brief Update the data_fast pointer offset to the origin for faster access
          * 
@@ -221,6 +388,9 @@ namespace schnek
         /// The grid index type
         typedef typename BaseType::RangeType RangeType;
 
+        /// The iteration policy that visits the grid in storage order
+        typedef RangeFortranIterationPolicy<rank> IterationPolicy;
+
         /// Default constructor
         SingleArrayGridFortranOrderStorageBase();
 
@@ -249,6 +419,16 @@ namespace schnek
             const SingleArrayGridFortranOrderStorageBase<T, rank, AllocationPolicy> &
         ) = default;
 
+        /// Move constructor, the moved-from storage is left empty
+        SingleArrayGridFortranOrderStorageBase(SingleArrayGridFortranOrderStorageBase &&) noexcept;
+
+        /**
+         * @brief Move assignment operator
+         */
+        SingleArrayGridFortranOrderStorageBase<T, rank, AllocationPolicy> &operator=(
+            SingleArrayGridFortranOrderStorageBase<T, rank, AllocationPolicy> &&
+        ) noexcept;
+
         /**
          * @brief Get the lvalue at a given grid index
          * 
@@ -277,11 +457,26 @@ namespace schnek
          */
         void resize(const RangeType range);
 
+        /**
+         * @brief resizes the grid and keeps the values in the overlap of the old and new grid
+         *
+         * See SingleArrayGridCOrderStorageBase::resizePreserve()
+         */
+        void resizePreserve(const IndexType &low, const IndexType &high);
+
+        /**
+         * @brief resizes the grid and keeps the values in the overlap of the old and new grid
+         */
+        void resizePreserve(const RangeType range);
+
         /**
          * @brief returns the stride of the specified dimension 
          */
         ptrdiff_t stride(size_t dim) const;  
     private:
+        /// The strides of all dimensions
+        Array<ptrdiff_t, rank> strides() const;
+
         void updateDataFast();  
     };
 
@@ -313,6 +508,26 @@ namespace schnek
         this->onUpdate([this](){ updateDataFast(); });
     }
 
+    template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
+    SingleArrayGridCOrderStorageBase<T, rank, AllocationPolicy>::SingleArrayGridCOrderStorageBase(SingleArrayGridCOrderStorageBase &&other) noexcept
+        : BaseType(std::move(other)), data_fast(other.data_fast)
+    {
+        this->onUpdate([this](){ updateDataFast(); });
+        other.data_fast = NULL;
+    }
+
+    template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
+    SingleArrayGridCOrderStorageBase<T, rank, AllocationPolicy> &SingleArrayGridCOrderStorageBase<T, rank, AllocationPolicy>::operator=(
+        SingleArrayGridCOrderStorageBase<T, rank, AllocationPolicy> &&other
+    ) noexcept
+    {
+        if (this == &other) return *this;
+        BaseType::operator=(std::move(other));
+        data_fast = other.data_fast;
+        other.data_fast = NULL;
+        return *this;
+    }
+
     template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
     SingleArrayGridCOrderStorageBase<T, rank, AllocationPolicy>::SingleArrayGridCOrderStorageBase(
         const IndexType &lo, 
@@ -335,10 +550,10 @@ namespace schnek
     template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
     SCHNEK_INLINE T &SingleArrayGridCOrderStorageBase<T, rank, AllocationPolicy>::get(const IndexType &index)
     {
-        size_t pos = index[0];
+        ptrdiff_t pos = index[0];
         for (size_t i = 1; i < rank; ++i)
         {
-            pos = index[i] + this->dims[i] * pos;
+            pos = index[i] + this->allocDims[i] * pos;
         }
         return this->data_fast[pos];
     }
@@ -346,10 +561,10 @@ namespace schnek
     template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
     SCHNEK_INLINE const T &SingleArrayGridCOrderStorageBase<T, rank, AllocationPolicy>::get(const IndexType &index) const
     {
-        size_t pos = index[0];
+        ptrdiff_t pos = index[0];
         for (size_t i = 1; i < rank; ++i)
         {
-            pos = index[i] + this->dims[i] * pos;
+            pos = index[i] + this->allocDims[i] * pos;
         }
         return this->data_fast[pos];
     }
@@ -362,7 +577,7 @@ namespace schnek
 
         // for (size_t d = 1; d < rank; ++d)
         // {
-        //     p = p * this->dims[d] - this->getLo(d);
+        //     p = p * this->allocDims[d] - this->getLo(d);
         // }
         // data_fast = this->data->ptr + p;
     }
@@ -373,13 +588,43 @@ namespace schnek
         this->resize(range.getLo(), range.getHi());
     }
 
+    template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
+    void SingleArrayGridCOrderStorageBase<T, rank, AllocationPolicy>::resizePreserve(const IndexType &lo, const IndexType &hi)
+    {
+        const IndexType oldLo = this->getLo();
+        const Array<ptrdiff_t, rank> oldStrides = strides();
+        const RangeType overlap = internal::intersectRanges(this->getRange(), RangeType(lo, hi));
+
+        this->resizePreserveImpl(lo, hi, [&](const T *oldPtr, T *newPtr)
+        {
+            internal::copyHyperslab(oldPtr, oldStrides, oldLo, newPtr, strides(), lo, overlap, rank - 1);
+        });
+    }
+
+    template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
+    inline void SingleArrayGridCOrderStorageBase<T, rank, AllocationPolicy>::resizePreserve(const RangeType range)
+    {
+        this->resizePreserve(range.getLo(), range.getHi());
+    }
+
+    template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
+    Array<ptrdiff_t, rank> SingleArrayGridCOrderStorageBase<T, rank, AllocationPolicy>::strides() const
+    {
+        Array<ptrdiff_t, rank> result;
+        for (size_t d = 0; d < rank; ++d)
+        {
+            result[d] = stride(d);
+        }
+        return result;
+    }
+
     template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
     inline ptrdiff_t SingleArrayGridCOrderStorageBase<T, rank, AllocationPolicy>::stride(size_t dim) const
     {
-        size_t stride = 1;
+        ptrdiff_t stride = 1;
         for (size_t i = rank - 1; i > dim; --i)
         {
-            stride *= this->dims[i];
+            stride *= this->allocDims[i];
         }
         return stride;
     }
@@ -391,7 +636,7 @@ namespace schnek
 
         for (size_t d = 1; d < rank; ++d)
         {
-            p = p * this->dims[d] - this->getLo(d);
+            p = p * this->allocDims[d] - this->getLo(d);
         }
         data_fast = this->data->ptr + p;
     }
@@ -414,6 +659,26 @@ namespace schnek
         this->onUpdate([this](){ updateDataFast(); });
     }
 
+    template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
+    SingleArrayGridFortranOrderStorageBase<T, rank, AllocationPolicy>::SingleArrayGridFortranOrderStorageBase(SingleArrayGridFortranOrderStorageBase &&other) noexcept
+        : BaseType(std::move(other)), data_fast(other.data_fast)
+    {
+        this->onUpdate([this](){ updateDataFast(); });
+        other.data_fast = NULL;
+    }
+
+    template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
+    SingleArrayGridFortranOrderStorageBase<T, rank, AllocationPolicy> &SingleArrayGridFortranOrderStorageBase<T, rank, AllocationPolicy>::operator=(
+        SingleArrayGridFortranOrderStorageBase<T, rank, AllocationPolicy> &&other
+    ) noexcept
+    {
+        if (this == &other) return *this;
+        BaseType::operator=(std::move(other));
+        data_fast = other.data_fast;
+        other.data_fast = NULL;
+        return *this;
+    }
+
     template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
     SingleArrayGridFortranOrderStorageBase<T, rank, AllocationPolicy>::SingleArrayGridFortranOrderStorageBase(
         const IndexType &lo, 
@@ -436,10 +701,10 @@ namespace schnek
     template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
     SCHNEK_INLINE T &SingleArrayGridFortranOrderStorageBase<T, rank, AllocationPolicy>::get(const IndexType &index)
     {
-        size_t pos = index[rank - 1];
+        ptrdiff_t pos = index[rank - 1];
         for (ptrdiff_t i = ptrdiff_t(rank) - 2; i >= 0; --i)
         {
-            pos = index[i] + this->dims[i] * pos;
+            pos = index[i] + this->allocDims[i] * pos;
         }
         return this->data_fast[pos];
     }
@@ -447,10 +712,10 @@ namespace schnek
     template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
     SCHNEK_INLINE const T &SingleArrayGridFortranOrderStorageBase<T, rank, AllocationPolicy>::get(const IndexType &index) const
     {
-        size_t pos = index[rank - 1];
+        ptrdiff_t pos = index[rank - 1];
         for (ptrdiff_t i = ptrdiff_t(rank) - 2; i >= 0; --i)
         {
-            pos = index[i] + this->dims[i] * pos;
+            pos = index[i] + this->allocDims[i] * pos;
         }
         return this->data_fast[pos];
     }
@@ -467,13 +732,43 @@ namespace schnek
         this->resize(range.getLo(), range.getHi());
     }
 
+    template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
+    void SingleArrayGridFortranOrderStorageBase<T, rank, AllocationPolicy>::resizePreserve(const IndexType &lo, const IndexType &hi)
+    {
+        const IndexType oldLo = this->getLo();
+        const Array<ptrdiff_t, rank> oldStrides = strides();
+        const RangeType overlap = internal::intersectRanges(this->getRange(), RangeType(lo, hi));
+
+        this->resizePreserveImpl(lo, hi, [&](const T *oldPtr, T *newPtr)
+        {
+            internal::copyHyperslab(oldPtr, oldStrides, oldLo, newPtr, strides(), lo, overlap, 0);
+        });
+    }
+
+    template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
+    inline void SingleArrayGridFortranOrderStorageBase<T, rank, AllocationPolicy>::resizePreserve(const RangeType range)
+    {
+        this->resizePreserve(range.getLo(), range.getHi());
+    }
+
+    template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
+    Array<ptrdiff_t, rank> SingleArrayGridFortranOrderStorageBase<T, rank, AllocationPolicy>::strides() const
+    {
+        Array<ptrdiff_t, rank> result;
+        for (size_t d = 0; d < rank; ++d)
+        {
+            result[d] = stride(d);
+        }
+        return result;
+    }
+
     template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
     inline ptrdiff_t SingleArrayGridFortranOrderStorageBase<T, rank, AllocationPolicy>::stride(size_t dim) const
     {
         ptrdiff_t stride = 1;
         for (size_t i = 0; i < dim; ++i)
         {
-            stride *= this->dims[i];
+            stride *= this->allocDims[i];
         }
         return stride;
     }
@@ -481,11 +776,11 @@ namespace schnek
     template <typename T, size_t rank, template <typename, size_t> class AllocationPolicy>
     void SingleArrayGridFortranOrderStorageBase<T, rank, AllocationPolicy>::updateDataFast()
     {
-        size_t p = -this->getLo(rank - 1);
+        ptrdiff_t p = -this->getLo(rank - 1);
 
         for (ptrdiff_t d = ptrdiff_t(rank) - 2; d >= 0; --d)
         {
-            p = p * this->dims[d] - this->getLo(d);
+            p = p * this->allocDims[d] - this->getLo(d);
         }
         data_fast = this->data->ptr + p;
     }
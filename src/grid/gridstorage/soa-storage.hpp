@@ -0,0 +1,496 @@
+/*
+ * soa-storage.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_GRIDSTORAGE_SOASTORAGE_HPP_
+#define SCHNEK_GRID_GRIDSTORAGE_SOASTORAGE_HPP_
+
+#include "single-array-allocation.hpp"
+#include "single-array-storage-base.hpp"
+#include "../array.hpp"
+#include "../iteration/range-iteration.hpp"
+
+#include <cstddef>
+
+namespace schnek
+{
+    namespace internal {
+        /**
+         * @brief The components of an element type stored in structure-of-arrays layout
+         *
+         * Only specialised for Array types.
+         */
+        template <typename T>
+        struct SoAComponents;
+
+        template <typename V, size_t N, template <size_t> class CheckingPolicy>
+        struct SoAComponents<Array<V, N, CheckingPolicy> >
+        {
+            /// The type of a single component
+            typedef V ComponentType;
+
+            /// The number of components
+            static constexpr size_t numComponents = N;
+        };
+
+        /// Stacks the component planes along the first dimension of the array
+        template <size_t numComponents>
+        struct SoARounding
+        {
+            static int round(size_t dim, int extent)
+            {
+                return dim == 0 ? int(numComponents) * extent : extent;
+            }
+        };
+
+        /// Binds the number of components so that the allocation can be used as an allocation policy
+        template <size_t numComponents>
+        struct SoAAllocationPolicy
+        {
+            template <typename V, size_t rank>
+            using type = SingleArrayRoundedAllocation<
+                V,
+                rank,
+                SoARounding<numComponents>,
+                AlignedArrayAllocator<V, SCHNEK_DEFAULT_ALIGNMENT>
+            >;
+        };
+
+        /**
+         * @brief A reference to an element of a grid with structure-of-arrays storage
+         *
+         * The components of the element are `numComponents` planes apart in memory. The
+         * reference behaves like an lvalue of the element type. Reading converts it to
+         * the element type and assignments write the components back to their planes.
+         * Single components can be accessed with `operator[]` without a conversion.
+         *
+         * @tparam T The element type, an Array
+         */
+        template <typename T>
+        class SoAReference
+        {
+        public:
+            typedef typename SoAComponents<T>::ComponentType ComponentType;
+            static constexpr size_t numComponents = SoAComponents<T>::numComponents;
+        private:
+            ComponentType *element;
+            ptrdiff_t planeSize;
+        public:
+            SoAReference(ComponentType *element, ptrdiff_t planeSize)
+                : element(element), planeSize(planeSize)
+            {}
+
+            SoAReference(const SoAReference &) = default;
+
+            /// The component `c` of the element
+            SCHNEK_INLINE ComponentType &operator[](size_t c) const
+            {
+                return element[c * planeSize];
+            }
+
+            /// Read the element
+            SCHNEK_INLINE operator T() const
+            {
+                T value;
+                for (size_t c = 0; c < numComponents; ++c)
+                {
+                    value[c] = element[c * planeSize];
+                }
+                return value;
+            }
+
+            /// Write the element
+            SCHNEK_INLINE SoAReference &operator=(const T &value)
+            {
+                for (size_t c = 0; c < numComponents; ++c)
+                {
+                    element[c * planeSize] = value[c];
+                }
+                return *this;
+            }
+
+            /// Copy the value of another element, not the reference
+            SCHNEK_INLINE SoAReference &operator=(const SoAReference &other)
+            {
+                return *this = T(other);
+            }
+
+            SCHNEK_INLINE SoAReference &operator+=(const SoAReference &rhs)
+            {
+                return *this += T(rhs);
+            }
+
+            template <typename Rhs>
+            SCHNEK_INLINE SoAReference &operator+=(const Rhs &rhs)
+            {
+                T value(*this);
+                value += rhs;
+                return *this = value;
+            }
+
+            SCHNEK_INLINE SoAReference &operator-=(const SoAReference &rhs)
+            {
+                return *this -= T(rhs);
+            }
+
+            template <typename Rhs>
+            SCHNEK_INLINE SoAReference &operator-=(const Rhs &rhs)
+            {
+                T value(*this);
+                value -= rhs;
+                return *this = value;
+            }
+
+            SCHNEK_INLINE SoAReference &operator*=(const SoAReference &rhs)
+            {
+                return *this *= T(rhs);
+            }
+
+            template <typename Rhs>
+            SCHNEK_INLINE SoAReference &operator*=(const Rhs &rhs)
+            {
+                T value(*this);
+                value *= rhs;
+                return *this = value;
+            }
+
+            SCHNEK_INLINE SoAReference &operator/=(const SoAReference &rhs)
+            {
+                return *this /= T(rhs);
+            }
+
+            template <typename Rhs>
+            SCHNEK_INLINE SoAReference &operator/=(const Rhs &rhs)
+            {
+                T value(*this);
+                value /= rhs;
+                return *this = value;
+            }
+        };
+
+        /**
+         * @brief Iterates over all elements of a structure-of-arrays grid in storage order
+         *
+         * @tparam T The element type, an Array
+         * @tparam Reference The type returned by dereferencing the iterator, either
+         *     SoAReference or the element type
+         */
+        template <typename T, typename Reference>
+        class SoAIterator
+        {
+        private:
+            typedef typename SoAComponents<T>::ComponentType ComponentType;
+            ComponentType *element;
+            ptrdiff_t planeSize;
+        public:
+            SoAIterator(ComponentType *element, ptrdiff_t planeSize)
+                : element(element), planeSize(planeSize)
+            {}
+
+            Reference operator*() const { return SoAReference<T>(element, planeSize); }
+
+            SoAIterator &operator++()
+            {
+                ++element;
+                return *this;
+            }
+
+            ptrdiff_t operator-(const SoAIterator &other) const { return element - other.element; }
+
+            bool operator==(const SoAIterator &other) const { return element == other.element; }
+
+            bool operator!=(const SoAIterator &other) const { return element != other.element; }
+        };
+    }
+
+    /**
+     * @brief Storage policy that stores the components of Array elements in separate planes
+     *
+     * A grid of `Array<V, N>` elements is stored as N contiguous planes of type `V`, one
+     * for each component. Within a plane, the elements are stored in C order without
+     * padding. Kernels that work on one component at a time can therefore be vectorised
+     * over contiguous memory. The pointer to each plane is available through
+     * `getComponentData()`, which can also be used to write single components to HDF5
+     * files, see HdfOStream::writeGridComponent().
+     *
+     * Because the components of an element are not adjacent in memory, `get()` returns a
+     * lightweight proxy, see internal::SoAReference. The proxy converts to `Array<V, N>`
+     * and can be assigned from it. `getRawData()` returns the start of the first plane
+     * and `getSize()` returns the number of elements in one plane.
+     *
+     * @tparam T The type of data stored in the grid, must be an Array
+     * @tparam rank The rank of the grid
+     */
+    template <typename T, size_t rank>
+    class SoAGridStorage : public SingleArrayGridStorageBase<
+        typename internal::SoAComponents<T>::ComponentType,
+        rank,
+        internal::SoAAllocationPolicy<internal::SoAComponents<T>::numComponents>::template type
+    >
+    {
+    public:
+        /// The type of a single component
+        typedef typename internal::SoAComponents<T>::ComponentType ComponentType;
+
+        /// The number of components
+        static constexpr size_t numComponents = internal::SoAComponents<T>::numComponents;
+
+        /// Base class type
+        typedef SingleArrayGridStorageBase<
+            ComponentType,
+            rank,
+            internal::SoAAllocationPolicy<numComponents>::template type
+        > BaseType;
+
+        /// The grid index type
+        typedef typename BaseType::IndexType IndexType;
+
+        /// The grid range type
+        typedef typename BaseType::RangeType RangeType;
+
+        /// The proxy returned by `get()`
+        typedef internal::SoAReference<T> reference;
+
+        /// The iteration policy that visits the grid in storage order
+        typedef RangeCIterationPolicy<rank> IterationPolicy;
+
+        typedef internal::SoAIterator<T, reference> storage_iterator;
+        typedef internal::SoAIterator<T, T> const_storage_iterator;
+    private:
+        /// The component 0 data pointer offset to the origin for faster access
+        ComponentType *data_fast;
+
+        /// The number of elements in each plane
+        ptrdiff_t planeSize;
+    public:
+        /// Default constructor
+        SoAGridStorage();
+
+        /// Copy constructor
+        SoAGridStorage(const SoAGridStorage&);
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param lo the lowest coordinate in the grid (inclusive)
+         * @param hi the highest coordinate in the grid (inclusive)
+         */
+        SoAGridStorage(const IndexType &lo, const IndexType &hi);
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param range the lowest and highest coordinates in the grid (inclusive)
+         */
+        SoAGridStorage(const RangeType &range);
+
+        /**
+         * @brief Assignment operator
+         */
+        SoAGridStorage<T, rank> &operator=(const SoAGridStorage<T, rank> &) = default;
+
+        /// Move constructor, the moved-from storage is left empty
+        SoAGridStorage(SoAGridStorage &&) noexcept;
+
+        /**
+         * @brief Move assignment operator
+         */
+        SoAGridStorage<T, rank> &operator=(SoAGridStorage<T, rank> &&) noexcept;
+
+        /**
+         * @brief Get a reference to the element at a given grid index
+         *
+         * @param index The grid index
+         * @return a proxy for the element at the grid index
+         */
+        SCHNEK_INLINE reference get(const IndexType &index);
+
+        /**
+         * @brief Get the value at a given grid index
+         *
+         * @param index The grid index
+         * @return the value at the grid index
+         */
+        SCHNEK_INLINE T get(const IndexType &index) const;
+
+        /// Get the number of elements in each component plane
+        SCHNEK_INLINE size_t getSize() const { return size_t(planeSize); }
+
+        /// Get a pointer to the first element of the plane of component `c`
+        SCHNEK_INLINE ComponentType *getComponentData(size_t c) { return this->getRawData() + c * planeSize; }
+
+        /// Get a pointer to the first element of the plane of component `c`
+        SCHNEK_INLINE const ComponentType *getComponentData(size_t c) const { return this->getRawData() + c * planeSize; }
+
+        /**
+         * @brief resizes to grid with lower indices lo[0],...,lo[rank-1]
+         * and upper indices hi[0],...,hi[rank-1]
+         */
+        void resize(const IndexType &low, const IndexType &high);
+
+        /**
+         * @brief resizes to grid with the range.
+         * The endponts of the range are inclusive
+         */
+        void resize(const RangeType range);
+
+        /**
+         * @brief returns the stride of the specified dimension within a component plane
+         */
+        ptrdiff_t stride(size_t dim) const;
+
+        SCHNEK_INLINE storage_iterator begin() { return storage_iterator(this->getRawData(), planeSize); }
+        SCHNEK_INLINE storage_iterator end() { return storage_iterator(this->getRawData() + planeSize, planeSize); }
+
+        SCHNEK_INLINE const_storage_iterator cbegin() const { return const_storage_iterator(this->getRawData(), planeSize); }
+        SCHNEK_INLINE const_storage_iterator cend() const
+        {
+            return const_storage_iterator(this->getRawData() + planeSize, planeSize);
+        }
+    private:
+        /// The position of a grid index relative to data_fast
+        SCHNEK_INLINE ptrdiff_t position(const IndexType &index) const;
+
+        /**
+         * @brief Update the data_fast pointer and the plane size
+         *
+         * This method is called indirectly when a resize is performed on any of the copies of the
+         * grid.
+         */
+        void updateDataFast();
+    };
+
+    //=================================================================
+    //======================= SoAGridStorage ==========================
+    //=================================================================
+
+    template <typename T, size_t rank>
+    SoAGridStorage<T, rank>::SoAGridStorage()
+        : BaseType(), data_fast(NULL), planeSize(0)
+    {
+        this->onUpdate([this](){ updateDataFast(); });
+    }
+
+    template <typename T, size_t rank>
+    SoAGridStorage<T, rank>::SoAGridStorage(const SoAGridStorage &other)
+        : BaseType(other), data_fast(other.data_fast), planeSize(other.planeSize)
+    {
+        this->onUpdate([this](){ updateDataFast(); });
+    }
+
+    template <typename T, size_t rank>
+    SoAGridStorage<T, rank>::SoAGridStorage(SoAGridStorage &&other) noexcept
+        : BaseType(std::move(other)), data_fast(other.data_fast), planeSize(other.planeSize)
+    {
+        this->onUpdate([this](){ updateDataFast(); });
+        other.data_fast = NULL;
+        other.planeSize = 0;
+    }
+
+    template <typename T, size_t rank>
+    SoAGridStorage<T, rank> &SoAGridStorage<T, rank>::operator=(SoAGridStorage<T, rank> &&other) noexcept
+    {
+        if (this == &other) return *this;
+        BaseType::operator=(std::move(other));
+        data_fast = other.data_fast;
+        planeSize = other.planeSize;
+        other.data_fast = NULL;
+        other.planeSize = 0;
+        return *this;
+    }
+
+    template <typename T, size_t rank>
+    SoAGridStorage<T, rank>::SoAGridStorage(
+        const IndexType &lo,
+        const IndexType &hi
+    ) : BaseType(), data_fast(NULL), planeSize(0)
+    {
+        this->onUpdate([this](){ updateDataFast(); });
+        resize(lo, hi);
+    }
+
+    template <typename T, size_t rank>
+    SoAGridStorage<T, rank>::SoAGridStorage(
+        const RangeType &range
+    ) : BaseType(), data_fast(NULL), planeSize(0)
+    {
+        this->onUpdate([this](){ updateDataFast(); });
+        resize(range.getLo(), range.getHi());
+    }
+
+    template <typename T, size_t rank>
+    SCHNEK_INLINE ptrdiff_t SoAGridStorage<T, rank>::position(const IndexType &index) const
+    {
+        ptrdiff_t pos = index[0];
+        for (size_t i = 1; i < rank; ++i)
+        {
+            pos = index[i] + this->dims[i] * pos;
+        }
+        return pos;
+    }
+
+    template <typename T, size_t rank>
+    SCHNEK_INLINE typename SoAGridStorage<T, rank>::reference SoAGridStorage<T, rank>::get(const IndexType &index)
+    {
+        return reference(data_fast + position(index), planeSize);
+    }
+
+    template <typename T, size_t rank>
+    SCHNEK_INLINE T SoAGridStorage<T, rank>::get(const IndexType &index) const
+    {
+        return reference(data_fast + position(index), planeSize);
+    }
+
+    template <typename T, size_t rank>
+    inline void SoAGridStorage<T, rank>::resize(const IndexType &lo, const IndexType &hi)
+    {
+        this->resizeImpl(lo, hi);
+    }
+
+    template <typename T, size_t rank>
+    inline void SoAGridStorage<T, rank>::resize(const RangeType range)
+    {
+        this->resize(range.getLo(), range.getHi());
+    }
+
+    template <typename T, size_t rank>
+    inline ptrdiff_t SoAGridStorage<T, rank>::stride(size_t dim) const
+    {
+        ptrdiff_t stride = 1;
+        for (size_t i = rank - 1; i > dim; --i)
+        {
+            stride *= this->dims[i];
+        }
+        return stride;
+    }
+
+    template <typename T, size_t rank>
+    void SoAGridStorage<T, rank>::updateDataFast()
+    {
+        planeSize = ptrdiff_t(this->size / numComponents);
+        data_fast = this->data->ptr - position(this->range.getLo());
+    }
+}
+
+#endif // SCHNEK_GRID_GRIDSTORAGE_SOASTORAGE_HPP_
@@ -0,0 +1,784 @@
+/*
+ * sparse-storage.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_GRIDSTORAGE_SPARSESTORAGE_HPP_
+#define SCHNEK_GRID_GRIDSTORAGE_SPARSESTORAGE_HPP_
+
+#include "shared-view-list.hpp"
+#include "../array.hpp"
+#include "../range.hpp"
+#include "../gridtile.hpp"
+#include "../iteration/sparse-iteration.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace schnek
+{
+    namespace internal {
+        /**
+         * @brief The tiles of a block-sparse grid, shared by all copies of the grid
+         *
+         * The table holds one pointer per tile, NULL for tiles that have not been
+         * allocated. Allocated tiles are filled with the background value.
+         *
+         * Tiles are published with a compare-and-swap, so that different threads may write
+         * to the grid concurrently, even when they allocate the same tile. Resetting the
+         * table and releasing tiles must not run concurrently with other accesses.
+         *
+         * @tparam T The type of data stored in the grid
+         * @tparam SizeInfo The size information passed on a resize
+         */
+        template <typename T, typename SizeInfo>
+        class SparseTileData
+        {
+        public:
+            typedef SharedView<SizeInfo> ViewType;
+        private:
+            SharedViewList<SizeInfo> views;
+        public:
+            /// The tile table, indexed by the position of the tile in C order
+            std::vector<std::atomic<T*> > tiles;
+
+            /// The number of elements in a tile
+            size_t tileVolume;
+
+            /// The number of allocated tiles
+            std::atomic<size_t> numAllocated;
+
+            /// The value of all grid points in tiles that have not been allocated
+            T background;
+
+            SparseTileData(size_t tileVolume)
+                : tileVolume(tileVolume), numAllocated(0), background()
+            {}
+
+            SparseTileData(const SparseTileData &) = delete;
+            SparseTileData &operator=(const SparseTileData &) = delete;
+
+            ~SparseTileData() { reset(0); }
+
+            /// Free all tiles and resize the table to `numTiles` empty tiles
+            void reset(size_t numTiles)
+            {
+                for (std::atomic<T*> &tile : tiles) delete[] tile.load(std::memory_order_relaxed);
+                std::vector<std::atomic<T*> > empty(numTiles);
+                for (std::atomic<T*> &tile : empty) tile.store(NULL, std::memory_order_relaxed);
+                tiles.swap(empty);
+                numAllocated.store(0, std::memory_order_relaxed);
+            }
+
+            /// The tile at a position in the table, NULL if it has not been allocated
+            SCHNEK_INLINE T *getTile(size_t tile) const
+            {
+                return tiles[tile].load(std::memory_order_acquire);
+            }
+
+            /**
+             * @brief Allocate a tile filled with the background value
+             *
+             * If another thread has allocated the tile in the meantime, the new tile is
+             * freed again and the tile of the other thread is returned.
+             */
+            T *allocateTile(size_t tile)
+            {
+                T *ptr = new T[tileVolume];
+                std::fill(ptr, ptr + tileVolume, background);
+                T *expected = NULL;
+                if (!tiles[tile].compare_exchange_strong(expected, ptr, std::memory_order_acq_rel,
+                                                         std::memory_order_acquire))
+                {
+                    delete[] ptr;
+                    return expected;
+                }
+                numAllocated.fetch_add(1, std::memory_order_relaxed);
+                return ptr;
+            }
+
+            /// Free a tile, reads of the tile will return the background value
+            void releaseTile(size_t tile)
+            {
+                delete[] tiles[tile].exchange(NULL, std::memory_order_acq_rel);
+                numAllocated.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            /// Add a view sharing the data
+            void attach(ViewType *view) { views.attach(view); }
+
+            /// Remove a view sharing the data
+            void detach(ViewType *view) { views.detach(view); }
+
+            /// Put the view `to` in the place of `from`, used when a grid object is moved
+            void replace(ViewType *from, ViewType *to) { views.replace(from, to); }
+
+            /// Notify all views of a resize
+            void update(const SizeInfo& sizeInfo) { views.notify(sizeInfo); }
+
+            /// The number of resizes so far
+            size_t getGeneration() const { return views.getGeneration(); }
+        };
+
+        /**
+         * @brief A reference to an element of a grid with block-sparse storage
+         *
+         * Reading an element of a tile that has not been allocated returns the background
+         * value without allocating the tile. Writing a value different from the background
+         * allocates the tile first.
+         *
+         * @tparam T The type of data stored in the grid
+         * @tparam DataType The tile data, see SparseTileData
+         */
+        template <typename T, typename DataType>
+        class SparseReference
+        {
+        private:
+            DataType *data;
+            size_t tile;
+            size_t offset;
+        public:
+            SparseReference(DataType *data, size_t tile, size_t offset)
+                : data(data), tile(tile), offset(offset)
+            {}
+
+            SparseReference(const SparseReference &) = default;
+
+            /// Read the element
+            SCHNEK_INLINE operator T() const
+            {
+                const T *ptr = data->getTile(tile);
+                return ptr ? ptr[offset] : data->background;
+            }
+
+            /// Write the element
+            SCHNEK_INLINE SparseReference &operator=(const T &value)
+            {
+                T *ptr = data->getTile(tile);
+                if (!ptr)
+                {
+                    if (value == data->background) return *this;
+                    ptr = data->allocateTile(tile);
+                }
+                ptr[offset] = value;
+                return *this;
+            }
+
+            /// Copy the value of another element, not the reference
+            SCHNEK_INLINE SparseReference &operator=(const SparseReference &other)
+            {
+                return *this = T(other);
+            }
+
+            SCHNEK_INLINE SparseReference &operator+=(const SparseReference &rhs)
+            {
+                return *this += T(rhs);
+            }
+
+            template <typename Rhs>
+            SCHNEK_INLINE SparseReference &operator+=(const Rhs &rhs)
+            {
+                T value(*this);
+                value += rhs;
+                return *this = value;
+            }
+
+            SCHNEK_INLINE SparseReference &operator-=(const SparseReference &rhs)
+            {
+                return *this -= T(rhs);
+            }
+
+            template <typename Rhs>
+            SCHNEK_INLINE SparseReference &operator-=(const Rhs &rhs)
+            {
+                T value(*this);
+                value -= rhs;
+                return *this = value;
+            }
+
+            SCHNEK_INLINE SparseReference &operator*=(const SparseReference &rhs)
+            {
+                return *this *= T(rhs);
+            }
+
+            template <typename Rhs>
+            SCHNEK_INLINE SparseReference &operator*=(const Rhs &rhs)
+            {
+                T value(*this);
+                value *= rhs;
+                return *this = value;
+            }
+
+            SCHNEK_INLINE SparseReference &operator/=(const SparseReference &rhs)
+            {
+                return *this /= T(rhs);
+            }
+
+            template <typename Rhs>
+            SCHNEK_INLINE SparseReference &operator/=(const Rhs &rhs)
+            {
+                T value(*this);
+                value /= rhs;
+                return *this = value;
+            }
+        };
+
+        /**
+         * @brief Iterates over all elements of all tiles of a block-sparse grid in storage order
+         *
+         * @tparam T The type of data stored in the grid
+         * @tparam DataType The tile data, see SparseTileData
+         * @tparam Reference The type returned by dereferencing the iterator, either
+         *     SparseReference or the element type
+         */
+        template <typename T, typename DataType, typename Reference>
+        class SparseIterator
+        {
+        private:
+            DataType *data;
+            size_t tile;
+            size_t offset;
+        public:
+            SparseIterator(DataType *data, size_t tile)
+                : data(data), tile(tile), offset(0)
+            {}
+
+            Reference operator*() const { return SparseReference<T, DataType>(data, tile, offset); }
+
+            SparseIterator &operator++()
+            {
+                if (++offset == data->tileVolume)
+                {
+                    offset = 0;
+                    ++tile;
+                }
+                return *this;
+            }
+
+            bool operator==(const SparseIterator &other) const
+            {
+                return (tile == other.tile) && (offset == other.offset);
+            }
+
+            bool operator!=(const SparseIterator &other) const { return !(*this == other); }
+        };
+    }
+
+    /**
+     * @brief Storage policy that allocates the grid in tiles on the first write
+     *
+     * The grid is divided into tiles of the shape given by `TileShape`, starting at the
+     * lowest coordinate of the grid, like TiledGridStorageBase. A tile is only allocated
+     * when a value different from the background value is written to one of its grid
+     * points. Reading a grid point in a tile that has not been allocated returns the
+     * background value, which is `T()` unless changed with `setBackground()`. The memory
+     * used by the grid is therefore proportional to the region in which the grid is
+     * non-trivial.
+     *
+     * Because writing may allocate, `get()` returns a lightweight proxy, see
+     * internal::SparseReference. Reading through the proxy never allocates. Tiles that
+     * only contain the background value can be freed again with `compact()`.
+     *
+     * The grid may be written by several threads at once, for example with
+     * RangeThreadedIterationPolicy. A tile that is written by two threads for the first
+     * time is allocated only once. `resize()`, `compact()` and `setBackground()` must
+     * not run concurrently with other accesses to the grid.
+     *
+     * The storage iterators run over all elements of all tiles, allocated or not, so that
+     * operations on whole grids behave as for dense grids. The iteration policy available
+     * as `IterationPolicy` visits only the allocated tiles when the grid itself is passed
+     * as the range, see SparseTileIterationPolicy.
+     *
+     * There is no single array holding the data, so the storage provides neither
+     * `getRawData()` nor `stride()`. The values can be copied into a dense array in
+     * C order with `copyTo()`.
+     *
+     * @tparam T The type of data stored in the grid, must be comparable with `==`
+     * @tparam rank The rank of the grid
+     * @tparam TileShape The shape of the tiles, see GridTile
+     */
+    template <typename T, size_t rank, class TileShape>
+    class SparseGridStorageBase
+    {
+        static_assert(
+            (TileShape::numExtents == 0) || (TileShape::numExtents == rank),
+            "the number of tile extents must match the rank"
+        );
+    public:
+        /// The grid index type
+        typedef Array<int, rank> IndexType;
+
+        /// The grid range type
+        typedef Range<int, rank> RangeType;
+
+        /// The iteration policy that visits the allocated tiles
+        typedef SparseTileIterationPolicy<rank, TileShape> IterationPolicy;
+
+        /// The number of elements in a tile
+        static constexpr size_t tileVolume = TileShape::template volume<rank>();
+
+        /// Statistics of the memory used by the grid
+        struct Statistics
+        {
+            /// The number of tiles covering the grid
+            size_t numTiles;
+            /// The number of tiles that have been allocated
+            size_t allocatedTiles;
+            /// The number of bytes in allocated tiles
+            size_t bytesAllocated;
+        };
+    protected:
+        struct SizeInfo {
+            IndexType lo;
+            IndexType hi;
+        };
+
+        typedef internal::SparseTileData<T, SizeInfo> DataType;
+
+        typedef typename DataType::ViewType ViewType;
+    public:
+        /// The proxy returned by `get()`
+        typedef internal::SparseReference<T, DataType> reference;
+
+        typedef internal::SparseIterator<T, DataType, reference> storage_iterator;
+        typedef internal::SparseIterator<T, DataType, T> const_storage_iterator;
+    private:
+        /// The tile data shared with the copies of this storage
+        std::shared_ptr<DataType> data;
+
+        /// The lowest and highest coordinates in the grid (inclusive)
+        RangeType range;
+
+        /// The dimensions of the grid `dims = high - low + 1`
+        IndexType dims;
+
+        /// The number of tiles in each dimension
+        Array<size_t, rank> numTiles;
+
+        /// The number of grid points
+        size_t size;
+
+        /// The link of this object in the list of objects sharing the data
+        ViewType view;
+    public:
+        /// Default constructor
+        SparseGridStorageBase();
+
+        /// Copy constructor, the copy shares the tiles
+        SparseGridStorageBase(const SparseGridStorageBase&);
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param lo the lowest coordinate in the grid (inclusive)
+         * @param hi the highest coordinate in the grid (inclusive)
+         */
+        SparseGridStorageBase(const IndexType &lo, const IndexType &hi);
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param range the lowest and highest coordinates in the grid (inclusive)
+         */
+        SparseGridStorageBase(const RangeType &range);
+
+        /**
+         * @brief Assignment operator, shares the tiles of the other storage
+         */
+        SparseGridStorageBase<T, rank, TileShape> &operator=(const SparseGridStorageBase<T, rank, TileShape> &);
+
+        /// Move constructor, the moved-from storage is left empty
+        SparseGridStorageBase(SparseGridStorageBase &&) noexcept;
+
+        /**
+         * @brief Move assignment operator
+         */
+        SparseGridStorageBase<T, rank, TileShape> &operator=(SparseGridStorageBase<T, rank, TileShape> &&) noexcept;
+
+        /// Destructor
+        ~SparseGridStorageBase();
+
+        /**
+         * @brief Get a reference to the element at a given grid index
+         *
+         * @param index The grid index
+         * @return a proxy for the element at the grid index
+         */
+        SCHNEK_INLINE reference get(const IndexType &index);
+
+        /**
+         * @brief Get the rvalue at a given grid index
+         *
+         * @param index The grid index
+         * @return the rvalue at the grid index, the background value if the tile has not
+         *     been allocated
+         */
+        SCHNEK_INLINE const T &get(const IndexType &index) const;
+
+        /**
+         * @brief resizes to grid with lower indices lo[0],...,lo[rank-1]
+         * and upper indices hi[0],...,hi[rank-1]
+         *
+         * All tiles are freed.
+         */
+        void resize(const IndexType &low, const IndexType &high);
+
+        /**
+         * @brief resizes to grid with the range.
+         * The endponts of the range are inclusive
+         */
+        void resize(const RangeType range);
+
+        /// Get the lowest coordinate in the grid (inclusive)
+        SCHNEK_INLINE const IndexType &getLo() const { return range.getLo(); }
+
+        /// Get the highest coordinate in the grid (inclusive)
+        SCHNEK_INLINE const IndexType &getHi() const { return range.getHi(); }
+
+        /// Get the lowest and highest coordinates in the grid (inclusive)
+        SCHNEK_INLINE const RangeType &getRange() const { return range; }
+
+        /// Get the dimensions of the grid `dims = high - low + 1`
+        SCHNEK_INLINE const IndexType &getDims() const { return dims; }
+
+        /// Get k-th component of the lowest coordinate in the grid (inclusive)
+        SCHNEK_INLINE int getLo(int k) const { return range.getLo(k); }
+
+        /// Get k-th component of the highest coordinate in the grid (inclusive)
+        SCHNEK_INLINE int getHi(int k) const { return range.getHi(k); }
+
+        /// Get k-th component of the dimensions of the grid `dims = high - low + 1`
+        SCHNEK_INLINE int getDims(int k) const { return dims[k]; }
+
+        /// Get the number of grid points
+        SCHNEK_INLINE size_t getSize() const { return size; }
+
+        /// The number of resizes of the data shared with the copies of this storage
+        size_t getGeneration() const { return data ? data->getGeneration() : 0; }
+
+        /// The value of grid points in tiles that have not been allocated
+        const T &getBackground() const;
+
+        /**
+         * @brief Set the value of grid points in tiles that have not been allocated
+         *
+         * Allocated tiles are not changed.
+         */
+        void setBackground(const T &value);
+
+        /**
+         * @brief Whether a tile has been allocated
+         *
+         * @param tile The tile coordinates, starting at zero in the lowest corner of the grid
+         */
+        bool isTileAllocated(const IndexType &tile) const;
+
+        /// Free all tiles that only contain the background value
+        void compact();
+
+        /// The memory used by the grid
+        Statistics getStatistics() const;
+
+        /**
+         * @brief Copy the values of all grid points to a dense array in C order
+         *
+         * @param dest The array, must hold at least `getSize()` elements
+         */
+        void copyTo(T *dest) const;
+
+        SCHNEK_INLINE storage_iterator begin() { ensureData(); return storage_iterator(data.get(), 0); }
+        SCHNEK_INLINE storage_iterator end() { ensureData(); return storage_iterator(data.get(), data->tiles.size()); }
+
+        SCHNEK_INLINE const_storage_iterator cbegin() const { return const_storage_iterator(data.get(), 0); }
+        SCHNEK_INLINE const_storage_iterator cend() const
+        {
+            return const_storage_iterator(data.get(), data ? data->tiles.size() : 0);
+        }
+    private:
+        /// Create the data if this storage has been moved from
+        void ensureData();
+
+        /// The position of the tile holding a grid index in the tile table
+        SCHNEK_INLINE size_t tilePosition(const IndexType &index) const;
+
+        /// The position of a grid index inside its tile
+        SCHNEK_INLINE size_t innerPosition(const IndexType &index) const;
+
+        /// Forwards a resize of the shared data to `updateSizeInfo`
+        static void notifyView(void *owner, const SizeInfo &sizeInfo);
+
+        /// Update the range, the dimensions and the number of tiles
+        void updateSizeInfo(const SizeInfo &sizeInfo);
+
+        /// Set the size information to that of an empty grid
+        void resetSizeInfo();
+    };
+
+    //=================================================================
+    //=================== SparseGridStorageBase =======================
+    //=================================================================
+
+    template <typename T, size_t rank, class TileShape>
+    SparseGridStorageBase<T, rank, TileShape>::SparseGridStorageBase()
+        : data(new DataType(tileVolume)), view(this, &notifyView)
+    {
+        resetSizeInfo();
+        data->attach(&view);
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    SparseGridStorageBase<T, rank, TileShape>::SparseGridStorageBase(const SparseGridStorageBase &other)
+        : data(other.data), range(other.range), dims(other.dims), numTiles(other.numTiles), size(other.size),
+          view(this, &notifyView)
+    {
+        if (data) data->attach(&view);
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    SparseGridStorageBase<T, rank, TileShape>::SparseGridStorageBase(
+        const IndexType &lo,
+        const IndexType &hi
+    ) : data(new DataType(tileVolume)), view(this, &notifyView)
+    {
+        data->attach(&view);
+        resize(lo, hi);
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    SparseGridStorageBase<T, rank, TileShape>::SparseGridStorageBase(
+        const RangeType &range
+    ) : data(new DataType(tileVolume)), view(this, &notifyView)
+    {
+        data->attach(&view);
+        resize(range.getLo(), range.getHi());
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    SparseGridStorageBase<T, rank, TileShape> &SparseGridStorageBase<T, rank, TileShape>::operator=(
+        const SparseGridStorageBase<T, rank, TileShape> &other
+    )
+    {
+        if (this == &other) return *this;
+        if (data) data->detach(&view);
+        data = other.data;
+        range = other.range;
+        dims = other.dims;
+        numTiles = other.numTiles;
+        size = other.size;
+        if (data) data->attach(&view);
+        return *this;
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    SparseGridStorageBase<T, rank, TileShape>::SparseGridStorageBase(SparseGridStorageBase &&other) noexcept
+        : data(std::move(other.data)), range(other.range), dims(other.dims), numTiles(other.numTiles),
+          size(other.size), view(this, &notifyView)
+    {
+        if (data) data->replace(&other.view, &view);
+        other.resetSizeInfo();
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    SparseGridStorageBase<T, rank, TileShape> &SparseGridStorageBase<T, rank, TileShape>::operator=(
+        SparseGridStorageBase<T, rank, TileShape> &&other
+    ) noexcept
+    {
+        if (this == &other) return *this;
+        if (data) data->detach(&view);
+        data = std::move(other.data);
+        range = other.range;
+        dims = other.dims;
+        numTiles = other.numTiles;
+        size = other.size;
+        if (data) data->replace(&other.view, &view);
+        other.resetSizeInfo();
+        return *this;
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    SparseGridStorageBase<T, rank, TileShape>::~SparseGridStorageBase()
+    {
+        if (data) data->detach(&view);
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    SCHNEK_INLINE size_t SparseGridStorageBase<T, rank, TileShape>::tilePosition(const IndexType &index) const
+    {
+        size_t pos = 0;
+        for (size_t d = 0; d < rank; ++d)
+        {
+            // unsigned arithmetic turns division by power-of-two extents into shifts
+            pos = size_t(index[d] - range.getLo(d)) / TileShape::extent(d) + numTiles[d] * pos;
+        }
+        return pos;
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    SCHNEK_INLINE size_t SparseGridStorageBase<T, rank, TileShape>::innerPosition(const IndexType &index) const
+    {
+        size_t pos = 0;
+        for (size_t d = 0; d < rank; ++d)
+        {
+            const size_t extent = TileShape::extent(d);
+            pos = size_t(index[d] - range.getLo(d)) % extent + extent * pos;
+        }
+        return pos;
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    SCHNEK_INLINE typename SparseGridStorageBase<T, rank, TileShape>::reference
+        SparseGridStorageBase<T, rank, TileShape>::get(const IndexType &index)
+    {
+        return reference(data.get(), tilePosition(index), innerPosition(index));
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    SCHNEK_INLINE const T &SparseGridStorageBase<T, rank, TileShape>::get(const IndexType &index) const
+    {
+        const T *tile = data->getTile(tilePosition(index));
+        return tile ? tile[innerPosition(index)] : data->background;
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    void SparseGridStorageBase<T, rank, TileShape>::ensureData()
+    {
+        if (data) return;
+        data = std::make_shared<DataType>(tileVolume);
+        data->attach(&view);
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    void SparseGridStorageBase<T, rank, TileShape>::resize(const IndexType &lo, const IndexType &hi)
+    {
+        ensureData();
+
+        size_t total = 1;
+        for (size_t d = 0; d < rank; ++d)
+        {
+            const size_t extent = TileShape::extent(d);
+            total *= hi[d] < lo[d] ? 0 : (size_t(hi[d] - lo[d]) + extent) / extent;
+        }
+        data->reset(total);
+        data->update(SizeInfo{lo, hi});
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    inline void SparseGridStorageBase<T, rank, TileShape>::resize(const RangeType range)
+    {
+        this->resize(range.getLo(), range.getHi());
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    const T &SparseGridStorageBase<T, rank, TileShape>::getBackground() const
+    {
+        // a moved-from storage has no data and reports the default background
+        static const T defaultBackground = T();
+        return data ? data->background : defaultBackground;
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    void SparseGridStorageBase<T, rank, TileShape>::setBackground(const T &value)
+    {
+        ensureData();
+        data->background = value;
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    bool SparseGridStorageBase<T, rank, TileShape>::isTileAllocated(const IndexType &tile) const
+    {
+        if (!data) return false;
+        size_t pos = 0;
+        for (size_t d = 0; d < rank; ++d)
+        {
+            pos = size_t(tile[d]) + numTiles[d] * pos;
+        }
+        return data->getTile(pos) != NULL;
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    void SparseGridStorageBase<T, rank, TileShape>::compact()
+    {
+        if (!data) return;
+        const T &background = data->background;
+        for (size_t t = 0; t < data->tiles.size(); ++t)
+        {
+            const T *tile = data->getTile(t);
+            if (!tile) continue;
+            if (std::all_of(tile, tile + tileVolume, [&](const T &v) { return v == background; }))
+            {
+                data->releaseTile(t);
+            }
+        }
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    typename SparseGridStorageBase<T, rank, TileShape>::Statistics
+        SparseGridStorageBase<T, rank, TileShape>::getStatistics() const
+    {
+        if (!data) return Statistics{0, 0, 0};
+        const size_t numAllocated = data->numAllocated.load(std::memory_order_relaxed);
+        return Statistics{data->tiles.size(), numAllocated, numAllocated * tileVolume * sizeof(T)};
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    void SparseGridStorageBase<T, rank, TileShape>::copyTo(T *dest) const
+    {
+        RangeCIterationPolicy<rank>::forEach(range, [&](const IndexType &index) {
+            *dest++ = get(index);
+        });
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    void SparseGridStorageBase<T, rank, TileShape>::notifyView(void *owner, const SizeInfo &sizeInfo)
+    {
+        static_cast<SparseGridStorageBase*>(owner)->updateSizeInfo(sizeInfo);
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    void SparseGridStorageBase<T, rank, TileShape>::updateSizeInfo(const SizeInfo &sizeInfo)
+    {
+        range = RangeType{sizeInfo.lo, sizeInfo.hi};
+        size = 1;
+        for (size_t d = 0; d < rank; ++d)
+        {
+            const size_t extent = TileShape::extent(d);
+            dims[d] = sizeInfo.hi[d] - sizeInfo.lo[d] + 1;
+            numTiles[d] = dims[d] > 0 ? (size_t(dims[d]) + extent - 1) / extent : 0;
+            size *= dims[d] > 0 ? dims[d] : 0;
+        }
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    void SparseGridStorageBase<T, rank, TileShape>::resetSizeInfo()
+    {
+        range = RangeType{IndexType(0), IndexType(-1)};
+        dims = IndexType(0);
+        numTiles = Array<size_t, rank>(size_t(0));
+        size = 0;
+    }
+}
+
+#endif // SCHNEK_GRID_GRIDSTORAGE_SPARSESTORAGE_HPP_
@@ -0,0 +1,274 @@
+/*
+ * static-storage.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_GRIDSTORAGE_STATICSTORAGE_HPP_
+#define SCHNEK_GRID_GRIDSTORAGE_STATICSTORAGE_HPP_
+
+#include "../array.hpp"
+#include "../range.hpp"
+#include "../iteration/range-iteration.hpp"
+#include "../../util/exceptions.hpp"
+
+#include <array>
+#include <cstddef>
+#include <sstream>
+#include <utility>
+
+namespace schnek
+{
+    /**
+     * @brief Storage policy with extents that are fixed at compile time
+     *
+     * The elements are stored in C order in an array that is a member of the storage,
+     * so no memory is allocated on the heap. The extents and strides are compile-time
+     * constants and the index calculation is unrolled over the dimensions. This suits
+     * small grids, such as stencil coefficients or per-cell kernels, that are created
+     * in large numbers or accessed in tight loops.
+     *
+     * The lowest coordinate of the grid can be chosen freely, but the extents of the grid
+     * cannot be changed. Resizing to different extents throws a ScheckException.
+     *
+     * Unlike the other storage policies, copies of the grid do not share the data. Copying
+     * or assigning a grid copies all elements.
+     *
+     * Use StaticExtents<Extents...>::Storage as the storage policy of the Grid class.
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     * @tparam Extents The extents of the grid in each dimension
+     */
+    template <typename T, size_t rank, size_t... Extents>
+    class StaticGridStorage
+    {
+        static_assert(sizeof...(Extents) == rank, "the number of extents must match the rank");
+        static_assert(((Extents > 0) && ...), "the extents must be positive");
+    public:
+        /// The grid index type
+        typedef Array<int, rank> IndexType;
+
+        /// The grid range type
+        typedef Range<int, rank> RangeType;
+
+        /// The iteration policy that visits the grid in storage order
+        typedef RangeCIterationPolicy<rank> IterationPolicy;
+
+        typedef T* storage_iterator;
+        typedef const T* const_storage_iterator;
+
+        /// The extents of the grid in each dimension
+        static constexpr std::array<int, rank> extents = {int(Extents)...};
+
+        /// The number of elements
+        static constexpr size_t volume = (Extents * ...);
+    private:
+        /// The strides of the dimensions in C order
+        static constexpr std::array<ptrdiff_t, rank> strides = []() {
+            std::array<ptrdiff_t, rank> result{};
+            ptrdiff_t stride = 1;
+            for (size_t d = rank; d-- > 0;)
+            {
+                result[d] = stride;
+                stride *= extents[d];
+            }
+            return result;
+        }();
+
+        /// The elements of the grid
+        T data[volume];
+
+        /// The lowest and highest coordinates in the grid (inclusive)
+        RangeType range;
+
+        /// The position of the element with index zero in `data`, may lie outside the array
+        ptrdiff_t origin;
+    public:
+        /// Default constructor, the lowest coordinate is zero
+        StaticGridStorage();
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param lo the lowest coordinate in the grid (inclusive)
+         * @param hi the highest coordinate in the grid (inclusive), must match the extents
+         */
+        StaticGridStorage(const IndexType &lo, const IndexType &hi);
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param range the lowest and highest coordinates in the grid (inclusive)
+         */
+        StaticGridStorage(const RangeType &range);
+
+        /**
+         * @brief Get the lvalue at a given grid index
+         *
+         * @param index The grid index
+         * @return the lvalue at the grid index
+         */
+        SCHNEK_INLINE T &get(const IndexType &index)
+        {
+            return data[position(index, std::make_index_sequence<rank>())];
+        }
+
+        /**
+         * @brief Get the rvalue at a given grid index
+         *
+         * @param index The grid index
+         * @return the rvalue at the grid index
+         */
+        SCHNEK_INLINE const T &get(const IndexType &index) const
+        {
+            return data[position(index, std::make_index_sequence<rank>())];
+        }
+
+        /**
+         * @brief Move the grid to the lower indices lo[0],...,lo[rank-1]
+         *
+         * The upper indices hi[0],...,hi[rank-1] must match the extents. The data is
+         * not changed.
+         */
+        void resize(const IndexType &low, const IndexType &high);
+
+        /**
+         * @brief Move the grid to the range.
+         * The endponts of the range are inclusive
+         */
+        void resize(const RangeType range);
+
+        /// Access to the underlying raw data
+        T *getRawData() { return data; }
+
+        /// Access to the underlying raw data
+        const T *getRawData() const { return data; }
+
+        /// Get the lowest coordinate in the grid (inclusive)
+        SCHNEK_INLINE const IndexType &getLo() const { return range.getLo(); }
+
+        /// Get the highest coordinate in the grid (inclusive)
+        SCHNEK_INLINE const IndexType &getHi() const { return range.getHi(); }
+
+        /// Get the lowest and highest coordinates in the grid (inclusive)
+        SCHNEK_INLINE const RangeType &getRange() const { return range; }
+
+        /// Get the dimensions of the grid
+        SCHNEK_INLINE IndexType getDims() const { return IndexType(int(Extents)...); }
+
+        /// Get k-th component of the lowest coordinate in the grid (inclusive)
+        SCHNEK_INLINE int getLo(int k) const { return range.getLo(k); }
+
+        /// Get k-th component of the highest coordinate in the grid (inclusive)
+        SCHNEK_INLINE int getHi(int k) const { return range.getHi(k); }
+
+        /// Get k-th component of the dimensions of the grid
+        SCHNEK_INLINE static constexpr int getDims(int k) { return extents[k]; }
+
+        /// Get the number of elements
+        SCHNEK_INLINE static constexpr size_t getSize() { return volume; }
+
+        /// The data never changes its location, so the generation is always zero
+        SCHNEK_INLINE static constexpr size_t getGeneration() { return 0; }
+
+        /// returns the stride of the specified dimension
+        SCHNEK_INLINE static constexpr ptrdiff_t stride(size_t dim) { return strides[dim]; }
+
+        SCHNEK_INLINE storage_iterator begin() { return data; }
+        SCHNEK_INLINE storage_iterator end() { return data + volume; }
+
+        SCHNEK_INLINE const_storage_iterator cbegin() const { return data; }
+        SCHNEK_INLINE const_storage_iterator cend() const { return data + volume; }
+    private:
+        /// The position of a grid index in the array, unrolled over the dimensions
+        template <size_t... dim>
+        SCHNEK_INLINE ptrdiff_t position(const IndexType &index, std::index_sequence<dim...>) const
+        {
+            return origin + ((ptrdiff_t(index[dim]) * strides[dim]) + ...);
+        }
+    };
+
+    /**
+     * @brief The extents of grids using StaticGridStorage
+     *
+     * The nested alias `Storage` can be passed as a storage policy to the Grid class.
+     *
+     * @code
+     * Grid<double, 3, GridNoArgCheck, StaticExtents<5, 5, 5>::Storage> kernel;
+     * @endcode
+     *
+     * @tparam Extents The extents of the grid in each dimension
+     */
+    template <size_t... Extents>
+    struct StaticExtents
+    {
+        /// The static storage policy with these extents
+        template <typename T, size_t rank>
+        using Storage = StaticGridStorage<T, rank, Extents...>;
+    };
+
+    //=================================================================
+    //===================== StaticGridStorage =========================
+    //=================================================================
+
+    template <typename T, size_t rank, size_t... Extents>
+    StaticGridStorage<T, rank, Extents...>::StaticGridStorage()
+        : data(), range(IndexType(0), IndexType(int(Extents - 1)...)), origin(0)
+    {}
+
+    template <typename T, size_t rank, size_t... Extents>
+    StaticGridStorage<T, rank, Extents...>::StaticGridStorage(const IndexType &lo, const IndexType &hi)
+        : data(), origin(0)
+    {
+        resize(lo, hi);
+    }
+
+    template <typename T, size_t rank, size_t... Extents>
+    StaticGridStorage<T, rank, Extents...>::StaticGridStorage(const RangeType &range)
+        : data(), origin(0)
+    {
+        resize(range.getLo(), range.getHi());
+    }
+
+    template <typename T, size_t rank, size_t... Extents>
+    void StaticGridStorage<T, rank, Extents...>::resize(const IndexType &lo, const IndexType &hi)
+    {
+        origin = 0;
+        for (size_t d = 0; d < rank; ++d)
+        {
+            SCHNEK_ASSERT(hi[d] - lo[d] + 1 == extents[d],
+                "the extents of a static grid cannot be changed, dimension " << d
+                << " has extent " << extents[d]);
+            origin -= lo[d] * strides[d];
+        }
+        range = RangeType(lo, hi);
+    }
+
+    template <typename T, size_t rank, size_t... Extents>
+    inline void StaticGridStorage<T, rank, Extents...>::resize(const RangeType range)
+    {
+        this->resize(range.getLo(), range.getHi());
+    }
+}
+
+#endif // SCHNEK_GRID_GRIDSTORAGE_STATICSTORAGE_HPP_
@@ -0,0 +1,311 @@
+/*
+ * tiled-storage.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_GRIDSTORAGE_TILEDSTORAGE_HPP_
+#define SCHNEK_GRID_GRIDSTORAGE_TILEDSTORAGE_HPP_
+
+#include "single-array-allocation.hpp"
+#include "single-array-storage-base.hpp"
+#include "../gridtile.hpp"
+#include "../iteration/tiled-iteration.hpp"
+
+namespace schnek
+{
+    namespace internal {
+        /// Rounds the dimensions of the array up to a whole number of tiles
+        template <class TileShape>
+        struct TileRounding
+        {
+            static int round(size_t dim, int extent)
+            {
+                const int tileExtent = TileShape::extent(dim);
+                return tileExtent * ((extent + tileExtent - 1) / tileExtent);
+            }
+        };
+    }
+
+    /**
+     * @brief Allocate a single array for a grid that is stored in tiles.
+     *
+     * The dimensions of the array are rounded up to a multiple of the tile extents
+     * in every dimension, so that the array holds a whole number of tiles.
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     * @tparam TileShape The shape of the tiles, see GridTile
+     */
+    template <typename T, size_t rank, class TileShape>
+    using SingleArrayTiledAllocation = SingleArrayRoundedAllocation<T, rank, internal::TileRounding<TileShape> >;
+
+    namespace internal {
+        /// Binds the tile shape so that the tiled allocation can be used as an allocation policy
+        template <class TileShape>
+        struct TiledAllocationPolicy
+        {
+            template <typename T, size_t rank>
+            using type = SingleArrayTiledAllocation<T, rank, TileShape>;
+        };
+    }
+
+    /**
+     * @brief Storage policy that stores the grid in contiguous tiles (bricks)
+     *
+     * The grid is divided into tiles of the shape given by `TileShape`, starting at the
+     * lowest coordinate of the grid. The tiles are stored one after the other in C order
+     * of the tile coordinates. Inside a tile, the elements are also stored in C order.
+     * Neighbouring grid points in any dimension are therefore close in memory, except
+     * across tile boundaries.
+     *
+     * Tiles at the upper end of the grid may be only partially filled. The storage
+     * iterators run over all elements of the allocated array, including those outside
+     * the grid. There is no constant stride between grid points, so the storage does
+     * not provide a `stride()` method.
+     *
+     * The iteration policy matching the layout is available as `IterationPolicy`.
+     *
+     * @tparam T The type of data stored in the grid
+     * @tparam rank The rank of the grid
+     * @tparam TileShape The shape of the tiles, see GridTile
+     */
+    template <typename T, size_t rank, class TileShape>
+    class TiledGridStorageBase
+        : public SingleArrayGridStorageBase<T, rank, internal::TiledAllocationPolicy<TileShape>::template type>
+    {
+        static_assert(
+            (TileShape::numExtents == 0) || (TileShape::numExtents == rank),
+            "the number of tile extents must match the rank"
+        );
+    private:
+        /// The number of tiles in each dimension
+        Array<size_t, rank> numTiles;
+
+        /// A copy of the data pointer for faster access
+        T *data_fast;
+    public:
+        /// Base class type
+        typedef SingleArrayGridStorageBase<
+            T,
+            rank,
+            internal::TiledAllocationPolicy<TileShape>::template type
+        > BaseType;
+
+        /// The grid index type
+        typedef typename BaseType::IndexType IndexType;
+
+        /// The grid index type
+        typedef typename BaseType::RangeType RangeType;
+
+        /// The iteration policy that visits the grid tile by tile
+        typedef RangeTiledIterationPolicy<rank, TileShape> IterationPolicy;
+
+        /// The number of elements in a tile
+        static constexpr size_t tileVolume = TileShape::template volume<rank>();
+
+        /// Default constructor
+        TiledGridStorageBase();
+
+        /// Copy constructor
+        TiledGridStorageBase(const TiledGridStorageBase&);
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param lo the lowest coordinate in the grid (inclusive)
+         * @param hi the highest coordinate in the grid (inclusive)
+         */
+        TiledGridStorageBase(const IndexType &lo, const IndexType &hi);
+
+        /**
+         * @brief Construct with a given size
+         *
+         * @param range the lowest and highest coordinates in the grid (inclusive)
+         */
+        TiledGridStorageBase(const RangeType &range);
+
+        /**
+         * @brief Assignment operator
+         */
+        TiledGridStorageBase<T, rank, TileShape> &operator=(
+            const TiledGridStorageBase<T, rank, TileShape> &
+        ) = default;
+
+        /// Move constructor, the moved-from storage is left empty
+        TiledGridStorageBase(TiledGridStorageBase &&) noexcept;
+
+        /**
+         * @brief Move assignment operator
+         */
+        TiledGridStorageBase<T, rank, TileShape> &operator=(TiledGridStorageBase<T, rank, TileShape> &&) noexcept;
+
+        /**
+         * @brief Get the lvalue at a given grid index
+         *
+         * @param index The grid index
+         * @return the lvalue at the grid index
+         */
+        SCHNEK_INLINE T &get(const IndexType &index);
+
+        /**
+         * @brief Get the rvalue at a given grid index
+         *
+         * @param index The grid index
+         * @return the rvalue at the grid index
+         */
+        SCHNEK_INLINE const T &get(const IndexType &index) const;
+
+        /**
+         * @brief resizes to grid with lower indices lo[0],...,lo[rank-1]
+         * and upper indices hi[0],...,hi[rank-1]
+         */
+        void resize(const IndexType &low, const IndexType &high);
+
+        /**
+         * @brief resizes to grid with the range.
+         * The endponts of the range are inclusive
+         */
+        void resize(const RangeType range);
+    private:
+        /// The position of a grid index in the array
+        SCHNEK_INLINE size_t position(const IndexType &index) const;
+
+        /**
+         * @brief Update the number of tiles and the data pointer
+         *
+         * This method is called indirectly when a resize is performed on any of the copies of the
+         * grid.
+         */
+        void updateDataFast();
+    };
+
+    //=================================================================
+    //==================== TiledGridStorageBase =======================
+    //=================================================================
+
+    template <typename T, size_t rank, class TileShape>
+    TiledGridStorageBase<T, rank, TileShape>::TiledGridStorageBase()
+        : BaseType(), data_fast(NULL)
+    {
+        this->onUpdate([this](){ updateDataFast(); });
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    TiledGridStorageBase<T, rank, TileShape>::TiledGridStorageBase(const TiledGridStorageBase &other)
+        : BaseType(other), numTiles(other.numTiles), data_fast(other.data_fast)
+    {
+        this->onUpdate([this](){ updateDataFast(); });
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    TiledGridStorageBase<T, rank, TileShape>::TiledGridStorageBase(TiledGridStorageBase &&other) noexcept
+        : BaseType(std::move(other)), numTiles(other.numTiles), data_fast(other.data_fast)
+    {
+        this->onUpdate([this](){ updateDataFast(); });
+        other.data_fast = NULL;
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    TiledGridStorageBase<T, rank, TileShape> &TiledGridStorageBase<T, rank, TileShape>::operator=(
+        TiledGridStorageBase<T, rank, TileShape> &&other
+    ) noexcept
+    {
+        if (this == &other) return *this;
+        BaseType::operator=(std::move(other));
+        numTiles = other.numTiles;
+        data_fast = other.data_fast;
+        other.data_fast = NULL;
+        return *this;
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    TiledGridStorageBase<T, rank, TileShape>::TiledGridStorageBase(
+        const IndexType &lo,
+        const IndexType &hi
+    ) : BaseType(), data_fast(NULL)
+    {
+        this->onUpdate([this](){ updateDataFast(); });
+        resize(lo, hi);
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    TiledGridStorageBase<T, rank, TileShape>::TiledGridStorageBase(
+        const RangeType &range
+    ) : BaseType(), data_fast(NULL)
+    {
+        this->onUpdate([this](){ updateDataFast(); });
+        resize(range.getLo(), range.getHi());
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    SCHNEK_INLINE size_t TiledGridStorageBase<T, rank, TileShape>::position(const IndexType &index) const
+    {
+        size_t tilePos = 0;
+        size_t innerPos = 0;
+        for (size_t d = 0; d < rank; ++d)
+        {
+            // unsigned arithmetic turns division by power-of-two extents into shifts
+            const size_t extent = TileShape::extent(d);
+            const size_t offset = size_t(index[d] - this->range.getLo(d));
+            tilePos = offset / extent + numTiles[d] * tilePos;
+            innerPos = offset % extent + extent * innerPos;
+        }
+        return tilePos * tileVolume + innerPos;
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    SCHNEK_INLINE T &TiledGridStorageBase<T, rank, TileShape>::get(const IndexType &index)
+    {
+        return this->data_fast[position(index)];
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    SCHNEK_INLINE const T &TiledGridStorageBase<T, rank, TileShape>::get(const IndexType &index) const
+    {
+        return this->data_fast[position(index)];
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    inline void TiledGridStorageBase<T, rank, TileShape>::resize(const IndexType &lo, const IndexType &hi)
+    {
+        this->resizeImpl(lo, hi);
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    inline void TiledGridStorageBase<T, rank, TileShape>::resize(const RangeType range)
+    {
+        this->resize(range.getLo(), range.getHi());
+    }
+
+    template <typename T, size_t rank, class TileShape>
+    void TiledGridStorageBase<T, rank, TileShape>::updateDataFast()
+    {
+        for (size_t d = 0; d < rank; ++d)
+        {
+            numTiles[d] = this->allocDims[d] / TileShape::extent(d);
+        }
+        data_fast = this->data->ptr;
+    }
+}
+
+#endif // SCHNEK_GRID_GRIDSTORAGE_TILEDSTORAGE_HPP_
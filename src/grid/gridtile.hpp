@@ -0,0 +1,95 @@
+/*
+ * gridtile.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_GRIDTILE_HPP_
+#define SCHNEK_GRID_GRIDTILE_HPP_
+
+#include <cstddef>
+
+namespace schnek
+{
+    template <typename T, size_t rank, class TileShape>
+    class TiledGridStorageBase;
+
+    template <typename T, size_t rank, class TileShape>
+    class SparseGridStorageBase;
+
+    /**
+     * @brief The shape of the tiles (bricks) used by tiled storage and tiled iteration
+     *
+     * The extents are given for each dimension. If no extents are given, the tile has
+     * an extent of `defaultExtent` in every dimension.
+     *
+     * The nested aliases `Storage` and `SparseStorage` can be passed as a storage policy
+     * to the Grid class.
+     *
+     * @code
+     * Grid<double, 3, GridNoArgCheck, GridTile<4, 4, 16>::Storage> grid;
+     * Grid<double, 3, GridNoArgCheck, GridTile<16, 16, 16>::SparseStorage> sparseGrid;
+     * @endcode
+     *
+     * @tparam Extents The extents of the tile in each dimension
+     */
+    template <size_t... Extents>
+    struct GridTile
+    {
+        /// The extent used in every dimension when no extents are given
+        static constexpr size_t defaultExtent = 8;
+
+        /// The number of extents given, zero if the default extents are used
+        static constexpr size_t numExtents = sizeof...(Extents);
+
+        /// The extent of the tile in dimension `dim`
+        static constexpr size_t extent(size_t dim)
+        {
+            constexpr size_t values[] = {Extents..., 0};
+            return numExtents == 0 ? defaultExtent : values[dim];
+        }
+
+        /// The number of grid points in a tile of the given rank
+        template <size_t rank>
+        static constexpr size_t volume()
+        {
+            size_t v = 1;
+            for (size_t d = 0; d < rank; ++d)
+            {
+                v *= extent(d);
+            }
+            return v;
+        }
+
+        /// The tiled storage policy using this tile shape
+        template <typename T, size_t rank>
+        using Storage = TiledGridStorageBase<T, rank, GridTile<Extents...> >;
+
+        /// The block-sparse storage policy using this tile shape
+        template <typename T, size_t rank>
+        using SparseStorage = SparseGridStorageBase<T, rank, GridTile<Extents...> >;
+
+        static_assert(((Extents > 0) && ...), "tile extents must be positive");
+    };
+}
+
+#endif // SCHNEK_GRID_GRIDTILE_HPP_
@@ -33,6 +33,8 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <utility>
+
 namespace schnek {
     
     template<
@@ -57,6 +59,34 @@ namespace schnek {
             typename Func
         >
         static void forEach(const RangeType& range, const Func &func);
+
+        /**
+         * @brief Combine the values of a function over all indices in the range
+         *
+         * The range is reduced with `Kokkos::parallel_reduce` using a custom reducer that
+         * joins the partial results with `combineFunc`. Both functions are called inside
+         * the kernel and have to be callable in the execution space, e.g. by creating them
+         * with `KOKKOS_LAMBDA`. The order in which the values are combined is unspecified.
+         *
+         * @tparam RangeType The range type. Requires accessor methods `getLo()` and `getHi()`
+         *     that return the array-like bounds of the range with length `rank`
+         * @tparam T The type of the result
+         * @tparam MapFunc Called with an array-like index of length `rank`, returns a value of type `T`
+         * @tparam CombineFunc Called with two values of type `T`, returns their combination.
+         *     Must be associative and commutative.
+         * @param range The range over which to reduce
+         * @param init The neutral element of `combineFunc`, returned for an empty range
+         * @param mapFunc The function that maps each position to a value
+         * @param combineFunc The function that combines two values
+         * @return the combined value
+         */
+        template<
+            class RangeType,
+            typename T,
+            typename MapFunc,
+            typename CombineFunc
+        >
+        static T reduce(const RangeType& range, const T& init, const MapFunc &mapFunc, const CombineFunc &combineFunc);
     };
 
     //=================================================================
@@ -75,6 +105,109 @@ namespace schnek {
                 func(typename RangeType::LimitType{ind...});
             }
         };
+
+        /// Used to expand a parameter pack of `rank` index arguments
+        template<size_t, typename ValueType>
+        struct KokkosIndexArgument
+        {
+            typedef ValueType type;
+        };
+
+        template<typename MapFunc, typename CombineFunc, typename RangeType, typename T, typename Sequence>
+        struct RangeKokkosReduceFunctor;
+
+        /**
+         * @brief Functor for `Kokkos::parallel_reduce` with one index argument per dimension
+         *
+         * Kokkos passes the accumulated value after the indices, so the number of index
+         * arguments has to be fixed by the index sequence.
+         */
+        template<typename MapFunc, typename CombineFunc, typename RangeType, typename T, size_t... I>
+        struct RangeKokkosReduceFunctor<MapFunc, CombineFunc, RangeType, T, std::index_sequence<I...> >
+        {
+            MapFunc mapFunc;
+            CombineFunc combineFunc;
+
+            SCHNEK_INLINE void operator()(
+                typename KokkosIndexArgument<I, typename RangeType::value_type>::type... ind,
+                T &value
+            ) const
+            {
+                value = combineFunc(value, mapFunc(typename RangeType::LimitType{ind...}));
+            }
+        };
+
+        /**
+         * @brief Kokkos reducer that joins values with a user supplied function
+         *
+         * @tparam T The type of the reduced value
+         * @tparam CombineFunc The function that combines two values
+         */
+        template<typename T, typename CombineFunc>
+        struct KokkosCombineReducer
+        {
+            typedef KokkosCombineReducer reducer;
+            typedef T value_type;
+            typedef Kokkos::View<value_type, Kokkos::HostSpace, Kokkos::MemoryUnmanaged> result_view_type;
+
+            value_type *result;
+            value_type identity;
+            CombineFunc combineFunc;
+
+            KokkosCombineReducer(value_type &result, const value_type &identity, const CombineFunc &combineFunc)
+              : result(&result), identity(identity), combineFunc(combineFunc)
+            {}
+
+            SCHNEK_INLINE void join(value_type &dest, const value_type &src) const
+            {
+                dest = combineFunc(dest, src);
+            }
+
+            SCHNEK_INLINE void init(value_type &value) const
+            {
+                value = identity;
+            }
+
+            SCHNEK_INLINE value_type &reference() const
+            {
+                return *result;
+            }
+
+            result_view_type view() const
+            {
+                return result_view_type(result);
+            }
+
+            bool references_scalar() const
+            {
+                return true;
+            }
+        };
+
+        /// Run `Kokkos::parallel_reduce` over an execution policy and return the result
+        template<
+            size_t rank,
+            class RangeType,
+            class ExecutionPolicy,
+            typename T,
+            typename MapFunc,
+            typename CombineFunc
+        >
+        T kokkosReduce(const ExecutionPolicy &policy, const T& init, const MapFunc &mapFunc, const CombineFunc &combineFunc)
+        {
+            RangeKokkosReduceFunctor<MapFunc, CombineFunc, RangeType, T, std::make_index_sequence<rank> > functor{
+                mapFunc,
+                combineFunc
+            };
+            T result = init;
+            Kokkos::parallel_reduce(
+                "schnek:reduce",
+                policy,
+                functor,
+                KokkosCombineReducer<T, CombineFunc>(result, init, combineFunc)
+            );
+            return result;
+        }
     }
 
     // specialization for 1d because Kokkos::MDRangePolicy can only be used for rank>1
@@ -99,6 +232,26 @@ namespace schnek {
 
             Kokkos::parallel_for("schnek:forEach", rangePolicy, functor); 
         }
+
+        template<
+            class RangeType,
+            typename T,
+            typename MapFunc,
+            typename CombineFunc
+        >
+        static T reduce(const RangeType& range, const T& init, const MapFunc &mapFunc, const CombineFunc &combineFunc)
+        {
+            typedef typename RangeType::value_type IndexT;
+            typedef Kokkos::RangePolicy<
+                Kokkos::IndexType<IndexT>,
+                executionSpace
+            > ExecutionPolicy;
+
+            if (range.getHi()[0] < range.getLo()[0]) return init;
+            ExecutionPolicy rangePolicy(range.getLo()[0], range.getHi()[0] + 1);
+
+            return internal::kokkosReduce<1, RangeType>(rangePolicy, init, mapFunc, combineFunc);
+        }
     };
 
     template<
@@ -134,6 +287,45 @@ namespace schnek {
         Kokkos::parallel_for("schnek:forEach", rangePolicy, functor);
     }
 
+    template<
+      size_t rank, 
+      typename executionSpace
+    >
+    template<
+        class RangeType,
+        typename T,
+        typename MapFunc,
+        typename CombineFunc
+    >
+    inline T RangeKokkosIterationPolicy<rank, executionSpace>::reduce(
+        const RangeType& range,
+        const T& init,
+        const MapFunc &mapFunc,
+        const CombineFunc &combineFunc
+    )
+    {
+        typedef typename RangeType::value_type IndexT;
+        IndexT lo[rank];
+        IndexT hi[rank];
+        const typename RangeType::LimitType& loR = range.getLo();
+        const typename RangeType::LimitType& hiR = range.getHi();
+
+        for (size_t i=0; i<rank; ++i)
+        {
+            if (hiR[i] < loR[i]) return init;
+            lo[i] = loR[i];
+            hi[i] = hiR[i] + 1;
+        }
+
+        Kokkos::MDRangePolicy<
+            Kokkos::IndexType<IndexT>,
+            Kokkos::Rank<rank>,
+            executionSpace
+        > rangePolicy(lo, hi);
+
+        return internal::kokkosReduce<rank, RangeType>(rangePolicy, init, mapFunc, combineFunc);
+    }
+
 } // namespace schnek
 
 #endif // SCHNEK_HAVE_KOKKOS
@@ -0,0 +1,251 @@
+/*
+ * morton-iteration.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_ITERATION_MORTONITERATION_HPP_
+#define SCHNEK_GRID_ITERATION_MORTONITERATION_HPP_
+
+#include "../../config.hpp"
+#include "../mortonlayout.hpp"
+#include "range-iteration.hpp"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace schnek {
+
+    /**
+     * @brief Iteration policy that iterates over a domain in Morton (Z-order)
+     *
+     * The indices are visited in increasing order of the Morton code of their offset
+     * from the lowest corner of the range, see internal::MortonLayout. The range is
+     * recursively divided into blocks of power-of-two extents and blocks that lie
+     * entirely outside the range are skipped, so the range does not need to have
+     * power-of-two extents.
+     *
+     * When the range is the full range of a grid using MortonGridStorage, the
+     * iteration visits the grid in storage order.
+     *
+     * @tparam rank the rank of the domain to iterate over
+     */
+    template<size_t rank>
+    struct RangeMortonIterationPolicy {
+        /**
+         * @brief Call a function for each index in the range
+         *
+         * The range will be iterated over in Morton order
+         *
+         * @tparam RangeType The range type. Requires accessor methods `getLo()` and `getHi()`
+         *     that return the array-like bounds of the range with length `rank`
+         * @tparam Func The function that will be called with an array-like index of length `rank`
+         * @param range The range over which to iterate
+         * @param func The function that will be called for each position in the range
+         */
+        template<
+            class RangeType,
+            typename Func
+        >
+        static void forEach(const RangeType& range, Func func);
+
+        /**
+         * @brief Combine the values of a function over all indices in the range
+         *
+         * The values are combined serially in the order of `forEach()`.
+         *
+         * @tparam RangeType The range type, as for `forEach()`
+         * @tparam T The type of the result
+         * @tparam MapFunc Called with an array-like index of length `rank`, returns a value of type `T`
+         * @tparam CombineFunc Called with two values of type `T`, returns their combination
+         * @param range The range over which to reduce
+         * @param init The neutral element of `combineFunc`, returned for an empty range
+         * @param mapFunc The function that maps each position to a value
+         * @param combineFunc The function that combines two values
+         * @return the combined value
+         */
+        template<
+            class RangeType,
+            typename T,
+            typename MapFunc,
+            typename CombineFunc
+        >
+        static T reduce(const RangeType& range, const T& init, MapFunc mapFunc, CombineFunc combineFunc);
+    };
+
+    //=================================================================
+    //================= RangeMortonIterationPolicy ====================
+    //=================================================================
+
+    namespace internal {
+        /**
+         * @brief Visits the blocks of a range in Morton order
+         *
+         * The blocks are divided recursively down to `leafLevels`. Below that, the
+         * offsets inside a block are taken from a table in Morton order so that the
+         * innermost levels do not pay for the recursion.
+         */
+        template<size_t rank, class IndexType, typename Func>
+        struct MortonBlockVisitor
+        {
+            typedef typename std::decay<decltype(std::declval<IndexType>()[0])>::type ValueType;
+
+            const IndexType &hi;
+            Func &func;
+            Array<int, rank> bits;
+            int leafLevels;
+            std::vector<Array<int, rank> > leafOffsets;
+            Array<int, rank> leafExtent;
+
+            MortonBlockVisitor(const IndexType &hi, Func &func, const Array<int, rank> &bits, int leafLevels)
+                : hi(hi), func(func), bits(bits), leafLevels(leafLevels)
+            {
+                for (size_t d = 0; d < rank; ++d)
+                {
+                    leafExtent[d] = 1 << std::min(bits[d], leafLevels);
+                }
+
+                // the lowest levels of the code follow the same rule as the whole code
+                const MortonLayout<rank> leafLayout(leafExtent);
+                const uint64_t leafVolume = leafExtent.product();
+                leafOffsets.resize(leafVolume);
+                for (uint64_t code = 0; code < leafVolume; ++code)
+                {
+                    leafLayout.decode(code, leafOffsets[code]);
+                }
+            }
+
+            /**
+             * @brief Visit the block with lower corner `pos`
+             *
+             * On `level`, the dimensions with more than `level` bits are split in two.
+             * The children are visited in the order of their code bits, the first
+             * dimension being the most significant.
+             */
+            void visit(int level, IndexType &pos)
+            {
+                if (level < leafLevels)
+                {
+                    visitLeaf(pos);
+                    return;
+                }
+
+                size_t split[rank];
+                size_t numSplit = 0;
+                for (size_t d = 0; d < rank; ++d)
+                {
+                    if (bits[d] > level) split[numSplit++] = d;
+                }
+
+                const IndexType base = pos;
+                const size_t numChildren = size_t(1) << numSplit;
+                for (size_t child = 0; child < numChildren; ++child)
+                {
+                    bool inside = true;
+                    for (size_t s = 0; s < numSplit; ++s)
+                    {
+                        const size_t d = split[s];
+                        const ValueType bit = ValueType((child >> (numSplit - 1 - s)) & 1);
+                        pos[d] = base[d] + (bit << level);
+                        inside = inside && (pos[d] <= hi[d]);
+                    }
+                    if (inside) visit(level - 1, pos);
+                }
+                pos = base;
+            }
+
+            /// Visit all indices in the leaf block with lower corner `base`
+            void visitLeaf(const IndexType &base)
+            {
+                bool full = true;
+                for (size_t d = 0; d < rank; ++d)
+                {
+                    full = full && (base[d] + leafExtent[d] - 1 <= hi[d]);
+                }
+
+                IndexType pos = base;
+                for (const Array<int, rank> &offset : leafOffsets)
+                {
+                    bool inside = true;
+                    for (size_t d = 0; d < rank; ++d)
+                    {
+                        pos[d] = base[d] + offset[d];
+                        inside = inside && (pos[d] <= hi[d]);
+                    }
+                    if (full || inside)
+                    {
+                        const IndexType &current = pos;
+                        func(current);
+                    }
+                }
+            }
+        };
+    }
+
+    template<size_t rank>
+    template<
+        class RangeType,
+        typename Func
+    >
+    inline void RangeMortonIterationPolicy<rank>::forEach(const RangeType& range, Func func)
+    {
+        typedef typename std::decay<decltype(range.getLo())>::type IndexType;
+        const IndexType &lo = range.getLo();
+        const IndexType &hi = range.getHi();
+
+        Array<int, rank> bits;
+        int maxBits = 0;
+        for (size_t d = 0; d < rank; ++d)
+        {
+            if (hi[d] < lo[d]) return;
+            bits[d] = internal::mortonBits(int(hi[d] - lo[d] + 1));
+            if (bits[d] > maxBits) maxBits = bits[d];
+        }
+
+        // leaf blocks of up to 64 points
+        const int leafLevels = std::min(maxBits, std::max(1, int(6 / rank)));
+        internal::MortonBlockVisitor<rank, IndexType, Func> visitor(hi, func, bits, leafLevels);
+        IndexType pos = lo;
+        visitor.visit(maxBits - 1, pos);
+    }
+
+    template<size_t rank>
+    template<
+        class RangeType,
+        typename T,
+        typename MapFunc,
+        typename CombineFunc
+    >
+    inline T RangeMortonIterationPolicy<rank>::reduce(
+        const RangeType& range,
+        const T& init,
+        MapFunc mapFunc,
+        CombineFunc combineFunc
+    )
+    {
+        return internal::reduceWithForEach<RangeMortonIterationPolicy<rank> >(range, init, mapFunc, combineFunc);
+    }
+}
+
+#endif // SCHNEK_GRID_ITERATION_MORTONITERATION_HPP_
@@ -29,6 +29,8 @@
 #include "../../config.hpp"
 #include "../array.hpp"
 
+#include <type_traits>
+
 namespace schnek {
 
     /**
@@ -54,6 +56,52 @@ namespace schnek {
             typename Func
         >
         static void forEach(const RangeType& range, Func func);
+
+        /**
+         * @brief Call a function for each line along the last dimension of the range
+         *
+         * The lines are visited in C-ordering. The function is called with the index of the
+         * first point of the line and the number of points in the line. For grids with C layout
+         * the points of a line are contiguous in memory, so that kernels can loop over them with
+         * a raw pointer and `stride()` in a loop that the compiler can vectorise.
+         *
+         * @tparam RangeType The range type. Requires accessor methods `getLo()` and `getHi()`
+         *     that return the array-like bounds of the range with length `rank`
+         * @tparam Func The function that will be called with an array-like index of length `rank`
+         *     and the length of the line
+         * @param range The range over which to iterate
+         * @param func The function that will be called for each line in the range
+         */
+        template<
+            class RangeType,
+            typename Func
+        >
+        static void forEachLine(const RangeType& range, Func func);
+
+        /**
+         * @brief Combine the values of a function over all indices in the range
+         *
+         * The range is visited in C-ordering and the result is
+         * `combineFunc(...combineFunc(combineFunc(init, mapFunc(i0)), mapFunc(i1))..., mapFunc(iN))`.
+         *
+         * @tparam RangeType The range type. Requires accessor methods `getLo()` and `getHi()`
+         *     that return the array-like bounds of the range with length `rank`
+         * @tparam T The type of the result
+         * @tparam MapFunc Called with an array-like index of length `rank`, returns a value of type `T`
+         * @tparam CombineFunc Called with two values of type `T`, returns their combination
+         * @param range The range over which to reduce
+         * @param init The neutral element of `combineFunc`, returned for an empty range
+         * @param mapFunc The function that maps each position to a value
+         * @param combineFunc The function that combines two values
+         * @return the combined value
+         */
+        template<
+            class RangeType,
+            typename T,
+            typename MapFunc,
+            typename CombineFunc
+        >
+        static T reduce(const RangeType& range, const T& init, MapFunc mapFunc, CombineFunc combineFunc);
     };
 
     /**
@@ -79,8 +127,86 @@ namespace schnek {
             typename Func
         >
         static void forEach(const RangeType& range, Func func);
+
+        /**
+         * @brief Call a function for each line along the first dimension of the range
+         *
+         * The lines are visited in Fortran-ordering. The function is called with the index of
+         * the first point of the line and the number of points in the line. For grids with
+         * Fortran layout the points of a line are contiguous in memory.
+         *
+         * @tparam RangeType The range type. Requires accessor methods `getLo()` and `getHi()`
+         *     that return the array-like bounds of the range with length `rank`
+         * @tparam Func The function that will be called with an array-like index of length `rank`
+         *     and the length of the line
+         * @param range The range over which to iterate
+         * @param func The function that will be called for each line in the range
+         */
+        template<
+            class RangeType,
+            typename Func
+        >
+        static void forEachLine(const RangeType& range, Func func);
+
+        /**
+         * @brief Combine the values of a function over all indices in the range
+         *
+         * The range is visited in Fortran-ordering and the result is
+         * `combineFunc(...combineFunc(combineFunc(init, mapFunc(i0)), mapFunc(i1))..., mapFunc(iN))`.
+         *
+         * @tparam RangeType The range type. Requires accessor methods `getLo()` and `getHi()`
+         *     that return the array-like bounds of the range with length `rank`
+         * @tparam T The type of the result
+         * @tparam MapFunc Called with an array-like index of length `rank`, returns a value of type `T`
+         * @tparam CombineFunc Called with two values of type `T`, returns their combination
+         * @param range The range over which to reduce
+         * @param init The neutral element of `combineFunc`, returned for an empty range
+         * @param mapFunc The function that maps each position to a value
+         * @param combineFunc The function that combines two values
+         * @return the combined value
+         */
+        template<
+            class RangeType,
+            typename T,
+            typename MapFunc,
+            typename CombineFunc
+        >
+        static T reduce(const RangeType& range, const T& init, MapFunc mapFunc, CombineFunc combineFunc);
     };
    
+    namespace internal {
+        /// A minimal range type holding the bounds of a part of a range
+        template<class IndexType>
+        struct RangeBounds {
+            IndexType lo;
+            IndexType hi;
+            const IndexType &getLo() const { return lo; }
+            const IndexType &getHi() const { return hi; }
+        };
+
+        /**
+         * @brief Reduce over a range using the `forEach()` of a serial iteration policy
+         *
+         * Used by the serial iteration policies to implement `reduce()`.
+         */
+        template<
+            class IterationPolicy,
+            class RangeType,
+            typename T,
+            typename MapFunc,
+            typename CombineFunc
+        >
+        inline T reduceWithForEach(const RangeType& range, const T& init, MapFunc &mapFunc, CombineFunc &combineFunc)
+        {
+            typedef typename std::decay<decltype(range.getLo())>::type IndexType;
+            T result = init;
+            IterationPolicy::forEach(range, [&](const IndexType &pos) {
+                result = combineFunc(result, mapFunc(pos));
+            });
+            return result;
+        }
+    }
+
     //=================================================================
     //==================== RangeCIterationPolicy ======================
     //=================================================================
@@ -141,6 +267,37 @@ namespace schnek {
         internal::RangeCIterationPolicyImpl<rank, rank>::forEach(range, pos, func);
     }
 
+    template<size_t rank>
+    template<
+        class RangeType,
+        typename Func
+    >
+    inline void RangeCIterationPolicy<rank>::forEachLine(const RangeType& range, Func func)
+    {
+        typedef typename std::decay<decltype(range.getLo())>::type IndexType;
+        constexpr size_t dim = rank - 1;
+        const auto length = range.getHi()[dim] - range.getLo()[dim] + 1;
+        if (length <= 0) return;
+
+        internal::RangeBounds<IndexType> starts{range.getLo(), range.getHi()};
+        starts.hi[dim] = starts.lo[dim];
+        forEach(starts, [&](const IndexType &pos) {
+            func(pos, length);
+        });
+    }
+
+    template<size_t rank>
+    template<
+        class RangeType,
+        typename T,
+        typename MapFunc,
+        typename CombineFunc
+    >
+    inline T RangeCIterationPolicy<rank>::reduce(const RangeType& range, const T& init, MapFunc mapFunc, CombineFunc combineFunc)
+    {
+        return internal::reduceWithForEach<RangeCIterationPolicy<rank> >(range, init, mapFunc, combineFunc);
+    }
+
     //=================================================================
     //==================== RangeFortranIterationPolicy ================
     //=================================================================
@@ -203,6 +360,36 @@ namespace schnek {
         internal::RangeFortranIterationPolicyImpl<rank>::forEach(range, pos, func);
     }
 
+    template<size_t rank>
+    template<
+        class RangeType,
+        typename Func
+    >
+    inline void RangeFortranIterationPolicy<rank>::forEachLine(const RangeType& range, Func func)
+    {
+        typedef typename std::decay<decltype(range.getLo())>::type IndexType;
+        const auto length = range.getHi()[0] - range.getLo()[0] + 1;
+        if (length <= 0) return;
+
+        internal::RangeBounds<IndexType> starts{range.getLo(), range.getHi()};
+        starts.hi[0] = starts.lo[0];
+        forEach(starts, [&](const IndexType &pos) {
+            func(pos, length);
+        });
+    }
+
+    template<size_t rank>
+    template<
+        class RangeType,
+        typename T,
+        typename MapFunc,
+        typename CombineFunc
+    >
+    inline T RangeFortranIterationPolicy<rank>::reduce(const RangeType& range, const T& init, MapFunc mapFunc, CombineFunc combineFunc)
+    {
+        return internal::reduceWithForEach<RangeFortranIterationPolicy<rank> >(range, init, mapFunc, combineFunc);
+    }
+
 } // namespace schnek
 
 #endif // SCHNEK_GRID_ITERATION_RANGEITERATION_HPP_
\ No newline at end of file
@@ -0,0 +1,268 @@
+/*
+ * reduction.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_ITERATION_REDUCTION_HPP_
+#define SCHNEK_GRID_ITERATION_REDUCTION_HPP_
+
+#include "../../config.hpp"
+#include "../../macros.hpp"
+#include "range-iteration.hpp"
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace schnek {
+
+    /**
+     * @brief Reduction that sums the values
+     *
+     * A reduction provides the neutral element `identity()`, the function `map()` applied
+     * to each value, the associative function `combine()`, the reduction `global()` of the
+     * local result over all processes of a DomainSubdivision and the function `finish()`
+     * applied to the combined result.
+     *
+     * @tparam T The type of the values
+     */
+    template<typename T>
+    struct SumReduction
+    {
+        typedef T value_type;
+
+        static SCHNEK_INLINE T identity() { return T(0); }
+        static SCHNEK_INLINE T map(const T &value) { return value; }
+        static SCHNEK_INLINE T combine(const T &a, const T &b) { return a + b; }
+
+        template<class Subdivision>
+        static T global(const T &value, const Subdivision &subdivision) { return subdivision.sumReduce(value); }
+
+        static T finish(const T &value) { return value; }
+    };
+
+    /**
+     * @brief Reduction that finds the smallest value
+     *
+     * @tparam T The type of the values
+     */
+    template<typename T>
+    struct MinReduction
+    {
+        typedef T value_type;
+
+        static SCHNEK_INLINE T identity() { return std::numeric_limits<T>::max(); }
+        static SCHNEK_INLINE T map(const T &value) { return value; }
+        static SCHNEK_INLINE T combine(const T &a, const T &b) { return (b < a) ? b : a; }
+
+        template<class Subdivision>
+        static T global(const T &value, const Subdivision &subdivision) { return subdivision.minReduce(value); }
+
+        static T finish(const T &value) { return value; }
+    };
+
+    /**
+     * @brief Reduction that finds the largest value
+     *
+     * @tparam T The type of the values
+     */
+    template<typename T>
+    struct MaxReduction
+    {
+        typedef T value_type;
+
+        static SCHNEK_INLINE T identity() { return std::numeric_limits<T>::lowest(); }
+        static SCHNEK_INLINE T map(const T &value) { return value; }
+        static SCHNEK_INLINE T combine(const T &a, const T &b) { return (a < b) ? b : a; }
+
+        template<class Subdivision>
+        static T global(const T &value, const Subdivision &subdivision) { return subdivision.maxReduce(value); }
+
+        static T finish(const T &value) { return value; }
+    };
+
+    /**
+     * @brief Reduction that calculates the L2-norm, the square root of the sum of squares
+     *
+     * The squares are summed locally and over all processes before the square root is taken.
+     *
+     * @tparam T The type of the values
+     */
+    template<typename T>
+    struct L2NormReduction
+    {
+        typedef T value_type;
+
+        static SCHNEK_INLINE T identity() { return T(0); }
+        static SCHNEK_INLINE T map(const T &value) { return value*value; }
+        static SCHNEK_INLINE T combine(const T &a, const T &b) { return a + b; }
+
+        template<class Subdivision>
+        static T global(const T &value, const Subdivision &subdivision) { return subdivision.sumReduce(value); }
+
+        static T finish(const T &value) { return std::sqrt(value); }
+    };
+
+    namespace internal {
+        /// Applies the `map()` of a reduction to the value of a function at a position
+        template<class Reduction, typename Func>
+        struct ReductionMap
+        {
+            Func func;
+
+            template<class IndexType>
+            SCHNEK_INLINE typename Reduction::value_type operator()(const IndexType &pos) const
+            {
+                return Reduction::map(func(pos));
+            }
+        };
+
+        /// Calls the `combine()` of a reduction
+        template<class Reduction>
+        struct ReductionCombine
+        {
+            SCHNEK_INLINE typename Reduction::value_type operator()(
+                const typename Reduction::value_type &a,
+                const typename Reduction::value_type &b
+            ) const
+            {
+                return Reduction::combine(a, b);
+            }
+        };
+
+        /// Reads the value of a grid at a position
+        template<class GridType>
+        struct GridValue
+        {
+            const GridType *grid;
+
+            template<class IndexType>
+            typename GridType::value_type operator()(const IndexType &pos) const
+            {
+                return (*grid)[pos];
+            }
+        };
+
+        /// The iteration policy of a grid, or RangeCIterationPolicy if the grid does not define one
+        template<class GridType, typename = void>
+        struct DefaultIterationPolicy
+        {
+            typedef RangeCIterationPolicy<GridType::Rank> type;
+        };
+
+        template<class GridType>
+        struct DefaultIterationPolicy<GridType, std::void_t<typename GridType::IterationPolicy> >
+        {
+            typedef typename GridType::IterationPolicy type;
+        };
+
+        /// Reduce over a range without applying `finish()`
+        template<class Reduction, class IterationPolicy, class RangeType, typename Func>
+        typename Reduction::value_type reduceLocal(const RangeType &range, const Func &func)
+        {
+            return IterationPolicy::reduce(
+                range,
+                Reduction::identity(),
+                ReductionMap<Reduction, Func>{func},
+                ReductionCombine<Reduction>()
+            );
+        }
+    }
+
+    /**
+     * @brief Reduce the values of a function over a range on the local process
+     *
+     * @code
+     * double maxValue = reduceRange<MaxReduction<double>, RangeCIterationPolicy<3> >(
+     *     range, [&](const Array<int, 3> &pos) { return std::abs(grid[pos]); }
+     * );
+     * @endcode
+     *
+     * @tparam Reduction The reduction, e.g. SumReduction, MinReduction, MaxReduction or L2NormReduction
+     * @tparam IterationPolicy The iteration policy that provides `reduce()`
+     * @param range The range over which to reduce
+     * @param func Called with each position in the range, returns the value to reduce
+     * @return the reduced value
+     */
+    template<class Reduction, class IterationPolicy, class RangeType, typename Func>
+    typename Reduction::value_type reduceRange(const RangeType &range, const Func &func)
+    {
+        return Reduction::finish(internal::reduceLocal<Reduction, IterationPolicy>(range, func));
+    }
+
+    /**
+     * @brief Reduce the values of a function over a range and over all processes
+     *
+     * The range is reduced on each process and the local results are reduced over all
+     * processes with the `sumReduce()`, `minReduce()` or `maxReduce()` of the subdivision.
+     * The subdivision only provides these for `int` and `double`. The function must be
+     * called by all processes of the subdivision.
+     *
+     * @tparam Reduction The reduction, e.g. SumReduction, MinReduction, MaxReduction or L2NormReduction
+     * @tparam IterationPolicy The iteration policy that provides `reduce()`
+     * @param range The local range over which to reduce
+     * @param func Called with each position in the range, returns the value to reduce
+     * @param subdivision The subdivision of the global domain
+     * @return the reduced value, the same on all processes
+     */
+    template<class Reduction, class IterationPolicy, class RangeType, typename Func, class Subdivision>
+    typename Reduction::value_type globalReduce(const RangeType &range, const Func &func, const Subdivision &subdivision)
+    {
+        const typename Reduction::value_type local = internal::reduceLocal<Reduction, IterationPolicy>(range, func);
+        return Reduction::finish(Reduction::global(local, subdivision));
+    }
+
+    /**
+     * @brief The L2-norm of a field over the inner ranges of all processes
+     *
+     * The ghost cells are excluded, so that each point of the global domain is counted once.
+     *
+     * @code
+     * double norm = globalNorm(field, subdivision);
+     * @endcode
+     *
+     * @tparam IterationPolicy The iteration policy. If `void`, the iteration policy of the
+     *     field's storage is used, or RangeCIterationPolicy if the storage does not define one.
+     * @param field The field
+     * @param subdivision The subdivision of the global domain
+     * @return the L2-norm, the same on all processes
+     */
+    template<class IterationPolicy = void, class FieldType, class Subdivision>
+    typename FieldType::value_type globalNorm(const FieldType &field, const Subdivision &subdivision)
+    {
+        typedef typename std::conditional<
+            std::is_void<IterationPolicy>::value,
+            typename internal::DefaultIterationPolicy<FieldType>::type,
+            IterationPolicy
+        >::type Policy;
+
+        return globalReduce<L2NormReduction<typename FieldType::value_type>, Policy>(
+            field.getInnerRange(),
+            internal::GridValue<FieldType>{&field},
+            subdivision
+        );
+    }
+
+} // namespace schnek
+
+#endif // SCHNEK_GRID_ITERATION_REDUCTION_HPP_
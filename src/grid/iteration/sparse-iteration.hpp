@@ -0,0 +1,186 @@
+/*
+ * sparse-iteration.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_ITERATION_SPARSEITERATION_HPP_
+#define SCHNEK_GRID_ITERATION_SPARSEITERATION_HPP_
+
+#include "../../config.hpp"
+#include "../gridtile.hpp"
+#include "range-iteration.hpp"
+#include "tiled-iteration.hpp"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+namespace schnek {
+
+    namespace internal {
+        /// True if the range is a block-sparse grid that can tell which of its tiles are allocated
+        template<class RangeType, typename = void>
+        struct HasAllocatedTiles : std::false_type {};
+
+        template<class RangeType>
+        struct HasAllocatedTiles<
+            RangeType,
+            std::void_t<decltype(std::declval<const RangeType&>().isTileAllocated(std::declval<const RangeType&>().getLo()))>
+        > : std::true_type {};
+    }
+
+    /**
+     * @brief Iteration policy that visits only the allocated tiles of a block-sparse grid
+     *
+     * When the range passed to `forEach` is a grid using SparseGridStorageBase with the same
+     * tile shape, only the indices inside allocated tiles are visited. The tiles are visited
+     * in C-order and the indices inside each tile are also visited in C-order. Indices in
+     * tiles that have never been written hold the background value and are skipped.
+     *
+     * Any other range is visited completely, tile by tile, as with RangeTiledIterationPolicy.
+     *
+     * @tparam rank the rank of the domain to iterate over
+     * @tparam TileShape the shape of the tiles, see GridTile
+     */
+    template<size_t rank, class TileShape = GridTile<> >
+    struct SparseTileIterationPolicy {
+        static_assert(
+            (TileShape::numExtents == 0) || (TileShape::numExtents == rank),
+            "the number of tile extents must match the rank"
+        );
+
+        /**
+         * @brief Call a function for each index in the range
+         *
+         * @tparam RangeType The range type. Requires accessor methods `getLo()` and `getHi()`
+         *     that return the array-like bounds of the range with length `rank`. If the range
+         *     also provides `isTileAllocated(tile)`, only allocated tiles are visited.
+         * @tparam Func The function that will be called with an array-like index of length `rank`
+         * @param range The range over which to iterate
+         * @param func The function that will be called for each position in the range
+         */
+        template<
+            class RangeType,
+            typename Func
+        >
+        static void forEach(const RangeType& range, Func func);
+
+        /**
+         * @brief Combine the values of a function over all indices in the range
+         *
+         * Unlike `forEach()`, all indices are visited, also when the range is a block-sparse
+         * grid. The points in tiles that have not been allocated hold the background value
+         * and contribute to the result. The values are combined serially, tile by tile.
+         *
+         * @tparam RangeType The range type, as for `forEach()`
+         * @tparam T The type of the result
+         * @tparam MapFunc Called with an array-like index of length `rank`, returns a value of type `T`
+         * @tparam CombineFunc Called with two values of type `T`, returns their combination
+         * @param range The range over which to reduce
+         * @param init The neutral element of `combineFunc`, returned for an empty range
+         * @param mapFunc The function that maps each position to a value
+         * @param combineFunc The function that combines two values
+         * @return the combined value
+         */
+        template<
+            class RangeType,
+            typename T,
+            typename MapFunc,
+            typename CombineFunc
+        >
+        static T reduce(const RangeType& range, const T& init, MapFunc mapFunc, CombineFunc combineFunc);
+    };
+
+    //=================================================================
+    //================== SparseTileIterationPolicy ====================
+    //=================================================================
+
+    template<size_t rank, class TileShape>
+    template<
+        class RangeType,
+        typename Func
+    >
+    inline void SparseTileIterationPolicy<rank, TileShape>::forEach(const RangeType& range, Func func)
+    {
+        if constexpr (!internal::HasAllocatedTiles<RangeType>::value)
+        {
+            RangeTiledIterationPolicy<rank, TileShape>::forEach(range, func);
+        }
+        else
+        {
+            typedef typename std::decay<decltype(range.getLo())>::type IndexType;
+            const IndexType &lo = range.getLo();
+            const IndexType &hi = range.getHi();
+
+            // the tile coordinates start at zero in the lowest corner of the grid
+            internal::RangeBounds<IndexType> tiles{lo, lo};
+            for (size_t d = 0; d < rank; ++d)
+            {
+                if (hi[d] < lo[d]) return;
+                tiles.lo[d] = 0;
+                tiles.hi[d] = (hi[d] - lo[d]) / int(TileShape::extent(d));
+            }
+
+            RangeCIterationPolicy<rank>::forEach(tiles, [&](const IndexType &tile) {
+                if (!range.isTileAllocated(tile)) return;
+                internal::RangeBounds<IndexType> bounds{lo, lo};
+                for (size_t d = 0; d < rank; ++d)
+                {
+                    const int extent = int(TileShape::extent(d));
+                    bounds.lo[d] = lo[d] + tile[d] * extent;
+                    bounds.hi[d] = std::min(hi[d], bounds.lo[d] + extent - 1);
+                }
+                RangeCIterationPolicy<rank>::forEach(bounds, func);
+            });
+        }
+    }
+
+    template<size_t rank, class TileShape>
+    template<
+        class RangeType,
+        typename T,
+        typename MapFunc,
+        typename CombineFunc
+    >
+    inline T SparseTileIterationPolicy<rank, TileShape>::reduce(
+        const RangeType& range,
+        const T& init,
+        MapFunc mapFunc,
+        CombineFunc combineFunc
+    )
+    {
+        if constexpr (!internal::HasAllocatedTiles<RangeType>::value)
+        {
+            return internal::reduceWithForEach<RangeTiledIterationPolicy<rank, TileShape> >(range, init, mapFunc, combineFunc);
+        }
+        else
+        {
+            // the grid itself would only visit the allocated tiles
+            typedef typename std::decay<decltype(range.getLo())>::type IndexType;
+            const internal::RangeBounds<IndexType> bounds{range.getLo(), range.getHi()};
+            return internal::reduceWithForEach<RangeTiledIterationPolicy<rank, TileShape> >(bounds, init, mapFunc, combineFunc);
+        }
+    }
+}
+
+#endif // SCHNEK_GRID_ITERATION_SPARSEITERATION_HPP_
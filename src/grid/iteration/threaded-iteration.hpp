@@ -0,0 +1,450 @@
+/*
+ * threaded-iteration.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_ITERATION_THREADEDITERATION_HPP_
+#define SCHNEK_GRID_ITERATION_THREADEDITERATION_HPP_
+
+#include "../../config.hpp"
+#include "../array.hpp"
+#include "../../util/threadpool.hpp"
+#include "tiled-iteration.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace schnek {
+
+    /**
+     * @brief Schedule that gives each thread one contiguous block of the range
+     *
+     * If the outermost dimension has at least as many indices as there are threads, the
+     * range is split along the outermost dimension with partitionRange(). Otherwise the lines
+     * along the innermost dimension are numbered in C-order and this collapsed index space is
+     * split into blocks.
+     *
+     * FirstTouchArrayGridStorage uses the same split for the allocated range of the grid.
+     * Only an iteration over exactly that range gives every thread the memory it has touched
+     * first. Sub-ranges, such as the inner range of a field without its ghost cells, are split
+     * differently, and the slabs near the thread boundaries belong to a neighbouring thread.
+     */
+    struct StaticSchedule
+    {
+        /**
+         * @brief Distribute the rows over the threads of the ThreadPool
+         *
+         * @param numSlabs The extent of the outermost dimension
+         * @param rowsPerSlab The number of rows in each index of the outermost dimension
+         * @param body Called with the half-open interval `[begin, end)` of rows to process
+         */
+        template<typename Body>
+        static void execute(size_t numSlabs, size_t rowsPerSlab, const Body &body);
+    };
+
+    /**
+     * @brief Schedule in which the threads take chunks of rows from a shared counter
+     *
+     * A row is a line along the innermost dimension. Each thread repeatedly takes the next
+     * `chunkRows` rows until the range is exhausted. This balances the load when the cost of
+     * the function varies across the range.
+     *
+     * @tparam chunkRows The number of rows in a chunk. If zero, the chunk size is chosen so
+     *     that there are about eight chunks per thread.
+     */
+    template<size_t chunkRows = 0>
+    struct DynamicSchedule
+    {
+        /**
+         * @brief Distribute the rows over the threads of the ThreadPool
+         *
+         * @param numSlabs The extent of the outermost dimension
+         * @param rowsPerSlab The number of rows in each index of the outermost dimension
+         * @param body Called with the half-open interval `[begin, end)` of rows to process
+         */
+        template<typename Body>
+        static void execute(size_t numSlabs, size_t rowsPerSlab, const Body &body);
+    };
+
+    /**
+     * @brief Schedule that balances the load by work stealing
+     *
+     * The rows are distributed with ThreadPool::runWorkStealing(). Each thread starts with a
+     * contiguous block of rows and splits it recursively down to the grain size. Threads that
+     * run out of work steal the largest remaining blocks from other threads. Use this schedule
+     * when the cost per index is very uneven, for example in cells with many particles or in
+     * cut cells at boundaries.
+     *
+     * @tparam grainRows The largest number of rows processed as one piece of work. If zero,
+     *     the grain size is chosen so that there are about 32 pieces per thread.
+     */
+    template<size_t grainRows = 0>
+    struct WorkStealingSchedule
+    {
+        /**
+         * @brief Distribute the rows over the threads of the ThreadPool
+         *
+         * @param numSlabs The extent of the outermost dimension
+         * @param rowsPerSlab The number of rows in each index of the outermost dimension
+         * @param body Called with the half-open interval `[begin, end)` of rows to process
+         */
+        template<typename Body>
+        static void execute(size_t numSlabs, size_t rowsPerSlab, const Body &body);
+    };
+
+    /**
+     * @brief Schedule that runs the whole range on the calling thread
+     *
+     * The range is visited in C-order, as with RangeCIterationPolicy. This can be used for
+     * debugging threaded kernels without changing the code of the kernel. Setting the number
+     * of threads of the ThreadPool to one has the same effect at runtime for the other
+     * schedules.
+     */
+    struct DeterministicSchedule
+    {
+        /**
+         * @brief Process all rows on the calling thread
+         *
+         * @param numSlabs The extent of the outermost dimension
+         * @param rowsPerSlab The number of rows in each index of the outermost dimension
+         * @param body Called with the half-open interval `[begin, end)` of rows to process
+         */
+        template<typename Body>
+        static void execute(size_t numSlabs, size_t rowsPerSlab, const Body &body);
+    };
+
+    /**
+     * @brief Iteration policy that iterates over a domain using the threads of the ThreadPool
+     *
+     * The lines along the innermost dimension, the rows, are distributed over the threads
+     * according to the `Schedule`. Each row is visited in ascending order. Rows are numbered
+     * in C-order, so that a contiguous block of rows is contiguous in memory for grids with
+     * C layout. For rank 1 each index is a row of its own.
+     *
+     * The function is copied once for each block of rows handed out by the schedule, so a
+     * thread may use several copies. The copies are called concurrently and must not write
+     * to data that is shared with calls for other indices. The order in which the indices
+     * are visited is unspecified unless DeterministicSchedule is used. When called from
+     * inside a task of the ThreadPool, the iteration runs serially on the calling thread.
+     *
+     * @tparam rank the rank of the domain to iterate over
+     * @tparam Schedule the schedule, StaticSchedule, DynamicSchedule, WorkStealingSchedule or
+     *     DeterministicSchedule
+     */
+    template<size_t rank, class Schedule = StaticSchedule>
+    struct RangeThreadedIterationPolicy {
+        /**
+         * @brief Call a function for each index in the range
+         *
+         * The range will be iterated over in parallel
+         *
+         * @tparam RangeType The range type. Requires accessor methods `getLo()` and `getHi()`
+         *     that return the array-like bounds of the range with length `rank`
+         * @tparam Func The function that will be called with an array-like index of length `rank`
+         * @param range The range over which to iterate
+         * @param func The function that will be called for each position in the range
+         */
+        template<
+            class RangeType,
+            typename Func
+        >
+        static void forEach(const RangeType& range, Func func);
+
+        /**
+         * @brief Combine the values of a function over all indices in the range
+         *
+         * Each block of rows handed out by the `Schedule` is reduced serially into a partial
+         * result, starting from `init`. The partial results are then combined on the calling
+         * thread in the order of their rows. The result does not depend on which thread
+         * processed which block, so it is reproducible as long as the blocks are the same.
+         * This is the case for StaticSchedule with a fixed number of threads, for
+         * DynamicSchedule with a fixed chunk size and for DeterministicSchedule. With
+         * WorkStealingSchedule the blocks, and so the rounding of floating point sums,
+         * may differ between runs.
+         *
+         * @tparam RangeType The range type. Requires accessor methods `getLo()` and `getHi()`
+         *     that return the array-like bounds of the range with length `rank`
+         * @tparam T The type of the result
+         * @tparam MapFunc Called with an array-like index of length `rank`, returns a value of type `T`
+         * @tparam CombineFunc Called with two values of type `T`, returns their combination.
+         *     Must be associative.
+         * @param range The range over which to reduce
+         * @param init The neutral element of `combineFunc`, returned for an empty range
+         * @param mapFunc The function that maps each position to a value
+         * @param combineFunc The function that combines two values
+         * @return the combined value
+         */
+        template<
+            class RangeType,
+            typename T,
+            typename MapFunc,
+            typename CombineFunc
+        >
+        static T reduce(const RangeType& range, const T& init, MapFunc mapFunc, CombineFunc combineFunc);
+    };
+
+    /**
+     * @brief Threaded iteration policy with load balancing by work stealing
+     *
+     * @tparam rank the rank of the domain to iterate over
+     * @tparam grainRows the grain size in rows, see WorkStealingSchedule
+     */
+    template<size_t rank, size_t grainRows = 0>
+    using RangeWorkStealingIterationPolicy = RangeThreadedIterationPolicy<rank, WorkStealingSchedule<grainRows> >;
+
+    /**
+     * @brief Tiled iteration policy in which the tiles are distributed over the threads
+     *
+     * The tiles are the unit of parallel work. Each tile is visited in C-order by one thread,
+     * so that stencils reuse the data of the tile in the cache. The lines of tiles along the
+     * innermost dimension are distributed over the threads according to the `Schedule`.
+     *
+     * @code
+     * RangeTiledThreadedIterationPolicy<3, GridTile<8, 8, 64>, DynamicSchedule<> >::forEach(range, func);
+     * @endcode
+     *
+     * @tparam rank the rank of the domain to iterate over
+     * @tparam TileShape the shape of the tiles, see GridTile
+     * @tparam Schedule the schedule, see RangeThreadedIterationPolicy
+     */
+    template<size_t rank, class TileShape = GridTile<>, class Schedule = StaticSchedule>
+    using RangeTiledThreadedIterationPolicy =
+        RangeTiledIterationPolicy<rank, TileShape, RangeThreadedIterationPolicy<rank, Schedule> >;
+
+    //=================================================================
+    //========================== Schedules ============================
+    //=================================================================
+
+    template<typename Body>
+    inline void StaticSchedule::execute(size_t numSlabs, size_t rowsPerSlab, const Body &body)
+    {
+        const size_t numRows = numSlabs*rowsPerSlab;
+        if (numRows == 0) return;
+
+        ThreadPool &pool = ThreadPool::instance();
+        const size_t parts = pool.getNumThreads();
+        const size_t unit = (numSlabs >= parts) ? rowsPerSlab : 1;
+        const long numUnits = long(numRows/unit);
+
+        pool.run([&](size_t part) {
+            long partLo, partHi;
+            partitionRange(0L, numUnits - 1, part, parts, partLo, partHi);
+            if (partLo <= partHi)
+            {
+                body(size_t(partLo)*unit, size_t(partHi + 1)*unit);
+            }
+        });
+    }
+
+    template<size_t chunkRows>
+    template<typename Body>
+    inline void DynamicSchedule<chunkRows>::execute(size_t numSlabs, size_t rowsPerSlab, const Body &body)
+    {
+        const size_t numRows = numSlabs*rowsPerSlab;
+        if (numRows == 0) return;
+
+        ThreadPool &pool = ThreadPool::instance();
+        const size_t chunk = (chunkRows > 0) ? chunkRows : std::max(size_t(1), numRows/(8*pool.getNumThreads()));
+        std::atomic<size_t> next(0);
+
+        pool.run([&](size_t) {
+            while (true)
+            {
+                const size_t begin = next.fetch_add(chunk, std::memory_order_relaxed);
+                if (begin >= numRows) break;
+                body(begin, std::min(begin + chunk, numRows));
+            }
+        });
+    }
+
+    template<size_t grainRows>
+    template<typename Body>
+    inline void WorkStealingSchedule<grainRows>::execute(size_t numSlabs, size_t rowsPerSlab, const Body &body)
+    {
+        const size_t numRows = numSlabs*rowsPerSlab;
+        if (numRows == 0) return;
+
+        ThreadPool &pool = ThreadPool::instance();
+        const size_t grain = (grainRows > 0) ? grainRows : std::max(size_t(1), numRows/(32*pool.getNumThreads()));
+        pool.runWorkStealing(0, numRows, grain, body);
+    }
+
+    template<typename Body>
+    inline void DeterministicSchedule::execute(size_t numSlabs, size_t rowsPerSlab, const Body &body)
+    {
+        const size_t numRows = numSlabs*rowsPerSlab;
+        if (numRows > 0) body(size_t(0), numRows);
+    }
+
+    //=================================================================
+    //================= RangeThreadedIterationPolicy ==================
+    //=================================================================
+
+    namespace internal {
+        template<size_t rank>
+        struct RangeThreadedIterationPolicyImpl {
+            /// The number of rows in each index of the outermost dimension
+            template<class RangeType>
+            static size_t rowsPerSlab(const RangeType& range)
+            {
+                size_t rows = 1;
+                for (size_t d=1; d<rank-1; ++d)
+                {
+                    const auto lo = range.getLo()[d];
+                    const auto hi = range.getHi()[d];
+                    rows *= (hi < lo) ? 0 : size_t(hi - lo) + 1;
+                }
+                return range.getHi()[rank-1] < range.getLo()[rank-1] ? 0 : rows;
+            }
+
+            /// Visit the rows `[begin, end)`, numbered in C-order
+            template<
+                class RangeType,
+                typename Func
+            >
+            static void forRows(const RangeType& range, size_t begin, size_t end, Func &func)
+            {
+                typedef typename std::decay<decltype(range.getLo()[0])>::type ValueType;
+                auto pos = range.getLo();
+                size_t row = begin;
+                for (size_t d=rank-1; d-- > 0;)
+                {
+                    const size_t extent = size_t(range.getHi()[d] - range.getLo()[d]) + 1;
+                    pos[d] = range.getLo()[d] + ValueType(row % extent);
+                    row /= extent;
+                }
+
+                const auto lo = range.getLo()[rank-1];
+                const auto hi = range.getHi()[rank-1];
+                for (row=begin; row<end; ++row)
+                {
+                    for (pos[rank-1]=lo; pos[rank-1]<=hi; ++pos[rank-1])
+                    {
+                        func(pos);
+                    }
+                    for (size_t d=rank-1; d-- > 0;)
+                    {
+                        if (++pos[d] <= range.getHi()[d]) break;
+                        pos[d] = range.getLo()[d];
+                    }
+                }
+            }
+        };
+
+        template<>
+        struct RangeThreadedIterationPolicyImpl<1> {
+            template<class RangeType>
+            static size_t rowsPerSlab(const RangeType&)
+            {
+                return 1;
+            }
+
+            template<
+                class RangeType,
+                typename Func
+            >
+            static void forRows(const RangeType& range, size_t begin, size_t end, Func &func)
+            {
+                typedef typename std::decay<decltype(range.getLo()[0])>::type ValueType;
+                auto pos = range.getLo();
+                for (size_t row=begin; row<end; ++row)
+                {
+                    pos[0] = range.getLo()[0] + ValueType(row);
+                    func(pos);
+                }
+            }
+        };
+    }
+
+    template<size_t rank, class Schedule>
+    template<
+        class RangeType,
+        typename Func
+    >
+    inline void RangeThreadedIterationPolicy<rank, Schedule>::forEach(const RangeType& range, Func func)
+    {
+        typedef internal::RangeThreadedIterationPolicyImpl<rank> Impl;
+        const auto lo = range.getLo()[0];
+        const auto hi = range.getHi()[0];
+        const size_t numSlabs = (hi < lo) ? 0 : size_t(hi - lo) + 1;
+
+        Schedule::execute(numSlabs, Impl::rowsPerSlab(range), [&](size_t begin, size_t end) {
+            Func threadFunc(func);
+            Impl::forRows(range, begin, end, threadFunc);
+        });
+    }
+
+    template<size_t rank, class Schedule>
+    template<
+        class RangeType,
+        typename T,
+        typename MapFunc,
+        typename CombineFunc
+    >
+    inline T RangeThreadedIterationPolicy<rank, Schedule>::reduce(
+        const RangeType& range,
+        const T& init,
+        MapFunc mapFunc,
+        CombineFunc combineFunc
+    )
+    {
+        typedef internal::RangeThreadedIterationPolicyImpl<rank> Impl;
+        const auto lo = range.getLo()[0];
+        const auto hi = range.getHi()[0];
+        const size_t numSlabs = (hi < lo) ? 0 : size_t(hi - lo) + 1;
+
+        std::mutex mutex;
+        std::vector<std::pair<size_t, T> > partials;
+
+        Schedule::execute(numSlabs, Impl::rowsPerSlab(range), [&](size_t begin, size_t end) {
+            MapFunc threadMapFunc(mapFunc);
+            T partial = init;
+            auto accumulate = [&](const auto &pos) {
+                partial = combineFunc(partial, threadMapFunc(pos));
+            };
+            Impl::forRows(range, begin, end, accumulate);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            partials.emplace_back(begin, partial);
+        });
+
+        std::sort(partials.begin(), partials.end(), [](const std::pair<size_t, T> &a, const std::pair<size_t, T> &b) {
+            return a.first < b.first;
+        });
+
+        T result = init;
+        for (const std::pair<size_t, T> &partial : partials)
+        {
+            result = combineFunc(result, partial.second);
+        }
+        return result;
+    }
+
+} // namespace schnek
+
+#endif // SCHNEK_GRID_ITERATION_THREADEDITERATION_HPP_
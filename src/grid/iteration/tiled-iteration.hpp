@@ -0,0 +1,386 @@
+/*
+ * tiled-iteration.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_ITERATION_TILEDITERATION_HPP_
+#define SCHNEK_GRID_ITERATION_TILEDITERATION_HPP_
+
+#include "../../config.hpp"
+#include "../gridtile.hpp"
+#include "range-iteration.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace schnek {
+
+    /**
+     * @brief Iteration policy that iterates over a domain tile by tile
+     *
+     * The range is divided into tiles of the shape given by `TileShape`, starting at
+     * the lowest corner of the range. The tiles are visited in C-order and the indices
+     * inside each tile are also visited in C-order. Tiles at the upper end of the range
+     * may be only partially filled.
+     *
+     * When the range is the full range of a grid using TiledGridStorageBase with the
+     * same tile shape, the iteration visits the grid in storage order.
+     *
+     * The tiles themselves are visited using `TileOrderPolicy`. Passing a threaded policy,
+     * such as RangeThreadedIterationPolicy, makes the tiles the unit of parallel work. Each
+     * tile is then visited in C-order by a single thread, see RangeTiledThreadedIterationPolicy.
+     *
+     * @tparam rank the rank of the domain to iterate over
+     * @tparam TileShape the shape of the tiles, see GridTile
+     * @tparam TileOrderPolicy the iteration policy used to visit the tiles
+     */
+    template<size_t rank, class TileShape = GridTile<>, class TileOrderPolicy = RangeCIterationPolicy<rank> >
+    struct RangeTiledIterationPolicy {
+        static_assert(
+            (TileShape::numExtents == 0) || (TileShape::numExtents == rank),
+            "the number of tile extents must match the rank"
+        );
+
+        /**
+         * @brief Call a function for each index in the range
+         *
+         * The range will be iterated over tile by tile
+         *
+         * @tparam RangeType The range type. Requires accessor methods `getLo()` and `getHi()`
+         *     that return the array-like bounds of the range with length `rank`
+         * @tparam Func The function that will be called with an array-like index of length `rank`
+         * @param range The range over which to iterate
+         * @param func The function that will be called for each position in the range
+         */
+        template<
+            class RangeType,
+            typename Func
+        >
+        static void forEach(const RangeType& range, Func func);
+
+        /**
+         * @brief Call a function for each index in the range using tiles of a given size
+         *
+         * The tile extents are given at runtime and override the extents of `TileShape`.
+         * Extents that are zero or negative fall back to the extent of `TileShape` in that
+         * dimension. This allows tuning the tile size to the cache of the machine without
+         * recompiling.
+         *
+         * @tparam RangeType The range type. Requires accessor methods `getLo()` and `getHi()`
+         *     that return the array-like bounds of the range with length `rank`
+         * @tparam ExtentType An array-like type of length `rank` holding the tile extents
+         * @tparam Func The function that will be called with an array-like index of length `rank`
+         * @param range The range over which to iterate
+         * @param tileExtents The extents of the tiles in each dimension
+         * @param func The function that will be called for each position in the range
+         */
+        template<
+            class RangeType,
+            class ExtentType,
+            typename Func
+        >
+        static void forEach(const RangeType& range, const ExtentType& tileExtents, Func func);
+
+        /**
+         * @brief Call a function for each line inside the tiles of the range
+         *
+         * The tiles are visited in the same order as by `forEach()`. Inside each tile, the
+         * function is called for each line along the last dimension, see
+         * RangeCIterationPolicy::forEachLine(). The lines are at most as long as the extent
+         * of the tile in the last dimension.
+         *
+         * @tparam RangeType The range type. Requires accessor methods `getLo()` and `getHi()`
+         *     that return the array-like bounds of the range with length `rank`
+         * @tparam Func The function that will be called with an array-like index of length `rank`
+         *     and the length of the line
+         * @param range The range over which to iterate
+         * @param func The function that will be called for each line in the range
+         */
+        template<
+            class RangeType,
+            typename Func
+        >
+        static void forEachLine(const RangeType& range, Func func);
+
+        /**
+         * @brief Call a function for each line inside tiles of a given size
+         *
+         * The tile extents override the extents of `TileShape`, as in `forEach()`.
+         *
+         * @tparam RangeType The range type. Requires accessor methods `getLo()` and `getHi()`
+         *     that return the array-like bounds of the range with length `rank`
+         * @tparam ExtentType An array-like type of length `rank` holding the tile extents
+         * @tparam Func The function that will be called with an array-like index of length `rank`
+         *     and the length of the line
+         * @param range The range over which to iterate
+         * @param tileExtents The extents of the tiles in each dimension
+         * @param func The function that will be called for each line in the range
+         */
+        template<
+            class RangeType,
+            class ExtentType,
+            typename Func
+        >
+        static void forEachLine(const RangeType& range, const ExtentType& tileExtents, Func func);
+
+        /**
+         * @brief Combine the values of a function over all indices in the range
+         *
+         * Each tile is reduced in C-order, starting from `init`. The results of the tiles are
+         * then combined with `TileOrderPolicy::reduce()`, so that the tiles are reduced in
+         * parallel when `TileOrderPolicy` is a threaded policy.
+         *
+         * @tparam RangeType The range type. Requires accessor methods `getLo()` and `getHi()`
+         *     that return the array-like bounds of the range with length `rank`
+         * @tparam T The type of the result
+         * @tparam MapFunc Called with an array-like index of length `rank`, returns a value of type `T`
+         * @tparam CombineFunc Called with two values of type `T`, returns their combination
+         * @param range The range over which to reduce
+         * @param init The neutral element of `combineFunc`, returned for an empty range
+         * @param mapFunc The function that maps each position to a value
+         * @param combineFunc The function that combines two values
+         * @return the combined value
+         */
+        template<
+            class RangeType,
+            typename T,
+            typename MapFunc,
+            typename CombineFunc
+        >
+        static T reduce(const RangeType& range, const T& init, MapFunc mapFunc, CombineFunc combineFunc);
+    private:
+        /**
+         * @brief Calculate the tile extents and the range of tile coordinates
+         *
+         * @return false if the range is empty
+         */
+        template<
+            class IndexType,
+            class ExtentType
+        >
+        static bool tileRange(
+            const IndexType& lo,
+            const IndexType& hi,
+            const ExtentType& tileExtents,
+            IndexType& extent,
+            internal::RangeBounds<IndexType>& tiles
+        );
+
+        /// The bounds of the tile with the given tile coordinates
+        template<class IndexType>
+        static internal::RangeBounds<IndexType> tileBounds(
+            const IndexType& lo,
+            const IndexType& hi,
+            const IndexType& extent,
+            const IndexType& tile
+        );
+
+        /// Call `tileFunc` with the bounds of each tile
+        template<
+            class RangeType,
+            class ExtentType,
+            typename TileFunc
+        >
+        static void forEachTile(const RangeType& range, const ExtentType& tileExtents, const TileFunc &tileFunc);
+    };
+
+    //=================================================================
+    //================== RangeTiledIterationPolicy ====================
+    //=================================================================
+
+    namespace internal {
+        /// The tile extents given by the tile shape
+        template<size_t rank, class TileShape>
+        struct DefaultTileExtents {
+            size_t extents[rank];
+
+            DefaultTileExtents()
+            {
+                for (size_t d = 0; d < rank; ++d)
+                {
+                    extents[d] = TileShape::extent(d);
+                }
+            }
+
+            size_t operator[](size_t d) const { return extents[d]; }
+        };
+    }
+
+    template<size_t rank, class TileShape, class TileOrderPolicy>
+    template<
+        class IndexType,
+        class ExtentType
+    >
+    inline bool RangeTiledIterationPolicy<rank, TileShape, TileOrderPolicy>::tileRange(
+        const IndexType& lo,
+        const IndexType& hi,
+        const ExtentType& tileExtents,
+        IndexType& extent,
+        internal::RangeBounds<IndexType>& tiles
+    )
+    {
+        typedef typename std::decay<decltype(lo[0])>::type ValueType;
+        tiles.lo = lo;
+        tiles.hi = lo;
+        for (size_t d = 0; d < rank; ++d)
+        {
+            if (hi[d] < lo[d]) return false;
+            extent[d] = (tileExtents[d] > 0) ? ValueType(tileExtents[d]) : ValueType(TileShape::extent(d));
+            tiles.hi[d] = lo[d] + (hi[d] - lo[d]) / extent[d];
+        }
+        return true;
+    }
+
+    template<size_t rank, class TileShape, class TileOrderPolicy>
+    template<class IndexType>
+    inline internal::RangeBounds<IndexType> RangeTiledIterationPolicy<rank, TileShape, TileOrderPolicy>::tileBounds(
+        const IndexType& lo,
+        const IndexType& hi,
+        const IndexType& extent,
+        const IndexType& tile
+    )
+    {
+        internal::RangeBounds<IndexType> bounds{lo, lo};
+        for (size_t d = 0; d < rank; ++d)
+        {
+            bounds.lo[d] = lo[d] + (tile[d] - lo[d]) * extent[d];
+            bounds.hi[d] = std::min(hi[d], bounds.lo[d] + extent[d] - 1);
+        }
+        return bounds;
+    }
+
+    template<size_t rank, class TileShape, class TileOrderPolicy>
+    template<
+        class RangeType,
+        class ExtentType,
+        typename TileFunc
+    >
+    inline void RangeTiledIterationPolicy<rank, TileShape, TileOrderPolicy>::forEachTile(
+        const RangeType& range,
+        const ExtentType& tileExtents,
+        const TileFunc &tileFunc
+    )
+    {
+        typedef typename std::decay<decltype(range.getLo())>::type IndexType;
+        const IndexType &lo = range.getLo();
+        const IndexType &hi = range.getHi();
+
+        IndexType extent;
+        internal::RangeBounds<IndexType> tiles;
+        if (!tileRange(lo, hi, tileExtents, extent, tiles)) return;
+
+        TileOrderPolicy::forEach(tiles, [&](const IndexType &tile) {
+            tileFunc(tileBounds(lo, hi, extent, tile));
+        });
+    }
+
+    template<size_t rank, class TileShape, class TileOrderPolicy>
+    template<
+        class RangeType,
+        typename Func
+    >
+    inline void RangeTiledIterationPolicy<rank, TileShape, TileOrderPolicy>::forEach(const RangeType& range, Func func)
+    {
+        forEach(range, internal::DefaultTileExtents<rank, TileShape>(), func);
+    }
+
+    template<size_t rank, class TileShape, class TileOrderPolicy>
+    template<
+        class RangeType,
+        class ExtentType,
+        typename Func
+    >
+    inline void RangeTiledIterationPolicy<rank, TileShape, TileOrderPolicy>::forEach(
+        const RangeType& range,
+        const ExtentType& tileExtents,
+        Func func
+    )
+    {
+        typedef typename std::decay<decltype(range.getLo())>::type IndexType;
+        forEachTile(range, tileExtents, [&](const internal::RangeBounds<IndexType> &bounds) {
+            RangeCIterationPolicy<rank>::forEach(bounds, func);
+        });
+    }
+
+    template<size_t rank, class TileShape, class TileOrderPolicy>
+    template<
+        class RangeType,
+        typename Func
+    >
+    inline void RangeTiledIterationPolicy<rank, TileShape, TileOrderPolicy>::forEachLine(const RangeType& range, Func func)
+    {
+        forEachLine(range, internal::DefaultTileExtents<rank, TileShape>(), func);
+    }
+
+    template<size_t rank, class TileShape, class TileOrderPolicy>
+    template<
+        class RangeType,
+        class ExtentType,
+        typename Func
+    >
+    inline void RangeTiledIterationPolicy<rank, TileShape, TileOrderPolicy>::forEachLine(
+        const RangeType& range,
+        const ExtentType& tileExtents,
+        Func func
+    )
+    {
+        typedef typename std::decay<decltype(range.getLo())>::type IndexType;
+        forEachTile(range, tileExtents, [&](const internal::RangeBounds<IndexType> &bounds) {
+            RangeCIterationPolicy<rank>::forEachLine(bounds, func);
+        });
+    }
+
+    template<size_t rank, class TileShape, class TileOrderPolicy>
+    template<
+        class RangeType,
+        typename T,
+        typename MapFunc,
+        typename CombineFunc
+    >
+    inline T RangeTiledIterationPolicy<rank, TileShape, TileOrderPolicy>::reduce(
+        const RangeType& range,
+        const T& init,
+        MapFunc mapFunc,
+        CombineFunc combineFunc
+    )
+    {
+        typedef typename std::decay<decltype(range.getLo())>::type IndexType;
+        const IndexType &lo = range.getLo();
+        const IndexType &hi = range.getHi();
+
+        IndexType extent;
+        internal::RangeBounds<IndexType> tiles;
+        if (!tileRange(lo, hi, internal::DefaultTileExtents<rank, TileShape>(), extent, tiles)) return init;
+
+        return TileOrderPolicy::reduce(
+            tiles,
+            init,
+            [&](const IndexType &tile) {
+                return RangeCIterationPolicy<rank>::reduce(tileBounds(lo, hi, extent, tile), init, mapFunc, combineFunc);
+            },
+            combineFunc
+        );
+    }
+}
+
+#endif // SCHNEK_GRID_ITERATION_TILEDITERATION_HPP_
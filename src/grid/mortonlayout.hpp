@@ -0,0 +1,157 @@
+/*
+ * mortonlayout.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_MORTONLAYOUT_HPP_
+#define SCHNEK_GRID_MORTONLAYOUT_HPP_
+
+#include "array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__BMI2__) && !defined(SCHNEK_NO_BMI2)
+#define SCHNEK_HAVE_BMI2
+#include <immintrin.h>
+#endif
+
+namespace schnek
+{
+    namespace internal {
+        /**
+         * @brief Scatter the low bits of `x` to the positions of the set bits in `mask`
+         *
+         * Uses the BMI2 `pdep` instruction when available.
+         */
+        inline uint64_t mortonDeposit(uint64_t x, uint64_t mask)
+        {
+#ifdef SCHNEK_HAVE_BMI2
+            return _pdep_u64(x, mask);
+#else
+            uint64_t result = 0;
+            for (uint64_t bit = 1; mask != 0; bit <<= 1)
+            {
+                const uint64_t lowest = mask & (~mask + 1);
+                if (x & bit) result |= lowest;
+                mask ^= lowest;
+            }
+            return result;
+#endif
+        }
+
+        /**
+         * @brief Gather the bits of `code` at the positions of the set bits in `mask`
+         *
+         * Uses the BMI2 `pext` instruction when available.
+         */
+        inline uint64_t mortonExtract(uint64_t code, uint64_t mask)
+        {
+#ifdef SCHNEK_HAVE_BMI2
+            return _pext_u64(code, mask);
+#else
+            uint64_t result = 0;
+            for (uint64_t bit = 1; mask != 0; bit <<= 1)
+            {
+                const uint64_t lowest = mask & (~mask + 1);
+                if (code & lowest) result |= bit;
+                mask ^= lowest;
+            }
+            return result;
+#endif
+        }
+
+        /// The number of bits needed to store offsets `0, ..., extent-1`
+        inline int mortonBits(int extent)
+        {
+            int bits = 0;
+            while ((1 << bits) < extent) ++bits;
+            return bits;
+        }
+
+        /**
+         * @brief The bit layout of a Morton (Z-order) code
+         *
+         * Each dimension `d` uses `bits[d]` bits of the code, so the extents need not
+         * be equal. The code is built from the least significant bit level upwards.
+         * On each level, the dimensions that still have bits left each receive one code
+         * bit, with the last dimension receiving the least significant one. For equal
+         * extents this is the usual bit interleaving, and a Morton code of extents
+         * `1, ..., 1, n` reduces to C-order.
+         *
+         * @tparam rank The rank of the grid
+         */
+        template <size_t rank>
+        struct MortonLayout
+        {
+            /// The number of bits of the code used by each dimension
+            Array<int, rank> bits;
+
+            /// The positions of the code bits of each dimension
+            Array<uint64_t, rank> masks;
+
+            /// Create a layout with the given extents in each dimension
+            MortonLayout(const Array<int, rank> &extents)
+            {
+                int maxBits = 0;
+                for (size_t d = 0; d < rank; ++d)
+                {
+                    bits[d] = mortonBits(extents[d]);
+                    masks[d] = 0;
+                    if (bits[d] > maxBits) maxBits = bits[d];
+                }
+
+                int pos = 0;
+                for (int level = 0; level < maxBits; ++level)
+                {
+                    for (size_t d = rank; d-- > 0; )
+                    {
+                        if (bits[d] > level) masks[d] |= uint64_t(1) << pos++;
+                    }
+                }
+            }
+
+            /// The Morton code of an offset from the lowest corner
+            uint64_t encode(const Array<int, rank> &offset) const
+            {
+                uint64_t code = 0;
+                for (size_t d = 0; d < rank; ++d)
+                {
+                    code |= mortonDeposit(uint64_t(offset[d]), masks[d]);
+                }
+                return code;
+            }
+
+            /// The offset from the lowest corner for a Morton code
+            void decode(uint64_t code, Array<int, rank> &offset) const
+            {
+                for (size_t d = 0; d < rank; ++d)
+                {
+                    offset[d] = int(mortonExtract(code, masks[d]));
+                }
+            }
+        };
+    }
+}
+
+#endif // SCHNEK_GRID_MORTONLAYOUT_HPP_
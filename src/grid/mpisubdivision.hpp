@@ -28,6 +28,7 @@
 #define SCHNEK_MPISUBDIVISION_HPP
 
 #include "domainsubdivision.hpp"
+#include "gridstorage/host-mirror.hpp"
 #include "../config.hpp"
 
 #ifdef SCHNEK_HAVE_MPI
@@ -73,7 +74,7 @@ class MPICartSubdivision : public DomainSubdivision<GridType>
     /** @brief The size of the array that needs to be exchanged,
      *  when the exchange method is called
      */
-    int exchSize[Rank];
+    size_t exchSize[Rank];
 
     value_type *sendarr[Rank]; ///< send buffers for exchanging data
     value_type *recvarr[Rank]; ///< receive buffers for exchanging data
@@ -82,6 +83,9 @@ class MPICartSubdivision : public DomainSubdivision<GridType>
     int scalarSize;
 
     DomainType globalDomain;
+
+    /// Send `count` values to `dest` and receive `count` values from `source`
+    void sendrecv(value_type *send, int dest, value_type *recv, int source, size_t count);
   public:
     using DomainSubdivision<GridType>::init;
     using DomainSubdivision<GridType>::exchange;
@@ -97,6 +101,9 @@ class MPICartSubdivision : public DomainSubdivision<GridType>
     /// Return the global domain size excluding ghost cells
     const DomainType &getGlobalDomain() const override { return globalDomain; }
 
+    /// Move the local and global domains by n grid points in dimension dim
+    void shift(size_t dim, int n) override;
+
     /** @brief Exchanges the boundaries in direction specified by dim.
      *
      *  The outermost simulated cells are sent and the surrounding
@@ -42,7 +42,9 @@
 
 #pragma GCC diagnostic pop
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <vector>
 
 namespace schnek {
@@ -95,7 +97,7 @@ void MPICartSubdivision<GridType>::init(const LimitType &lo, const LimitType &hi
   SCHNEK_ASSERT(errorCode == MPI_SUCCESS, "Could not determine MPI Cartesian coordinates ("+boost::lexical_cast<std::string>(errorCode)+")");
 
   double width[Rank];
-  int exchangeSizeProduct = delta;
+  size_t exchangeSizeProduct = delta;
 
   //std::cout << "Calculating exchange size product: " << exchangeSizeProduct << std::endl;
 
@@ -125,7 +127,7 @@ void MPICartSubdivision<GridType>::init(const LimitType &lo, const LimitType &hi
     //std::cout << "Calculating exchange size "<<i<<": " << exchSize[i] << std::endl;
     sendarr[i] = new value_type[exchSize[i]];
     recvarr[i] = new value_type[exchSize[i]];
-    for (int k=0; k<exchSize[i]; ++k)
+    for (size_t k=0; k<exchSize[i]; ++k)
     {
       sendarr[i][k] = value_type();
       recvarr[i][k] = value_type();
@@ -149,6 +151,31 @@ MPICartSubdivision<GridType>::~MPICartSubdivision()
   if (comm!=0) MPI_Comm_free(&comm);
 }
 
+template<class GridType>
+void MPICartSubdivision<GridType>::sendrecv(value_type *send, int dest, value_type *recv, int source, size_t count)
+{
+  // MPI counts are int, so large buffers are sent in several messages
+  const size_t maxCount = std::numeric_limits<int>::max();
+  MPI_Datatype mpiType = MpiValueType<value_type>::value;
+  MPI_Status stat;
+
+  for (size_t offset=0; offset<count; offset+=maxCount)
+  {
+    int chunk = int(std::min(maxCount, count-offset));
+    MPI_Sendrecv(send + offset, chunk, mpiType, dest, 0,
+                 recv + offset, chunk, mpiType, source, 0,
+                 comm, &stat);
+  }
+}
+
+template<class GridType>
+void MPICartSubdivision<GridType>::shift(size_t dim, int n)
+{
+  DomainSubdivision<GridType>::shift(dim, n);
+  globalDomain.getLo()[dim] += n;
+  globalDomain.getHi()[dim] += n;
+}
+
 template<class GridType>
 void MPICartSubdivision<GridType>::exchange(GridType &grid, size_t dim)
 {
@@ -160,17 +187,15 @@ void MPICartSubdivision<GridType>::exchange(GridType &grid, size_t dim)
   DomainType loSource = this->bounds->getGhostSourceDomain(dim, BoundaryType::Min);
   DomainType hiSource = this->bounds->getGhostSourceDomain(dim, BoundaryType::Max);
 
-  MPI_Status stat;
+  internal::syncHostMirror(grid);
 
   value_type *send = sendarr[dim];
   value_type *recv = recvarr[dim];
 
-  MPI_Datatype mpiType = MpiValueType<value_type>::value;
-
   // fill the lower ghost cells with the vales from higher source cells
   // in the neighbouring process
   {
-    int arr_ind = 0;
+    size_t arr_ind = 0;
     typename DomainType::iterator domIt  = hiSource.begin();
     typename DomainType::iterator domEnd = hiSource.end();
 
@@ -185,11 +210,9 @@ void MPICartSubdivision<GridType>::exchange(GridType &grid, size_t dim)
     }
   }
 
-  MPI_Sendrecv(send, exchSize[dim], mpiType, nextcoord[dim], 0,
-               recv, exchSize[dim], mpiType, prevcoord[dim], 0,
-               comm, &stat);
+  sendrecv(send, nextcoord[dim], recv, prevcoord[dim], exchSize[dim]);
   {
-    int arr_ind = 0;
+    size_t arr_ind = 0;
     typename DomainType::iterator domIt  = loGhost.begin();
     typename DomainType::iterator domEnd = loGhost.end();
 
@@ -204,7 +227,7 @@ void MPICartSubdivision<GridType>::exchange(GridType &grid, size_t dim)
   // fill the upper ghost cells with the values from lower source cells
   // in the neighbouring process
   {
-    int arr_ind = 0;
+    size_t arr_ind = 0;
     typename DomainType::iterator domIt  = loSource.begin();
     typename DomainType::iterator domEnd = loSource.end();
 
@@ -219,11 +242,9 @@ void MPICartSubdivision<GridType>::exchange(GridType &grid, size_t dim)
     }
   }
 
-  MPI_Sendrecv(send, exchSize[dim], mpiType, prevcoord[dim], 0,
-               recv, exchSize[dim], mpiType, nextcoord[dim], 0,
-               comm, &stat);
+  sendrecv(send, prevcoord[dim], recv, nextcoord[dim], exchSize[dim]);
   {
-    int arr_ind = 0;
+    size_t arr_ind = 0;
     typename DomainType::iterator domIt  = hiGhost.begin();
     typename DomainType::iterator domEnd = hiGhost.end();
 
@@ -234,6 +255,8 @@ void MPICartSubdivision<GridType>::exchange(GridType &grid, size_t dim)
       ++domIt;
     }
   }
+
+  internal::markHostModified(grid);
 }
 
 
@@ -252,20 +275,18 @@ void MPICartSubdivision<GridType>::accumulate(GridType &grid, size_t dim)
   DomainType loSource = this->bounds->getGhostSourceDomain(dim, BoundaryType::Min);
   DomainType hiSource = this->bounds->getGhostSourceDomain(dim, BoundaryType::Max);
 
-  MPI_Status stat;
+  internal::syncHostMirror(grid);
 
   value_type *send = sendarr[dim];
   value_type *recv = recvarr[dim];
 
-  MPI_Datatype mpiType = MpiValueType<value_type>::value;
-
   // == 1 ==
   // Add the lower ghost cells to the vales from higher source cells
   // in the neighbouring process
 
   // fill send buffer with values from inner cells
   {
-    int arr_ind = 0;
+    size_t arr_ind = 0;
     typename DomainType::iterator domIt  = hiSource.begin();
     typename DomainType::iterator domEnd = hiSource.end();
 
@@ -280,12 +301,10 @@ void MPICartSubdivision<GridType>::accumulate(GridType &grid, size_t dim)
     }
   }
   // send to neighbour
-  MPI_Sendrecv(send, exchSize[dim], mpiType, nextcoord[dim], 0,
-               recv, exchSize[dim], mpiType, prevcoord[dim], 0,
-               comm, &stat);
+  sendrecv(send, nextcoord[dim], recv, prevcoord[dim], exchSize[dim]);
   // add to the ghost cells and fill send array with the result
   {
-    int arr_ind = 0;
+    size_t arr_ind = 0;
     typename DomainType::iterator domIt  = loGhost.begin();
     typename DomainType::iterator domEnd = loGhost.end();
 
@@ -300,12 +319,10 @@ void MPICartSubdivision<GridType>::accumulate(GridType &grid, size_t dim)
     }
   }
   // send back to neighbour
-  MPI_Sendrecv(send, exchSize[dim], mpiType, prevcoord[dim], 0,
-               recv, exchSize[dim], mpiType, nextcoord[dim], 0,
-               comm, &stat);
+  sendrecv(send, prevcoord[dim], recv, nextcoord[dim], exchSize[dim]);
   // save result back to inner cells
   {
-    int arr_ind = 0;
+    size_t arr_ind = 0;
     typename DomainType::iterator domIt  = hiSource.begin();
     typename DomainType::iterator domEnd = hiSource.end();
 
@@ -326,7 +343,7 @@ void MPICartSubdivision<GridType>::accumulate(GridType &grid, size_t dim)
 
   // fill send buffer with values from inner cells
   {
-    int arr_ind = 0;
+    size_t arr_ind = 0;
     typename DomainType::iterator domIt  = loSource.begin();
     typename DomainType::iterator domEnd = loSource.end();
 
@@ -341,12 +358,10 @@ void MPICartSubdivision<GridType>::accumulate(GridType &grid, size_t dim)
     }
   }
   // send to neighbour
-  MPI_Sendrecv(send, exchSize[dim], mpiType, prevcoord[dim], 0,
-               recv, exchSize[dim], mpiType, nextcoord[dim], 0,
-               comm, &stat);
+  sendrecv(send, prevcoord[dim], recv, nextcoord[dim], exchSize[dim]);
   // add to the ghost cells and fill send array with the result
   {
-    int arr_ind = 0;
+    size_t arr_ind = 0;
     typename DomainType::iterator domIt  = hiGhost.begin();
     typename DomainType::iterator domEnd = hiGhost.end();
 
@@ -361,12 +376,10 @@ void MPICartSubdivision<GridType>::accumulate(GridType &grid, size_t dim)
     }
   }
   // send result back to neighbour
-  MPI_Sendrecv(send, exchSize[dim], mpiType, nextcoord[dim], 0,
-               recv, exchSize[dim], mpiType, prevcoord[dim], 0,
-               comm, &stat);
+  sendrecv(send, nextcoord[dim], recv, prevcoord[dim], exchSize[dim]);
   // save result back to inner cells
   {
-    int arr_ind = 0;
+    size_t arr_ind = 0;
     typename DomainType::iterator domIt  = loSource.begin();
     typename DomainType::iterator domEnd = loSource.end();
 
@@ -380,6 +393,8 @@ void MPICartSubdivision<GridType>::accumulate(GridType &grid, size_t dim)
       std::cerr << "Error "<< dim << "-max: "<< arr_ind << " vs " << exchSize[dim] << std::endl;
     }
   }
+
+  internal::markHostModified(grid);
 }
 
 template<class GridType>
@@ -29,6 +29,7 @@
 
 #include "grid.hpp"
 #include "range.hpp"
+#include "gridstorage/kokkos-subgrid-storage.hpp"
 
 namespace schnek {
 
@@ -42,6 +43,7 @@ class SubGridStorage {
     typedef Array<int,rank> IndexType;
     typedef BaseGrid BaseGridType;
     typedef Range<int, rank> DomainType;
+    typedef Range<int, rank> RangeType;
   protected:
     BaseGridType *baseGrid;
     DomainType domain;
@@ -49,22 +51,23 @@ class SubGridStorage {
 
   public:
 
+    /// The type returned by the writing accessors of the base grid
+    typedef typename BaseGrid::reference reference;
+
     class storage_iterator {
       protected:
         typename DomainType::iterator it;
         BaseGridType *baseGrid;
-        T* element;
         storage_iterator(typename DomainType::iterator it_, BaseGridType *baseGrid_)
-          : it(it_), baseGrid(baseGrid_), element(&baseGrid->get(*it)) {}
+          : it(it_), baseGrid(baseGrid_) {}
 
         friend class SubGridStorage;
 
       public:
-        T& operator*() { return *element;}
+        reference operator*() { return baseGrid->get(*it); }
         storage_iterator &operator++()
         {
           ++it;
-          element = &baseGrid->get(*it);
           return *this;
         }
         bool operator==(const storage_iterator &SI)
@@ -78,18 +81,16 @@ class SubGridStorage {
       protected:
         typename DomainType::iterator it;
         const BaseGridType *baseGrid;
-        const T* element;
         const_storage_iterator(typename DomainType::iterator it_, BaseGridType *baseGrid_)
-          : it(it_), baseGrid(baseGrid_), element(&baseGrid->get(*it)) {}
+          : it(it_), baseGrid(baseGrid_) {}
 
         friend class SubGridStorage;
 
       public:
-        const T& operator*() { return *element;}
+        decltype(auto) operator*() { return baseGrid->get(*it); }
         const_storage_iterator &operator++()
         {
           ++it;
-          element = &baseGrid->get(*it);
           return *this;
         }
         bool operator==(const const_storage_iterator &SI)
@@ -104,16 +105,17 @@ class SubGridStorage {
 
     void resize(const IndexType &low_, const IndexType &high_);
 
-    SCHNEK_INLINE T &get(const IndexType &index)
+    SCHNEK_INLINE reference get(const IndexType &index)
     {
       //typename BaseGrid::CheckingPolicy<rank>::check(index, domain.getLo(), domain.getHi());
       return baseGrid->get(baseGrid->check(index, domain.getLo(), domain.getHi()));
     }
 
-    SCHNEK_INLINE const T &get(const IndexType &index) const
+    SCHNEK_INLINE decltype(auto) get(const IndexType &index) const
     {
       //typename BaseGrid::CheckingPolicy<rank>::check(index, domain.getLo(), domain.getHi());
-      return baseGrid->get(baseGrid->check(index, domain.getLo(), domain.getHi()));
+      const BaseGridType *grid = baseGrid;
+      return grid->get(grid->check(index, domain.getLo(), domain.getHi()));
     }
 
     /** */
@@ -140,6 +142,29 @@ class SubGridStorage {
 
 };
 
+namespace internal {
+  /**
+   * Selects the storage of a SubGrid.
+   *
+   * Sub-grids of grids that keep their data in a Kokkos view use a subview of the base
+   * grid's view, see KokkosSubGridStorage. All other sub-grids forward element access
+   * to the base grid.
+   */
+  template<class BaseGrid, typename = void>
+  struct SubGridStorageSelector
+  {
+    typedef SubGridStorage<typename BaseGrid::value_type, BaseGrid::Rank, BaseGrid> type;
+  };
+
+#ifdef SCHNEK_HAVE_KOKKOS
+  template<class BaseGrid>
+  struct SubGridStorageSelector<BaseGrid, typename std::enable_if<HasKokkosView<BaseGrid>::value>::type>
+  {
+    typedef KokkosSubGridStorage<typename BaseGrid::value_type, BaseGrid::Rank, BaseGrid> type;
+  };
+#endif
+}
+
 template<
   class BaseGrid,
   template<size_t> class CheckingPolicy = GridNoArgCheck
@@ -150,11 +175,7 @@ class SubGrid
       typename BaseGrid::value_type,
       BaseGrid::Rank,
       CheckingPolicy<BaseGrid::Rank>,
-      SubGridStorage<
-        typename BaseGrid::value_type,
-        BaseGrid::Rank,
-        BaseGrid
-      >
+      typename internal::SubGridStorageSelector<BaseGrid>::type
     >
 {
   private:
@@ -163,11 +184,7 @@ class SubGrid
           typename BaseGrid::value_type,
           BaseGrid::Rank,
           CheckingPolicy<BaseGrid::Rank>,
-          SubGridStorage<
-            typename BaseGrid::value_type,
-            BaseGrid::Rank,
-            BaseGrid
-          >
+          typename internal::SubGridStorageSelector<BaseGrid>::type
         > ParentType;
 
   public:
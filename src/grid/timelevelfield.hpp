@@ -0,0 +1,153 @@
+/*
+ * timelevelfield.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHNEK_GRID_TIMELEVELFIELD_HPP_
+#define SCHNEK_GRID_TIMELEVELFIELD_HPP_
+
+#include "field.hpp"
+
+#include <array>
+#include <utility>
+
+namespace schnek
+{
+    /**
+     * @brief A set of fields holding the same quantity at successive time levels
+     *
+     * Multi-step time integration schemes, such as leapfrog or Adams-Bashforth, keep
+     * a quantity at several time levels. Instead of copying the data from one level to
+     * the next after each step, `rotate()` passes the buffers on from one level to the
+     * next. This does not touch the grid data, so it costs the same for any grid size.
+     *
+     * Level 0 is the most recent time level, level `nLevels-1` the oldest. Each level is
+     * a `Field` object that stays at a fixed address. Grids and views that refer to a
+     * level by reference, such as a `SubGrid`, always see the current data of that
+     * level. Copies of a level share the buffer and not the level, so they will see the
+     * data of a different level after a rotation.
+     *
+     * @tparam T The type of data stored in the fields
+     * @tparam rank The rank of the fields
+     * @tparam nLevels The number of time levels, must be at least 2
+     * @tparam CheckingPolicy The grid checking policy of the fields
+     * @tparam StoragePolicy The grid storage policy of the fields
+     */
+    template <
+        typename T,
+        size_t rank,
+        size_t nLevels,
+        template <size_t> class CheckingPolicy = GridNoArgCheck,
+        template <typename, size_t> class StoragePolicy = SingleArrayGridStorage
+    >
+    class TimeLevelField
+    {
+        static_assert(nLevels >= 2, "a time level field needs at least two levels");
+    public:
+        /// The type of the field at each time level
+        typedef Field<T, rank, CheckingPolicy, StoragePolicy> FieldType;
+
+        /// The grid index type
+        typedef typename FieldType::IndexType IndexType;
+
+        /// The number of time levels
+        static constexpr size_t Levels = nLevels;
+    private:
+        std::array<FieldType, nLevels> levels;
+    public:
+        /// Default constructor creates empty fields
+        TimeLevelField() {}
+
+        /**
+         * @brief Construct all levels with the same size, see the corresponding `Field` constructor
+         */
+        template<
+            template<size_t> class ArrayCheckingPolicy,
+            template<size_t> class RangeCheckingPolicy,
+            template<size_t> class StaggerCheckingPolicy>
+        TimeLevelField(
+            const Array<int, rank, ArrayCheckingPolicy> &size,
+            const Range<double, rank, RangeCheckingPolicy> &domain,
+            const Array<bool, rank, StaggerCheckingPolicy> &stagger,
+            int ghostCells
+        )
+        {
+            resize(size, domain, stagger, ghostCells);
+        }
+
+        /**
+         * @brief Resize all levels, see the corresponding `Field::resize`
+         */
+        template<
+            template<size_t> class ArrayCheckingPolicy,
+            template<size_t> class RangeCheckingPolicy,
+            template<size_t> class StaggerCheckingPolicy>
+        void resize(
+            const Array<int, rank, ArrayCheckingPolicy> &size,
+            const Range<double, rank, RangeCheckingPolicy> &domain,
+            const Array<bool, rank, StaggerCheckingPolicy> &stagger,
+            int ghostCells
+        )
+        {
+            for (FieldType &field : levels)
+            {
+                field.resize(size, domain, stagger, ghostCells);
+            }
+        }
+
+        /**
+         * @brief The field at a time level, 0 being the most recent
+         */
+        FieldType &operator[](size_t level) { return levels[level]; }
+
+        /**
+         * @brief The field at a time level, 0 being the most recent
+         */
+        const FieldType &operator[](size_t level) const { return levels[level]; }
+
+        /// The field at the most recent time level
+        FieldType &current() { return levels[0]; }
+
+        /// The field at the oldest time level
+        FieldType &oldest() { return levels[nLevels - 1]; }
+
+        /**
+         * @brief Advance the time levels by one step
+         *
+         * Every level takes over the buffer of the next more recent level. Level 0
+         * receives the buffer of the oldest level, which can then be overwritten with
+         * the new time step. No grid data is copied.
+         */
+        void rotate()
+        {
+            FieldType oldestField(std::move(levels[nLevels - 1]));
+            for (size_t l = nLevels - 1; l > 0; --l)
+            {
+                levels[l] = std::move(levels[l - 1]);
+            }
+            levels[0] = std::move(oldestField);
+        }
+    };
+}
+
+#endif // SCHNEK_GRID_TIMELEVELFIELD_HPP_
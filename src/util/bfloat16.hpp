@@ -0,0 +1,118 @@
+/*
+ * bfloat16.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SCHNEK_UTIL_BFLOAT16_HPP_
+#define SCHNEK_UTIL_BFLOAT16_HPP_
+
+#include "../macros.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace schnek {
+
+    /**
+     * @brief A 16-bit floating point number in the bfloat16 format
+     *
+     * The bfloat16 format keeps the sign and the 8 exponent bits of a 32-bit float but only
+     * the upper 7 bits of the mantissa. It has the same range as `float` with a precision of
+     * about three significant digits. The conversion is done in software. Converting from
+     * `float` or `double` rounds to the nearest representable value, ties to even. NaNs stay
+     * NaNs.
+     *
+     * Like the built-in floating point types, a default constructed BFloat16 is not
+     * initialised.
+     */
+    class BFloat16
+    {
+    private:
+        uint16_t bits;
+    public:
+        /// Default constructor, the value is undefined
+        BFloat16() = default;
+
+        /// Convert from float, rounding to the nearest representable value
+        SCHNEK_INLINE explicit BFloat16(float value) : bits(fromFloat(value)) {}
+
+        /// Convert from double, rounding once to the nearest representable value
+        SCHNEK_INLINE explicit BFloat16(double value) : bits(fromDouble(value)) {}
+
+        /// Convert to float, this is exact
+        SCHNEK_INLINE operator float() const
+        {
+            uint32_t u = uint32_t(bits) << 16;
+            float value;
+            std::memcpy(&value, &u, sizeof(value));
+            return value;
+        }
+
+        /// The bit pattern of the number
+        SCHNEK_INLINE uint16_t getBits() const { return bits; }
+
+        /// Create a number from its bit pattern
+        static BFloat16 fromBits(uint16_t bits)
+        {
+            BFloat16 result;
+            result.bits = bits;
+            return result;
+        }
+    private:
+        SCHNEK_INLINE static uint16_t fromFloat(float value)
+        {
+            uint32_t u;
+            std::memcpy(&u, &value, sizeof(u));
+            if ((u & 0x7fffffffu) > 0x7f800000u)
+            {
+                // keep NaNs quiet, rounding could turn them into infinities
+                return uint16_t((u >> 16) | 0x0040u);
+            }
+            u += 0x7fffu + ((u >> 16) & 1u);
+            return uint16_t(u >> 16);
+        }
+
+        SCHNEK_INLINE static uint16_t fromDouble(double value)
+        {
+            // Rounding to float first would round twice. Values just above a tie would
+            // become a tie and be rounded to even. Narrowing to float with round-to-odd
+            // keeps the information that the value was inexact, so that fromFloat rounds
+            // correctly.
+            float narrow = float(value);
+            if (double(narrow) != value && value == value)
+            {
+                uint32_t u;
+                std::memcpy(&u, &narrow, sizeof(u));
+                if (std::fabs(double(narrow)) > std::fabs(value)) --u;
+                u |= 1u;
+                std::memcpy(&narrow, &u, sizeof(narrow));
+            }
+            return fromFloat(narrow);
+        }
+    };
+
+} // namespace schnek
+
+#endif // SCHNEK_UTIL_BFLOAT16_HPP_
@@ -0,0 +1,251 @@
+/*
+ * memorypool.cpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "memorypool.hpp"
+
+#include <memory>
+#include <new>
+
+using namespace schnek;
+
+namespace {
+  /// The maximum number of blocks per size class in a thread cache
+  const size_t maxCachedPerClass = 4;
+
+  /// The maximum number of bytes in a thread cache
+  const size_t maxCachedBytes = size_t(64)*1024*1024;
+
+  /// The default maximum number of bytes held by the pool
+  const size_t defaultMaxHeldBytes = size_t(1024)*1024*1024;
+}
+
+/** The free blocks cached by a single thread.
+ *
+ *  The cache is created on the first allocation of a thread and
+ *  registered with the pool, so that trim() can release its blocks.
+ *  When the thread terminates, the blocks are moved to the shared lists.
+ */
+struct MemoryPool::ThreadCache
+{
+  MemoryPool &pool;
+  std::mutex mutex;
+  std::vector<std::vector<void*> > blocks;
+  size_t bytes;
+
+  ThreadCache(MemoryPool &pool) : pool(pool), blocks(numClasses), bytes(0)
+  {
+    std::lock_guard<std::mutex> poolLock(pool.mutex);
+    pool.caches.push_back(this);
+  }
+
+  ~ThreadCache()
+  {
+    std::lock_guard<std::mutex> poolLock(pool.mutex);
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t cls=0; cls<numClasses; ++cls)
+    {
+      pool.freeBlocks[cls].insert(pool.freeBlocks[cls].end(), blocks[cls].begin(), blocks[cls].end());
+    }
+    pool.caches.remove(this);
+  }
+};
+
+MemoryPool::MemoryPool()
+  : freeBlocks(numClasses), hits(0), misses(0), bytesHeld(0), bytesInUse(0),
+    maxHeldBytes(defaultMaxHeldBytes)
+{}
+
+MemoryPool::~MemoryPool()
+{
+  trim();
+}
+
+size_t MemoryPool::sizeClass(size_t bytes)
+{
+  if (bytes <= blockAlignment) return 0;
+
+  // the position of the highest bit of bytes-1, the power of two below bytes
+  size_t k = 0;
+  for (size_t n = bytes - 1; n > 1; n >>= 1) ++k;
+
+  const size_t base = size_t(1) << k;
+  const size_t step = base / 4;
+  const size_t sub = (bytes - base + step - 1) / step;
+  const size_t cls = 4*(k - 6) + sub;
+  return cls < numClasses ? cls : numClasses;
+}
+
+size_t MemoryPool::classBytes(size_t cls)
+{
+  const size_t base = blockAlignment << (cls / 4);
+  return base + (cls % 4)*(base / 4);
+}
+
+MemoryPool::ThreadCache &MemoryPool::localCache()
+{
+  thread_local std::unique_ptr<ThreadCache> cache;
+  if (!cache) cache.reset(new ThreadCache(*this));
+  return *cache;
+}
+
+bool MemoryPool::reserveHeld(size_t bytes)
+{
+  size_t held = bytesHeld;
+  while (held + bytes <= maxHeldBytes)
+  {
+    if (bytesHeld.compare_exchange_weak(held, held + bytes)) return true;
+  }
+  return false;
+}
+
+void *MemoryPool::allocate(size_t bytes)
+{
+  const size_t cls = sizeClass(bytes);
+  if (cls == numClasses)
+  {
+    ++misses;
+    void *ptr = systemAllocate(bytes);
+    bytesInUse += bytes;
+    return ptr;
+  }
+
+  const size_t blockBytes = classBytes(cls);
+  void *ptr = NULL;
+
+  ThreadCache &cache = localCache();
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (!cache.blocks[cls].empty())
+    {
+      ptr = cache.blocks[cls].back();
+      cache.blocks[cls].pop_back();
+      cache.bytes -= blockBytes;
+    }
+  }
+
+  if (ptr == NULL)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!freeBlocks[cls].empty())
+    {
+      ptr = freeBlocks[cls].back();
+      freeBlocks[cls].pop_back();
+    }
+  }
+
+  if (ptr != NULL)
+  {
+    ++hits;
+    bytesHeld -= blockBytes;
+  }
+  else
+  {
+    ++misses;
+    ptr = systemAllocate(blockBytes);
+  }
+  bytesInUse += blockBytes;
+  return ptr;
+}
+
+void MemoryPool::deallocate(void *ptr, size_t bytes)
+{
+  if (ptr == NULL) return;
+
+  const size_t cls = sizeClass(bytes);
+  if (cls == numClasses)
+  {
+    bytesInUse -= bytes;
+    systemDeallocate(ptr);
+    return;
+  }
+
+  const size_t blockBytes = classBytes(cls);
+  bytesInUse -= blockBytes;
+
+  if (!reserveHeld(blockBytes))
+  {
+    systemDeallocate(ptr);
+    return;
+  }
+
+  ThreadCache &cache = localCache();
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if ((cache.blocks[cls].size() < maxCachedPerClass) && (cache.bytes + blockBytes <= maxCachedBytes))
+    {
+      cache.blocks[cls].push_back(ptr);
+      cache.bytes += blockBytes;
+      return;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  freeBlocks[cls].push_back(ptr);
+}
+
+void MemoryPool::trim()
+{
+  std::lock_guard<std::mutex> poolLock(mutex);
+  for (ThreadCache *cache : caches)
+  {
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    for (size_t cls=0; cls<numClasses; ++cls)
+    {
+      for (void *ptr : cache->blocks[cls]) systemDeallocate(ptr);
+      bytesHeld -= cache->blocks[cls].size()*classBytes(cls);
+      cache->blocks[cls].clear();
+    }
+    cache->bytes = 0;
+  }
+
+  for (size_t cls=0; cls<numClasses; ++cls)
+  {
+    for (void *ptr : freeBlocks[cls]) systemDeallocate(ptr);
+    bytesHeld -= freeBlocks[cls].size()*classBytes(cls);
+    freeBlocks[cls].clear();
+  }
+}
+
+MemoryPool::Statistics MemoryPool::getStatistics() const
+{
+  return Statistics{hits, misses, bytesHeld, bytesInUse};
+}
+
+void MemoryPool::resetStatistics()
+{
+  hits = 0;
+  misses = 0;
+}
+
+void *MemoryPool::systemAllocate(size_t bytes)
+{
+  return ::operator new(bytes, std::align_val_t(blockAlignment));
+}
+
+void MemoryPool::systemDeallocate(void *ptr)
+{
+  ::operator delete(ptr, std::align_val_t(blockAlignment));
+}
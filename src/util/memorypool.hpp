@@ -0,0 +1,144 @@
+/*
+ * memorypool.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SCHNEK_UTIL_MEMORYPOOL_HPP_
+#define SCHNEK_UTIL_MEMORYPOOL_HPP_
+
+#include "singleton.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <vector>
+
+namespace schnek {
+
+/** A pool of memory blocks sorted into size classes.
+ *
+ *  Freed blocks are kept by the pool and handed out again when a block
+ *  of the same size class is requested. The size classes are spaced by
+ *  a quarter of a power of two, so a block is at most 25% larger than
+ *  requested.
+ *
+ *  Each thread has a small cache of blocks that is accessed without
+ *  contention. Blocks that do not fit into the thread cache go to a
+ *  shared list. The pool holds at most getMaxHeldBytes() bytes in free
+ *  blocks, further blocks are returned to the system. The memory held by
+ *  the pool can be released explicitly by calling trim().
+ *
+ *  All blocks are aligned to MemoryPool::blockAlignment bytes. Requests
+ *  larger than the largest size class bypass the pool.
+ */
+class MemoryPool : public Singleton<MemoryPool>
+{
+  public:
+    /// The alignment of all blocks in bytes
+    static constexpr size_t blockAlignment = 64;
+
+    /// The number of size classes
+    static constexpr size_t numClasses = 4*(40 - 6) + 1;
+
+    /// Statistics of the pool usage
+    struct Statistics
+    {
+      /// Number of requests that were served from a free block
+      size_t hits;
+      /// Number of requests that had to allocate memory from the system
+      size_t misses;
+      /// Number of bytes held in free blocks
+      size_t bytesHeld;
+      /// Number of bytes in blocks that are currently handed out
+      size_t bytesInUse;
+    };
+
+    /** Obtain a block of at least `bytes` bytes */
+    void *allocate(size_t bytes);
+
+    /** Return a block that has been obtained by allocate(bytes) */
+    void deallocate(void *ptr, size_t bytes);
+
+    /** Return all free blocks to the system */
+    void trim();
+
+    /** The current statistics */
+    Statistics getStatistics() const;
+
+    /** Set the hit and miss counters to zero */
+    void resetStatistics();
+
+    /** The maximum number of bytes held in free blocks */
+    size_t getMaxHeldBytes() const { return maxHeldBytes; }
+
+    /** Set the maximum number of bytes held in free blocks
+     *
+     *  Reducing the limit does not release any memory, call trim() for
+     *  that.
+     */
+    void setMaxHeldBytes(size_t bytes) { maxHeldBytes = bytes; }
+
+    /** The size class of a request of `bytes` bytes */
+    static size_t sizeClass(size_t bytes);
+
+    /** The block size in bytes of the size class `cls` */
+    static size_t classBytes(size_t cls);
+  private:
+    friend class Singleton<MemoryPool>;
+    friend class CreateUsingNew<MemoryPool>;
+
+    struct ThreadCache;
+    friend struct ThreadCache;
+
+    /// Protects the shared free lists and the list of thread caches
+    std::mutex mutex;
+
+    /// The shared free lists, one for each size class
+    std::vector<std::vector<void*> > freeBlocks;
+
+    /// The caches of all running threads
+    std::list<ThreadCache*> caches;
+
+    std::atomic<size_t> hits;
+    std::atomic<size_t> misses;
+    std::atomic<size_t> bytesHeld;
+    std::atomic<size_t> bytesInUse;
+    std::atomic<size_t> maxHeldBytes;
+
+    MemoryPool();
+    ~MemoryPool();
+
+    ThreadCache &localCache();
+
+    /// Reserve `bytes` of the held bytes limit, returns false if the limit would be exceeded
+    bool reserveHeld(size_t bytes);
+
+    static void *systemAllocate(size_t bytes);
+    static void systemDeallocate(void *ptr);
+};
+
+} // namespace schnek
+
+#endif // SCHNEK_UTIL_MEMORYPOOL_HPP_
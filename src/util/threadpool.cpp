@@ -0,0 +1,267 @@
+/*
+ * threadpool.cpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "threadpool.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <utility>
+
+using namespace schnek;
+
+namespace {
+  /// Set on threads while they execute a task of the pool
+  thread_local bool threadInsideTask = false;
+
+  size_t envNumThreads(const char *name)
+  {
+    const char *value = std::getenv(name);
+    if (value == NULL) return 0;
+    long num = std::strtol(value, NULL, 10);
+    return num > 0 ? size_t(num) : 0;
+  }
+
+  size_t defaultNumThreads()
+  {
+    size_t num = envNumThreads("SCHNEK_NUM_THREADS");
+    if (num == 0) num = envNumThreads("OMP_NUM_THREADS");
+    if (num == 0) num = std::thread::hardware_concurrency();
+    return num > 0 ? num : 1;
+  }
+
+  /// An interval of indices [first, second)
+  typedef std::pair<size_t, size_t> Interval;
+
+  /// The intervals owned by one thread during ThreadPool::runWorkStealing
+  struct StealingDeque
+  {
+    std::mutex mutex;
+    std::deque<Interval> intervals;
+
+    void push(const Interval &interval)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      intervals.push_back(interval);
+    }
+
+    /// Take the most recently pushed interval, used by the owner
+    bool pop(Interval &interval)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (intervals.empty()) return false;
+      interval = intervals.back();
+      intervals.pop_back();
+      return true;
+    }
+
+    /// Take the oldest interval, used by other threads
+    bool steal(Interval &interval)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (intervals.empty()) return false;
+      interval = intervals.front();
+      intervals.pop_front();
+      return true;
+    }
+  };
+}
+
+ThreadPool::ThreadPool()
+  : numThreads(defaultNumThreads()), task(NULL), generation(0), pending(0), shutdown(false)
+{
+  startWorkers();
+}
+
+ThreadPool::~ThreadPool()
+{
+  stopWorkers();
+}
+
+void ThreadPool::setNumThreads(size_t numThreads_)
+{
+  std::lock_guard<std::mutex> runLock(runMutex);
+  stopWorkers();
+  numThreads = numThreads_ > 0 ? numThreads_ : 1;
+  startWorkers();
+}
+
+bool ThreadPool::insideTask()
+{
+  return threadInsideTask;
+}
+
+void ThreadPool::run(const TaskType &task_)
+{
+  if (threadInsideTask || numThreads == 1)
+  {
+    bool outer = threadInsideTask;
+    threadInsideTask = true;
+    try
+    {
+      for (size_t i=0; i<numThreads; ++i) task_(i);
+    }
+    catch (...)
+    {
+      threadInsideTask = outer;
+      throw;
+    }
+    threadInsideTask = outer;
+    return;
+  }
+
+  std::lock_guard<std::mutex> runLock(runMutex);
+  {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    task = &task_;
+    error = nullptr;
+    pending = workers.size();
+    ++generation;
+  }
+  startCondition.notify_all();
+
+  execute(0);
+
+  std::exception_ptr taskError;
+  {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    doneCondition.wait(lock, [this]{ return pending == 0; });
+    task = NULL;
+    taskError = error;
+    error = nullptr;
+  }
+
+  if (taskError) std::rethrow_exception(taskError);
+}
+
+void ThreadPool::runWorkStealing(size_t begin, size_t end, size_t grain, const RangeTaskType &task_)
+{
+  if (end <= begin) return;
+  if (grain == 0) grain = 1;
+
+  const size_t parts = numThreads;
+  std::vector<StealingDeque> deques(parts);
+  for (size_t part=0; part<parts; ++part)
+  {
+    size_t partLo, partHi;
+    partitionRange(begin, end - 1, part, parts, partLo, partHi);
+    if (partLo <= partHi) deques[part].intervals.push_back(Interval(partLo, partHi + 1));
+  }
+
+  std::atomic<size_t> remaining(end - begin);
+  std::atomic<bool> aborted(false);
+
+  run([&](size_t self) {
+    Interval work;
+    while ((remaining.load(std::memory_order_acquire) > 0) && !aborted.load(std::memory_order_relaxed))
+    {
+      bool found = deques[self].pop(work);
+      for (size_t i=1; !found && (i<parts); ++i)
+      {
+        found = deques[(self + i) % parts].steal(work);
+      }
+      if (!found)
+      {
+        std::this_thread::yield();
+        continue;
+      }
+
+      while (work.second - work.first > grain)
+      {
+        const size_t mid = work.first + (work.second - work.first)/2;
+        deques[self].push(Interval(mid, work.second));
+        work.second = mid;
+      }
+
+      try
+      {
+        task_(work.first, work.second);
+      }
+      catch (...)
+      {
+        aborted = true;
+        throw;
+      }
+      remaining.fetch_sub(work.second - work.first, std::memory_order_acq_rel);
+    }
+  });
+}
+
+void ThreadPool::execute(size_t index)
+{
+  threadInsideTask = true;
+  try
+  {
+    (*task)(index);
+  }
+  catch (...)
+  {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (!error) error = std::current_exception();
+  }
+  threadInsideTask = false;
+}
+
+void ThreadPool::workerLoop(size_t index, size_t seen)
+{
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(stateMutex);
+      startCondition.wait(lock, [this, seen]{ return shutdown || generation != seen; });
+      if (shutdown) return;
+      seen = generation;
+    }
+
+    execute(index);
+
+    {
+      std::lock_guard<std::mutex> lock(stateMutex);
+      --pending;
+    }
+    doneCondition.notify_one();
+  }
+}
+
+void ThreadPool::startWorkers()
+{
+  shutdown = false;
+  for (size_t i=1; i<numThreads; ++i)
+  {
+    workers.emplace_back([this, i, g = generation]{ workerLoop(i, g); });
+  }
+}
+
+void ThreadPool::stopWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    shutdown = true;
+  }
+  startCondition.notify_all();
+  for (std::thread &worker : workers) worker.join();
+  workers.clear();
+}
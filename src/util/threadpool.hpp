@@ -0,0 +1,177 @@
+/*
+ * threadpool.hpp
+ *
+ * Created on: 18 Oct 2026
+ * Author: Holger Schmitz
+ * Email: holger@notjustphysics.com
+ *
+ * Copyright 2012-2026 Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SCHNEK_UTIL_THREADPOOL_HPP_
+#define SCHNEK_UTIL_THREADPOOL_HPP_
+
+#include "singleton.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace schnek {
+
+/** A pool of persistent worker threads.
+ *
+ *  The pool executes a task on all of its threads and waits for the
+ *  task to complete. The calling thread takes part in the execution as
+ *  thread 0, so a pool with a single thread does not start any workers.
+ *
+ *  The number of threads is taken from the environment variable
+ *  SCHNEK_NUM_THREADS. If it is not set, OMP_NUM_THREADS is used and,
+ *  failing that, the number of hardware threads.
+ *
+ *  Tasks that are run from inside a task are executed serially on the
+ *  calling thread.
+ */
+class ThreadPool : public Singleton<ThreadPool>
+{
+  public:
+    /// The task type, the argument is the index of the executing thread
+    typedef std::function<void(size_t)> TaskType;
+
+    /// The task type for index intervals, the arguments are the bounds `[begin, end)`
+    typedef std::function<void(size_t, size_t)> RangeTaskType;
+
+    /** The number of threads, including the calling thread */
+    size_t getNumThreads() const { return numThreads; }
+
+    /** Set the number of threads, including the calling thread.
+     *
+     *  Must not be called while a task is running.
+     */
+    void setNumThreads(size_t numThreads);
+
+    /** Run the task on all threads and wait for completion
+     *
+     *  The task is called with the thread index 0,...,getNumThreads()-1.
+     *  If the task throws on any thread, the first exception is rethrown
+     *  on the calling thread after all threads have finished.
+     */
+    void run(const TaskType &task);
+
+    /** Process the index interval [begin, end) on all threads using work stealing
+     *
+     *  Every thread starts with a contiguous block of the interval, as
+     *  given by partitionRange(), and keeps it in its own deque. A thread
+     *  takes the most recently added interval from the back of its deque
+     *  and splits it in halves, pushing the upper half back onto the
+     *  deque, until it is no longer than `grain`. It then calls the task
+     *  on this interval. A thread whose deque is empty steals the oldest,
+     *  and therefore largest, interval from the front of the deque of
+     *  another thread. This balances the load when the cost of the work
+     *  varies across the interval.
+     *
+     *  The task is called concurrently with disjoint intervals that
+     *  together cover [begin, end). If the task throws, the remaining
+     *  work is abandoned and the first exception is rethrown on the
+     *  calling thread.
+     *
+     *  @param begin The first index
+     *  @param end One past the last index
+     *  @param grain The largest interval passed to the task, at least one
+     *  @param task Called with the bounds of each interval
+     */
+    void runWorkStealing(size_t begin, size_t end, size_t grain, const RangeTaskType &task);
+
+    /** True if the current thread is executing a task of the pool */
+    static bool insideTask();
+  private:
+    friend class Singleton<ThreadPool>;
+    friend class CreateUsingNew<ThreadPool>;
+
+    /// The number of threads, including the calling thread
+    size_t numThreads;
+
+    /// The worker threads, thread i has index i+1
+    std::vector<std::thread> workers;
+
+    /// Serialises calls to run from different threads
+    std::mutex runMutex;
+
+    /// Protects the task state below
+    std::mutex stateMutex;
+    std::condition_variable startCondition;
+    std::condition_variable doneCondition;
+
+    /// The current task
+    const TaskType *task;
+
+    /// Incremented for each new task
+    size_t generation;
+
+    /// The number of workers that have not finished the current task
+    size_t pending;
+
+    /// Set when the workers should terminate
+    bool shutdown;
+
+    /// The first exception thrown by the current task
+    std::exception_ptr error;
+
+    ThreadPool();
+    ~ThreadPool();
+
+    void startWorkers();
+    void stopWorkers();
+    void workerLoop(size_t index, size_t seen);
+    void execute(size_t index);
+};
+
+/** Split the inclusive index range [lo, hi] into a number of parts.
+ *
+ *  Calculates the inclusive bounds [partLo, partHi] of the part with
+ *  index `part` when [lo, hi] is split into `parts` contiguous parts of
+ *  nearly equal size. The parts differ in length by at most one. If
+ *  there are more parts than indices, the trailing parts are empty and
+ *  partLo > partHi.
+ *
+ *  This is the static decomposition used by the parallel first-touch
+ *  allocation. Parallel loops should use the same decomposition of the
+ *  outermost dimension so that each thread works on memory that it has
+ *  touched first.
+ */
+template<typename IndexType>
+inline void partitionRange(IndexType lo, IndexType hi, size_t part, size_t parts,
+                           IndexType &partLo, IndexType &partHi)
+{
+  const size_t length = (hi < lo) ? 0 : size_t(hi - lo) + 1;
+  const size_t base = length / parts;
+  const size_t remainder = length % parts;
+  const size_t offset = part*base + (part < remainder ? part : remainder);
+  const size_t partLength = base + (part < remainder ? 1 : 0);
+  partLo = lo + IndexType(offset);
+  partHi = partLo + IndexType(partLength) - 1;
+}
+
+} // namespace schnek
+
+#endif // SCHNEK_UTIL_THREADPOOL_HPP_
@@ -0,0 +1,233 @@
+/*
+ * test_hdf_io.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ */
+
+#include <config.hpp>
+
+#ifdef SCHNEK_HAVE_HDF5
+
+#include "../utility.hpp"
+
+#include <diagnostic/hdfdiagnostic.hpp>
+#include <grid/grid.hpp>
+#include <grid/gridstorage/reduced-precision-storage.hpp>
+#include <grid/gridstorage/morton-storage.hpp>
+#include <grid/gridstorage/soa-storage.hpp>
+#include <grid/gridstorage/tiled-storage.hpp>
+#include <grid/iteration/range-iteration.hpp>
+#include <util/bfloat16.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include <unistd.h>
+
+using namespace schnek;
+
+struct HdfIOTest
+{
+    std::string tempFileName(const std::string &name)
+    {
+      return (std::filesystem::temp_directory_path()
+              / ("schnek-test-" + name + "-" + std::to_string(getpid()) + ".h5")).string();
+    }
+
+    /// Resize the grid of a container and let the local range cover the whole grid
+    template<typename GridType>
+    void initContainer(GridContainer<GridType> &container,
+                       const typename GridType::IndexType &lo,
+                       const typename GridType::IndexType &hi)
+    {
+      container.grid.resize(lo, hi);
+      container.global_min = lo;
+      container.global_max = hi;
+      container.local_min = lo;
+      container.local_max = hi;
+    }
+
+    /// A value that is different for every grid point
+    template<size_t rank>
+    static double value(const Array<int, rank> &pos)
+    {
+      double result = 0.0;
+      for (size_t d=0; d<rank; ++d) result = 37.0*result + pos[d];
+      return 0.125*result + 0.5;
+    }
+
+    /**
+     * Write a grid of type WriteGridType to a file and read it back into grids of
+     * type ReadGridType and of the plain C-ordered grid type
+     *
+     * The values read back must be the values held by the written grid.
+     */
+    template<typename WriteGridType, typename ReadGridType = WriteGridType>
+    void check_round_trip(const std::string &name,
+                          const typename WriteGridType::IndexType &lo,
+                          const typename WriteGridType::IndexType &hi)
+    {
+      static const size_t rank = WriteGridType::Rank;
+      typedef typename WriteGridType::IndexType IndexType;
+      const internal::RangeBounds<IndexType> range{lo, hi};
+      const std::string path = tempFileName(name);
+
+      GridContainer<WriteGridType> out;
+      initContainer(out, lo, hi);
+      RangeCIterationPolicy<rank>::forEach(range, [&](const IndexType &pos) {
+        out.grid[pos] = value<rank>(pos);
+      });
+
+      {
+        HdfOStream stream(path.c_str());
+        stream.writeGrid(out);
+        stream.close();
+      }
+
+      GridContainer<ReadGridType> in;
+      initContainer(in, lo, hi);
+      GridContainer<Grid<double, rank> > plain;
+      initContainer(plain, lo, hi);
+      RangeCIterationPolicy<rank>::forEach(range, [&](const IndexType &pos) {
+        in.grid[pos] = -1.0;
+        plain.grid[pos] = -1.0;
+      });
+
+      {
+        HdfIStream stream(path.c_str());
+        stream.readGrid(in);
+        stream.close();
+      }
+      {
+        HdfIStream stream(path.c_str());
+        stream.readGrid(plain);
+        stream.close();
+      }
+
+      const WriteGridType &written = out.grid;
+      const ReadGridType &readBack = in.grid;
+      const Grid<double, rank> &readPlain = plain.grid;
+      bool same = true;
+      RangeCIterationPolicy<rank>::forEach(range, [&](const IndexType &pos) {
+        same = same && (double(readBack[pos]) == double(written[pos]));
+        same = same && (readPlain[pos] == double(written[pos]));
+      });
+      BOOST_CHECK(same);
+
+      std::remove(path.c_str());
+    }
+};
+
+BOOST_AUTO_TEST_SUITE( diagnostic )
+
+BOOST_AUTO_TEST_SUITE( hdf_io )
+
+BOOST_FIXTURE_TEST_CASE( reduced_precision, HdfIOTest )
+{
+  typedef Grid<double, 2, GridNoArgCheck, ReducedPrecision<float>::Storage> FloatGrid;
+  typedef Grid<double, 3, GridNoArgCheck, ReducedPrecision<BFloat16>::Storage> BFloatGrid;
+
+  check_round_trip<FloatGrid>("float", Array<int, 2>(-2, 3), Array<int, 2>(9, 17));
+  check_round_trip<BFloatGrid>("bfloat16", Array<int, 3>(0, -3, 1), Array<int, 3>(5, 4, 12));
+}
+
+BOOST_FIXTURE_TEST_CASE( non_c_layouts, HdfIOTest )
+{
+  // the data of these grids is not a dense array in C order and is copied element by element
+  typedef Grid<double, 2, GridNoArgCheck, TiledGridStorage> TiledGrid2d;
+  typedef Grid<double, 3, GridNoArgCheck, TiledGridStorage> TiledGrid3d;
+  typedef Grid<double, 2, GridNoArgCheck, MortonGridStorage> MortonGrid2d;
+  typedef Grid<double, 3, GridNoArgCheck, MortonGridStorage> MortonGrid3d;
+  typedef Grid<double, 2, GridNoArgCheck, CircularGridStorage> CircularGrid2d;
+  typedef Grid<double, 3, GridNoArgCheck, CircularGridStorage> CircularGrid3d;
+  typedef Grid<double, 3, GridNoArgCheck, SingleArrayGridStorageFortran> FortranGrid3d;
+  typedef Grid<double, 2, GridNoArgCheck, SparseGridStorage> SparseGrid2d;
+
+  check_round_trip<TiledGrid2d>("tiled2d", Array<int, 2>(-2, 3), Array<int, 2>(19, 13));
+  check_round_trip<TiledGrid3d>("tiled3d", Array<int, 3>(1, -4, 0), Array<int, 3>(10, 6, 20));
+  check_round_trip<MortonGrid2d>("morton2d", Array<int, 2>(-2, 3), Array<int, 2>(9, 17));
+  check_round_trip<MortonGrid3d>("morton3d", Array<int, 3>(0, -3, 1), Array<int, 3>(5, 4, 12));
+  // the lowest coordinates are not multiples of the extents, so the data is rotated in memory
+  check_round_trip<CircularGrid2d>("circular2d", Array<int, 2>(-2, 3), Array<int, 2>(9, 17));
+  check_round_trip<CircularGrid3d>("circular3d", Array<int, 3>(7, -3, 1), Array<int, 3>(12, 4, 12));
+  check_round_trip<FortranGrid3d>("fortran3d", Array<int, 3>(0, -3, 1), Array<int, 3>(5, 4, 12));
+  check_round_trip<SparseGrid2d>("sparse2d", Array<int, 2>(-2, 3), Array<int, 2>(19, 23));
+
+  // a tiled grid can be read back into a Morton grid
+  check_round_trip<TiledGrid2d, MortonGrid2d>("tiled-morton", Array<int, 2>(-2, 3), Array<int, 2>(19, 13));
+}
+
+BOOST_FIXTURE_TEST_CASE( padded, HdfIOTest )
+{
+  // the lines of these grids are padded, so the allocated array is larger than the grid
+  typedef Grid<double, 2, GridNoArgCheck, AlignedArrayGridStorage> AlignedGrid2d;
+  typedef Grid<double, 3, GridNoArgCheck, AlignedArrayGridStorage> AlignedGrid3d;
+  typedef Grid<double, 3, GridNoArgCheck, AlignedArrayGridStorageFortran> AlignedFortranGrid3d;
+
+  AlignedGrid3d padded(Array<int, 3>(0, -3, 1), Array<int, 3>(5, 4, 12));
+  BOOST_REQUIRE(padded.stride(1) > padded.getDims(2));
+
+  check_round_trip<AlignedGrid2d>("aligned2d", Array<int, 2>(-2, 3), Array<int, 2>(9, 17));
+  check_round_trip<AlignedGrid3d>("aligned3d", Array<int, 3>(0, -3, 1), Array<int, 3>(5, 4, 12));
+  check_round_trip<AlignedFortranGrid3d>("aligned-fortran3d", Array<int, 3>(0, -3, 1), Array<int, 3>(5, 4, 12));
+
+  // a padded grid can be read back into a dense grid and vice versa
+  check_round_trip<AlignedGrid2d, Grid<double, 2> >("aligned-dense", Array<int, 2>(-2, 3), Array<int, 2>(9, 17));
+  check_round_trip<Grid<double, 2>, AlignedGrid2d>("dense-aligned", Array<int, 2>(-2, 3), Array<int, 2>(9, 17));
+}
+
+BOOST_FIXTURE_TEST_CASE( soa_components, HdfIOTest )
+{
+  // writeGrid() rejects grids with structure-of-arrays storage, each component is written separately
+  typedef Array<double, 3> Vector;
+  typedef Grid<Vector, 2, GridNoArgCheck, SoAGridStorage> SoAGrid;
+  static_assert(internal::HasComponentData<SoAGrid>::value, "SoA grids must be detected");
+  static_assert(!internal::HasComponentData<Grid<double, 2> >::value, "plain grids have no components");
+
+  typedef Array<int, 2> IndexType;
+  const IndexType lo(-2, 3), hi(9, 17);
+  const internal::RangeBounds<IndexType> range{lo, hi};
+  const std::string path = tempFileName("soa");
+
+  GridContainer<SoAGrid> out;
+  initContainer(out, lo, hi);
+  RangeCIterationPolicy<2>::forEach(range, [&](const IndexType &pos) {
+    out.grid[pos] = Vector(value<2>(pos), 2.0*value<2>(pos), -value<2>(pos));
+  });
+
+  {
+    HdfOStream stream(path.c_str());
+    for (size_t c=0; c<3; ++c) stream.writeGridComponent(out, c);
+    stream.close();
+  }
+
+  GridContainer<Grid<double, 2> > in[3];
+  {
+    HdfIStream stream(path.c_str());
+    for (size_t c=0; c<3; ++c)
+    {
+      initContainer(in[c], lo, hi);
+      stream.readGrid(in[c]);
+    }
+    stream.close();
+  }
+
+  bool same = true;
+  RangeCIterationPolicy<2>::forEach(range, [&](const IndexType &pos) {
+    const Vector v = out.grid[pos];
+    for (size_t c=0; c<3; ++c) same = same && (in[c].grid[pos] == v[c]);
+  });
+  BOOST_CHECK(same);
+
+  std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // SCHNEK_HAVE_HDF5
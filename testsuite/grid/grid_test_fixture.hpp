@@ -39,6 +39,7 @@
 #include <boost/timer/progress_display.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <cstdint>
 #include <map>
 
 struct GridTest
@@ -421,6 +422,19 @@ struct GridTest
       }
     }
 
+    template<class GridType>
+    void test_line_alignment(GridType &grid, size_t lineDim, size_t alignment)
+    {
+      typename GridType::RangeType range = grid.getRange();
+      range.getHi()[lineDim] = range.getLo()[lineDim];
+
+      for (typename GridType::RangeType::iterator it = range.begin(); it != range.end(); ++it)
+      {
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(&(grid.get(*it)));
+        BOOST_CHECK_EQUAL(address % alignment, 0ul);
+      }
+    }
+
     template<class GridType>
     void test_range_access(GridType &grid)
     {
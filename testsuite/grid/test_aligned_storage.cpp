@@ -0,0 +1,594 @@
+/*
+ * test_aligned_storage.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ * 
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/grid.hpp>
+
+#include <boost/timer/progress_display.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <limits>
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( aligned_storage )
+
+BOOST_FIXTURE_TEST_CASE( access_1d, GridTest )
+{
+  typedef schnek::Grid<double, 1, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<1>(lo, hi);
+    GridType g(lo,hi);
+    test_access_1d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<1>(lo, hi);
+      g.resize(lo,hi);
+      test_access_1d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_2d, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<2>(lo, hi);
+    GridType g(lo,hi);
+    test_access_2d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<2>(lo, hi);
+      g.resize(lo,hi);
+      test_access_2d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<3>(lo, hi);
+    GridType g(lo,hi);
+    test_access_3d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<3>(lo, hi);
+      g.resize(lo,hi);
+      test_access_3d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_4d, GridTest )
+{
+  typedef schnek::Grid<double, 4, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<4>(lo, hi);
+    GridType g(lo,hi);
+    test_access_4d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<4>(lo, hi);
+      g.resize(lo,hi);
+      test_access_4d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( range_access_1d, GridTest )
+{
+  typedef schnek::Grid<double, 1, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+  generic_range_access_Nd<1, GridType>();
+}
+
+BOOST_FIXTURE_TEST_CASE( range_access_2d, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+  generic_range_access_Nd<2, GridType>();
+}
+
+BOOST_FIXTURE_TEST_CASE( range_access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+  generic_range_access_Nd<3, GridType>();
+}
+
+BOOST_FIXTURE_TEST_CASE( range_access_4d, GridTest )
+{
+  typedef schnek::Grid<double, 4, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+  generic_range_access_Nd<4, GridType>();
+}
+
+BOOST_FIXTURE_TEST_CASE( stride_2d, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(100);
+  for (int n=0; n<10; ++n)
+  {
+    random_extent(lo, hi);
+
+    GridType g(lo, hi);
+    hi = hi - 1;
+    for (int m=0; m<10; ++m)
+    {
+      GridType::IndexType index = random_index(lo, hi);
+      test_stride(g, index);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( stride_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(100);
+  for (int n=0; n<10; ++n)
+  {
+    random_extent(lo, hi);
+
+    GridType g(lo, hi);
+    hi = hi - 1;
+    for (int m=0; m<10; ++m)
+    {
+      GridType::IndexType index = random_index(lo, hi);
+      test_stride(g, index);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( stride_4d, GridTest )
+{
+  typedef schnek::Grid<double, 4, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(100);
+  for (int n=0; n<10; ++n)
+  {
+    random_extent(lo, hi);
+
+    GridType g(lo, hi);
+    hi = hi - 1;
+    for (int m=0; m<10; ++m)
+    {
+      GridType::IndexType index = random_index(lo, hi);
+      test_stride(g, index);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( line_alignment, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(10);
+  for (int n=0; n<10; ++n)
+  {
+    random_extent(lo, hi);
+    GridType g(lo, hi);
+    test_line_alignment(g, 2, SCHNEK_DEFAULT_ALIGNMENT);
+    ++show_progress;
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( storage_iterator, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  random_extent(lo, hi);
+  GridType g(lo, hi);
+
+  BOOST_CHECK_EQUAL(g.end() - g.begin(), g.getSize());
+  BOOST_CHECK_GE(g.getSize(), g.getDims().product());
+
+  g = 1.5;
+  double sum = 0.0;
+  for (int i=lo[0]; i<=hi[0]; ++i)
+    for (int j=lo[1]; j<=hi[1]; ++j)
+      for (int k=lo[2]; k<=hi[2]; ++k)
+      {
+        sum += g(i,j,k);
+      }
+
+  BOOST_CHECK(is_equal(sum, 1.5*g.getDims().product()));
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_constructor, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_copy_constructor(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( assignment_operator, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_assignment_operator(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_then_resize, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_copy_resize(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( free_shared, GridTest )
+{
+  typedef schnek::Grid<DeleteCounter, 1, GridBoostTestCheck, schnek::AlignedArrayGridStorage> GridType;
+  std::map<int, int> counters;
+
+  DeleteCounter del1(1, counters);
+  DeleteCounter del2(2, counters);
+
+  GridType::IndexType lo(0), hi(10);
+  GridType *ga = new GridType(lo, hi);
+  GridType *gb = new GridType(lo, hi);
+  GridType *gc = new GridType(*ga);
+  *ga = del1;
+  *gb = del2;
+
+  // the padding elements are also destroyed
+  const int size = ga->getSize();
+  BOOST_CHECK_GE(size, 11);
+
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 0ul);
+
+  *gb = *ga;
+
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 1ul);
+  BOOST_CHECK_EQUAL(counters[2], size);
+  
+  delete ga;
+  delete gc;
+  
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 1ul);
+  
+  delete gb;
+  
+  BOOST_CHECK_EQUAL(counters.count(1), 1ul);
+  BOOST_CHECK_EQUAL(counters[1], size);
+  BOOST_CHECK_EQUAL(counters[2], size);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( aligned_storage_fortran )
+
+BOOST_FIXTURE_TEST_CASE( access_1d, GridTest )
+{
+  typedef schnek::Grid<double, 1, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<1>(lo, hi);
+    GridType g(lo,hi);
+    test_access_1d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<1>(lo, hi);
+      g.resize(lo,hi);
+      test_access_1d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_2d, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<2>(lo, hi);
+    GridType g(lo,hi);
+    test_access_2d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<2>(lo, hi);
+      g.resize(lo,hi);
+      test_access_2d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<3>(lo, hi);
+    GridType g(lo,hi);
+    test_access_3d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<3>(lo, hi);
+      g.resize(lo,hi);
+      test_access_3d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_4d, GridTest )
+{
+  typedef schnek::Grid<double, 4, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<4>(lo, hi);
+    GridType g(lo,hi);
+    test_access_4d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<4>(lo, hi);
+      g.resize(lo,hi);
+      test_access_4d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( range_access_1d, GridTest )
+{
+  typedef schnek::Grid<double, 1, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+  generic_range_access_Nd<1, GridType>();
+}
+
+BOOST_FIXTURE_TEST_CASE( range_access_2d, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+  generic_range_access_Nd<2, GridType>();
+}
+
+BOOST_FIXTURE_TEST_CASE( range_access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+  generic_range_access_Nd<3, GridType>();
+}
+
+BOOST_FIXTURE_TEST_CASE( range_access_4d, GridTest )
+{
+  typedef schnek::Grid<double, 4, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+  generic_range_access_Nd<4, GridType>();
+}
+
+BOOST_FIXTURE_TEST_CASE( stride_2d, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(100);
+  for (int n=0; n<10; ++n)
+  {
+    random_extent(lo, hi);
+
+    GridType g(lo, hi);
+    hi = hi - 1;
+    for (int m=0; m<10; ++m)
+    {
+      GridType::IndexType index = random_index(lo, hi);
+      test_stride(g, index);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( stride_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(100);
+  for (int n=0; n<10; ++n)
+  {
+    random_extent(lo, hi);
+
+    GridType g(lo, hi);
+    hi = hi - 1;
+    for (int m=0; m<10; ++m)
+    {
+      GridType::IndexType index = random_index(lo, hi);
+      test_stride(g, index);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( stride_4d, GridTest )
+{
+  typedef schnek::Grid<double, 4, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(100);
+  for (int n=0; n<10; ++n)
+  {
+    random_extent(lo, hi);
+
+    GridType g(lo, hi);
+    hi = hi - 1;
+    for (int m=0; m<10; ++m)
+    {
+      GridType::IndexType index = random_index(lo, hi);
+      test_stride(g, index);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( line_alignment, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(10);
+  for (int n=0; n<10; ++n)
+  {
+    random_extent(lo, hi);
+    GridType g(lo, hi);
+    test_line_alignment(g, 0, SCHNEK_DEFAULT_ALIGNMENT);
+    ++show_progress;
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( storage_iterator, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+  GridType::IndexType lo, hi;
+  random_extent(lo, hi);
+  GridType g(lo, hi);
+
+  BOOST_CHECK_EQUAL(g.end() - g.begin(), g.getSize());
+  BOOST_CHECK_GE(g.getSize(), g.getDims().product());
+
+  g = 1.5;
+  double sum = 0.0;
+  for (int i=lo[0]; i<=hi[0]; ++i)
+    for (int j=lo[1]; j<=hi[1]; ++j)
+      for (int k=lo[2]; k<=hi[2]; ++k)
+      {
+        sum += g(i,j,k);
+      }
+
+  BOOST_CHECK(is_equal(sum, 1.5*g.getDims().product()));
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_constructor, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_copy_constructor(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( assignment_operator, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_assignment_operator(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_then_resize, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_copy_resize(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( free_shared, GridTest )
+{
+  typedef schnek::Grid<DeleteCounter, 1, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> GridType;
+  std::map<int, int> counters;
+
+  DeleteCounter del1(1, counters);
+  DeleteCounter del2(2, counters);
+
+  GridType::IndexType lo(0), hi(10);
+  GridType *ga = new GridType(lo, hi);
+  GridType *gb = new GridType(lo, hi);
+  GridType *gc = new GridType(*ga);
+  *ga = del1;
+  *gb = del2;
+
+  // the padding elements are also destroyed
+  const int size = ga->getSize();
+  BOOST_CHECK_GE(size, 11);
+
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 0ul);
+
+  *gb = *ga;
+
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 1ul);
+  BOOST_CHECK_EQUAL(counters[2], size);
+  
+  delete ga;
+  delete gc;
+  
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 1ul);
+  
+  delete gb;
+  
+  BOOST_CHECK_EQUAL(counters.count(1), 1ul);
+  BOOST_CHECK_EQUAL(counters[1], size);
+  BOOST_CHECK_EQUAL(counters[2], size);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,171 @@
+/*
+ * test_circular_storage.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/grid.hpp>
+#include <grid/field.hpp>
+#include <grid/boundary.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+struct CircularStorageTest : public GridTest
+{
+    typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::CircularGridStorage> GridType;
+    typedef GridType::IndexType IndexType;
+
+    static double value(const IndexType &pos)
+    {
+      return 10000.0*pos[0] + 100.0*pos[1] + pos[2] + 0.5;
+    }
+
+    void fill(GridType &grid)
+    {
+      for (int i=grid.getLo(0); i<=grid.getHi(0); ++i)
+        for (int j=grid.getLo(1); j<=grid.getHi(1); ++j)
+          for (int k=grid.getLo(2); k<=grid.getHi(2); ++k)
+          {
+            grid(i,j,k) = value(IndexType(i,j,k));
+          }
+    }
+
+    /**
+     * Check that the grid points inside `valid` hold their original values and all
+     * other grid points are zero
+     */
+    bool check(GridType &grid, schnek::Range<int, 3> valid)
+    {
+      bool ok = true;
+      for (int i=grid.getLo(0); i<=grid.getHi(0); ++i)
+        for (int j=grid.getLo(1); j<=grid.getHi(1); ++j)
+          for (int k=grid.getLo(2); k<=grid.getHi(2); ++k)
+          {
+            IndexType pos(i,j,k);
+            double expected = valid.inside(pos) ? value(pos) : 0.0;
+            ok = ok && (grid[pos] == expected);
+          }
+      return ok;
+    }
+};
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( circular_storage )
+
+BOOST_FIXTURE_TEST_CASE( access, CircularStorageTest )
+{
+  IndexType lo(-7, 0, 3), hi(4, 5, 9);
+  GridType grid(lo, hi);
+  fill(grid);
+  BOOST_CHECK(check(grid, schnek::Range<int, 3>(lo, hi)));
+
+  // all grid points are stored at different positions
+  std::vector<bool> used(grid.getSize(), false);
+  bool distinct = true;
+  for (int i=lo[0]; i<=hi[0]; ++i)
+    for (int j=lo[1]; j<=hi[1]; ++j)
+      for (int k=lo[2]; k<=hi[2]; ++k)
+      {
+        ptrdiff_t pos = &grid(i,j,k) - grid.getRawData();
+        distinct = distinct && (pos >= 0) && (pos < ptrdiff_t(grid.getSize())) && !used[pos];
+        if (distinct) used[pos] = true;
+      }
+  BOOST_CHECK(distinct);
+}
+
+BOOST_FIXTURE_TEST_CASE( shift, CircularStorageTest )
+{
+  IndexType lo(-2, 0, 3), hi(5, 4, 9);
+  GridType grid(lo, hi);
+  GridType copy(grid);
+  fill(grid);
+  const double *ptr = grid.getRawData();
+
+  schnek::Range<int, 3> valid(lo, hi);
+  int shifts[] = {1, 3, -2, 7, -5, -1};
+  for (int n : shifts)
+  {
+    grid.shift(0, n);
+    lo[0] += n;
+    hi[0] += n;
+
+    valid.getLo()[0] = std::max(valid.getLo()[0], lo[0]);
+    valid.getHi()[0] = std::min(valid.getHi()[0], hi[0]);
+
+    BOOST_CHECK(grid.getLo() == lo);
+    BOOST_CHECK(grid.getHi() == hi);
+    BOOST_CHECK(grid.getRawData() == ptr);
+    BOOST_CHECK(check(grid, valid));
+
+    // copies sharing the data follow the shift
+    BOOST_CHECK(copy.getLo() == lo);
+    BOOST_CHECK(&copy(lo[0], 2, 5) == &grid(lo[0], 2, 5));
+
+    // refill the cleared slab so that the next shift keeps more points
+    fill(grid);
+    valid = schnek::Range<int, 3>(lo, hi);
+  }
+
+  // shifts in more than one dimension
+  grid.shift(1, -2);
+  grid.shift(2, 4);
+  valid.getHi()[1] -= 2;
+  valid.getLo()[2] += 4;
+  BOOST_CHECK(check(grid, valid));
+
+  // a shift larger than the grid clears everything
+  grid.shift(2, 100);
+  BOOST_CHECK(check(grid, schnek::Range<int, 3>(IndexType(0, 0, 0), IndexType(-1, -1, -1))));
+}
+
+BOOST_FIXTURE_TEST_CASE( field_and_boundary, CircularStorageTest )
+{
+  typedef schnek::Field<double, 1, GridBoostTestCheck, schnek::CircularGridStorage> FieldType;
+  const schnek::Range<double, 1> domain(schnek::Array<double, 1>(0.0), schnek::Array<double, 1>(1.0));
+
+  FieldType field(schnek::Array<int, 1>(10), domain, schnek::Array<bool, 1>(false), 2);
+  for (int i=field.getLo(0); i<=field.getHi(0); ++i) field(i) = i;
+
+  const double x = field.indexToPosition(0, 4);
+  field.shift(0, 3);
+  BOOST_CHECK_EQUAL(field.getLo(0), 1);
+  BOOST_CHECK_EQUAL(field.getHi(0), 14);
+  BOOST_CHECK_CLOSE(field.getDomain().getLo()[0], 0.3, 1e-10);
+  BOOST_CHECK_CLOSE(field.getDomain().getHi()[0], 1.3, 1e-10);
+  BOOST_CHECK_CLOSE(field.indexToPosition(0, 4), x, 1e-10);
+  BOOST_CHECK_EQUAL(field.positionToIndex(0, x + 1e-6), 4);
+  BOOST_CHECK_EQUAL(field(11), 11.0);
+  BOOST_CHECK_EQUAL(field(12), 0.0);
+
+  schnek::Boundary<1> boundary(field.getLo(), field.getHi(), 2);
+  boundary.shift(0, -3);
+  BOOST_CHECK_EQUAL(boundary.getDomain().getLo()[0], -2);
+  BOOST_CHECK_EQUAL(boundary.getInnerDomain().getHi()[0], 9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
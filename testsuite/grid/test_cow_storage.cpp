@@ -0,0 +1,159 @@
+/*
+ * test_cow_storage.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/grid.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <utility>
+
+struct CopyOnWriteTest : public GridTest
+{
+    typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::CopyOnWriteGridStorage> GridType;
+    typedef GridType::IndexType IndexType;
+
+    IndexType lo, hi;
+
+    CopyOnWriteTest() : lo(-1, 2), hi(6, 9) {}
+
+    static double value(int i, int j)
+    {
+      return 100.0*i + j;
+    }
+
+    void fill(GridType &grid)
+    {
+      for (int i=grid.getLo(0); i<=grid.getHi(0); ++i)
+        for (int j=grid.getLo(1); j<=grid.getHi(1); ++j)
+        {
+          grid(i,j) = value(i,j);
+        }
+    }
+
+    bool check(const GridType &grid, double offset = 0.0)
+    {
+      bool ok = true;
+      for (int i=grid.getLo(0); i<=grid.getHi(0); ++i)
+        for (int j=grid.getLo(1); j<=grid.getHi(1); ++j)
+        {
+          ok = ok && (grid(i,j) == value(i,j) + offset);
+        }
+      return ok;
+    }
+};
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( copy_on_write )
+
+BOOST_FIXTURE_TEST_CASE( write_detaches, CopyOnWriteTest )
+{
+  GridType grid(lo, hi);
+  fill(grid);
+  BOOST_CHECK(!grid.isShared());
+
+  GridType copy(grid);
+  BOOST_CHECK(grid.isShared());
+  BOOST_CHECK(copy.getRawData() == grid.getRawData());
+
+  // reading through a const reference keeps the data shared
+  const GridType &constCopy = copy;
+  BOOST_CHECK(check(constCopy));
+  BOOST_CHECK(copy.getRawData() == grid.getRawData());
+
+  copy(2, 5) += 1.0;
+  BOOST_CHECK(copy.getRawData() != grid.getRawData());
+  BOOST_CHECK(!grid.isShared());
+  BOOST_CHECK(!copy.isShared());
+  BOOST_CHECK_EQUAL(copy(2, 5), value(2, 5) + 1.0);
+  BOOST_CHECK(check(grid));
+
+  // the original is the only owner now, writing to it does not copy
+  const double *ptr = grid.getRawData();
+  grid = 1.0;
+  BOOST_CHECK(grid.getRawData() == ptr);
+  BOOST_CHECK_EQUAL(copy(-1, 2), value(-1, 2));
+}
+
+BOOST_FIXTURE_TEST_CASE( last_owner, CopyOnWriteTest )
+{
+  GridType grid(lo, hi);
+  fill(grid);
+  const double *ptr = grid.getRawData();
+  {
+    GridType copy(grid);
+    BOOST_CHECK(check(copy));
+  }
+
+  // the copy has gone, so the grid keeps its array when written to
+  grid(0, 3) = 0.0;
+  BOOST_CHECK(grid.getRawData() == ptr);
+}
+
+BOOST_FIXTURE_TEST_CASE( assign_and_iterate, CopyOnWriteTest )
+{
+  GridType grid(lo, hi);
+  fill(grid);
+
+  GridType other;
+  other = grid;
+  BOOST_CHECK(other.getRawData() == grid.getRawData());
+  BOOST_CHECK(other.getHi() == hi);
+
+  for (double &v : other)
+  {
+    v += 0.5;
+  }
+  BOOST_CHECK(other.getRawData() != grid.getRawData());
+  BOOST_CHECK(check(other, 0.5));
+  BOOST_CHECK(check(grid));
+}
+
+BOOST_FIXTURE_TEST_CASE( resize_and_move, CopyOnWriteTest )
+{
+  GridType grid(lo, hi);
+  fill(grid);
+  GridType copy(grid);
+
+  IndexType lo2(0, 0), hi2(3, 3);
+  copy.resize(lo2, hi2);
+  BOOST_CHECK(grid.getHi() == hi);
+  BOOST_CHECK(copy.getHi() == hi2);
+  BOOST_CHECK(!grid.isShared());
+  BOOST_CHECK(check(grid));
+
+  GridType second(grid);
+  GridType moved(std::move(second));
+  BOOST_CHECK_EQUAL(second.getSize(), 0);
+  BOOST_CHECK(moved.getRawData() == grid.getRawData());
+
+  moved(0, 2) = -1.0;
+  BOOST_CHECK(check(grid));
+  BOOST_CHECK_EQUAL(moved(0, 2), -1.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
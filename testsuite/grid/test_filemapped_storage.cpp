@@ -0,0 +1,229 @@
+/*
+ * test_filemapped_storage.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ * 
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/grid.hpp>
+
+#include <boost/timer/progress_display.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include <unistd.h>
+
+struct FileMappedGridTest : public GridTest
+{
+    std::string tempFileName(const std::string &name)
+    {
+      return (std::filesystem::temp_directory_path()
+              / ("schnek-test-" + name + "-" + std::to_string(getpid()) + ".dat")).string();
+    }
+};
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( filemapped_storage )
+
+BOOST_FIXTURE_TEST_CASE( access_1d, GridTest )
+{
+  typedef schnek::Grid<double, 1, GridBoostTestCheck, schnek::FileMappedArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<1>(lo, hi);
+    GridType g(lo,hi);
+    test_access_1d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<1>(lo, hi);
+      g.resize(lo,hi);
+      test_access_1d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_2d, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::FileMappedArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<2>(lo, hi);
+    GridType g(lo,hi);
+    test_access_2d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<2>(lo, hi);
+      g.resize(lo,hi);
+      test_access_2d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::FileMappedArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<3>(lo, hi);
+    GridType g(lo,hi);
+    test_access_3d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<3>(lo, hi);
+      g.resize(lo,hi);
+      test_access_3d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( range_access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::FileMappedArrayGridStorage> GridType;
+  generic_range_access_Nd<3, GridType>();
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_constructor, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::FileMappedArrayGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_copy_constructor(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( assignment_operator, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::FileMappedArrayGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_assignment_operator(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_then_resize, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::FileMappedArrayGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_copy_resize(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( checkpoint, FileMappedGridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::FileMappedArrayGridStorage> GridType;
+  const std::string path = tempFileName("checkpoint");
+
+  GridType::IndexType lo, hi;
+  random_extent(lo, hi);
+  double sum = 0.0;
+  {
+    GridType g;
+    g.setMappedFile(path);
+    g.resize(lo, hi);
+    BOOST_CHECK_EQUAL(g.getMappedFile(), path);
+    for (double *it = g.begin(); it != g.end(); ++it)
+    {
+      *it = dist(rGen);
+      sum += *it;
+    }
+    g.sync();
+    BOOST_CHECK_EQUAL(std::filesystem::file_size(path), g.getSize()*sizeof(double));
+  }
+
+  // mapping the file again restores the data
+  GridType g;
+  g.setMappedFile(path, schnek::FileMapMode::copyOnWrite);
+  g.resize(lo, hi);
+  double restored = 0.0;
+  for (double *it = g.begin(); it != g.end(); ++it)
+  {
+    restored += *it;
+  }
+  BOOST_CHECK_EQUAL(restored, sum);
+
+  // changes to a copy-on-write mapping do not reach the file
+  g = 0.0;
+  g.resize(lo, hi);
+  restored = 0.0;
+  for (double *it = g.begin(); it != g.end(); ++it)
+  {
+    restored += *it;
+  }
+  BOOST_CHECK_EQUAL(restored, sum);
+
+  std::remove(path.c_str());
+}
+
+BOOST_FIXTURE_TEST_CASE( shared_settings, FileMappedGridTest )
+{
+  typedef schnek::Grid<int, 2, GridBoostTestCheck, schnek::FileMappedArrayGridStorage> GridType;
+  const std::string path = tempFileName("shared");
+
+  GridType::IndexType lo(0, 0), hi(99, 49);
+  GridType g(lo, hi);
+  BOOST_CHECK(g.getMappedFile().empty());
+  BOOST_CHECK(g.getMapMode() == schnek::FileMapMode::shared);
+
+  // the file is shared between copies and used from the next resize
+  GridType c(g);
+  c.setMappedFile(path);
+  c.setSyncOnResize(true);
+  BOOST_CHECK_EQUAL(g.getMappedFile(), path);
+  BOOST_CHECK(!std::filesystem::exists(path));
+
+  g.resize(lo, hi);
+  BOOST_CHECK(std::filesystem::exists(path));
+  g = 42;
+  c.resize(lo, hi);
+  BOOST_CHECK_EQUAL(g(10, 20), 42);
+  BOOST_CHECK_EQUAL(c(99, 49), 42);
+
+  // the file is only ever extended
+  c.resize(GridType::IndexType(0, 0), GridType::IndexType(9, 9));
+  BOOST_CHECK_EQUAL(std::filesystem::file_size(path), 5000*sizeof(int));
+  BOOST_CHECK_EQUAL(g(9, 9), 42);
+
+  std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,313 @@
+/*
+ * test_firsttouch_storage.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ * 
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/grid.hpp>
+#include <util/threadpool.hpp>
+
+#include <boost/timer/progress_display.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( firsttouch_storage )
+
+BOOST_FIXTURE_TEST_CASE( access_1d, GridTest )
+{
+  typedef schnek::Grid<double, 1, GridBoostTestCheck, schnek::FirstTouchArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<1>(lo, hi);
+    GridType g(lo,hi);
+    test_access_1d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<1>(lo, hi);
+      g.resize(lo,hi);
+      test_access_1d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_2d, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::FirstTouchArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<2>(lo, hi);
+    GridType g(lo,hi);
+    test_access_2d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<2>(lo, hi);
+      g.resize(lo,hi);
+      test_access_2d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::FirstTouchArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<3>(lo, hi);
+    GridType g(lo,hi);
+    test_access_3d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<3>(lo, hi);
+      g.resize(lo,hi);
+      test_access_3d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( range_access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::FirstTouchArrayGridStorage> GridType;
+  generic_range_access_Nd<3, GridType>();
+}
+
+BOOST_FIXTURE_TEST_CASE( stride_2d, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::FirstTouchArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(100);
+  for (int n=0; n<10; ++n)
+  {
+    random_extent(lo, hi);
+
+    GridType g(lo, hi);
+    hi = hi - 1;
+    for (int m=0; m<10; ++m)
+    {
+      GridType::IndexType index = random_index(lo, hi);
+      test_stride(g, index);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( stride_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::FirstTouchArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(100);
+  for (int n=0; n<10; ++n)
+  {
+    random_extent(lo, hi);
+
+    GridType g(lo, hi);
+    hi = hi - 1;
+    for (int m=0; m<10; ++m)
+    {
+      GridType::IndexType index = random_index(lo, hi);
+      test_stride(g, index);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_constructor, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::FirstTouchArrayGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_copy_constructor(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( assignment_operator, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::FirstTouchArrayGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_assignment_operator(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_then_resize, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::FirstTouchArrayGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_copy_resize(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( zero_initialised, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::FirstTouchArrayGridStorage> GridType;
+  schnek::ThreadPool &pool = schnek::ThreadPool::instance();
+  const size_t numThreads = pool.getNumThreads();
+
+  GridType::IndexType lo, hi;
+  for (size_t threads : {1ul, 2ul, 3ul, 7ul})
+  {
+    pool.setNumThreads(threads);
+    for (int n=0; n<5; ++n)
+    {
+      random_extent<3>(lo, hi);
+      GridType g(lo,hi);
+      bool allZero = true;
+      for (GridType::storage_iterator it = g.begin(); it != g.end(); ++it)
+      {
+        allZero = allZero && (*it == 0.0);
+      }
+      BOOST_CHECK(allZero);
+      test_access_3d(g);
+    }
+  }
+  pool.setNumThreads(numThreads);
+}
+
+BOOST_FIXTURE_TEST_CASE( partition_range, GridTest )
+{
+  for (int n=0; n<100; ++n)
+  {
+    int lo = boost::random::uniform_int_distribution<int>(-100, 100)(rGen);
+    int hi = lo + boost::random::uniform_int_distribution<int>(-1, 200)(rGen);
+    size_t parts = boost::random::uniform_int_distribution<size_t>(1, 20)(rGen);
+    int next = lo;
+    size_t maxLength = 0, minLength = std::numeric_limits<size_t>::max();
+    for (size_t part=0; part<parts; ++part)
+    {
+      int partLo, partHi;
+      schnek::partitionRange(lo, hi, part, parts, partLo, partHi);
+      BOOST_CHECK_EQUAL(partLo, next);
+      BOOST_CHECK_GE(partHi, partLo - 1);
+      size_t length = partHi - partLo + 1;
+      maxLength = std::max(maxLength, length);
+      minLength = std::min(minLength, length);
+      next = partHi + 1;
+    }
+    BOOST_CHECK_EQUAL(next, std::max(hi + 1, lo));
+    BOOST_CHECK_LE(maxLength - minLength, 1ul);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( thread_pool_run, GridTest )
+{
+  schnek::ThreadPool &pool = schnek::ThreadPool::instance();
+  const size_t numThreads = pool.getNumThreads();
+  pool.setNumThreads(4);
+
+  std::vector<int> calls(4, 0);
+  std::vector<int> nested(4, 0);
+  pool.run([&](size_t i) {
+    ++calls[i];
+    pool.run([&](size_t) { if (schnek::ThreadPool::insideTask()) ++nested[i]; });
+  });
+  for (int c : calls) BOOST_CHECK_EQUAL(c, 1);
+  for (int c : nested) BOOST_CHECK_EQUAL(c, 4);
+  BOOST_CHECK(!schnek::ThreadPool::insideTask());
+
+  BOOST_CHECK_THROW(
+    pool.run([](size_t i) { if (i == 2) throw std::runtime_error("task failed"); }),
+    std::runtime_error
+  );
+
+  std::vector<int> again(4, 0);
+  pool.run([&](size_t i) { again[i] = 1; });
+  for (int c : again) BOOST_CHECK_EQUAL(c, 1);
+
+  pool.setNumThreads(numThreads);
+}
+
+BOOST_FIXTURE_TEST_CASE( fortran_access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::FirstTouchArrayGridStorageFortran> GridType;
+  GridType::IndexType lo, hi;
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<3>(lo, hi);
+    GridType g(lo,hi);
+    test_access_3d(g);
+    random_extent<3>(lo, hi);
+    g.resize(lo,hi);
+    test_access_3d(g);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( free_shared, GridTest )
+{
+  typedef schnek::Grid<DeleteCounter, 1, GridBoostTestCheck, schnek::FirstTouchArrayGridStorage> GridType;
+  std::map<int, int> counters;
+
+  DeleteCounter del1(1, counters);
+  DeleteCounter del2(2, counters);
+
+  GridType::IndexType lo(0), hi(10);
+  GridType *ga = new GridType(lo, hi);
+  GridType *gb = new GridType(lo, hi);
+  GridType *gc = new GridType(*ga);
+  *ga = del1;
+  *gb = del2;
+
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 0ul);
+
+  *gb = *ga;
+
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 1ul);
+  BOOST_CHECK_EQUAL(counters[2], 11);
+  
+  delete ga;
+  delete gc;
+  
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 1ul);
+  
+  delete gb;
+  
+  BOOST_CHECK_EQUAL(counters.count(1), 1ul);
+  BOOST_CHECK_EQUAL(counters[1], 11);
+  BOOST_CHECK_EQUAL(counters[2], 11);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,261 @@
+/*
+ * test_grid_move.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/grid.hpp>
+#include <grid/field.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+struct GridMoveTest : public GridTest
+{
+    typedef schnek::Array<int, 3> IndexType;
+
+    static double value(const IndexType &pos)
+    {
+      return 10000.0*pos[0] + 100.0*pos[1] + pos[2];
+    }
+
+    template<class GridType>
+    void fill(GridType &grid)
+    {
+      for (int i=grid.getLo(0); i<=grid.getHi(0); ++i)
+        for (int j=grid.getLo(1); j<=grid.getHi(1); ++j)
+          for (int k=grid.getLo(2); k<=grid.getHi(2); ++k)
+          {
+            grid(i,j,k) = value(IndexType(i,j,k));
+          }
+    }
+
+    template<class GridType>
+    bool check(GridType &grid)
+    {
+      bool ok = true;
+      for (int i=grid.getLo(0); i<=grid.getHi(0); ++i)
+        for (int j=grid.getLo(1); j<=grid.getHi(1); ++j)
+          for (int k=grid.getLo(2); k<=grid.getHi(2); ++k)
+          {
+            ok = ok && (grid(i,j,k) == value(IndexType(i,j,k)));
+          }
+      return ok;
+    }
+
+    template<class GridType>
+    void check_empty(GridType &grid)
+    {
+      BOOST_CHECK_EQUAL(grid.getSize(), 0);
+      BOOST_CHECK(grid.getRawData() == NULL);
+      BOOST_CHECK(grid.begin() == grid.end());
+      for (size_t d=0; d<3; ++d)
+      {
+        BOOST_CHECK_EQUAL(grid.getDims(d), 0);
+      }
+    }
+
+    /**
+     * Move construct and move assign grids and check that the data is taken over
+     * without copying, that the moved-from grid is empty and can be resized, and that
+     * copies keep sharing the data with the grid that has taken it over.
+     */
+    template<class GridType>
+    void test_move()
+    {
+      static_assert(std::is_nothrow_move_constructible<GridType>::value, "move must not throw");
+      static_assert(std::is_nothrow_move_assignable<GridType>::value, "move must not throw");
+
+      IndexType lo(-2, 0, 3), hi(5, 7, 9);
+      GridType grid(lo, hi);
+      fill(grid);
+      GridType copy(grid);
+      const auto *ptr = grid.getRawData();
+
+      GridType moved(std::move(grid));
+      BOOST_CHECK(moved.getRawData() == ptr);
+      BOOST_CHECK(moved.getLo() == lo);
+      BOOST_CHECK(moved.getHi() == hi);
+      BOOST_CHECK(check(moved));
+      check_empty(grid);
+
+      // the copy still follows the data after it has been moved
+      IndexType lo2(0, 1, 2), hi2(3, 4, 5);
+      moved.resize(lo2, hi2);
+      fill(moved);
+      BOOST_CHECK(copy.getLo() == lo2);
+      BOOST_CHECK(copy.getHi() == hi2);
+      BOOST_CHECK(copy.getRawData() == moved.getRawData());
+      BOOST_CHECK(check(copy));
+
+      // the moved-from grid is independent
+      grid.resize(lo, hi);
+      fill(grid);
+      BOOST_CHECK(grid.getRawData() != moved.getRawData());
+      BOOST_CHECK(check(grid));
+      BOOST_CHECK(moved.getHi() == hi2);
+
+      // move assignment releases the old data of the target
+      GridType target(lo, hi);
+      GridType targetCopy(target);
+      target = std::move(moved);
+      check_empty(moved);
+      BOOST_CHECK(target.getHi() == hi2);
+      BOOST_CHECK(check(target));
+
+      target.resize(lo, hi);
+      BOOST_CHECK(targetCopy.getHi() == hi);
+      BOOST_CHECK(copy.getHi() == hi);
+      BOOST_CHECK(copy.getRawData() == target.getRawData());
+
+      // self move assignment keeps the grid intact
+      GridType &self = target;
+      fill(target);
+      target = std::move(self);
+      BOOST_CHECK(check(target));
+    }
+};
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( move )
+
+BOOST_FIXTURE_TEST_CASE( c_storage, GridMoveTest )
+{
+  test_move<schnek::Grid<double, 3, GridBoostTestCheck, schnek::SingleArrayGridStorage> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( fortran_storage, GridMoveTest )
+{
+  test_move<schnek::Grid<double, 3, GridBoostTestCheck, schnek::SingleArrayGridStorageFortran> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( lazy_storage, GridMoveTest )
+{
+  test_move<schnek::Grid<double, 3, GridBoostTestCheck, schnek::LazyArrayGridStorage> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( aligned_storage, GridMoveTest )
+{
+  test_move<schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorage> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( pooled_storage, GridMoveTest )
+{
+  test_move<schnek::Grid<double, 3, GridBoostTestCheck, schnek::PooledArrayGridStorage> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( tiled_storage, GridMoveTest )
+{
+  test_move<schnek::Grid<double, 3, GridBoostTestCheck, schnek::TiledGridStorage> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( morton_storage, GridMoveTest )
+{
+  test_move<schnek::Grid<double, 3, GridBoostTestCheck, schnek::MortonGridStorage> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( circular_storage, GridMoveTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::CircularGridStorage> GridType;
+  test_move<GridType>();
+
+  // a moved-from grid can be shifted and stays empty
+  IndexType lo(-2, 0, 3), hi(5, 7, 9);
+  GridType grid(lo, hi);
+  fill(grid);
+  GridType moved(std::move(grid));
+  grid.shift(0, 3);
+  grid.shift(2, -2);
+  BOOST_CHECK_EQUAL(grid.getSize(), 0);
+  BOOST_CHECK(grid.begin() == grid.end());
+  BOOST_CHECK(moved.getLo() == lo);
+  BOOST_CHECK(check(moved));
+
+  grid.resize(lo, hi);
+  fill(grid);
+  grid.shift(1, 2);
+  BOOST_CHECK(grid.getRawData() != moved.getRawData());
+  BOOST_CHECK(grid(0, 7, 5) == value(IndexType(0, 7, 5)));
+  BOOST_CHECK(grid(0, 9, 5) == 0.0);
+}
+
+BOOST_FIXTURE_TEST_CASE( soa_storage, GridMoveTest )
+{
+  typedef schnek::Array<double, 2> Vector;
+  typedef schnek::Grid<Vector, 3, GridBoostTestCheck, schnek::SoAGridStorage> GridType;
+  static_assert(std::is_nothrow_move_constructible<GridType>::value, "move must not throw");
+
+  IndexType lo(0, 0, 0), hi(3, 4, 5);
+  GridType grid(lo, hi);
+  grid = Vector(1.0, 2.0);
+  const double *ptr = grid.getComponentData(1);
+
+  GridType moved(std::move(grid));
+  BOOST_CHECK(moved.getComponentData(1) == ptr);
+  BOOST_CHECK(Vector(moved(3, 4, 5)) == Vector(1.0, 2.0));
+  BOOST_CHECK_EQUAL(grid.getSize(), 0);
+  BOOST_CHECK(grid.begin() == grid.end());
+
+  grid.resize(lo, hi);
+  grid = Vector(3.0, 4.0);
+  BOOST_CHECK(Vector(moved(1, 2, 3)) == Vector(1.0, 2.0));
+  BOOST_CHECK(Vector(grid(1, 2, 3)) == Vector(3.0, 4.0));
+}
+
+BOOST_FIXTURE_TEST_CASE( field_vector, GridMoveTest )
+{
+  typedef schnek::Field<double, 3, GridBoostTestCheck> FieldType;
+  static_assert(std::is_nothrow_move_constructible<FieldType>::value, "move must not throw");
+
+  const schnek::Range<double, 3> domain(schnek::Array<double, 3>(0.0, 0.0, 0.0), schnek::Array<double, 3>(1.0, 1.0, 1.0));
+  const schnek::Array<bool, 3> stagger(false, true, false);
+
+  std::vector<FieldType> fields;
+  std::vector<const double*> pointers;
+  for (int n=0; n<20; ++n)
+  {
+    fields.emplace_back(IndexType(4, 5, 6), domain, stagger, 2);
+    fill(fields.back());
+    pointers.push_back(fields.back().getRawData());
+  }
+
+  // growing the vector moves the fields and keeps their data in place
+  for (size_t n=0; n<fields.size(); ++n)
+  {
+    BOOST_CHECK(fields[n].getRawData() == pointers[n]);
+    BOOST_CHECK(fields[n].getStagger() == stagger);
+    BOOST_CHECK(check(fields[n]));
+  }
+
+  FieldType field(std::move(fields.front()));
+  BOOST_CHECK(field.getInnerLo() == IndexType(0, 0, 0));
+  BOOST_CHECK(field.getInnerHi() == IndexType(3, 4, 5));
+  BOOST_CHECK_EQUAL(fields.front().getSize(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
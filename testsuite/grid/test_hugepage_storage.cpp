@@ -0,0 +1,275 @@
+/*
+ * test_hugepage_storage.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ * 
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/grid.hpp>
+
+#include <boost/timer/progress_display.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <limits>
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( hugepage_storage )
+
+BOOST_FIXTURE_TEST_CASE( access_1d, GridTest )
+{
+  typedef schnek::Grid<double, 1, GridBoostTestCheck, schnek::HugePageArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<1>(lo, hi);
+    GridType g(lo,hi);
+    test_access_1d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<1>(lo, hi);
+      g.resize(lo,hi);
+      test_access_1d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_2d, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::HugePageArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<2>(lo, hi);
+    GridType g(lo,hi);
+    test_access_2d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<2>(lo, hi);
+      g.resize(lo,hi);
+      test_access_2d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::HugePageArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<3>(lo, hi);
+    GridType g(lo,hi);
+    test_access_3d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<3>(lo, hi);
+      g.resize(lo,hi);
+      test_access_3d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( range_access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::HugePageArrayGridStorage> GridType;
+  generic_range_access_Nd<3, GridType>();
+}
+
+BOOST_FIXTURE_TEST_CASE( stride_2d, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::HugePageArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(100);
+  for (int n=0; n<10; ++n)
+  {
+    random_extent(lo, hi);
+
+    GridType g(lo, hi);
+    hi = hi - 1;
+    for (int m=0; m<10; ++m)
+    {
+      GridType::IndexType index = random_index(lo, hi);
+      test_stride(g, index);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( stride_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::HugePageArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(100);
+  for (int n=0; n<10; ++n)
+  {
+    random_extent(lo, hi);
+
+    GridType g(lo, hi);
+    hi = hi - 1;
+    for (int m=0; m<10; ++m)
+    {
+      GridType::IndexType index = random_index(lo, hi);
+      test_stride(g, index);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_constructor, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::HugePageArrayGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_copy_constructor(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( assignment_operator, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::HugePageArrayGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_assignment_operator(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_then_resize, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::HugePageArrayGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_copy_resize(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( page_type, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::HugePageArrayGridStorage> GridType;
+
+  GridType empty;
+  BOOST_CHECK(empty.getPageType() == schnek::PageType::none);
+  BOOST_CHECK_EQUAL(empty.getPageSize(), 0ul);
+
+  GridType::IndexType lo(0,0,0), hi(127,127,127);
+  GridType g(lo, hi);
+  GridType copy(g);
+
+  BOOST_CHECK(g.getPageType() != schnek::PageType::none);
+  BOOST_CHECK(copy.getPageType() == g.getPageType());
+  BOOST_CHECK_GE(g.getPageSize(), schnek::internal::basePageSize());
+
+  std::uintptr_t address = reinterpret_cast<std::uintptr_t>(g.getRawData());
+  if (g.getPageType() == schnek::PageType::base)
+  {
+    BOOST_CHECK_EQUAL(g.getPageSize(), schnek::internal::basePageSize());
+  }
+  else
+  {
+    BOOST_CHECK_EQUAL(g.getPageSize(), schnek::internal::hugePageSize());
+    BOOST_CHECK_EQUAL(address % g.getPageSize(), 0ul);
+  }
+
+  g = 1.0;
+  BOOST_CHECK_EQUAL(copy(127,127,127), 1.0);
+}
+
+BOOST_FIXTURE_TEST_CASE( small_allocation, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::HugePageArrayGridStorage> GridType;
+
+  // grids smaller than one huge page are not mapped but allocated with operator new
+  GridType::IndexType lo(0,0,0), hi(7,7,7);
+  GridType g(lo, hi);
+  BOOST_CHECK(g.getPageType() == schnek::PageType::base);
+  BOOST_CHECK_EQUAL(g.getPageSize(), schnek::internal::basePageSize());
+  std::uintptr_t address = reinterpret_cast<std::uintptr_t>(g.getRawData());
+  BOOST_CHECK_EQUAL(address % SCHNEK_DEFAULT_ALIGNMENT, 0ul);
+
+  g = 2.0;
+  BOOST_CHECK_EQUAL(g(7,7,7), 2.0);
+
+  // resizing across the threshold switches between the two kinds of allocation
+  g.resize(lo, GridType::IndexType(127,127,127));
+  BOOST_CHECK_EQUAL(g.getPageSize() == schnek::internal::basePageSize(),
+                    g.getPageType() == schnek::PageType::base);
+  g = 3.0;
+  BOOST_CHECK_EQUAL(g(127,127,127), 3.0);
+
+  g.resize(lo, hi);
+  BOOST_CHECK(g.getPageType() == schnek::PageType::base);
+  g = 4.0;
+  BOOST_CHECK_EQUAL(g(7,7,7), 4.0);
+}
+
+BOOST_FIXTURE_TEST_CASE( free_shared, GridTest )
+{
+  typedef schnek::Grid<DeleteCounter, 1, GridBoostTestCheck, schnek::HugePageArrayGridStorage> GridType;
+  std::map<int, int> counters;
+
+  DeleteCounter del1(1, counters);
+  DeleteCounter del2(2, counters);
+
+  GridType::IndexType lo(0), hi(10);
+  GridType *ga = new GridType(lo, hi);
+  GridType *gb = new GridType(lo, hi);
+  GridType *gc = new GridType(*ga);
+  *ga = del1;
+  *gb = del2;
+
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 0ul);
+
+  *gb = *ga;
+
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 1ul);
+  BOOST_CHECK_EQUAL(counters[2], 11);
+  
+  delete ga;
+  delete gc;
+  
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 1ul);
+  
+  delete gb;
+  
+  BOOST_CHECK_EQUAL(counters.count(1), 1ul);
+  BOOST_CHECK_EQUAL(counters[1], 11);
+  BOOST_CHECK_EQUAL(counters[2], 11);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -10,12 +10,17 @@
 
 #include <grid/grid.hpp>
 #include <grid/gridstorage/kokkos-storage.hpp>
+#include <grid/gridstorage/host-mirror.hpp>
+#include <grid/iteration/kokkos-iteration.hpp>
+#include <grid/subgrid.hpp>
 
 #include <boost/timer/progress_display.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include <iostream>
 #include <limits>
+#include <type_traits>
+#include <utility>
 
 #ifdef SCHNEK_HAVE_KOKKOS
 
@@ -429,6 +434,190 @@ BOOST_FIXTURE_TEST_CASE( copy_then_resize, GridTest )
   test_copy_resize(g);
 }
 
+BOOST_FIXTURE_TEST_CASE( dual_access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::KokkosDualGridStorageC> GridType;
+  GridType::IndexType lo, hi;
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<3>(lo, hi);
+    GridType g(lo,hi);
+    test_access_3d(g);
+    random_extent<3>(lo, hi);
+    g.resize(lo,hi);
+    test_access_3d(g);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( dual_layout, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::KokkosDualGridStorageC> DualC;
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::KokkosDualGridStorageFortran> DualFortran;
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::KokkosGridStorageFortran> KokkosFortran;
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::SingleArrayGridStorage> SingleC;
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::SingleArrayGridStorageFortran> SingleFortran;
+
+  DualC::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  DualC dc(lo, hi);
+  DualFortran df(lo, hi);
+  KokkosFortran kf(lo, hi);
+  SingleC sc(lo, hi);
+  SingleFortran sf(lo, hi);
+
+  // the host data has the same layout as the single array storages
+  bool same = true;
+  for (int n=0; n<100; ++n)
+  {
+    DualC::IndexType pos = random_index(lo, hi);
+    same = same && (&dc[pos] - dc.getRawData() == &sc[pos] - sc.getRawData());
+    same = same && (&df[pos] - df.getRawData() == &sf[pos] - sf.getRawData());
+    same = same && (&kf[pos] - kf.getRawData() == &sf[pos] - sf.getRawData());
+  }
+  BOOST_CHECK(same);
+  for (size_t d=0; d<3; ++d)
+  {
+    BOOST_CHECK_EQUAL(dc.stride(d), sc.stride(d));
+    BOOST_CHECK_EQUAL(df.stride(d), sf.stride(d));
+  }
+  BOOST_CHECK_EQUAL(dc.getSize(), sc.getSize());
+  BOOST_CHECK_EQUAL(dc.end() - dc.begin(), ptrdiff_t(sc.getSize()));
+}
+
+BOOST_FIXTURE_TEST_CASE( dual_sync, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::KokkosDualGridStorageC> GridType;
+  GridType g(GridType::IndexType(0, 0), GridType::IndexType(9, 9));
+  GridType copy(g);
+  BOOST_CHECK(!g.needSyncHost());
+  BOOST_CHECK(!g.needSyncDevice());
+  BOOST_CHECK(schnek::internal::HasHostMirror<GridType>::value);
+
+  g = 1.0;
+  g.modifyHost();
+  BOOST_CHECK(copy.needSyncDevice());
+  copy.syncDevice();
+  BOOST_CHECK(!g.needSyncDevice());
+  BOOST_CHECK_EQUAL(g.getDeviceView().extent(0), 10u);
+
+  g.modifyDevice();
+  BOOST_CHECK(g.needSyncHost());
+  schnek::internal::syncHostMirror(g);
+  BOOST_CHECK(!copy.needSyncHost());
+  BOOST_CHECK_EQUAL(copy(3, 4), 1.0);
+
+  // resizing is seen by all copies
+  g.resize(GridType::IndexType(-1, -1), GridType::IndexType(4, 4));
+  BOOST_CHECK(copy.getDims() == GridType::IndexType(6, 6));
+  BOOST_CHECK_EQUAL(copy.getRawData(), g.getRawData());
+}
+
+BOOST_FIXTURE_TEST_CASE( dual_copy_then_resize, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::KokkosDualGridStorageC> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_copy_resize(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( dual_move, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::KokkosDualGridStorageC> GridType;
+  BOOST_CHECK(std::is_nothrow_move_constructible<GridType>::value);
+  BOOST_CHECK(std::is_nothrow_move_assignable<GridType>::value);
+
+  GridType g(GridType::IndexType(0, 0), GridType::IndexType(9, 9));
+  GridType copy(g);
+  g = 1.0;
+  const double *data = g.getRawData();
+
+  // the moved-to grid takes over the data and stays linked to the copies
+  GridType moved(std::move(g));
+  BOOST_CHECK_EQUAL(moved.getRawData(), data);
+  BOOST_CHECK_EQUAL(g.getSize(), 0u);
+
+  GridType assigned(GridType::IndexType(0, 0), GridType::IndexType(3, 3));
+  assigned = std::move(moved);
+  BOOST_CHECK_EQUAL(assigned.getRawData(), data);
+  BOOST_CHECK_EQUAL(moved.getSize(), 0u);
+  BOOST_CHECK_EQUAL(assigned(5, 5), 1.0);
+
+  assigned.resize(GridType::IndexType(-1, -1), GridType::IndexType(4, 4));
+  BOOST_CHECK(copy.getDims() == GridType::IndexType(6, 6));
+  BOOST_CHECK_EQUAL(copy.getRawData(), assigned.getRawData());
+}
+
+BOOST_FIXTURE_TEST_CASE( subgrid_view, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, GridStorage> GridType;
+  typedef schnek::SubGrid<GridType, GridBoostTestCheck> SubGridType;
+  typedef schnek::SubGrid<SubGridType, GridBoostTestCheck> SubSubGridType;
+  BOOST_CHECK(schnek::internal::HasKokkosView<GridType>::value);
+
+  GridType::IndexType lo(-3, 2, 0), hi(6, 9, 12);
+  GridType g(lo, hi);
+  schnek::Range<int, 3> range(lo, hi);
+  for (const GridType::IndexType &pos : range)
+  {
+    g[pos] = 100*pos[0] + 10*pos[1] + pos[2];
+  }
+
+  GridType::IndexType subLo(-1, 4, 10), subHi(2, 9, 11);
+  SubGridType sub(subLo, subHi, g);
+  schnek::Range<int, 3> subRange(subLo, subHi);
+  schnek::Range<int, 3> subsubRange(GridType::IndexType(0, 5, 10), GridType::IndexType(1, 6, 10));
+  SubSubGridType subsub(subsubRange, sub);
+
+  // elements of the sub-grid are the elements of the base grid
+  bool same = true;
+  for (const GridType::IndexType &pos : subRange)
+  {
+    same = same && (&sub[pos] == &g[pos]);
+  }
+  for (const GridType::IndexType &pos : subsubRange)
+  {
+    same = same && (&subsub[pos] == &g[pos]);
+  }
+  BOOST_CHECK(same);
+
+  // the view is indexed from the lowest coordinate of the sub-grid
+  SubGridType::KokkosView view = sub.getView();
+  for (size_t d=0; d<3; ++d)
+  {
+    BOOST_CHECK_EQUAL(view.extent(d), size_t(subHi[d] - subLo[d] + 1));
+  }
+  BOOST_CHECK_EQUAL(&view(0, 0, 0), &g[subLo]);
+
+  schnek::RangeKokkosIterationPolicy<3>::forEach(sub.getRange(), [=](const GridType::IndexType &i) {
+    view(i[0] - subLo[0], i[1] - subLo[1], i[2] - subLo[2]) = -1.0;
+  });
+
+  bool ok = true;
+  for (const GridType::IndexType &pos : range)
+  {
+    const bool inside = subRange.inside(pos);
+    ok = ok && (g[pos] == (inside ? -1.0 : 100*pos[0] + 10*pos[1] + pos[2]));
+  }
+  BOOST_CHECK(ok);
+
+  // the storage iterators write to the base grid
+  for (SubGridType::storage_iterator it = sub.begin(); it != sub.end(); ++it) *it = 2.0;
+  for (SubSubGridType::storage_iterator it = subsub.begin(); it != subsub.end(); ++it) *it = 3.0;
+  BOOST_CHECK_EQUAL(g(-1, 4, 10), 2.0);
+  BOOST_CHECK_EQUAL(g(0, 6, 10), 3.0);
+  BOOST_CHECK_EQUAL(g(0, 6, 11), 2.0);
+  BOOST_CHECK_EQUAL(g(-2, 4, 10), -150.0);
+
+  // the sub-grid follows a resize of the base grid
+  g.resize(GridType::IndexType(-4, 0, 0), GridType::IndexType(8, 10, 12));
+  g = 5.0;
+  BOOST_CHECK_EQUAL(sub(-1, 4, 10), 5.0);
+  BOOST_CHECK_EQUAL(subsub(0, 6, 10), 5.0);
+  BOOST_CHECK_EQUAL(&sub.getView()(0, 0, 0), &g[subLo]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
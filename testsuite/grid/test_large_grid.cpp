@@ -0,0 +1,103 @@
+/*
+ * test_large_grid.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/grid.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+// Grids with more than 2^31 elements. The elements are not initialised, so only
+// the pages that are written to are backed by physical memory.
+struct LargeGridTest : public GridTest
+{
+    /// 1024 x 1024 x 2049 = 2^31 + 2^20 elements
+    static constexpr int nx = 1024;
+    static constexpr int ny = 1024;
+    static constexpr int nz = 2049;
+    static constexpr size_t volume = size_t(nx) * size_t(ny) * size_t(nz);
+
+    /// Write to the corners of the grid and check the positions in the array
+    template<class GridType>
+    bool checkCorners(GridType &grid, const ptrdiff_t (&strides)[3])
+    {
+      typedef typename GridType::IndexType IndexType;
+      const IndexType &lo = grid.getLo();
+      const IndexType &hi = grid.getHi();
+      bool ok = true;
+      for (int c=0; c<8; ++c)
+      {
+        IndexType pos((c & 1) ? hi[0] : lo[0], (c & 2) ? hi[1] : lo[1], (c & 4) ? hi[2] : lo[2]);
+        ptrdiff_t expected = 0;
+        for (size_t d=0; d<3; ++d) expected += ptrdiff_t(pos[d] - lo[d])*strides[d];
+
+        grid(pos[0], pos[1], pos[2]) = char('a' + c);
+        ok = ok && (&grid(pos[0], pos[1], pos[2]) - grid.getRawData() == expected);
+      }
+      for (int c=0; c<8; ++c)
+      {
+        ok = ok && (grid((c & 1) ? hi[0] : lo[0], (c & 2) ? hi[1] : lo[1], (c & 4) ? hi[2] : lo[2]) == char('a' + c));
+      }
+      return ok;
+    }
+};
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( large_grid )
+
+BOOST_FIXTURE_TEST_CASE( c_order, LargeGridTest )
+{
+  typedef schnek::Grid<char, 3, GridBoostTestCheck> GridType;
+  GridType grid(GridType::IndexType(-3, 5, -1000), GridType::IndexType(nx - 4, ny + 4, nz - 1001));
+
+  BOOST_CHECK_GT(grid.getSize(), size_t(INT32_MAX));
+  BOOST_CHECK_EQUAL(grid.getSize(), volume);
+  BOOST_CHECK_EQUAL(grid.stride(0), ptrdiff_t(ny)*nz);
+  BOOST_CHECK_EQUAL(grid.stride(2), 1);
+  BOOST_CHECK_EQUAL(grid.end() - grid.begin(), ptrdiff_t(volume));
+
+  const ptrdiff_t strides[3] = {ptrdiff_t(ny)*nz, nz, 1};
+  BOOST_CHECK(checkCorners(grid, strides));
+  BOOST_CHECK_EQUAL(&grid(nx - 4, ny + 4, nz - 1001) - grid.getRawData(), ptrdiff_t(volume) - 1);
+}
+
+BOOST_FIXTURE_TEST_CASE( fortran_order, LargeGridTest )
+{
+  typedef schnek::Grid<char, 3, GridBoostTestCheck, schnek::SingleArrayGridStorageFortran> GridType;
+  GridType grid(GridType::IndexType(-3, 5, -1000), GridType::IndexType(nx - 4, ny + 4, nz - 1001));
+
+  BOOST_CHECK_EQUAL(grid.getSize(), volume);
+  BOOST_CHECK_EQUAL(grid.stride(2), ptrdiff_t(nx)*ny);
+
+  const ptrdiff_t strides[3] = {1, nx, ptrdiff_t(nx)*ny};
+  BOOST_CHECK(checkCorners(grid, strides));
+  BOOST_CHECK_EQUAL(&grid(nx - 4, ny + 4, nz - 1001) - grid.getRawData(), ptrdiff_t(volume) - 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,315 @@
+/*
+ * test_morton_storage.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ * 
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/grid.hpp>
+#include <grid/mortonlayout.hpp>
+
+#include <boost/timer/progress_display.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <limits>
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( morton_storage )
+
+BOOST_FIXTURE_TEST_CASE( access_1d, GridTest )
+{
+  typedef schnek::Grid<double, 1, GridBoostTestCheck, schnek::MortonGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<1>(lo, hi);
+    GridType g(lo,hi);
+    test_access_1d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<1>(lo, hi);
+      g.resize(lo,hi);
+      test_access_1d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_2d, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::MortonGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<2>(lo, hi);
+    GridType g(lo,hi);
+    test_access_2d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<2>(lo, hi);
+      g.resize(lo,hi);
+      test_access_2d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::MortonGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<3>(lo, hi);
+    GridType g(lo,hi);
+    test_access_3d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<3>(lo, hi);
+      g.resize(lo,hi);
+      test_access_3d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_4d, GridTest )
+{
+  typedef schnek::Grid<double, 4, GridBoostTestCheck, schnek::MortonGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<4>(lo, hi);
+    GridType g(lo,hi);
+    test_access_4d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<4>(lo, hi);
+      g.resize(lo,hi);
+      test_access_4d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( range_access_1d, GridTest )
+{
+  typedef schnek::Grid<double, 1, GridBoostTestCheck, schnek::MortonGridStorage> GridType;
+  generic_range_access_Nd<1, GridType>();
+}
+
+BOOST_FIXTURE_TEST_CASE( range_access_2d, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::MortonGridStorage> GridType;
+  generic_range_access_Nd<2, GridType>();
+}
+
+BOOST_FIXTURE_TEST_CASE( range_access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::MortonGridStorage> GridType;
+  generic_range_access_Nd<3, GridType>();
+}
+
+BOOST_FIXTURE_TEST_CASE( range_access_4d, GridTest )
+{
+  typedef schnek::Grid<double, 4, GridBoostTestCheck, schnek::MortonGridStorage> GridType;
+  generic_range_access_Nd<4, GridType>();
+}
+
+BOOST_FIXTURE_TEST_CASE( storage_iterator, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::MortonGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  random_extent(lo, hi);
+  GridType g(lo, hi);
+
+  BOOST_CHECK_EQUAL(g.end() - g.begin(), g.getSize());
+  BOOST_CHECK_GE(g.getSize(), g.getDims().product());
+
+  g = 1.5;
+  double sum = 0.0;
+  for (int i=lo[0]; i<=hi[0]; ++i)
+    for (int j=lo[1]; j<=hi[1]; ++j)
+      for (int k=lo[2]; k<=hi[2]; ++k)
+      {
+        sum += g(i,j,k);
+      }
+
+  BOOST_CHECK(is_equal(sum, 1.5*g.getDims().product()));
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_constructor, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::MortonGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_copy_constructor(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( assignment_operator, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::MortonGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_assignment_operator(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_then_resize, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::MortonGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_copy_resize(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( encode_decode, GridTest )
+{
+  boost::random::uniform_int_distribution<> extentDist(1, 100);
+  for (int n=0; n<20; ++n)
+  {
+    schnek::Array<int, 3> extents(extentDist(rGen), extentDist(rGen), extentDist(rGen));
+    schnek::internal::MortonLayout<3> layout(extents);
+
+    // the masks of the dimensions are disjoint and cover the lowest bits of the code
+    uint64_t all = 0;
+    int numBits = 0;
+    for (size_t d=0; d<3; ++d)
+    {
+      BOOST_CHECK_EQUAL(all & layout.masks[d], 0u);
+      BOOST_CHECK_GE((1 << layout.bits[d]), extents[d]);
+      all |= layout.masks[d];
+      numBits += layout.bits[d];
+    }
+    BOOST_CHECK_EQUAL(all, (uint64_t(1) << numBits) - 1);
+
+    for (int m=0; m<100; ++m)
+    {
+      schnek::Array<int, 3> offset, decoded;
+      for (size_t d=0; d<3; ++d)
+      {
+        offset[d] = boost::random::uniform_int_distribution<>(0, extents[d]-1)(rGen);
+      }
+      layout.decode(layout.encode(offset), decoded);
+      BOOST_CHECK(decoded == offset);
+    }
+  }
+
+  // equal extents interleave the bits, the last dimension being the least significant
+  schnek::internal::MortonLayout<2> square(schnek::Array<int, 2>(4, 4));
+  BOOST_CHECK_EQUAL(square.masks[0], 0xAu);
+  BOOST_CHECK_EQUAL(square.masks[1], 0x5u);
+  BOOST_CHECK_EQUAL(square.encode(schnek::Array<int, 2>(1, 2)), 0x6u);
+}
+
+BOOST_FIXTURE_TEST_CASE( storage_order, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::MortonGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  for (int n=0; n<10; ++n)
+  {
+    random_extent(lo, hi);
+    GridType g(lo, hi);
+
+    // the Morton iteration visits the grid in increasing memory order
+    const double *last = g.getRawData() - 1;
+    bool increasing = true;
+    GridType::IterationPolicy::forEach(g.getRange(), [&](const GridType::IndexType &pos) {
+      const double *current = &g[pos];
+      increasing = increasing && (current > last);
+      last = current;
+    });
+    BOOST_CHECK(increasing);
+    BOOST_CHECK_LT(last - g.getRawData(), g.getSize());
+  }
+
+  // with power-of-two extents the grid is traversed contiguously
+  lo = GridType::IndexType(-3, 5, 0);
+  hi = GridType::IndexType(4, 36, 15);
+  GridType g(lo, hi);
+  BOOST_CHECK_EQUAL(g.getSize(), g.getDims().product());
+  ptrdiff_t expected = 0;
+  bool contiguous = true;
+  GridType::IterationPolicy::forEach(g.getRange(), [&](const GridType::IndexType &pos) {
+    contiguous = contiguous && (&g[pos] - g.getRawData() == expected++);
+  });
+  BOOST_CHECK(contiguous);
+}
+
+BOOST_FIXTURE_TEST_CASE( free_shared, GridTest )
+{
+  typedef schnek::Grid<DeleteCounter, 1, GridBoostTestCheck, schnek::MortonGridStorage> GridType;
+  std::map<int, int> counters;
+
+  DeleteCounter del1(1, counters);
+  DeleteCounter del2(2, counters);
+
+  GridType::IndexType lo(0), hi(10);
+  GridType *ga = new GridType(lo, hi);
+  GridType *gb = new GridType(lo, hi);
+  GridType *gc = new GridType(*ga);
+  *ga = del1;
+  *gb = del2;
+
+  // the padding elements are also destroyed
+  const int size = ga->getSize();
+  BOOST_CHECK_GE(size, 11);
+
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 0ul);
+
+  *gb = *ga;
+
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 1ul);
+  BOOST_CHECK_EQUAL(counters[2], size);
+  
+  delete ga;
+  delete gc;
+  
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 1ul);
+  
+  delete gb;
+  
+  BOOST_CHECK_EQUAL(counters.count(1), 1ul);
+  BOOST_CHECK_EQUAL(counters[1], size);
+  BOOST_CHECK_EQUAL(counters[2], size);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,368 @@
+/*
+ * test_pooled_storage.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ * 
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/grid.hpp>
+#include <util/memorypool.hpp>
+#include <util/threadpool.hpp>
+
+#include <boost/timer/progress_display.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <limits>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( pooled_storage )
+
+BOOST_FIXTURE_TEST_CASE( access_1d, GridTest )
+{
+  typedef schnek::Grid<double, 1, GridBoostTestCheck, schnek::PooledArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<1>(lo, hi);
+    GridType g(lo,hi);
+    test_access_1d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<1>(lo, hi);
+      g.resize(lo,hi);
+      test_access_1d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_2d, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::PooledArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<2>(lo, hi);
+    GridType g(lo,hi);
+    test_access_2d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<2>(lo, hi);
+      g.resize(lo,hi);
+      test_access_2d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::PooledArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<3>(lo, hi);
+    GridType g(lo,hi);
+    test_access_3d(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<3>(lo, hi);
+      g.resize(lo,hi);
+      test_access_3d(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( range_access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::PooledArrayGridStorage> GridType;
+  generic_range_access_Nd<3, GridType>();
+}
+
+BOOST_FIXTURE_TEST_CASE( stride_2d, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::PooledArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(100);
+  for (int n=0; n<10; ++n)
+  {
+    random_extent(lo, hi);
+
+    GridType g(lo, hi);
+    hi = hi - 1;
+    for (int m=0; m<10; ++m)
+    {
+      GridType::IndexType index = random_index(lo, hi);
+      test_stride(g, index);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( stride_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::PooledArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(100);
+  for (int n=0; n<10; ++n)
+  {
+    random_extent(lo, hi);
+
+    GridType g(lo, hi);
+    hi = hi - 1;
+    for (int m=0; m<10; ++m)
+    {
+      GridType::IndexType index = random_index(lo, hi);
+      test_stride(g, index);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_constructor, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::PooledArrayGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_copy_constructor(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( assignment_operator, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::PooledArrayGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_assignment_operator(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_then_resize, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::PooledArrayGridStorage> GridType;
+
+  GridType::IndexType lo, hi;
+  random_extent<3>(lo, hi);
+  GridType g(lo,hi);
+  test_copy_resize(g);
+}
+
+BOOST_FIXTURE_TEST_CASE( lazy_access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::LazyPooledArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<3>(lo, hi);
+    GridType g(lo,hi);
+    test_access_3d(g);
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<3>(lo, hi);
+      g.resize(lo,hi);
+      test_access_3d(g);
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( fortran_access_3d, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::PooledArrayGridStorageFortran> GridType;
+  GridType::IndexType lo, hi;
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<3>(lo, hi);
+    GridType g(lo,hi);
+    test_access_3d(g);
+    random_extent<3>(lo, hi);
+    g.resize(lo,hi);
+    test_access_3d(g);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( aligned_line_alignment, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedPooledArrayGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  for (int n=0; n<10; ++n)
+  {
+    random_extent(lo, hi);
+    GridType g(lo, hi);
+    test_access_3d(g);
+    test_line_alignment(g, 2, SCHNEK_DEFAULT_ALIGNMENT);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( size_classes, GridTest )
+{
+  typedef schnek::MemoryPool Pool;
+  BOOST_CHECK_EQUAL(Pool::sizeClass(0), 0ul);
+  BOOST_CHECK_EQUAL(Pool::sizeClass(Pool::blockAlignment), 0ul);
+  BOOST_CHECK_EQUAL(Pool::classBytes(0), Pool::blockAlignment);
+
+  for (size_t cls=0; cls+1<Pool::numClasses; ++cls)
+  {
+    size_t bytes = Pool::classBytes(cls);
+    BOOST_CHECK_LT(bytes, Pool::classBytes(cls+1));
+    BOOST_CHECK_EQUAL(Pool::sizeClass(bytes), cls);
+    BOOST_CHECK_EQUAL(Pool::sizeClass(bytes + 1), cls + 1);
+  }
+
+  for (int n=0; n<1000; ++n)
+  {
+    size_t bytes = boost::random::uniform_int_distribution<size_t>(1, size_t(1) << 32)(rGen);
+    size_t cls = Pool::sizeClass(bytes);
+    BOOST_CHECK_GE(Pool::classBytes(cls), bytes);
+    BOOST_CHECK_LE(Pool::classBytes(cls), bytes + bytes/4 + Pool::blockAlignment);
+  }
+
+  BOOST_CHECK_EQUAL(Pool::sizeClass(Pool::classBytes(Pool::numClasses - 1) + 1), Pool::numClasses);
+}
+
+BOOST_FIXTURE_TEST_CASE( statistics_and_trim, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::PooledArrayGridStorage> GridType;
+  schnek::MemoryPool &pool = schnek::MemoryPool::instance();
+  pool.trim();
+  pool.resetStatistics();
+
+  GridType::IndexType lo(0,0,0), hi(19,29,39);
+  const size_t bytes = pool.classBytes(pool.sizeClass(20*30*40*sizeof(double)));
+  {
+    GridType g(lo, hi);
+    schnek::MemoryPool::Statistics stats = pool.getStatistics();
+    BOOST_CHECK_EQUAL(stats.hits, 0ul);
+    BOOST_CHECK_EQUAL(stats.misses, 1ul);
+    BOOST_CHECK_EQUAL(stats.bytesHeld, 0ul);
+    BOOST_CHECK_EQUAL(stats.bytesInUse, bytes);
+  }
+
+  schnek::MemoryPool::Statistics stats = pool.getStatistics();
+  BOOST_CHECK_EQUAL(stats.bytesHeld, bytes);
+  BOOST_CHECK_EQUAL(stats.bytesInUse, 0ul);
+
+  for (int n=0; n<10; ++n)
+  {
+    GridType g(lo, hi);
+    test_access_3d(g);
+  }
+
+  stats = pool.getStatistics();
+  BOOST_CHECK_EQUAL(stats.hits, 10ul);
+  BOOST_CHECK_EQUAL(stats.misses, 1ul);
+  BOOST_CHECK_EQUAL(stats.bytesHeld, bytes);
+
+  pool.trim();
+  stats = pool.getStatistics();
+  BOOST_CHECK_EQUAL(stats.bytesHeld, 0ul);
+  BOOST_CHECK_EQUAL(stats.bytesInUse, 0ul);
+
+  const size_t maxHeld = pool.getMaxHeldBytes();
+  pool.setMaxHeldBytes(bytes - 1);
+  {
+    GridType g(lo, hi);
+  }
+  BOOST_CHECK_EQUAL(pool.getStatistics().bytesHeld, 0ul);
+  pool.setMaxHeldBytes(maxHeld);
+}
+
+BOOST_FIXTURE_TEST_CASE( threaded_allocation, GridTest )
+{
+  typedef schnek::Grid<double, 2, schnek::GridNoArgCheck, schnek::PooledArrayGridStorage> GridType;
+  schnek::MemoryPool &pool = schnek::MemoryPool::instance();
+  schnek::ThreadPool &threads = schnek::ThreadPool::instance();
+  const size_t numThreads = threads.getNumThreads();
+  threads.setNumThreads(4);
+  pool.trim();
+
+  std::vector<int> errors(4, 0);
+  threads.run([&](size_t t) {
+    for (int n=0; n<200; ++n)
+    {
+      int size = 1 + (n*7 + int(t)*13) % 50;
+      GridType g(GridType::IndexType(0,0), GridType::IndexType(size, size));
+      g = double(t);
+      for (int i=0; i<=size; ++i)
+        if (g(i, size-i) != double(t)) ++errors[t];
+    }
+  });
+
+  for (int e : errors) BOOST_CHECK_EQUAL(e, 0);
+  BOOST_CHECK_EQUAL(pool.getStatistics().bytesInUse, 0ul);
+  BOOST_CHECK_GT(pool.getStatistics().hits, 0ul);
+
+  pool.trim();
+  BOOST_CHECK_EQUAL(pool.getStatistics().bytesHeld, 0ul);
+  threads.setNumThreads(numThreads);
+}
+
+BOOST_FIXTURE_TEST_CASE( free_shared, GridTest )
+{
+  typedef schnek::Grid<DeleteCounter, 1, GridBoostTestCheck, schnek::PooledArrayGridStorage> GridType;
+  std::map<int, int> counters;
+
+  DeleteCounter del1(1, counters);
+  DeleteCounter del2(2, counters);
+
+  GridType::IndexType lo(0), hi(10);
+  GridType *ga = new GridType(lo, hi);
+  GridType *gb = new GridType(lo, hi);
+  GridType *gc = new GridType(*ga);
+  *ga = del1;
+  *gb = del2;
+
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 0ul);
+
+  *gb = *ga;
+
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 1ul);
+  BOOST_CHECK_EQUAL(counters[2], 11);
+  
+  delete ga;
+  delete gc;
+  
+  BOOST_CHECK_EQUAL(counters.count(1), 0ul);
+  BOOST_CHECK_EQUAL(counters.count(2), 1ul);
+  
+  delete gb;
+  
+  BOOST_CHECK_EQUAL(counters.count(1), 1ul);
+  BOOST_CHECK_EQUAL(counters[1], 11);
+  BOOST_CHECK_EQUAL(counters[2], 11);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
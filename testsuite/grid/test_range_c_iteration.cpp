@@ -467,6 +467,90 @@ BOOST_FIXTURE_TEST_CASE( iterate_10d, RangeIterationTest )
 
 
 
+BOOST_FIXTURE_TEST_CASE( lines_1d, RangeIterationTest )
+{
+    typedef Grid<int, 1, GridBoostTestCheck, schnek::SingleArrayGridStorage> GridType;
+
+    GridType::IndexType lo, hi;
+
+    boost::timer::progress_display show_progress(10);
+
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<1>(lo, hi);
+        Range<int, 1, ArrayBoostTestArgCheck> range(lo, hi);
+        GridType expected(lo, hi);
+        GridType grid(lo, hi);
+
+        int count = 0;
+        RangeCIterationPolicy<1>::forEach(range, [&](const GridType::IndexType& pos){
+            expected[pos] = count++;
+        });
+
+        // the lines are contiguous in memory and visited in the same order
+        count = 0;
+        int numLines = 0;
+        RangeCIterationPolicy<1>::forEachLine(range, [&](const GridType::IndexType& pos, int length){
+            BOOST_CHECK_EQUAL(pos[0], lo[0]);
+            BOOST_CHECK_EQUAL(length, hi[0] - lo[0] + 1);
+            int *line = &grid[pos];
+            for (int i=0; i<length; ++i) line[i] = count++;
+            ++numLines;
+        });
+
+        BOOST_CHECK_EQUAL(numLines, int(grid.getSize()) / (hi[0] - lo[0] + 1));
+        bool same = true;
+        for (auto it = grid.begin(), jt = expected.begin(); it != grid.end(); ++it, ++jt)
+        {
+            same = same && (*it == *jt);
+        }
+        BOOST_CHECK(same);
+        ++show_progress;
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( lines_3d, RangeIterationTest )
+{
+    typedef Grid<int, 3, GridBoostTestCheck, schnek::SingleArrayGridStorage> GridType;
+
+    GridType::IndexType lo, hi;
+
+    boost::timer::progress_display show_progress(10);
+
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<3>(lo, hi);
+        Range<int, 3, ArrayBoostTestArgCheck> range(lo, hi);
+        GridType expected(lo, hi);
+        GridType grid(lo, hi);
+
+        int count = 0;
+        RangeCIterationPolicy<3>::forEach(range, [&](const GridType::IndexType& pos){
+            expected[pos] = count++;
+        });
+
+        // the lines are contiguous in memory and visited in the same order
+        count = 0;
+        int numLines = 0;
+        RangeCIterationPolicy<3>::forEachLine(range, [&](const GridType::IndexType& pos, int length){
+            BOOST_CHECK_EQUAL(pos[2], lo[2]);
+            BOOST_CHECK_EQUAL(length, hi[2] - lo[2] + 1);
+            int *line = &grid[pos];
+            for (int i=0; i<length; ++i) line[i] = count++;
+            ++numLines;
+        });
+
+        BOOST_CHECK_EQUAL(numLines, int(grid.getSize()) / (hi[2] - lo[2] + 1));
+        bool same = true;
+        for (auto it = grid.begin(), jt = expected.begin(); it != grid.end(); ++it, ++jt)
+        {
+            same = same && (*it == *jt);
+        }
+        BOOST_CHECK(same);
+        ++show_progress;
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -18,6 +18,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <limits>
+
 using namespace schnek;
 
 #ifdef SCHNEK_HAVE_KOKKOS
@@ -93,6 +96,34 @@ struct Assign6d {
     }
 };
 
+struct IndexValue1d {
+    SCHNEK_INLINE long operator()(const Array<int, 1>& pos) const
+    {
+        return pos[0];
+    }
+};
+
+struct IndexValue3d {
+    SCHNEK_INLINE long operator()(const Array<int, 3>& pos) const
+    {
+        return pos[0] + 3*pos[1] + 7*pos[2];
+    }
+};
+
+struct Plus {
+    SCHNEK_INLINE long operator()(long a, long b) const
+    {
+        return a + b;
+    }
+};
+
+struct Max {
+    SCHNEK_INLINE long operator()(long a, long b) const
+    {
+        return a < b ? b : a;
+    }
+};
+
 BOOST_AUTO_TEST_SUITE( range_iteration )
 
 BOOST_AUTO_TEST_SUITE( kokkos )
@@ -302,6 +333,54 @@ BOOST_FIXTURE_TEST_CASE( iterate_6d, RangeIterationTest )
     }
 }
 
+BOOST_FIXTURE_TEST_CASE( reduce_1d, RangeIterationTest )
+{
+    Array<int, 1> lo, hi;
+
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<1>(lo, hi);
+        Range<int, 1, ArrayNoArgCheck> range(lo, hi);
+
+        long expected = 0;
+        for (int i=lo[0]; i<=hi[0]; ++i) expected += i;
+
+        const long sum = RangeKokkosIterationPolicy<1, Execution>::reduce(range, 0L, IndexValue1d(), Plus());
+        BOOST_CHECK_EQUAL(sum, expected);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( reduce_3d, RangeIterationTest )
+{
+    Array<int, 3> lo, hi;
+
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<3>(lo, hi);
+        Range<int, 3, ArrayNoArgCheck> range(lo, hi);
+
+        long expectedSum = 0;
+        long expectedMax = std::numeric_limits<long>::lowest();
+        for (int i=lo[0]; i<=hi[0]; ++i)
+            for (int j=lo[1]; j<=hi[1]; ++j)
+                for (int k=lo[2]; k<=hi[2]; ++k)
+                {
+                    expectedSum += i + 3*j + 7*k;
+                    expectedMax = std::max(expectedMax, long(i + 3*j + 7*k));
+                }
+
+        BOOST_CHECK_EQUAL(RangeKokkosIterationPolicy<3>::reduce(range, 0L, IndexValue3d(), Plus()), expectedSum);
+        BOOST_CHECK_EQUAL(
+            RangeKokkosIterationPolicy<3>::reduce(range, std::numeric_limits<long>::lowest(), IndexValue3d(), Max()),
+            expectedMax
+        );
+    }
+
+    // an empty range returns the initial value
+    Range<int, 3, ArrayNoArgCheck> empty(Array<int, 3>(0, 5, 0), Array<int, 3>(3, 4, 3));
+    BOOST_CHECK_EQUAL(RangeKokkosIterationPolicy<3>::reduce(empty, 0L, IndexValue3d(), Plus()), 0L);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
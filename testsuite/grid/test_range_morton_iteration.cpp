@@ -0,0 +1,118 @@
+/*
+ * test_range_morton_iteration.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ */
+
+#include "../utility.hpp"
+#include "range_test_fixture.hpp"
+
+#include <grid/iteration/morton-iteration.hpp>
+#include <grid/grid.hpp>
+#include <grid/range.hpp>
+
+#include <boost/timer/progress_display.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+using namespace schnek;
+
+/**
+ * Check that the iteration visits every index exactly once, in increasing order
+ * of the Morton code of the offset from the lower corner.
+ */
+template<size_t rank>
+void check_morton_iteration(const Array<int, rank> &lo, const Array<int, rank> &hi)
+{
+    typedef Grid<int, rank, GridBoostTestCheck, schnek::SingleArrayGridStorage> GridType;
+
+    Range<int, rank, ArrayBoostTestArgCheck> range(lo, hi);
+    GridType visits(lo, hi);
+    visits = 0;
+
+    internal::MortonLayout<rank> layout(visits.getDims());
+    std::vector<uint64_t> codes;
+    RangeMortonIterationPolicy<rank>::forEach(range, [&](const typename GridType::IndexType& pos){
+        ++visits[pos];
+        Array<int, rank> offset;
+        for (size_t d=0; d<rank; ++d)
+        {
+            offset[d] = pos[d] - lo[d];
+        }
+        codes.push_back(layout.encode(offset));
+    });
+
+    bool allOnce = true;
+    for (auto it = visits.begin(); it != visits.end(); ++it)
+    {
+        allOnce = allOnce && (*it == 1);
+    }
+    BOOST_CHECK(allOnce);
+    BOOST_CHECK_EQUAL(codes.size(), size_t(visits.getSize()));
+
+    bool ordered = true;
+    for (size_t n=1; n<codes.size(); ++n)
+    {
+        ordered = ordered && (codes[n-1] < codes[n]);
+    }
+    BOOST_CHECK(ordered);
+}
+
+BOOST_AUTO_TEST_SUITE( range_iteration )
+
+BOOST_AUTO_TEST_SUITE( morton )
+
+BOOST_FIXTURE_TEST_CASE( iterate_1d, RangeIterationTest )
+{
+    Array<int, 1> lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<1>(lo, hi);
+        check_morton_iteration<1>(lo, hi);
+        ++show_progress;
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( iterate_2d, RangeIterationTest )
+{
+    Array<int, 2> lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<2>(lo, hi);
+        check_morton_iteration<2>(lo, hi);
+        ++show_progress;
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( iterate_3d, RangeIterationTest )
+{
+    Array<int, 3> lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<3>(lo, hi);
+        check_morton_iteration<3>(lo, hi);
+        ++show_progress;
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( iterate_4d, RangeIterationTest )
+{
+    Array<int, 4> lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<4>(lo, hi);
+        check_morton_iteration<4>(lo, hi);
+        ++show_progress;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,269 @@
+/*
+ * test_range_reduction.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ */
+
+#include "../utility.hpp"
+#include "range_test_fixture.hpp"
+
+#include <grid/iteration/reduction.hpp>
+#include <grid/iteration/range-iteration.hpp>
+#include <grid/iteration/tiled-iteration.hpp>
+#include <grid/iteration/morton-iteration.hpp>
+#include <grid/iteration/sparse-iteration.hpp>
+#include <grid/iteration/threaded-iteration.hpp>
+#include <grid/gridstorage/sparse-storage.hpp>
+#include <grid/domainsubdivision.hpp>
+#include <grid/field.hpp>
+#include <grid/grid.hpp>
+#include <grid/range.hpp>
+#include <util/threadpool.hpp>
+
+#include <boost/timer/progress_display.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace schnek;
+
+/// A value that depends on every component of the index
+template<size_t rank>
+long indexValue(const Array<int, rank> &pos)
+{
+    long value = 0;
+    for (size_t d=0; d<rank; ++d) value = 31*value + pos[d];
+    return value;
+}
+
+/**
+ * Check that the reduction of an iteration policy matches a plain loop over the range
+ */
+template<size_t rank, class IterationPolicy>
+void check_reduce(const Array<int, rank> &lo, const Array<int, rank> &hi)
+{
+    typedef Array<int, rank> IndexType;
+    Range<int, rank, ArrayBoostTestArgCheck> range(lo, hi);
+
+    long expectedSum = 0;
+    long expectedMax = std::numeric_limits<long>::lowest();
+    for (auto it = range.begin(); it != range.end(); ++it)
+    {
+        expectedSum += indexValue<rank>(*it);
+        expectedMax = std::max(expectedMax, indexValue<rank>(*it));
+    }
+
+    const long sum = IterationPolicy::reduce(
+        range,
+        0L,
+        [](const IndexType &pos) { return indexValue<rank>(pos); },
+        [](long a, long b) { return a + b; }
+    );
+    BOOST_CHECK_EQUAL(sum, expectedSum);
+
+    const long max = IterationPolicy::reduce(
+        range,
+        std::numeric_limits<long>::lowest(),
+        [](const IndexType &pos) { return indexValue<rank>(pos); },
+        [](long a, long b) { return std::max(a, b); }
+    );
+    BOOST_CHECK_EQUAL(max, expectedMax);
+}
+
+template<size_t rank>
+void check_all_policies(const Array<int, rank> &lo, const Array<int, rank> &hi)
+{
+    check_reduce<rank, RangeCIterationPolicy<rank> >(lo, hi);
+    check_reduce<rank, RangeFortranIterationPolicy<rank> >(lo, hi);
+    check_reduce<rank, RangeTiledIterationPolicy<rank, GridTile<> > >(lo, hi);
+    check_reduce<rank, RangeMortonIterationPolicy<rank> >(lo, hi);
+    check_reduce<rank, SparseTileIterationPolicy<rank, GridTile<> > >(lo, hi);
+    check_reduce<rank, RangeThreadedIterationPolicy<rank, StaticSchedule> >(lo, hi);
+    check_reduce<rank, RangeThreadedIterationPolicy<rank, DynamicSchedule<3> > >(lo, hi);
+    check_reduce<rank, RangeThreadedIterationPolicy<rank, DeterministicSchedule> >(lo, hi);
+    check_reduce<rank, RangeWorkStealingIterationPolicy<rank, 2> >(lo, hi);
+    check_reduce<rank, RangeTiledThreadedIterationPolicy<rank, GridTile<>, DynamicSchedule<> > >(lo, hi);
+}
+
+BOOST_AUTO_TEST_SUITE( range_iteration )
+
+BOOST_AUTO_TEST_SUITE( reduce )
+
+BOOST_FIXTURE_TEST_CASE( reduce_1d, RangeIterationTest )
+{
+    Array<int, 1> lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<1>(lo, hi);
+        check_all_policies<1>(lo, hi);
+        ++show_progress;
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( reduce_2d, RangeIterationTest )
+{
+    Array<int, 2> lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<2>(lo, hi);
+        check_all_policies<2>(lo, hi);
+        ++show_progress;
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( reduce_3d, RangeIterationTest )
+{
+    Array<int, 3> lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<3>(lo, hi);
+        check_all_policies<3>(lo, hi);
+        ++show_progress;
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( empty_range, RangeIterationTest )
+{
+    Range<int, 2> empty(Array<int, 2>(0, 5), Array<int, 2>(10, 4));
+    auto value = [](const Array<int, 2> &) { return 1; };
+    auto plus = [](int a, int b) { return a + b; };
+
+    BOOST_CHECK_EQUAL(RangeCIterationPolicy<2>::reduce(empty, 7, value, plus), 7);
+    BOOST_CHECK_EQUAL(RangeTiledIterationPolicy<2>::reduce(empty, 7, value, plus), 7);
+    BOOST_CHECK_EQUAL(RangeMortonIterationPolicy<2>::reduce(empty, 7, value, plus), 7);
+    BOOST_CHECK_EQUAL(RangeThreadedIterationPolicy<2>::reduce(empty, 7, value, plus), 7);
+}
+
+BOOST_FIXTURE_TEST_CASE( threaded_reproducible, RangeIterationTest )
+{
+    // with a fixed number of threads the partial sums are combined in the same order
+    ThreadPool &pool = ThreadPool::instance();
+    const size_t numThreads = pool.getNumThreads();
+    pool.setNumThreads(4);
+
+    Range<int, 3> range(Array<int, 3>(-20, 0, 3), Array<int, 3>(25, 17, 40));
+    auto value = [](const Array<int, 3> &pos) { return 1.0/(1.0 + pos[0]*pos[0] + 0.1*pos[1] + 0.01*pos[2]); };
+    auto plus = [](double a, double b) { return a + b; };
+
+    const double first = RangeThreadedIterationPolicy<3>::reduce(range, 0.0, value, plus);
+    bool same = true;
+    for (int n=0; n<20; ++n)
+    {
+        same = same && (RangeThreadedIterationPolicy<3>::reduce(range, 0.0, value, plus) == first);
+        same = same && (RangeThreadedIterationPolicy<3, DynamicSchedule<5> >::reduce(range, 0.0, value, plus)
+                        == RangeThreadedIterationPolicy<3, DynamicSchedule<5> >::reduce(range, 0.0, value, plus));
+    }
+    BOOST_CHECK(same);
+
+    const double serial = RangeCIterationPolicy<3>::reduce(range, 0.0, value, plus);
+    BOOST_CHECK_CLOSE(first, serial, 1e-10);
+
+    pool.setNumThreads(numThreads);
+}
+
+BOOST_FIXTURE_TEST_CASE( builtin_reductions, RangeIterationTest )
+{
+    Array<int, 2> lo(-3, 2), hi(4, 9);
+    Grid<double, 2> grid(lo, hi);
+    double sum = 0.0, sumSquares = 0.0;
+    double min = std::numeric_limits<double>::max(), max = std::numeric_limits<double>::lowest();
+    for (int i=lo[0]; i<=hi[0]; ++i)
+        for (int j=lo[1]; j<=hi[1]; ++j)
+        {
+            grid(i, j) = dist(rGen) - 0.5;
+            sum += grid(i, j);
+            sumSquares += grid(i, j)*grid(i, j);
+            min = std::min(min, grid(i, j));
+            max = std::max(max, grid(i, j));
+        }
+
+    Range<int, 2> range(lo, hi);
+    auto value = [&](const Array<int, 2> &pos) { return grid[pos]; };
+    typedef RangeThreadedIterationPolicy<2> Policy;
+
+    BOOST_CHECK_CLOSE((reduceRange<SumReduction<double>, Policy>(range, value)), sum, 1e-10);
+    BOOST_CHECK_EQUAL((reduceRange<MinReduction<double>, Policy>(range, value)), min);
+    BOOST_CHECK_EQUAL((reduceRange<MaxReduction<double>, Policy>(range, value)), max);
+    BOOST_CHECK_CLOSE((reduceRange<L2NormReduction<double>, Policy>(range, value)), std::sqrt(sumSquares), 1e-10);
+
+    SerialSubdivision<Grid<double, 2> > subdivision;
+    BOOST_CHECK_CLOSE((globalReduce<SumReduction<double>, Policy>(range, value, subdivision)), sum, 1e-10);
+    BOOST_CHECK_EQUAL((globalReduce<MaxReduction<double>, Policy>(range, value, subdivision)), max);
+}
+
+BOOST_FIXTURE_TEST_CASE( sparse_background, RangeIterationTest )
+{
+    // the points in unallocated tiles hold the background and take part in the reduction
+    typedef Grid<double, 2, GridBoostTestCheck, SparseGridStorage> GridType;
+    typedef GridType::IterationPolicy Policy;
+    GridType grid(Array<int, 2>(0, 0), Array<int, 2>(23, 31));
+    grid.setBackground(-2.0);
+    grid(3, 4) = 5.0;
+    grid(20, 30) = 7.0;
+    BOOST_CHECK_EQUAL(grid.getStatistics().allocatedTiles, 2);
+
+    auto value = [&](const Array<int, 2> &pos) { return double(grid[pos]); };
+    auto plus = [](double a, double b) { return a + b; };
+    auto min = [](double a, double b) { return std::min(a, b); };
+
+    // the allocated tiles are filled with the background as well
+    const double sum = -2.0*(24*32 - 2) + 5.0 + 7.0;
+    BOOST_CHECK_EQUAL(Policy::reduce(grid, 0.0, value, plus), sum);
+    BOOST_CHECK_EQUAL(Policy::reduce(grid, std::numeric_limits<double>::max(), value, min), -2.0);
+
+    grid.setBackground(3.0);
+    grid(1, 1) = 4.0;
+    grid(18, 18) = 6.0;
+    grid.compact();
+    BOOST_CHECK_EQUAL((reduceRange<MinReduction<double>, Policy>(grid, value)), -2.0);
+    grid.setBackground(1.0);
+    grid = 1.0;
+    grid(18, 18) = 6.0;
+    grid.compact();
+    BOOST_CHECK_EQUAL(grid.getStatistics().allocatedTiles, 1);
+
+    // the allocated 8x8 tile holds 1.0 and 6.0, all other points the background
+    grid.setBackground(9.0);
+    BOOST_CHECK_EQUAL((reduceRange<MaxReduction<double>, Policy>(grid, value)), 9.0);
+    BOOST_CHECK_EQUAL((reduceRange<MinReduction<double>, Policy>(grid, value)), 1.0);
+    BOOST_CHECK_EQUAL((reduceRange<SumReduction<double>, Policy>(grid, value)), 9.0*(24*32 - 64) + 63.0 + 6.0);
+    grid.setBackground(-4.0);
+    BOOST_CHECK_EQUAL((reduceRange<MinReduction<double>, Policy>(grid, value)), -4.0);
+}
+
+BOOST_FIXTURE_TEST_CASE( global_norm, RangeIterationTest )
+{
+    typedef Field<double, 2, GridBoostTestCheck> FieldType;
+    typedef Field<double, 2, GridBoostTestCheck, SparseGridStorage> SparseFieldType;
+    const Range<double, 2> domain(Array<double, 2>(0.0, 0.0), Array<double, 2>(1.0, 1.0));
+
+    FieldType field(Array<int, 2>(20, 30), domain, Array<bool, 2>(false, false), 2);
+    SparseFieldType sparse(Array<int, 2>(20, 30), domain, Array<bool, 2>(false, false), 2);
+
+    // the ghost cells do not contribute to the norm
+    field = 100.0;
+    double sumSquares = 0.0;
+    for (int i=0; i<20; ++i)
+        for (int j=0; j<30; ++j)
+        {
+            field(i, j) = (i + j) % 3;
+            sparse(i, j) = (i + j) % 3;
+            sumSquares += field(i, j)*field(i, j);
+        }
+
+    SerialSubdivision<FieldType> subdivision;
+    BOOST_CHECK_CLOSE(globalNorm(field, subdivision), std::sqrt(sumSquares), 1e-10);
+    BOOST_CHECK_CLOSE(globalNorm<RangeThreadedIterationPolicy<2> >(field, subdivision), std::sqrt(sumSquares), 1e-10);
+    BOOST_CHECK_CLOSE(globalNorm(sparse, subdivision), std::sqrt(sumSquares), 1e-10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
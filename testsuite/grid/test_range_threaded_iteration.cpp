@@ -0,0 +1,261 @@
+/*
+ * test_range_threaded_iteration.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ */
+
+#include "../utility.hpp"
+#include "range_test_fixture.hpp"
+
+#include <grid/iteration/threaded-iteration.hpp>
+#include <grid/iteration/range-iteration.hpp>
+#include <grid/grid.hpp>
+#include <grid/range.hpp>
+#include <util/threadpool.hpp>
+
+#include <boost/timer/progress_display.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace schnek;
+
+/**
+ * Check that the iteration visits every index exactly once, for different numbers of threads
+ */
+template<size_t rank, class Schedule>
+void check_threaded_iteration(const Array<int, rank> &lo, const Array<int, rank> &hi)
+{
+    typedef Grid<int, rank, GridBoostTestCheck, schnek::SingleArrayGridStorage> GridType;
+
+    ThreadPool &pool = ThreadPool::instance();
+    const size_t numThreads = pool.getNumThreads();
+
+    Range<int, rank, ArrayBoostTestArgCheck> range(lo, hi);
+    GridType visits(lo, hi);
+    for (size_t threads : {1ul, 2ul, 3ul, 8ul})
+    {
+        pool.setNumThreads(threads);
+        visits = 0;
+        RangeThreadedIterationPolicy<rank, Schedule>::forEach(range, [&](const typename GridType::IndexType& pos){
+            ++visits[pos];
+        });
+
+        bool allOnce = true;
+        for (auto it = visits.begin(); it != visits.end(); ++it)
+        {
+            allOnce = allOnce && (*it == 1);
+        }
+        BOOST_CHECK(allOnce);
+    }
+    pool.setNumThreads(numThreads);
+}
+
+/**
+ * Check that the deterministic schedule visits the indices in C-order
+ */
+template<size_t rank>
+void check_deterministic_iteration(const Array<int, rank> &lo, const Array<int, rank> &hi)
+{
+    typedef Array<int, rank> IndexType;
+    Range<int, rank, ArrayBoostTestArgCheck> range(lo, hi);
+
+    std::vector<IndexType> expected;
+    RangeCIterationPolicy<rank>::forEach(range, [&](const IndexType& pos){ expected.push_back(pos); });
+
+    std::vector<IndexType> visited;
+    RangeThreadedIterationPolicy<rank, DeterministicSchedule>::forEach(range, [&](const IndexType& pos){
+        visited.push_back(pos);
+    });
+
+    BOOST_REQUIRE_EQUAL(visited.size(), expected.size());
+    bool same = true;
+    for (size_t n=0; n<visited.size(); ++n)
+    {
+        for (size_t d=0; d<rank; ++d) same = same && (visited[n][d] == expected[n][d]);
+    }
+    BOOST_CHECK(same);
+}
+
+BOOST_AUTO_TEST_SUITE( range_iteration )
+
+BOOST_AUTO_TEST_SUITE( threaded )
+
+BOOST_FIXTURE_TEST_CASE( iterate_1d, RangeIterationTest )
+{
+    Array<int, 1> lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<1>(lo, hi);
+        check_threaded_iteration<1, StaticSchedule>(lo, hi);
+        check_threaded_iteration<1, DynamicSchedule<> >(lo, hi);
+        check_threaded_iteration<1, DynamicSchedule<7> >(lo, hi);
+        check_threaded_iteration<1, WorkStealingSchedule<3> >(lo, hi);
+        check_deterministic_iteration<1>(lo, hi);
+        ++show_progress;
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( iterate_2d, RangeIterationTest )
+{
+    Array<int, 2> lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<2>(lo, hi);
+        check_threaded_iteration<2, StaticSchedule>(lo, hi);
+        check_threaded_iteration<2, DynamicSchedule<> >(lo, hi);
+        check_threaded_iteration<2, DynamicSchedule<3> >(lo, hi);
+        check_threaded_iteration<2, WorkStealingSchedule<> >(lo, hi);
+        check_deterministic_iteration<2>(lo, hi);
+        ++show_progress;
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( iterate_3d, RangeIterationTest )
+{
+    Array<int, 3> lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<3>(lo, hi);
+        check_threaded_iteration<3, StaticSchedule>(lo, hi);
+        check_threaded_iteration<3, DynamicSchedule<> >(lo, hi);
+        check_threaded_iteration<3, DynamicSchedule<5> >(lo, hi);
+        check_threaded_iteration<3, WorkStealingSchedule<2> >(lo, hi);
+        check_deterministic_iteration<3>(lo, hi);
+        ++show_progress;
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( iterate_4d, RangeIterationTest )
+{
+    Array<int, 4> lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<4>(lo, hi);
+        check_threaded_iteration<4, StaticSchedule>(lo, hi);
+        check_threaded_iteration<4, DynamicSchedule<> >(lo, hi);
+        check_threaded_iteration<4, WorkStealingSchedule<> >(lo, hi);
+        check_deterministic_iteration<4>(lo, hi);
+        ++show_progress;
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( thin_outer_dimension, RangeIterationTest )
+{
+    // fewer indices in the outer dimension than threads, the rows are split instead
+    check_threaded_iteration<3, StaticSchedule>(Array<int, 3>(4, -2, 0), Array<int, 3>(4, 20, 9));
+    check_threaded_iteration<3, StaticSchedule>(Array<int, 3>(0, 0, 0), Array<int, 3>(1, 0, 30));
+
+    // empty ranges do not call the function
+    int calls = 0;
+    Range<int, 2> empty(Array<int, 2>(0, 5), Array<int, 2>(10, 4));
+    RangeThreadedIterationPolicy<2>::forEach(empty, [&](const Array<int, 2>&){ ++calls; });
+    RangeThreadedIterationPolicy<2, DynamicSchedule<> >::forEach(empty, [&](const Array<int, 2>&){ ++calls; });
+    BOOST_CHECK_EQUAL(calls, 0);
+}
+
+BOOST_FIXTURE_TEST_CASE( static_slabs, RangeIterationTest )
+{
+    // with enough indices in the outer dimension, each thread gets the slabs of partitionRange
+    ThreadPool &pool = ThreadPool::instance();
+    const size_t numThreads = pool.getNumThreads();
+    pool.setNumThreads(4);
+
+    Array<int, 3> lo(-5, 0, 0), hi(12, 6, 3);
+    Range<int, 3> range(lo, hi);
+    Grid<int, 3> owner(lo, hi);
+    std::vector<std::thread::id> ids(4);
+    pool.run([&](size_t i){ ids[i] = std::this_thread::get_id(); });
+
+    RangeThreadedIterationPolicy<3>::forEach(range, [&](const Array<int, 3>& pos){
+        const std::thread::id id = std::this_thread::get_id();
+        for (size_t i=0; i<ids.size(); ++i) if (ids[i] == id) owner[pos] = int(i);
+    });
+
+    bool ok = true;
+    for (size_t part=0; part<4; ++part)
+    {
+        int partLo, partHi;
+        partitionRange(lo[0], hi[0], part, 4, partLo, partHi);
+        for (int i=partLo; i<=partHi; ++i)
+        {
+            ok = ok && (owner(i, 0, 0) == int(part)) && (owner(i, 6, 3) == int(part));
+        }
+    }
+    BOOST_CHECK(ok);
+    pool.setNumThreads(numThreads);
+}
+
+BOOST_FIXTURE_TEST_CASE( work_stealing, RangeIterationTest )
+{
+    ThreadPool &pool = ThreadPool::instance();
+    const size_t numThreads = pool.getNumThreads();
+
+    for (size_t threads : {1ul, 3ul, 8ul})
+    {
+        pool.setNumThreads(threads);
+        for (size_t grain : {1ul, 5ul, 1000ul})
+        {
+            std::vector<int> visits(1000, 0);
+            std::atomic<size_t> largest(0);
+            pool.runWorkStealing(17, 1000, grain, [&](size_t begin, size_t end) {
+                for (size_t i=begin; i<end; ++i) ++visits[i];
+                size_t length = end - begin;
+                size_t current = largest.load();
+                while ((length > current) && !largest.compare_exchange_weak(current, length)) {}
+            });
+            BOOST_CHECK(std::all_of(visits.begin(), visits.begin() + 17, [](int v){ return v == 0; }));
+            BOOST_CHECK(std::all_of(visits.begin() + 17, visits.end(), [](int v){ return v == 1; }));
+            BOOST_CHECK_LE(largest.load(), grain);
+        }
+
+        // uneven work is taken over by the idle threads
+        std::vector<int> visits(200, 0);
+        pool.runWorkStealing(0, 200, 1, [&](size_t begin, size_t end) {
+            for (size_t i=begin; i<end; ++i)
+            {
+                if (i < 20) std::this_thread::sleep_for(std::chrono::microseconds(200));
+                ++visits[i];
+            }
+        });
+        BOOST_CHECK(std::all_of(visits.begin(), visits.end(), [](int v){ return v == 1; }));
+
+        // exceptions abandon the remaining work
+        BOOST_CHECK_THROW(
+            pool.runWorkStealing(0, 100, 1, [](size_t begin, size_t) {
+                if (begin == 42) throw std::runtime_error("task failed");
+            }),
+            std::runtime_error
+        );
+    }
+
+    // nested inside a task the work runs on the calling thread
+    pool.setNumThreads(4);
+    std::mutex mutex;
+    std::vector<int> visits(4*50, 0);
+    pool.run([&](size_t t) {
+        pool.runWorkStealing(t*50, (t+1)*50, 4, [&](size_t begin, size_t end) {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t i=begin; i<end; ++i) ++visits[i];
+        });
+    });
+    BOOST_CHECK(std::all_of(visits.begin(), visits.end(), [](int v){ return v == 1; }));
+
+    pool.setNumThreads(numThreads);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,284 @@
+/*
+ * test_range_tiled_iteration.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ */
+
+#include "../utility.hpp"
+#include "range_test_fixture.hpp"
+
+#include <grid/iteration/tiled-iteration.hpp>
+#include <grid/iteration/threaded-iteration.hpp>
+#include <grid/grid.hpp>
+#include <grid/range.hpp>
+
+#include <boost/timer/progress_display.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace schnek;
+
+/**
+ * Check that the iteration visits every index exactly once, tile by tile in
+ * C-order of the tiles and in C-order inside each tile.
+ */
+template<size_t rank, class TileShape>
+void check_tiled_iteration(const Array<int, rank> &lo, const Array<int, rank> &hi, const Array<int, rank> &extents)
+{
+    typedef Grid<int, rank, GridBoostTestCheck, schnek::SingleArrayGridStorage> GridType;
+    typedef Array<int, 2*rank> KeyType;
+
+    Range<int, rank, ArrayBoostTestArgCheck> range(lo, hi);
+    GridType visits(lo, hi);
+    visits = 0;
+
+    std::vector<KeyType> keys;
+    RangeTiledIterationPolicy<rank, TileShape>::forEach(range, extents, [&](const typename GridType::IndexType& pos){
+        ++visits[pos];
+        KeyType key;
+        for (size_t d=0; d<rank; ++d)
+        {
+            key[d] = (pos[d] - lo[d]) / extents[d];
+            key[rank + d] = (pos[d] - lo[d]) % extents[d];
+        }
+        keys.push_back(key);
+    });
+
+    bool allOnce = true;
+    for (auto it = visits.begin(); it != visits.end(); ++it)
+    {
+        allOnce = allOnce && (*it == 1);
+    }
+    BOOST_CHECK(allOnce);
+    BOOST_CHECK_EQUAL(keys.size(), size_t(visits.getSize()));
+
+    bool ordered = true;
+    for (size_t n=1; n<keys.size(); ++n)
+    {
+        size_t d = 0;
+        while ((d < 2*rank) && (keys[n-1][d] == keys[n][d])) ++d;
+        ordered = ordered && (d < 2*rank) && (keys[n-1][d] < keys[n][d]);
+    }
+    BOOST_CHECK(ordered);
+}
+
+template<size_t rank, class TileShape>
+void check_tiled_iteration(const Array<int, rank> &lo, const Array<int, rank> &hi)
+{
+    Array<int, rank> extents;
+    for (size_t d=0; d<rank; ++d) extents[d] = int(TileShape::extent(d));
+    check_tiled_iteration<rank, TileShape>(lo, hi, extents);
+}
+
+/**
+ * Check that the threaded tiled iteration visits every index exactly once and that
+ * all indices of a tile are visited by the same thread.
+ */
+template<size_t rank, class TileShape, class Schedule>
+void check_tiled_threaded_iteration(const Array<int, rank> &lo, const Array<int, rank> &hi)
+{
+    typedef Grid<int, rank, GridBoostTestCheck, schnek::SingleArrayGridStorage> GridType;
+    typedef Grid<std::thread::id, rank, GridBoostTestCheck, schnek::SingleArrayGridStorage> ThreadGridType;
+
+    ThreadPool &pool = ThreadPool::instance();
+    const size_t numThreads = pool.getNumThreads();
+    pool.setNumThreads(4);
+
+    Range<int, rank, ArrayBoostTestArgCheck> range(lo, hi);
+    GridType visits(lo, hi);
+    ThreadGridType owner(lo, hi);
+    visits = 0;
+
+    RangeTiledThreadedIterationPolicy<rank, TileShape, Schedule>::forEach(range, [&](const typename GridType::IndexType& pos){
+        ++visits[pos];
+        owner[pos] = std::this_thread::get_id();
+    });
+
+    bool allOnce = true;
+    for (auto it = visits.begin(); it != visits.end(); ++it)
+    {
+        allOnce = allOnce && (*it == 1);
+    }
+    BOOST_CHECK(allOnce);
+
+    bool sameThread = true;
+    RangeCIterationPolicy<rank>::forEach(range, [&](const typename GridType::IndexType& pos){
+        typename GridType::IndexType corner;
+        for (size_t d=0; d<rank; ++d)
+        {
+            corner[d] = lo[d] + ((pos[d] - lo[d]) / int(TileShape::extent(d))) * int(TileShape::extent(d));
+        }
+        sameThread = sameThread && (owner[pos] == owner[corner]);
+    });
+    BOOST_CHECK(sameThread);
+
+    pool.setNumThreads(numThreads);
+}
+
+BOOST_AUTO_TEST_SUITE( range_iteration )
+
+BOOST_AUTO_TEST_SUITE( tiled )
+
+BOOST_FIXTURE_TEST_CASE( iterate_1d, RangeIterationTest )
+{
+    Array<int, 1> lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<1>(lo, hi);
+        check_tiled_iteration<1, GridTile<> >(lo, hi);
+        ++show_progress;
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( iterate_2d, RangeIterationTest )
+{
+    Array<int, 2> lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<2>(lo, hi);
+        check_tiled_iteration<2, GridTile<4, 16> >(lo, hi);
+        ++show_progress;
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( iterate_3d, RangeIterationTest )
+{
+    Array<int, 3> lo, hi;
+    boost::timer::progress_display show_progress(20);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<3>(lo, hi);
+        check_tiled_iteration<3, GridTile<> >(lo, hi);
+        ++show_progress;
+        check_tiled_iteration<3, GridTile<3, 1, 5> >(lo, hi);
+        ++show_progress;
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( iterate_4d, RangeIterationTest )
+{
+    Array<int, 4> lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<4>(lo, hi);
+        check_tiled_iteration<4, GridTile<2, 4, 2, 4> >(lo, hi);
+        ++show_progress;
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( runtime_extents, RangeIterationTest )
+{
+    Array<int, 3> lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<3>(lo, hi);
+        check_tiled_iteration<3, GridTile<> >(lo, hi, Array<int, 3>(2, 5, 32));
+        ++show_progress;
+    }
+
+    // extents that are not positive are taken from the tile shape
+    Array<int, 2> lo2(-3, 4), hi2(20, 40);
+    std::vector<Array<int, 2> > expected, visited;
+    RangeTiledIterationPolicy<2, GridTile<4, 8> >::forEach(Range<int, 2>(lo2, hi2), [&](const Array<int, 2>& pos){
+        expected.push_back(pos);
+    });
+    RangeTiledIterationPolicy<2, GridTile<4, 3> >::forEach(Range<int, 2>(lo2, hi2), Array<int, 2>(0, 8), [&](const Array<int, 2>& pos){
+        visited.push_back(pos);
+    });
+    BOOST_REQUIRE_EQUAL(visited.size(), expected.size());
+    bool same = true;
+    for (size_t i=0; i<visited.size(); ++i)
+    {
+        same = same && (visited[i][0] == expected[i][0]) && (visited[i][1] == expected[i][1]);
+    }
+    BOOST_CHECK(same);
+}
+
+BOOST_FIXTURE_TEST_CASE( threaded_tiles, RangeIterationTest )
+{
+    Array<int, 3> lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<3>(lo, hi);
+        check_tiled_threaded_iteration<3, GridTile<4, 4, 8>, StaticSchedule>(lo, hi);
+        check_tiled_threaded_iteration<3, GridTile<>, DynamicSchedule<> >(lo, hi);
+        check_tiled_threaded_iteration<3, GridTile<2, 8, 4>, WorkStealingSchedule<> >(lo, hi);
+        ++show_progress;
+    }
+
+    Array<int, 2> lo2, hi2;
+    random_extent<2>(lo2, hi2);
+    check_tiled_threaded_iteration<2, GridTile<16, 16>, StaticSchedule>(lo2, hi2);
+}
+
+BOOST_FIXTURE_TEST_CASE( lines, RangeIterationTest )
+{
+    typedef Grid<int, 3, GridBoostTestCheck, schnek::SingleArrayGridStorage> GridType;
+    typedef GridTile<4, 2, 8> TileShape;
+
+    GridType::IndexType lo, hi;
+    boost::timer::progress_display show_progress(10);
+    for (int n=0; n<10; ++n)
+    {
+        random_extent<3>(lo, hi);
+        Range<int, 3, ArrayBoostTestArgCheck> range(lo, hi);
+        GridType expected(lo, hi);
+        GridType grid(lo, hi);
+        grid = -1;
+
+        int count = 0;
+        RangeTiledIterationPolicy<3, TileShape>::forEach(range, [&](const GridType::IndexType& pos){
+            expected[pos] = count++;
+        });
+
+        // lines stay inside a tile and are visited in the same order as the indices
+        count = 0;
+        bool inTile = true;
+        RangeTiledIterationPolicy<3, TileShape>::forEachLine(range, [&](const GridType::IndexType& pos, int length){
+            const int tileLo = lo[2] + ((pos[2] - lo[2]) / 8) * 8;
+            inTile = inTile && (pos[2] == tileLo) && (length == std::min(8, hi[2] - tileLo + 1));
+            int *line = &grid[pos];
+            for (int i=0; i<length; ++i) line[i] = count++;
+        });
+        BOOST_CHECK(inTile);
+
+        bool same = true;
+        for (auto it = grid.begin(), jt = expected.begin(); it != grid.end(); ++it, ++jt)
+        {
+            same = same && (*it == *jt);
+        }
+        BOOST_CHECK(same);
+
+        // runtime tile extents
+        count = 0;
+        RangeTiledIterationPolicy<3, TileShape>::forEach(range, Array<int, 3>(3, 3, 5), [&](const GridType::IndexType& pos){
+            expected[pos] = count++;
+        });
+        count = 0;
+        RangeTiledIterationPolicy<3, TileShape>::forEachLine(range, Array<int, 3>(3, 3, 5), [&](const GridType::IndexType& pos, int length){
+            int *line = &grid[pos];
+            for (int i=0; i<length; ++i) line[i] = count++;
+        });
+        same = true;
+        for (auto it = grid.begin(), jt = expected.begin(); it != grid.end(); ++it, ++jt)
+        {
+            same = same && (*it == *jt);
+        }
+        BOOST_CHECK(same);
+        ++show_progress;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
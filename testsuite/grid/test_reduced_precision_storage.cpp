@@ -0,0 +1,192 @@
+/*
+ * test_reduced_precision_storage.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/grid.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+struct ReducedPrecisionTest : public GridTest
+{
+    /**
+     * Write random values to all grid points and check that they are read back
+     * rounded to the stored type and that the stored values are laid out in C order.
+     */
+    template<size_t rank, class GridType>
+    bool test_rounding(GridType &grid)
+    {
+      typedef typename GridType::IndexType IndexType;
+      typedef typename std::remove_pointer<decltype(grid.getRawData())>::type StoredType;
+      schnek::Range<int, rank> range(grid.getLo(), grid.getHi());
+
+      bool ok = true;
+      for (const IndexType &pos : range)
+      {
+        double val = dist(rGen);
+        grid[pos] = val;
+
+        ptrdiff_t offset = 0;
+        for (size_t d=0; d<rank; ++d) offset += (pos[d] - grid.getLo(d))*grid.stride(d);
+
+        const double rounded = double(StoredType(val));
+        const GridType &cgrid = grid;
+        ok = ok && (double(grid[pos]) == rounded) && (cgrid[pos] == rounded);
+        ok = ok && (double(grid.getRawData()[offset]) == rounded);
+      }
+      return ok;
+    }
+};
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( reduced_precision_storage )
+
+BOOST_FIXTURE_TEST_CASE( access, ReducedPrecisionTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::ReducedPrecision<float>::Storage> FloatGrid;
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::ReducedPrecision<schnek::BFloat16>::Storage> BFloatGrid;
+
+  FloatGrid::IndexType lo2, hi2;
+  random_extent<2>(lo2, hi2);
+  FloatGrid f(lo2, hi2);
+  BOOST_CHECK(test_rounding<2>(f));
+  random_extent<2>(lo2, hi2);
+  f.resize(lo2, hi2);
+  BOOST_CHECK(test_rounding<2>(f));
+
+  BFloatGrid::IndexType lo3, hi3;
+  random_extent<3>(lo3, hi3);
+  BFloatGrid b(lo3, hi3);
+  BOOST_CHECK(test_rounding<3>(b));
+
+  // the values are stored in the reduced type
+  BOOST_CHECK_EQUAL(sizeof(*f.getRawData()), sizeof(float));
+  BOOST_CHECK_EQUAL(sizeof(*b.getRawData()), 2u);
+  BOOST_CHECK_EQUAL(f.end() - f.begin(), ptrdiff_t(f.getSize()));
+}
+
+BOOST_AUTO_TEST_CASE( bfloat16 )
+{
+  typedef schnek::BFloat16 BFloat16;
+
+  BOOST_CHECK_EQUAL(float(BFloat16(1.0f)), 1.0f);
+  BOOST_CHECK_EQUAL(float(BFloat16(-3.5f)), -3.5f);
+  BOOST_CHECK_EQUAL(BFloat16(1.0f).getBits(), 0x3f80);
+
+  // round to nearest, ties to even
+  BOOST_CHECK_EQUAL(float(BFloat16(1.0f + 0.00390625f)), 1.0f);
+  BOOST_CHECK_EQUAL(float(BFloat16(1.0f + 3*0.00390625f)), 1.015625f);
+  BOOST_CHECK_EQUAL(float(BFloat16(1.0f + 0.005f)), 1.0078125f);
+
+  BOOST_CHECK(std::isnan(float(BFloat16(std::numeric_limits<float>::quiet_NaN()))));
+  BOOST_CHECK(std::isinf(float(BFloat16(std::numeric_limits<float>::infinity()))));
+  BOOST_CHECK(std::isinf(float(BFloat16(std::numeric_limits<float>::max()))));
+  BOOST_CHECK_EQUAL(float(BFloat16::fromBits(0x4049)), 3.140625f);
+
+  // doubles are rounded once, just above a tie the value is rounded up
+  const double aboveTie = 1.0 + 0.00390625 + std::ldexp(1.0, -30);
+  BOOST_CHECK_EQUAL(float(BFloat16(float(aboveTie))), 1.0f);
+  BOOST_CHECK_EQUAL(float(BFloat16(aboveTie)), 1.0078125f);
+  BOOST_CHECK_EQUAL(float(BFloat16(-aboveTie)), -1.0078125f);
+  BOOST_CHECK_EQUAL(float(BFloat16(1.0 + 0.00390625)), 1.0f);
+  BOOST_CHECK_EQUAL(float(BFloat16(1e-60)), 0.0f);
+  BOOST_CHECK(std::isinf(float(BFloat16(1e300))));
+  BOOST_CHECK_EQUAL(float(BFloat16(3.3e38)), float(BFloat16::fromBits(0x7f78)));
+  BOOST_CHECK(std::isnan(float(BFloat16(std::numeric_limits<double>::quiet_NaN()))));
+}
+
+BOOST_FIXTURE_TEST_CASE( proxy_operators, ReducedPrecisionTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::ReducedPrecision<float>::Storage> GridType;
+  GridType::IndexType lo(-2, 3), hi(5, 7);
+  GridType g(lo, hi);
+  GridType h(lo, hi);
+
+  g = 1.0;
+  h = 0.5;
+  const GridType &cg = g;
+  BOOST_CHECK_EQUAL(cg(0, 4), 1.0);
+
+  g(0, 4) += 1.0;
+  g(0, 4) *= 3.0;
+  BOOST_CHECK_EQUAL(double(g(0, 4)), 6.0);
+  g(0, 4) -= h(0, 4);
+  g(0, 4) /= 2.0;
+  BOOST_CHECK_EQUAL(double(g(0, 4)), 2.75);
+
+  g(1, 5) = h(0, 4);
+  BOOST_CHECK_EQUAL(double(g(1, 5)), 0.5);
+
+  // values are rounded on every store
+  g(2, 6) = 0.1;
+  BOOST_CHECK_EQUAL(double(g(2, 6)), double(0.1f));
+  BOOST_CHECK(double(g(2, 6)) != 0.1);
+
+  g += h;
+  BOOST_CHECK_EQUAL(double(g(-2, 3)), 1.5);
+  BOOST_CHECK_EQUAL(double(g(1, 5)), 1.0);
+}
+
+BOOST_FIXTURE_TEST_CASE( bfloat16_store, ReducedPrecisionTest )
+{
+  typedef schnek::Grid<double, 1, GridBoostTestCheck, schnek::ReducedPrecision<schnek::BFloat16>::Storage> GridType;
+  GridType g(GridType::IndexType(0), GridType::IndexType(3));
+
+  // rounding through float would turn this value into a tie and round it down to 1
+  const double aboveTie = 1.0 + 0.00390625 + std::ldexp(1.0, -30);
+  g(0) = aboveTie;
+  BOOST_CHECK_EQUAL(double(g(0)), 1.0078125);
+
+  g.store(GridType::IndexType(1), &aboveTie, 1);
+  BOOST_CHECK_EQUAL(double(g(1)), 1.0078125);
+}
+
+BOOST_FIXTURE_TEST_CASE( load_store, ReducedPrecisionTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::ReducedPrecision<float>::Storage> GridType;
+  GridType::IndexType lo(0, -1, 4), hi(3, 2, 20);
+  GridType g(lo, hi);
+  const size_t n = hi[2] - lo[2] + 1;
+
+  std::vector<double> row(n);
+  for (size_t i=0; i<n; ++i) row[i] = 0.25*i;
+  g.store(GridType::IndexType(2, 1, lo[2]), row.data(), n);
+  BOOST_CHECK_EQUAL(double(g(2, 1, lo[2] + 5)), 1.25);
+
+  std::vector<double> loaded(n, -1.0);
+  g.load(GridType::IndexType(2, 1, lo[2]), loaded.data(), n);
+  BOOST_CHECK(loaded == row);
+
+  std::vector<float> narrow(n);
+  schnek::convertPrecision(row.data(), narrow.data(), n);
+  BOOST_CHECK_EQUAL(narrow[n-1], float(row[n-1]));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,202 @@
+/*
+ * test_resize_preserve.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/grid.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+struct ResizePreserveTest : public GridTest
+{
+    typedef schnek::Array<int, 3> IndexType;
+    typedef schnek::Range<int, 3> RangeType;
+
+    static double value(const IndexType &pos)
+    {
+      return 10000.0*pos[0] + 100.0*pos[1] + pos[2] + 0.25;
+    }
+
+    template<class GridType>
+    void fill(GridType &grid)
+    {
+      for (int i=grid.getLo(0); i<=grid.getHi(0); ++i)
+        for (int j=grid.getLo(1); j<=grid.getHi(1); ++j)
+          for (int k=grid.getLo(2); k<=grid.getHi(2); ++k)
+          {
+            grid(i,j,k) = value(IndexType(i,j,k));
+          }
+    }
+
+    /// Check the values of all grid points that lie inside `valid`
+    template<class GridType>
+    bool check(const GridType &grid, RangeType valid)
+    {
+      bool ok = true;
+      for (int i=grid.getLo(0); i<=grid.getHi(0); ++i)
+        for (int j=grid.getLo(1); j<=grid.getHi(1); ++j)
+          for (int k=grid.getLo(2); k<=grid.getHi(2); ++k)
+          {
+            IndexType pos(i,j,k);
+            if (valid.inside(pos)) ok = ok && (grid(i,j,k) == value(pos));
+          }
+      return ok;
+    }
+
+    /**
+     * Grow, shrink and move a grid and check that the values in the overlap of the
+     * old and the new range are kept, also in a copy of the grid.
+     */
+    template<class GridType>
+    void test_preserve()
+    {
+      std::vector<RangeType> ranges = {
+        RangeType(IndexType(-2, 1, 0), IndexType(7, 6, 11)),
+        RangeType(IndexType(1, 2, 3), IndexType(4, 5, 6)),
+        RangeType(IndexType(3, -1, 2), IndexType(9, 8, 5)),
+        RangeType(IndexType(3, -1, -4), IndexType(9, 8, 5)),
+        RangeType(IndexType(20, 20, 20), IndexType(22, 22, 22))
+      };
+
+      GridType grid(IndexType(0, 0, 0), IndexType(5, 6, 7));
+      GridType copy(grid);
+      fill(grid);
+
+      for (const RangeType &range : ranges)
+      {
+        RangeType old = grid.getRange();
+        grid.resizePreserve(range);
+
+        BOOST_CHECK(grid.getLo() == range.getLo());
+        BOOST_CHECK(grid.getHi() == range.getHi());
+        BOOST_CHECK(copy.getHi() == range.getHi());
+        BOOST_CHECK(copy.getRawData() == grid.getRawData());
+        BOOST_CHECK(check(grid, old));
+
+        fill(grid);
+      }
+    }
+};
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( resize_preserve )
+
+BOOST_FIXTURE_TEST_CASE( c_storage, ResizePreserveTest )
+{
+  test_preserve<schnek::Grid<double, 3, GridBoostTestCheck, schnek::SingleArrayGridStorage> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( fortran_storage, ResizePreserveTest )
+{
+  test_preserve<schnek::Grid<double, 3, GridBoostTestCheck, schnek::SingleArrayGridStorageFortran> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( lazy_storage, ResizePreserveTest )
+{
+  test_preserve<schnek::Grid<double, 3, GridBoostTestCheck, schnek::LazyArrayGridStorage> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( aligned_storage, ResizePreserveTest )
+{
+  test_preserve<schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorage> >();
+  test_preserve<schnek::Grid<double, 3, GridBoostTestCheck, schnek::AlignedArrayGridStorageFortran> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( huge_page_storage, ResizePreserveTest )
+{
+  test_preserve<schnek::Grid<double, 3, GridBoostTestCheck, schnek::HugePageArrayGridStorage> >();
+
+  // grids larger than a huge page are mapped, the old and the new mapping exist at the same time
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::HugePageArrayGridStorage> GridType;
+  RangeType range(IndexType(0, 0, 0), IndexType(79, 79, 79));
+  GridType grid(range);
+  fill(grid);
+
+  RangeType moved(IndexType(10, -5, 3), IndexType(99, 69, 89));
+  grid.resizePreserve(moved);
+  BOOST_CHECK(grid.getPageType() != schnek::PageType::none);
+  BOOST_CHECK(check(grid, range));
+
+  // shrinking below one huge page switches to operator new
+  fill(grid);
+  RangeType small(IndexType(20, 20, 20), IndexType(27, 27, 27));
+  grid.resizePreserve(small);
+  BOOST_CHECK(grid.getPageType() == schnek::PageType::base);
+  BOOST_CHECK(check(grid, small));
+}
+
+BOOST_FIXTURE_TEST_CASE( first_touch_storage, ResizePreserveTest )
+{
+  test_preserve<schnek::Grid<double, 3, GridBoostTestCheck, schnek::FirstTouchArrayGridStorage> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( lazy_in_place, ResizePreserveTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::LazyArrayGridStorage> GridType;
+  typedef GridType::IndexType Index2;
+
+  GridType grid(Index2(0, 0), Index2(9, 9));
+  for (int i=0; i<=9; ++i)
+    for (int j=0; j<=9; ++j) grid(i,j) = 100*i + j;
+  const double *ptr = grid.getRawData();
+
+  // the rows grow, so the first rows move towards the start and the others towards the end
+  grid.resizePreserve(Index2(0, 3), Index2(7, 14));
+  BOOST_CHECK(grid.getRawData() == ptr);
+  bool ok = true;
+  for (int i=0; i<=7; ++i)
+    for (int j=3; j<=9; ++j) ok = ok && (grid(i,j) == 100*i + j);
+  BOOST_CHECK(ok);
+
+  // shrink again, all rows move towards the start
+  grid.resizePreserve(Index2(2, 5), Index2(6, 8));
+  BOOST_CHECK(grid.getRawData() == ptr);
+  ok = true;
+  for (int i=2; i<=6; ++i)
+    for (int j=5; j<=8; ++j) ok = ok && (grid(i,j) == 100*i + j);
+  BOOST_CHECK(ok);
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_on_write_storage, ResizePreserveTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::CopyOnWriteGridStorage> GridType;
+
+  RangeType range(IndexType(0, 0, 0), IndexType(5, 6, 7));
+  GridType grid(range);
+  fill(grid);
+  GridType copy(grid);
+
+  RangeType grown(IndexType(-1, -1, -1), IndexType(6, 7, 8));
+  grid.resizePreserve(grown);
+  BOOST_CHECK(check(grid, range));
+  BOOST_CHECK(copy.getRange().getHi() == range.getHi());
+  BOOST_CHECK(check(copy, range));
+  BOOST_CHECK(copy.getRawData() != grid.getRawData());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
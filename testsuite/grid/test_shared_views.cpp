@@ -0,0 +1,150 @@
+/*
+ * test_shared_views.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/grid.hpp>
+#include <grid/gridstorage/shared-view-list.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <list>
+#include <vector>
+
+struct SharedViewTest : public GridTest
+{
+    typedef schnek::internal::SharedViewList<int> ListType;
+    typedef ListType::ViewType ViewType;
+
+    /// Adds the size info to the counter that is the owner of the view
+    static void count(void *owner, const int &value)
+    {
+      *static_cast<int*>(owner) += value;
+    }
+
+    /**
+     * Make copies of a grid, destroy some of them in an irregular order and resize
+     * one of the remaining copies. All remaining copies must follow the resize.
+     */
+    template<class GridType>
+    void test_copies()
+    {
+      typename GridType::IndexType lo(0, 0), hi(9, 9), hi2(4, 19);
+      GridType grid(lo, hi);
+      const size_t generation = grid.getGeneration();
+
+      std::list<GridType> copies;
+      for (int n=0; n<50; ++n)
+      {
+        copies.push_back(grid);
+      }
+
+      int n = 0;
+      for (auto it = copies.begin(); it != copies.end(); ++n)
+      {
+        if ((n % 3 == 0) || (n % 7 == 0))
+          it = copies.erase(it);
+        else
+          ++it;
+      }
+
+      std::vector<GridType> moved;
+      moved.reserve(copies.size());
+      for (GridType &copy : copies)
+      {
+        moved.push_back(std::move(copy));
+      }
+      copies.clear();
+
+      moved[moved.size()/2].resize(lo, hi2);
+      moved[3] = 2.5;
+
+      BOOST_CHECK_EQUAL(grid.getGeneration(), generation + 1);
+      BOOST_CHECK(grid.getHi() == hi2);
+      BOOST_CHECK_EQUAL(grid(4, 19), 2.5);
+      for (GridType &copy : moved)
+      {
+        BOOST_CHECK(copy.getHi() == hi2);
+        BOOST_CHECK(copy.getRawData() == grid.getRawData());
+        BOOST_CHECK_EQUAL(copy(0, 0), 2.5);
+      }
+    }
+};
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( shared_views )
+
+BOOST_FIXTURE_TEST_CASE( view_list, SharedViewTest )
+{
+  int a = 0, b = 0, c = 0, d = 0;
+  ViewType viewA(&a, &count), viewB(&b, &count), viewC(&c, &count), viewD(&d, &count);
+
+  ListType list;
+  BOOST_CHECK(list.empty());
+  list.attach(&viewA);
+  list.attach(&viewB);
+  list.attach(&viewC);
+  list.notify(1);
+  BOOST_CHECK_EQUAL(list.getGeneration(), 1u);
+  BOOST_CHECK_EQUAL(a + b + c, 3);
+
+  // remove from the middle, then replace the head
+  list.detach(&viewB);
+  list.replace(&viewC, &viewD);
+  BOOST_CHECK(viewC.prev == NULL && viewC.next == NULL);
+
+  // views that are not attached are ignored
+  list.detach(&viewB);
+  list.detach(&viewC);
+
+  list.notify(10);
+  BOOST_CHECK_EQUAL(a, 11);
+  BOOST_CHECK_EQUAL(b, 1);
+  BOOST_CHECK_EQUAL(c, 1);
+  BOOST_CHECK_EQUAL(d, 10);
+
+  list.detach(&viewA);
+  list.detach(&viewD);
+  BOOST_CHECK(list.empty());
+  BOOST_CHECK_EQUAL(list.getGeneration(), 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE( c_storage, SharedViewTest )
+{
+  test_copies<schnek::Grid<double, 2, GridBoostTestCheck, schnek::SingleArrayGridStorage> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( lazy_storage, SharedViewTest )
+{
+  test_copies<schnek::Grid<double, 2, GridBoostTestCheck, schnek::LazyArrayGridStorage> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( morton_storage, SharedViewTest )
+{
+  test_copies<schnek::Grid<double, 2, GridBoostTestCheck, schnek::MortonGridStorage> >();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
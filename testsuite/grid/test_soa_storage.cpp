@@ -0,0 +1,245 @@
+/*
+ * test_soa_storage.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ * 
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/grid.hpp>
+
+#include <boost/timer/progress_display.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+
+typedef schnek::Array<double, 3> Vector;
+
+struct SoAGridTest : public GridTest
+{
+    Vector random_vector()
+    {
+      return Vector(dist(rGen), dist(rGen), dist(rGen));
+    }
+
+    /**
+     * Write random vectors to all grid points, read them back through the grid and
+     * through the component planes.
+     */
+    template<size_t rank, class GridType>
+    void test_vector_access(GridType &grid)
+    {
+      typedef typename GridType::IndexType IndexType;
+      schnek::Range<int, rank> range(grid.getLo(), grid.getHi());
+
+      Vector sumDirect(0.0, 0.0, 0.0);
+      for (const IndexType &pos : range)
+      {
+        Vector val = random_vector();
+        grid[pos] = val;
+        sumDirect += val;
+      }
+
+      Vector sumGrid(0.0, 0.0, 0.0);
+      for (const IndexType &pos : range)
+      {
+        sumGrid += Vector(grid[pos]);
+      }
+
+      Vector sumPlanes(0.0, 0.0, 0.0);
+      for (size_t c=0; c<3; ++c)
+      {
+        const double *plane = grid.getComponentData(c);
+        for (size_t n=0; n<grid.getSize(); ++n)
+        {
+          sumPlanes[c] += plane[n];
+        }
+      }
+
+      for (size_t c=0; c<3; ++c)
+      {
+        BOOST_CHECK(is_equal(sumDirect[c], sumGrid[c]));
+        BOOST_CHECK(is_equal(sumDirect[c], sumPlanes[c]));
+      }
+    }
+};
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( soa_storage )
+
+BOOST_FIXTURE_TEST_CASE( access_1d, SoAGridTest )
+{
+  typedef schnek::Grid<Vector, 1, GridBoostTestCheck, schnek::SoAGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<1>(lo, hi);
+    GridType g(lo,hi);
+    test_vector_access<1>(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<1>(lo, hi);
+      g.resize(lo,hi);
+      test_vector_access<1>(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_2d, SoAGridTest )
+{
+  typedef schnek::Grid<Vector, 2, GridBoostTestCheck, schnek::SoAGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<2>(lo, hi);
+    GridType g(lo,hi);
+    test_vector_access<2>(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<2>(lo, hi);
+      g.resize(lo,hi);
+      test_vector_access<2>(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( access_3d, SoAGridTest )
+{
+  typedef schnek::Grid<Vector, 3, GridBoostTestCheck, schnek::SoAGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  boost::timer::progress_display show_progress(30);
+  for (int n=0; n<5; ++n)
+  {
+    random_extent<3>(lo, hi);
+    GridType g(lo,hi);
+    test_vector_access<3>(g);
+    ++show_progress;
+    for (int m=0; m<5; ++m)
+    {
+      random_extent<3>(lo, hi);
+      g.resize(lo,hi);
+      test_vector_access<3>(g);
+      ++show_progress;
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( component_planes, SoAGridTest )
+{
+  typedef schnek::Grid<Vector, 3, GridBoostTestCheck, schnek::SoAGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  random_extent(lo, hi);
+  GridType g(lo, hi);
+
+  BOOST_CHECK_EQUAL(g.getSize(), g.getDims().product());
+  BOOST_CHECK_EQUAL(g.end() - g.begin(), g.getSize());
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(g.getComponentData(0)) % SCHNEK_DEFAULT_ALIGNMENT, 0u);
+
+  // every plane is stored in C order without padding
+  for (int n=0; n<100; ++n)
+  {
+    GridType::IndexType pos = random_index(lo, hi);
+    ptrdiff_t offset = 0;
+    for (size_t d=0; d<3; ++d)
+    {
+      offset += (pos[d] - lo[d])*g.stride(d);
+    }
+    Vector val = random_vector();
+    g[pos] = val;
+    for (size_t c=0; c<3; ++c)
+    {
+      BOOST_CHECK_EQUAL(g.getComponentData(c) + offset, &g[pos][c]);
+      BOOST_CHECK_EQUAL(g.getComponentData(c)[offset], val[c]);
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( proxy_operators, SoAGridTest )
+{
+  typedef schnek::Grid<Vector, 2, GridBoostTestCheck, schnek::SoAGridStorage> GridType;
+  GridType::IndexType lo(-2, 3), hi(5, 7);
+  GridType g(lo, hi);
+  GridType h(lo, hi);
+
+  g = Vector(1.0, 2.0, 3.0);
+  h = Vector(0.5, 0.5, 0.5);
+  const GridType &cg = g;
+  BOOST_CHECK(Vector(cg(0, 4)) == Vector(1.0, 2.0, 3.0));
+
+  g(0, 4) += Vector(1.0, 1.0, 1.0);
+  BOOST_CHECK(Vector(g(0, 4)) == Vector(2.0, 3.0, 4.0));
+
+  g(0, 4) *= 2.0;
+  BOOST_CHECK(Vector(g(0, 4)) == Vector(4.0, 6.0, 8.0));
+
+  g(0, 4) -= h(0, 4);
+  BOOST_CHECK(Vector(g(0, 4)) == Vector(3.5, 5.5, 7.5));
+
+  g(0, 4)[1] = -1.0;
+  BOOST_CHECK_EQUAL(cg(0, 4)[1], -1.0);
+
+  // assigning one proxy to another copies the value
+  g(1, 5) = g(0, 4);
+  g(0, 4) = Vector(0.0, 0.0, 0.0);
+  BOOST_CHECK(Vector(g(1, 5)) == Vector(3.5, -1.0, 7.5));
+
+  g -= h;
+  BOOST_CHECK(Vector(g(1, 5)) == Vector(3.0, -1.5, 7.0));
+  BOOST_CHECK(Vector(g(-2, 3)) == Vector(0.5, 1.5, 2.5));
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_and_resize, SoAGridTest )
+{
+  typedef schnek::Grid<Vector, 3, GridBoostTestCheck, schnek::SoAGridStorage> GridType;
+  GridType::IndexType lo, hi;
+  random_extent(lo, hi);
+  GridType g(lo, hi);
+  g = Vector(1.0, 2.0, 3.0);
+
+  // copies share the data
+  GridType c(g);
+  GridType a;
+  a = g;
+  GridType::IndexType pos = random_index(lo, hi);
+  g[pos] = Vector(4.0, 5.0, 6.0);
+  BOOST_CHECK(Vector(c[pos]) == Vector(4.0, 5.0, 6.0));
+  BOOST_CHECK(Vector(a[pos]) == Vector(4.0, 5.0, 6.0));
+
+  // resizing one copy resizes all of them
+  random_extent(lo, hi);
+  g.resize(lo, hi);
+  BOOST_CHECK(c.getLo() == lo);
+  BOOST_CHECK(a.getHi() == hi);
+  BOOST_CHECK_EQUAL(c.getComponentData(2), g.getComponentData(2));
+  c = Vector(7.0, 8.0, 9.0);
+  pos = random_index(lo, hi);
+  BOOST_CHECK(Vector(a[pos]) == Vector(7.0, 8.0, 9.0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
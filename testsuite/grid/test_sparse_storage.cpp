@@ -0,0 +1,258 @@
+/*
+ * test_sparse_storage.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/grid.hpp>
+#include <grid/field.hpp>
+#include <grid/boundary.hpp>
+#include <grid/iteration/threaded-iteration.hpp>
+#include <util/threadpool.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <utility>
+#include <vector>
+
+struct SparseStorageTest : public GridTest
+{
+    typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::SparseGridStorage> GridType;
+    typedef GridType::IndexType IndexType;
+    typedef schnek::Range<int, 3> RangeType;
+
+    static double value(const IndexType &pos)
+    {
+      return 10000.0*pos[0] + 100.0*pos[1] + pos[2] + 0.5;
+    }
+
+    /// Check that the grid points inside `valid` hold their values and all others the background
+    bool check(const GridType &grid, RangeType valid, double background)
+    {
+      bool ok = true;
+      for (int i=grid.getLo(0); i<=grid.getHi(0); ++i)
+        for (int j=grid.getLo(1); j<=grid.getHi(1); ++j)
+          for (int k=grid.getLo(2); k<=grid.getHi(2); ++k)
+          {
+            IndexType pos(i,j,k);
+            double expected = valid.inside(pos) ? value(pos) : background;
+            ok = ok && (grid(i,j,k) == expected);
+          }
+      return ok;
+    }
+};
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( sparse_storage )
+
+BOOST_FIXTURE_TEST_CASE( allocate_on_write, SparseStorageTest )
+{
+  GridType grid(IndexType(-4, 0, 0), IndexType(35, 39, 19));
+  BOOST_CHECK_EQUAL(grid.getSize(), 40*40*20);
+  BOOST_CHECK_EQUAL(grid.getStatistics().numTiles, 5*5*3);
+  BOOST_CHECK_EQUAL(grid.getStatistics().allocatedTiles, 0);
+
+  // reading does not allocate, also through the writing accessor
+  double sum = 0.0;
+  for (int i=-4; i<=35; ++i) sum += grid(i, 5, 5);
+  BOOST_CHECK_EQUAL(sum, 0.0);
+  BOOST_CHECK_EQUAL(grid.getStatistics().allocatedTiles, 0);
+
+  // writing the background value does not allocate
+  grid(3, 3, 3) = 0.0;
+  BOOST_CHECK_EQUAL(grid.getStatistics().allocatedTiles, 0);
+
+  RangeType active(IndexType(8, 12, 2), IndexType(11, 17, 9));
+  for (int i=8; i<=11; ++i)
+    for (int j=12; j<=17; ++j)
+      for (int k=2; k<=9; ++k) grid(i,j,k) = value(IndexType(i,j,k));
+
+  // the active region touches two tiles in dimensions 1 and 2
+  GridType::Statistics stats = grid.getStatistics();
+  BOOST_CHECK_EQUAL(stats.allocatedTiles, 4);
+  BOOST_CHECK_EQUAL(stats.bytesAllocated, 4*GridType::tileVolume*sizeof(double));
+  BOOST_CHECK(check(grid, active, 0.0));
+
+  // the background is only seen in tiles that have not been allocated
+  grid.setBackground(-1.0);
+  BOOST_CHECK_EQUAL(double(grid(30, 30, 15)), -1.0);
+  BOOST_CHECK_EQUAL(double(grid(10, 12, 0)), 0.0);
+}
+
+BOOST_FIXTURE_TEST_CASE( copies_and_compact, SparseStorageTest )
+{
+  GridType grid(IndexType(0, 0, 0), IndexType(23, 23, 23));
+  GridType copy(grid);
+
+  grid(1, 1, 1) = 2.0;
+  grid(20, 9, 3) = 3.0;
+  BOOST_CHECK_EQUAL(double(copy(1, 1, 1)), 2.0);
+  BOOST_CHECK_EQUAL(copy.getStatistics().allocatedTiles, 2);
+
+  // operations on whole grids visit all grid points
+  GridType other(IndexType(0, 0, 0), IndexType(23, 23, 23));
+  other(20, 9, 3) = 1.0;
+  other(12, 12, 12) = 5.0;
+  grid += other;
+  BOOST_CHECK_EQUAL(double(grid(20, 9, 3)), 4.0);
+  BOOST_CHECK_EQUAL(double(grid(12, 12, 12)), 5.0);
+  BOOST_CHECK_EQUAL(grid.getStatistics().allocatedTiles, 3);
+
+  grid = 0.0;
+  BOOST_CHECK_EQUAL(double(grid(12, 12, 12)), 0.0);
+  BOOST_CHECK_EQUAL(grid.getStatistics().allocatedTiles, 3);
+  grid(1, 1, 1) = 7.0;
+  grid.compact();
+  BOOST_CHECK_EQUAL(copy.getStatistics().allocatedTiles, 1);
+  BOOST_CHECK_EQUAL(double(copy(1, 1, 1)), 7.0);
+
+  grid.resize(IndexType(0, 0, 0), IndexType(7, 7, 7));
+  BOOST_CHECK(copy.getHi() == IndexType(7, 7, 7));
+  BOOST_CHECK_EQUAL(copy.getStatistics().allocatedTiles, 0);
+  BOOST_CHECK_EQUAL(double(copy(1, 1, 1)), 0.0);
+}
+
+BOOST_FIXTURE_TEST_CASE( iteration, SparseStorageTest )
+{
+  typedef GridType::IterationPolicy IterationPolicy;
+
+  GridType grid(IndexType(0, 0, 0), IndexType(19, 19, 19));
+  grid(1, 2, 3) = 1.0;
+  grid(18, 19, 17) = 2.0;
+
+  // only the two allocated tiles are visited, the second one is clipped at the grid boundary
+  RangeType range = grid.getRange();
+  size_t count = 0;
+  double sum = 0.0;
+  bool inside = true;
+  IterationPolicy::forEach(grid, [&](const IndexType &pos) {
+    ++count;
+    sum += grid(pos[0], pos[1], pos[2]);
+    inside = inside && range.inside(pos);
+  });
+  BOOST_CHECK_EQUAL(count, 8*8*8 + 4*4*4);
+  BOOST_CHECK_EQUAL(sum, 3.0);
+  BOOST_CHECK(inside);
+
+  // a plain range is visited completely
+  count = 0;
+  IterationPolicy::forEach(RangeType(grid.getLo(), grid.getHi()), [&](const IndexType &) { ++count; });
+  BOOST_CHECK_EQUAL(count, 20*20*20);
+
+  // the dense copy is in C order
+  std::vector<double> dense(grid.getSize());
+  grid.copyTo(dense.data());
+  BOOST_CHECK_EQUAL(dense[(1*20 + 2)*20 + 3], 1.0);
+  BOOST_CHECK_EQUAL(dense[(18*20 + 19)*20 + 17], 2.0);
+  double total = 0.0;
+  for (double v : dense) total += v;
+  BOOST_CHECK_EQUAL(total, 3.0);
+}
+
+BOOST_FIXTURE_TEST_CASE( moved_from, SparseStorageTest )
+{
+  typedef GridType::IterationPolicy IterationPolicy;
+
+  GridType grid(IndexType(0, 0, 0), IndexType(15, 15, 15));
+  grid.setBackground(1.5);
+  grid(3, 4, 5) = 2.0;
+  GridType moved(std::move(grid));
+  BOOST_CHECK_EQUAL(grid.getSize(), 0);
+
+  // the moved-from grid is empty and all operations on it are safe
+  BOOST_CHECK_EQUAL(grid.getBackground(), 0.0);
+  BOOST_CHECK(grid.cbegin() == grid.cend());
+  BOOST_CHECK(grid.begin() == grid.end());
+  grid = 3.0;
+  grid.compact();
+  size_t count = 0;
+  IterationPolicy::forEach(grid, [&](const IndexType &) { ++count; });
+  BOOST_CHECK_EQUAL(count, 0);
+  BOOST_CHECK_EQUAL(grid.getStatistics().allocatedTiles, 0);
+
+  // the moved-from grid has its own data and can be used again
+  grid.setBackground(-1.0);
+  grid.resize(IndexType(0, 0, 0), IndexType(7, 7, 7));
+  BOOST_CHECK_EQUAL(double(grid(1, 1, 1)), -1.0);
+  grid(1, 1, 1) = 4.0;
+  BOOST_CHECK(grid.isTileAllocated(IndexType(0, 0, 0)));
+  BOOST_CHECK_EQUAL(moved.getBackground(), 1.5);
+  BOOST_CHECK_EQUAL(double(moved(3, 4, 5)), 2.0);
+  BOOST_CHECK_EQUAL(moved.getStatistics().allocatedTiles, 1);
+
+  // move assignment also leaves the source empty
+  grid = std::move(moved);
+  BOOST_CHECK(moved.cbegin() == moved.cend());
+  moved.setBackground(2.5);
+  BOOST_CHECK_EQUAL(moved.getBackground(), 2.5);
+  BOOST_CHECK_EQUAL(double(grid(3, 4, 5)), 2.0);
+}
+
+BOOST_FIXTURE_TEST_CASE( threaded_write, SparseStorageTest )
+{
+  schnek::ThreadPool &pool = schnek::ThreadPool::instance();
+  const size_t numThreads = pool.getNumThreads();
+  pool.setNumThreads(4);
+
+  // every slice is scheduled separately, so neighbouring threads write to the same tiles
+  typedef schnek::RangeThreadedIterationPolicy<3, schnek::DynamicSchedule<1> > Policy;
+  RangeType active(IndexType(0, 0, 0), IndexType(29, 13, 21));
+  bool ok = true;
+  for (int n=0; n<10; ++n)
+  {
+    GridType grid(IndexType(0, 0, 0), IndexType(39, 39, 39));
+    Policy::forEach(active, [&](const IndexType &pos) { grid[pos] = value(pos); });
+    ok = ok && check(grid, active, 0.0);
+    ok = ok && (grid.getStatistics().allocatedTiles == 4*2*3);
+  }
+  BOOST_CHECK(ok);
+
+  pool.setNumThreads(numThreads);
+}
+
+BOOST_FIXTURE_TEST_CASE( field_and_boundary, SparseStorageTest )
+{
+  typedef schnek::Field<double, 2, GridBoostTestCheck, schnek::SparseGridStorage> FieldType;
+  typedef FieldType::IndexType Index2;
+  const schnek::Range<double, 2> domain(schnek::Array<double, 2>(0.0, 0.0), schnek::Array<double, 2>(1.0, 1.0));
+
+  FieldType field(Index2(30, 30), domain, schnek::Array<bool, 2>(false, false), 2);
+  BOOST_CHECK(field.getLo() == Index2(-2, -2));
+  field(5, 5) = 1.0;
+  BOOST_CHECK_EQUAL(field.getStatistics().allocatedTiles, 1);
+
+  schnek::Boundary<2> boundary(field.getLo(), field.getHi(), 2);
+  auto ghost = boundary.getGhostBoundary(0, schnek::Boundary<2>::Max, field);
+  BOOST_CHECK_EQUAL(double(ghost(30, 5)), 0.0);
+  BOOST_CHECK_EQUAL(field.getStatistics().allocatedTiles, 1);
+
+  for (int i=ghost.getLo(0); i<=ghost.getHi(0); ++i)
+    for (int j=ghost.getLo(1); j<=ghost.getHi(1); ++j) ghost(i,j) = 3.0;
+  BOOST_CHECK_EQUAL(double(field(31, 12)), 3.0);
+  BOOST_CHECK_EQUAL(double(field(29, 12)), 0.0);
+  BOOST_CHECK_EQUAL(field.getStatistics().allocatedTiles, 1 + 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
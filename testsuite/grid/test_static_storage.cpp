@@ -0,0 +1,102 @@
+/*
+ * test_static_storage.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/grid.hpp>
+#include <util/exceptions.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( static_storage )
+
+BOOST_FIXTURE_TEST_CASE( access, GridTest )
+{
+  typedef schnek::Grid<double, 1, GridBoostTestCheck, schnek::StaticExtents<7>::Storage> Grid1d;
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::StaticExtents<4, 9>::Storage> Grid2d;
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::StaticExtents<5, 5, 5>::Storage> Grid3d;
+
+  Grid1d g1;
+  test_access_1d(g1);
+  Grid2d g2(Grid2d::IndexType(-2, 3), Grid2d::IndexType(1, 11));
+  test_access_2d(g2);
+  Grid3d g3(Grid3d::IndexType(-2, -2, -2), Grid3d::IndexType(2, 2, 2));
+  test_access_3d(g3);
+
+  // the data is stored inside the grid object
+  const char *begin = reinterpret_cast<const char*>(&g3);
+  const char *data = reinterpret_cast<const char*>(g3.getRawData());
+  BOOST_CHECK(data >= begin && data + 125*sizeof(double) <= begin + sizeof(Grid3d));
+  BOOST_CHECK_EQUAL(g3.getSize(), 125);
+  BOOST_CHECK(g3.getDims() == Grid3d::IndexType(5, 5, 5));
+}
+
+BOOST_FIXTURE_TEST_CASE( layout, GridTest )
+{
+  typedef schnek::Grid<double, 3, GridBoostTestCheck, schnek::StaticExtents<3, 4, 6>::Storage> StaticGrid;
+  typedef schnek::Grid<double, 3, GridBoostTestCheck> DynamicGrid;
+  StaticGrid::IndexType lo(1, -3, 2), hi(3, 0, 7);
+
+  StaticGrid s(lo, hi);
+  DynamicGrid d(lo, hi);
+  bool same = true;
+  for (int i=lo[0]; i<=hi[0]; ++i)
+    for (int j=lo[1]; j<=hi[1]; ++j)
+      for (int k=lo[2]; k<=hi[2]; ++k)
+      {
+        same = same && (&s(i,j,k) - s.getRawData() == &d(i,j,k) - d.getRawData());
+      }
+  BOOST_CHECK(same);
+  for (size_t dim=0; dim<3; ++dim) BOOST_CHECK_EQUAL(s.stride(dim), d.stride(dim));
+
+  // moving the grid keeps the data
+  s(2, -1, 5) = 3.0;
+  s.resize(StaticGrid::IndexType(0, 0, 0), StaticGrid::IndexType(2, 3, 5));
+  BOOST_CHECK_EQUAL(s(1, 2, 3), 3.0);
+  BOOST_CHECK_THROW(s.resize(lo, StaticGrid::IndexType(3, 0, 8)), schnek::ScheckException);
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_and_assign, GridTest )
+{
+  typedef schnek::Grid<double, 2, GridBoostTestCheck, schnek::StaticExtents<3, 3>::Storage> GridType;
+
+  GridType a;
+  a = 1.0;
+  GridType b(a);
+  b(1, 1) = 5.0;
+  BOOST_CHECK_EQUAL(a(1, 1), 1.0);
+
+  a += b;
+  BOOST_CHECK_EQUAL(a(1, 1), 6.0);
+  BOOST_CHECK_EQUAL(a(0, 2), 2.0);
+
+  b = a;
+  a(0, 0) = 0.0;
+  BOOST_CHECK_EQUAL(b(0, 0), 2.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,141 @@
+/*
+ * test_time_level_field.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: Holger Schmitz
+ *
+ * This file is part of Schnek.
+ *
+ * Schnek is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Schnek is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Schnek.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../utility.hpp"
+#include "grid_test_fixture.hpp"
+
+#include <grid/timelevelfield.hpp>
+#include <grid/subgrid.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+struct TimeLevelFieldTest : public GridTest
+{
+    typedef schnek::Array<int, 2> IndexType;
+    typedef schnek::Range<double, 2> DomainType;
+
+    DomainType domain;
+    schnek::Array<bool, 2> stagger;
+
+    TimeLevelFieldTest()
+      : domain(schnek::Array<double, 2>(0.0, 0.0), schnek::Array<double, 2>(1.0, 1.0)),
+        stagger(false, true)
+    {}
+
+    /// Check that all inner and ghost points of a field have the same value
+    template<class FieldType>
+    bool check(FieldType &field, double value)
+    {
+      bool ok = true;
+      for (int i=field.getLo(0); i<=field.getHi(0); ++i)
+        for (int j=field.getLo(1); j<=field.getHi(1); ++j)
+        {
+          ok = ok && (field(i,j) == value);
+        }
+      return ok;
+    }
+
+    /**
+     * Rotate the levels several times and check that the buffers are passed on
+     * without copying and that the data of each level moves with the buffer.
+     */
+    template<class TimeLevelType>
+    void test_rotate()
+    {
+      const size_t N = TimeLevelType::Levels;
+      TimeLevelType levels(IndexType(6, 8), domain, stagger, 2);
+
+      std::vector<const double*> pointers;
+      for (size_t l=0; l<N; ++l)
+      {
+        levels[l] = double(l);
+        pointers.push_back(levels[l].getRawData());
+        BOOST_CHECK(levels[l].getLo() == IndexType(-2, -2));
+      }
+
+      for (size_t step=1; step<=2*N+1; ++step)
+      {
+        levels.rotate();
+        levels.current() = -double(step);
+
+        for (size_t l=0; l<N; ++l)
+        {
+          BOOST_CHECK(levels[l].getRawData() == pointers[(l + N - step % N) % N]);
+          BOOST_CHECK(levels[l].getStagger() == stagger);
+          BOOST_CHECK(levels[l].getInnerHi() == IndexType(5, 7));
+        }
+        BOOST_CHECK(check(levels[0], -double(step)));
+        if (step >= N - 1)
+        {
+          BOOST_CHECK(check(levels.oldest(), -double(step - N + 1)));
+        }
+      }
+    }
+};
+
+BOOST_AUTO_TEST_SUITE( grid )
+
+BOOST_AUTO_TEST_SUITE( time_level_field )
+
+BOOST_FIXTURE_TEST_CASE( two_levels, TimeLevelFieldTest )
+{
+  test_rotate<schnek::TimeLevelField<double, 2, 2, GridBoostTestCheck> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( three_levels, TimeLevelFieldTest )
+{
+  test_rotate<schnek::TimeLevelField<double, 2, 3, GridBoostTestCheck> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( morton_levels, TimeLevelFieldTest )
+{
+  test_rotate<schnek::TimeLevelField<double, 2, 4, GridBoostTestCheck, schnek::MortonGridStorage> >();
+}
+
+BOOST_FIXTURE_TEST_CASE( subgrid_follows_level, TimeLevelFieldTest )
+{
+  typedef schnek::TimeLevelField<double, 2, 3, GridBoostTestCheck> TimeLevelType;
+  typedef schnek::SubGrid<TimeLevelType::FieldType, GridBoostTestCheck> SubGridType;
+
+  TimeLevelType levels(IndexType(6, 8), domain, stagger, 2);
+  SubGridType previous(IndexType(0, 0), IndexType(3, 3), levels[1]);
+
+  levels[0] = 1.0;
+  levels[1] = 2.0;
+  levels[2] = 3.0;
+  BOOST_CHECK(check(previous, 2.0));
+
+  // the view on level 1 now sees the data that was at level 0
+  levels.rotate();
+  BOOST_CHECK(check(previous, 1.0));
+
+  previous(2, 2) = 5.0;
+  BOOST_CHECK_EQUAL(levels[1](2, 2), 5.0);
+  BOOST_CHECK_EQUAL(levels[1](5, 7), 1.0);
+  BOOST_CHECK(check(levels[2], 2.0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()